@@ -0,0 +1,356 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <string>
+
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#include <DecentEnclave/Trusted/Sgx/SharedClock.hpp>
+#else
+#include <chrono>
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+
+
+namespace EthereumClt
+{
+namespace Metrics
+{
+
+
+enum class Stage : size_t
+{
+	// host side
+	GethFetchHeader = 0,
+	GethFetchReceipts,
+	EcallRecvBlock,
+	// enclave side
+	BlockIngest,
+	HeaderParse,
+	HeaderValidate,
+	BloomCheck,
+	ReceiptsFetch,
+	ReceiptsVerify,
+	EventDispatch,
+	HeartbeatEmit,
+	SubscriberSend,
+
+	NumOfStages,
+}; // enum class Stage
+
+
+static constexpr size_t sk_numOfStages =
+	static_cast<size_t>(Stage::NumOfStages);
+
+
+struct StageInfo
+{
+	const char* m_name;
+	bool m_isTrusted;
+}; // struct StageInfo
+
+
+/**
+ * @brief Names of the stages, in the same order as `Stage`
+ *
+ */
+inline const StageInfo& GetStageInfo(size_t idx)
+{
+	static const StageInfo sk_infos[sk_numOfStages] = {
+		{ "geth_fetch_header",   false },
+		{ "geth_fetch_receipts", false },
+		{ "ecall_recv_block",    false },
+		{ "block_ingest",        true  },
+		{ "header_parse",        true  },
+		{ "header_validate",     true  },
+		{ "bloom_check",         true  },
+		{ "receipts_fetch",      true  },
+		{ "receipts_verify",     true  },
+		{ "event_dispatch",      true  },
+		{ "heartbeat_emit",      true  },
+		{ "subscriber_send",     true  },
+	};
+	return sk_infos[idx];
+}
+
+
+/**
+ * @brief Latency buckets are exponential, with the upper bound of the i-th
+ *        bucket being 2^i microseconds; slower samples only go to the
+ *        count
+ *
+ */
+static constexpr size_t sk_numOfBuckets = 22;
+
+
+struct StageData
+{
+	std::atomic<uint64_t> m_count;
+	std::atomic<uint64_t> m_sumNanoSec;
+	/**
+	 * @brief Number of samples in each bucket, NOT cumulative
+	 *
+	 */
+	std::atomic<uint64_t> m_buckets[sk_numOfBuckets];
+}; // struct StageData
+
+
+static constexpr uint64_t sk_defTraceSampleInterval = 16;
+static constexpr size_t sk_numOfTraceSlots = 64;
+
+
+/**
+ * @brief Stamps of a sampled block taken by the host, in wall-clock
+ *        nanoseconds; the slot of a block is its number modulo the number
+ *        of slots
+ *
+ */
+struct TraceSlot
+{
+	std::atomic<uint64_t> m_blkNum;
+	std::atomic<uint64_t> m_fetchNanoSec;
+	std::atomic<uint64_t> m_ingestNanoSec;
+}; // struct TraceSlot
+
+
+/**
+ * @brief Fixed-layout block of counters, allocated by the host and shared
+ *        with the enclave, so the host can read the enclave's counters at
+ *        any time without an ECALL.
+ *        The enclave only adds to the counters, and never trusts what it
+ *        reads from the page.
+ *
+ */
+struct MetricsPage
+{
+	MetricsPage() :
+		m_traceSampleInterval(sk_defTraceSampleInterval)
+	{
+		for (auto& stage : m_stages)
+		{
+			stage.m_count = 0;
+			stage.m_sumNanoSec = 0;
+			for (auto& bucket : stage.m_buckets)
+			{
+				bucket = 0;
+			}
+		}
+		for (auto& slot : m_traceSlots)
+		{
+			slot.m_blkNum = 0;
+			slot.m_fetchNanoSec = 0;
+			slot.m_ingestNanoSec = 0;
+		}
+	}
+
+	StageData m_stages[sk_numOfStages];
+
+	/**
+	 * @brief Only blocks whose number is a multiple of this are traced;
+	 *        0 disables tracing
+	 *
+	 */
+	std::atomic<uint64_t> m_traceSampleInterval;
+	/**
+	 * @brief Hops of the sampled blocks stamped by the host, which the
+	 *        enclave picks up when it validates the block
+	 *
+	 */
+	TraceSlot m_traceSlots[sk_numOfTraceSlots];
+}; // struct MetricsPage
+
+
+class Registry
+{
+public: // static members:
+
+	static Registry& GetInstance()
+	{
+		static Registry s_inst;
+		return s_inst;
+	}
+
+public:
+
+	Registry() :
+		m_ownedPage(),
+		m_page(&m_ownedPage)
+	{}
+
+	// LCOV_EXCL_START
+	~Registry() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Record into the given page, instead of the one owned by this
+	 *        registry; the page must outlive this registry
+	 *
+	 */
+	void Bind(MetricsPage* page)
+	{
+		m_page.store(page == nullptr ? &m_ownedPage : page);
+	}
+
+	MetricsPage& GetPage()
+	{
+		return *m_page.load();
+	}
+
+	const MetricsPage& GetPage() const
+	{
+		return *m_page.load();
+	}
+
+	/**
+	 * @brief The time the stages are timed against; inside an SGX enclave,
+	 *        it's read from the shared clock page ticked by the host (0 if
+	 *        no page is bound), which follows the same wall clock as the one
+	 *        read here on the other platforms
+	 *
+	 */
+	uint64_t NowNanoSec() const
+	{
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+		return DecentEnclave::Trusted::Sgx::SharedClock::GetInstance().Read();
+#else
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()
+			).count()
+		);
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+	}
+
+	void Record(size_t stageIdx, uint64_t nanoSec)
+	{
+		if (stageIdx >= sk_numOfStages)
+		{
+			return;
+		}
+		StageData& stage = GetPage().m_stages[stageIdx];
+
+		// rounded up, so each sample is within the bound of its bucket
+		const uint64_t microSec = (nanoSec + 999) / 1000;
+		size_t bucketIdx = 0;
+		for (
+			uint64_t bound = 1;
+			bucketIdx < sk_numOfBuckets && microSec > bound;
+			bound <<= 1
+		)
+		{
+			++bucketIdx;
+		}
+
+		if (bucketIdx < sk_numOfBuckets)
+		{
+			stage.m_buckets[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+		}
+		stage.m_sumNanoSec.fetch_add(nanoSec, std::memory_order_relaxed);
+		stage.m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Record(Stage stage, uint64_t nanoSec)
+	{
+		Record(static_cast<size_t>(stage), nanoSec);
+	}
+
+private:
+
+	MetricsPage m_ownedPage;
+	std::atomic<MetricsPage*> m_page;
+}; // class Registry
+
+
+/**
+ * @brief Records the time from its construction to its destruction into the
+ *        given stage
+ *
+ */
+class StageTimer
+{
+public:
+
+	StageTimer(Stage stage) :
+		m_stageIdx(static_cast<size_t>(stage)),
+		m_startNanoSec(Registry::GetInstance().NowNanoSec())
+	{}
+
+	StageTimer(const StageTimer&) = delete;
+
+	StageTimer& operator=(const StageTimer&) = delete;
+
+	~StageTimer()
+	{
+		Registry& registry = Registry::GetInstance();
+		const uint64_t endNanoSec = registry.NowNanoSec();
+		// the host's clock is not trusted to be monotonic
+		registry.Record(
+			m_stageIdx,
+			endNanoSec > m_startNanoSec ? endNanoSec - m_startNanoSec : 0
+		);
+	}
+
+private:
+
+	size_t m_stageIdx;
+	uint64_t m_startNanoSec;
+}; // class StageTimer
+
+
+/**
+ * @brief Format the page in the Prometheus text exposition format
+ *
+ */
+inline std::string ToPrometheusText(const MetricsPage& page)
+{
+	static const std::string sk_name = "ethereum_clt_stage_duration_seconds";
+
+	std::string res =
+		"# HELP " + sk_name + " Time spent in each stage of the block "
+			"pipeline\n"
+		"# TYPE " + sk_name + " histogram\n";
+
+	for (size_t i = 0; i < sk_numOfStages; ++i)
+	{
+		const StageInfo& info = GetStageInfo(i);
+		const StageData& stage = page.m_stages[i];
+		const std::string labels =
+			std::string("stage=\"") + info.m_name + "\",side=\"" +
+			(info.m_isTrusted ? "enclave" : "host") + "\"";
+
+		uint64_t cumulative = 0;
+		for (size_t j = 0; j < sk_numOfBuckets; ++j)
+		{
+			cumulative += stage.m_buckets[j].load(std::memory_order_relaxed);
+			res += sk_name + "_bucket{" + labels + ",le=\"" +
+				std::to_string((uint64_t(1) << j) / 1e6) + "\"} " +
+				std::to_string(cumulative) + "\n";
+		}
+		const uint64_t sumNanoSec =
+			stage.m_sumNanoSec.load(std::memory_order_relaxed);
+		uint64_t count = stage.m_count.load(std::memory_order_relaxed);
+		// a sample being recorded meanwhile may be in a bucket already,
+		// but not counted yet
+		count = count < cumulative ? cumulative : count;
+
+		res += sk_name + "_bucket{" + labels + ",le=\"+Inf\"} " +
+			std::to_string(count) + "\n";
+		res += sk_name + "_sum{" + labels + "} " +
+			std::to_string(sumNanoSec / 1e9) + "\n";
+		res += sk_name + "_count{" + labels + "} " +
+			std::to_string(count) + "\n";
+	}
+
+	return res;
+}
+
+
+} // namespace Metrics
+} // namespace EthereumClt
@@ -0,0 +1,269 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <DecentEnclave/Common/LatencyTrace.hpp>
+
+#include <EclipseMonitor/TraceHop.hpp>
+
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#include <DecentEnclave/Trusted/Time.hpp>
+#else
+#include <chrono>
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+
+#include "PipelineMetrics.hpp"
+
+
+namespace EthereumClt
+{
+namespace Metrics
+{
+
+
+using TraceHop = EclipseMonitor::TraceHop;
+using EclipseMonitor::GetTraceHopNames;
+
+
+/**
+ * @brief Traces one out of every `MetricsPage::m_traceSampleInterval`
+ *        blocks through the pipeline.
+ *        The host stamps when it starts fetching a sampled block, and when
+ *        it hands the block to the enclave, into the shared metrics page;
+ *        the enclave picks those up when the block is validated, stamps the
+ *        validation and the matching of its events, and attaches the trace
+ *        to each of those events, so it travels with them to the
+ *        subscribers.
+ *        Sampling is decided by the block number alone, so no coordination
+ *        is needed between the host and the enclave.
+ *
+ */
+class Tracer
+{
+public: // static members:
+
+	using BlockNumber = uint64_t;
+
+	/**
+	 * @brief A summary of the block traces is due every this many traces
+	 *
+	 */
+	static constexpr uint64_t sk_summaryInterval = 32;
+
+	static Tracer& GetInstance()
+	{
+		static Tracer s_inst;
+		return s_inst;
+	}
+
+	/**
+	 * @brief Wall-clock time in nanoseconds since the UNIX epoch, so stamps
+	 *        taken by different components can be compared
+	 *
+	 */
+	static uint64_t WallNanoSec()
+	{
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+		return DecentEnclave::Trusted::UntrustedTime::TimestampNanoSec();
+#else
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()
+			).count()
+		);
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+	}
+
+	static size_t ToIdx(TraceHop hop)
+	{
+		return EclipseMonitor::TraceHopToIdx(hop);
+	}
+
+public:
+
+	Tracer() :
+		m_mutex(),
+		m_hasCurrTrace(false),
+		m_currBlkNum(0),
+		m_currTrace(),
+		m_blockStats(GetTraceHopNames())
+	{}
+
+	// LCOV_EXCL_START
+	~Tracer() = default;
+	// LCOV_EXCL_STOP
+
+	bool IsSampled(BlockNumber blkNum) const
+	{
+		const uint64_t interval = Registry::GetInstance().GetPage().
+			m_traceSampleInterval.load(std::memory_order_relaxed);
+		return (interval != 0) && (blkNum % interval == 0);
+	}
+
+	/**
+	 * @brief Set the sampling interval; it's in the shared page, so it
+	 *        applies to the enclave as well
+	 *
+	 */
+	void SetSampleInterval(uint64_t interval)
+	{
+		Registry::GetInstance().GetPage().m_traceSampleInterval.store(interval);
+	}
+
+	// ===== host side =====
+
+	void StampFetch(BlockNumber blkNum)
+	{
+		if (!IsSampled(blkNum))
+		{
+			return;
+		}
+		TraceSlot& slot = GetSlot(blkNum);
+		slot.m_blkNum.store(blkNum);
+		slot.m_fetchNanoSec.store(WallNanoSec());
+		slot.m_ingestNanoSec.store(0);
+	}
+
+	void StampIngest(BlockNumber blkNum)
+	{
+		if (!IsSampled(blkNum))
+		{
+			return;
+		}
+		TraceSlot& slot = GetSlot(blkNum);
+		if (slot.m_blkNum.load() == blkNum)
+		{
+			slot.m_ingestNanoSec.store(WallNanoSec());
+		}
+	}
+
+	// ===== enclave side =====
+
+	/**
+	 * @brief Start the trace of a block that has just been validated;
+	 *        blocks are validated one at a time, so there is only one trace
+	 *        in progress
+	 *
+	 */
+	void BeginValidated(BlockNumber blkNum)
+	{
+		if (!IsSampled(blkNum))
+		{
+			return;
+		}
+
+		DecentEnclave::Common::LatencyTrace trace(ToIdx(TraceHop::NumOfHops));
+
+		// the host's stamps are only used for tracing, so they don't need
+		// to be trusted; a slot taken over by another block is skipped
+		const TraceSlot& slot = GetSlot(blkNum);
+		const uint64_t fetchNanoSec = slot.m_fetchNanoSec.load();
+		const uint64_t ingestNanoSec = slot.m_ingestNanoSec.load();
+		if (slot.m_blkNum.load() == blkNum)
+		{
+			trace.Stamp(ToIdx(TraceHop::Fetch), fetchNanoSec);
+			trace.Stamp(ToIdx(TraceHop::Ingest), ingestNanoSec);
+		}
+		trace.Stamp(ToIdx(TraceHop::Validate), WallNanoSec());
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_hasCurrTrace = true;
+		m_currBlkNum = blkNum;
+		m_currTrace = std::move(trace);
+	}
+
+	/**
+	 * @brief Stamp the match of an event in the given block
+	 *
+	 * @return The serialized trace to be attached to the event, or an empty
+	 *         vector if the block is not traced
+	 */
+	std::vector<uint8_t> StampMatch(BlockNumber blkNum)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_hasCurrTrace || m_currBlkNum != blkNum)
+		{
+			return std::vector<uint8_t>();
+		}
+		// events in the same block are matched in the same pass
+		if (m_currTrace.Get(ToIdx(TraceHop::Match)) == 0)
+		{
+			m_currTrace.Stamp(ToIdx(TraceHop::Match), WallNanoSec());
+		}
+		return m_currTrace.ToBytes();
+	}
+
+	/**
+	 * @brief Finish the trace of the given block, and add it to the block
+	 *        statistics
+	 *
+	 * @return true if a summary of the statistics is due
+	 */
+	bool EndValidated(BlockNumber blkNum)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_hasCurrTrace || m_currBlkNum != blkNum)
+		{
+			return false;
+		}
+		m_hasCurrTrace = false;
+
+		m_blockStats.Add(m_currTrace);
+		return (m_blockStats.GetNumOfTraces() % sk_summaryInterval) == 0;
+	}
+
+	/**
+	 * @brief Stamp the emission of an event carrying the given trace
+	 *
+	 */
+	template<typename _ByteCtnType>
+	static std::vector<uint8_t> StampEmit(
+		const _ByteCtnType& traceBytes,
+		uint64_t emitNanoSec
+	)
+	{
+		auto trace = DecentEnclave::Common::LatencyTrace::FromBytes(traceBytes);
+		trace.Stamp(ToIdx(TraceHop::Emit), emitNanoSec);
+		return trace.ToBytes();
+	}
+
+	/**
+	 * @brief Latencies of the sampled blocks, up to the match of their
+	 *        events
+	 *
+	 */
+	const DecentEnclave::Common::LatencyTraceStats& GetBlockStats() const
+	{
+		return m_blockStats;
+	}
+
+private:
+
+	static TraceSlot& GetSlot(BlockNumber blkNum)
+	{
+		return Registry::GetInstance().GetPage().
+			m_traceSlots[blkNum % sk_numOfTraceSlots];
+	}
+
+	std::mutex m_mutex;
+	bool m_hasCurrTrace;
+	BlockNumber m_currBlkNum;
+	DecentEnclave::Common::LatencyTrace m_currTrace;
+	DecentEnclave::Common::LatencyTraceStats m_blockStats;
+
+}; // class Tracer
+
+
+} // namespace Metrics
+} // namespace EthereumClt
@@ -0,0 +1,58 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include "PipelineMetrics.hpp"
+
+
+namespace EthereumClt
+{
+namespace Metrics
+{
+
+
+inline Stage ToPipelineStage(EclipseMonitor::MetricsStage stage)
+{
+	switch (stage)
+	{
+	case EclipseMonitor::MetricsStage::HeaderParse:
+		return Stage::HeaderParse;
+	case EclipseMonitor::MetricsStage::HeaderValidate:
+		return Stage::HeaderValidate;
+	case EclipseMonitor::MetricsStage::BloomCheck:
+		return Stage::BloomCheck;
+	case EclipseMonitor::MetricsStage::EventDispatch:
+		return Stage::EventDispatch;
+	default:
+		return Stage::NumOfStages;
+	}
+}
+
+
+} // namespace Metrics
+} // namespace EthereumClt
+
+
+namespace EclipseMonitor
+{
+
+
+class StageTimer :
+	public ::EthereumClt::Metrics::StageTimer
+{
+public:
+
+	StageTimer(MetricsStage stage) :
+		::EthereumClt::Metrics::StageTimer(
+			::EthereumClt::Metrics::ToPipelineStage(stage)
+		)
+	{}
+
+}; // class StageTimer
+
+
+} // namespace EclipseMonitor
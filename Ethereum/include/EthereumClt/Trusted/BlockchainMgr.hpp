@@ -16,6 +16,8 @@
 #include <SimpleObjects/Codec/Hex.hpp>
 #include <SimpleObjects/Internal/make_unique.hpp>
 
+#include "../Common/PipelineMetrics.hpp"
+#include "../Common/PipelineTrace.hpp"
 #include "HostBlockService.hpp"
 #include "Pubsub/SubscriberService.hpp"
 #include "RandomGenerator.hpp"
@@ -115,6 +117,7 @@ public:
 
 	void AppendBlock(const std::vector<uint8_t>& headerRlp)
 	{
+		Metrics::StageTimer timer(Metrics::Stage::BlockIngest);
 		std::lock_guard<std::mutex> lock(m_monitorMutex);
 		m_monitor->Update(headerRlp);
 	}
@@ -154,13 +157,25 @@ private:
 	{
 		m_lastValidatedBlkNum = hdr.GetRawHeader().get_Number();
 
+		Metrics::Tracer& tracer = Metrics::Tracer::GetInstance();
+		tracer.BeginValidated(hdr.GetNumber());
+
 		auto receiptsMgrGetter =
 			[this](EclipseMonitor::Eth::BlockNumber blkNum)
 				-> EclipseMonitor::Eth::ReceiptsMgr
 			{
-				return EclipseMonitor::Eth::ReceiptsMgr(
-					m_hostBlkSvc->GetReceiptsRlpByNum(blkNum).AsList()
-				);
+				// the receipts tree is dropped once the manager is built
+				SimpleObjects::ObjectArena arena;
+				SimpleObjects::Object receipts;
+				{
+					Metrics::StageTimer timer(Metrics::Stage::ReceiptsFetch);
+					receipts = m_hostBlkSvc->GetReceiptsRlpByNum(blkNum, arena);
+				}
+
+				// building the manager computes the receipts root, which is
+				// compared against the header by the event manager
+				Metrics::StageTimer timer(Metrics::Stage::ReceiptsVerify);
+				return EclipseMonitor::Eth::ReceiptsMgr(receipts.AsList());
 			};
 
 		m_monitor->GetEventManager()->CheckEvents(
@@ -168,6 +183,14 @@ private:
 			receiptsMgrGetter
 		);
 
+		if (tracer.EndValidated(hdr.GetNumber()))
+		{
+			m_logger.Info(
+				"Latency of the sampled blocks:\n" +
+				tracer.GetBlockStats().ToString()
+			);
+		}
+
 		const auto phase = m_monitor->GetPhase();
 		switch (phase)
 		{
@@ -231,31 +254,34 @@ private:
 
 	void LogMonitorStatus() const
 	{
-		const auto phase = m_monitor->GetPhase();
-		std::string phaseStr =
-			phase == EclipseMonitor::Phases::BootstrapI ?  "BootstrapII" :
-			phase == EclipseMonitor::Phases::BootstrapII ? "BootstrapII" :
-			phase == EclipseMonitor::Phases::Sync ?        "Sync" :
-			"Runtime";
-
-		const auto& monitor = *m_monitor;
-		const auto& secState = monitor.GetMonitorSecState();
-		const std::string genesisHash =
-			SimpleObjects::Codec::Hex::Encode<std::string>(
-				secState.get_genesisHash().GetVal()
-			);
-		const std::string chkptHash =
-			SimpleObjects::Codec::Hex::Encode<std::string>(
-				secState.get_checkpointHash().GetVal()
-			);
-		const auto chkptIter = secState.get_checkpointIter().GetVal();
-
 		m_logger.Info(
-			std::string("Current Eclipse Monitor Status:\n") +
-			"\tPhase:                " + phaseStr    + ";\n" +
-			"\tGenesis Hash:         " + genesisHash + ";\n" +
-			"\tCheckpoint Hash:      " + chkptHash   + ";\n" +
-			"\tCheckpoint Iteration: " + std::to_string(chkptIter) + ";\n"
+			[this]()
+			{
+				const auto phase = m_monitor->GetPhase();
+				std::string phaseStr =
+					phase == EclipseMonitor::Phases::BootstrapI ?  "BootstrapII" :
+					phase == EclipseMonitor::Phases::BootstrapII ? "BootstrapII" :
+					phase == EclipseMonitor::Phases::Sync ?        "Sync" :
+					"Runtime";
+
+				const auto& monitor = *m_monitor;
+				const auto& secState = monitor.GetMonitorSecState();
+				const std::string genesisHash =
+					SimpleObjects::Codec::Hex::Encode<std::string>(
+						secState.get_genesisHash().GetVal()
+					);
+				const std::string chkptHash =
+					SimpleObjects::Codec::Hex::Encode<std::string>(
+						secState.get_checkpointHash().GetVal()
+					);
+				const auto chkptIter = secState.get_checkpointIter().GetVal();
+
+				return std::string("Current Eclipse Monitor Status:\n") +
+					"\tPhase:                " + phaseStr    + ";\n" +
+					"\tGenesis Hash:         " + genesisHash + ";\n" +
+					"\tCheckpoint Hash:      " + chkptHash   + ";\n" +
+					"\tCheckpoint Iteration: " + std::to_string(chkptIter) + ";\n";
+			}
 		);
 	}
 
@@ -6,11 +6,15 @@
 #pragma once
 
 
-#include <DecentEnclave/Common/Sgx/Exceptions.hpp>
-#include <DecentEnclave/Trusted/Sgx/UntrustedBuffer.hpp>
 #include <SimpleObjects/SimpleObjects.hpp>
 #include <SimpleRlp/SimpleRlp.hpp>
 
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+#include "../Untrusted/HostBlockService.hpp"
+#else
+#include <DecentEnclave/Common/Sgx/Exceptions.hpp>
+#include <DecentEnclave/Trusted/Sgx/UntrustedBuffer.hpp>
+
 
 extern "C" sgx_status_t ocall_ethereum_clt_get_receipts(
 	sgx_status_t* retval,
@@ -25,6 +29,7 @@ extern "C" sgx_status_t ocall_ethereum_clt_get_latest_blknum(
 	const void*   host_blk_svc,
 	uint64_t*     out_blk_num
 );
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
 
 
 namespace EthereumClt
@@ -44,22 +49,27 @@ public:
 
 	SimpleObjects::Object GetReceiptsRlpByNum(uint64_t blockNum) const
 	{
-		DecentEnclave::Trusted::Sgx::UntrustedBuffer<uint8_t> ub;
-		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
-			ocall_ethereum_clt_get_receipts,
-			m_ptr,
-			blockNum,
-			&(ub.m_data),
-			&(ub.m_size)
-		);
-
-		auto rlp = ub.CopyToContainer<std::vector<uint8_t> >();
+		return SimpleRlp::ParseRlp(GetReceiptsRlpBytesByNum(blockNum));
+	}
 
-		return SimpleRlp::GeneralParser().Parse(rlp);
+	/**
+	 * @brief Same as above, but the returned tree is allocated from the
+	 *        given arena, which must outlive it
+	 *
+	 */
+	SimpleObjects::Object GetReceiptsRlpByNum(
+		uint64_t blockNum,
+		SimpleObjects::ObjectArena& arena
+	) const
+	{
+		return SimpleRlp::ParseRlp(GetReceiptsRlpBytesByNum(blockNum), arena);
 	}
 
 	uint64_t GetLatestBlockNum() const
 	{
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+		return GetHostBlkSvc().GetLatestBlockNum();
+#else
 		uint64_t ret;
 		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
 			ocall_ethereum_clt_get_latest_blknum,
@@ -68,10 +78,37 @@ public:
 		);
 
 		return ret;
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
 	}
 
 private:
 
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+	// the host service is in the same process, so it's called directly
+	const EthereumClt::HostBlockService& GetHostBlkSvc() const
+	{
+		return *static_cast<const EthereumClt::HostBlockService*>(m_ptr);
+	}
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
+
+	std::vector<uint8_t> GetReceiptsRlpBytesByNum(uint64_t blockNum) const
+	{
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+		return GetHostBlkSvc().GetReceiptsListRlpByNum(blockNum);
+#else
+		DecentEnclave::Trusted::Sgx::UntrustedBuffer<uint8_t> ub;
+		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
+			ocall_ethereum_clt_get_receipts,
+			m_ptr,
+			blockNum,
+			&(ub.m_data),
+			&(ub.m_size)
+		);
+
+		return ub.CopyToContainer<std::vector<uint8_t> >();
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
+	}
+
 	void* m_ptr;
 }; // class HostBlockService
 
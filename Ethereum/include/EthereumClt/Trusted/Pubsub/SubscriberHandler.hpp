@@ -14,6 +14,8 @@
 
 #include <SimpleObjects/Codec/Hex.hpp>
 
+#include "../../Common/PipelineMetrics.hpp"
+#include "../../Common/PipelineTrace.hpp"
 #include "../BlockchainMgr.hpp"
 #include "../DataType.hpp"
 #include "SubscriberService.hpp"
@@ -50,14 +52,19 @@ inline void NotifyEventHandler(
 		_MsgParser().ToPrimitive(abiBegin, abiEnd, abiBegin);
 
 	// 2. Save event to event queue
+	EventData evData({
+		EventData::value_type(headerMgr.GetRawHeader().get_Number()),
+		EventData::value_type(evMsg),
+	});
+	std::vector<uint8_t> trace =
+		Metrics::Tracer::GetInstance().StampMatch(headerMgr.GetNumber());
+	if (!trace.empty())
+	{
+		evData.push_back(EventData::value_type(std::move(trace)));
+	}
 	{
 		std::lock_guard<std::mutex> lock(evQueue.m_mutex);
-		evQueue.m_eventQueue.push_back(
-			EventData({
-				EventData::value_type(headerMgr.GetRawHeader().get_Number()),
-				EventData::value_type(evMsg),
-			})
-		);
+		evQueue.m_eventQueue.push_back(std::move(evData));
 	}
 
 	// 3. Debug message
@@ -140,14 +147,33 @@ inline void EmitterHandler(
 			evQueue.m_eventQueue = EventDataQueue();
 		}
 
-		std::vector<uint8_t> respMsg = BuildEmittedMsg(
-			SimpleObjects::Bytes(AdvancedRlp::GenericWriter::Write(
-				bcMgr.GetMonitorSecState()
-			)),
-			bcMgr.GetLastValidatedBlkNum(),
-			std::move(outEvQueue)
-		);
+		// stamp the traced events, with one timestamp for the heartbeat
+		uint64_t emitNanoSec = 0;
+		for (auto& evData : outEvQueue)
+		{
+			if (evData.size() > 2)
+			{
+				emitNanoSec = (emitNanoSec == 0) ?
+					Metrics::Tracer::WallNanoSec() : emitNanoSec;
+				evData[2] = EventData::value_type(
+					Metrics::Tracer::StampEmit(evData[2], emitNanoSec)
+				);
+			}
+		}
 
+		std::vector<uint8_t> respMsg;
+		{
+			Metrics::StageTimer timer(Metrics::Stage::HeartbeatEmit);
+			respMsg = BuildEmittedMsg(
+				SimpleObjects::Bytes(AdvancedRlp::GenericWriter::Write(
+					bcMgr.GetMonitorSecState()
+				)),
+				bcMgr.GetLastValidatedBlkNum(),
+				std::move(outEvQueue)
+			);
+		}
+
+		Metrics::StageTimer timer(Metrics::Stage::SubscriberSend);
 		socket.SizedSendBytes(respMsg);
 	}
 	catch(const std::exception&)
@@ -194,8 +220,12 @@ inline void SubReq(
 	}
 
 	// 2. subscribe to event manager first
-	s_logger.Debug("Subscribing to event manager @" +
-		SimpleObjects::Codec::Hex::Encode<std::string>(eventMgrAddr)
+	s_logger.Debug(
+		[&]()
+		{
+			return "Subscribing to event manager @" +
+				SimpleObjects::Codec::Hex::Encode<std::string>(eventMgrAddr);
+		}
 	);
 	std::shared_ptr<ThreadedEventQueue> eventQueue =
 		std::make_shared<ThreadedEventQueue>();
@@ -39,6 +39,8 @@ namespace Pubsub
  *        associated metadata; its structure should be
  *        1. SimpleObjects::Bytes - The block number when the event is emitted
  *        2. SimpleObjects::Bytes - The event message
+ *        3. SimpleObjects::Bytes - (Optional) The latency trace, only if
+ *                                  the block is sampled for tracing
  *
  */
 using EventData  = SimpleObjects::ListT<SimpleObjects::Bytes>;
@@ -254,10 +256,15 @@ private: // helper functions:
 
 		// 3. Debug message
 		svcStore.m_logger.Debug(
-			std::string("Event Manager @") +
-			SimpleObjects::Codec::Hex::Encode<std::string>(log.m_contractAddr) +
-			" emit an event at block #" +
-			std::to_string(headerMgr.GetNumber())
+			[&]()
+			{
+				return std::string("Event Manager @") +
+					SimpleObjects::Codec::Hex::Encode<std::string>(
+						log.m_contractAddr
+					) +
+					" emit an event at block #" +
+					std::to_string(headerMgr.GetNumber());
+			}
 		);
 	}
 
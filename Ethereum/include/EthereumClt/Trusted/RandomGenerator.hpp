@@ -6,7 +6,7 @@
 #pragma once
 
 
-#include <DecentEnclave/Trusted/Sgx/Random.hpp>
+#include <DecentEnclave/Common/Platform/Random.hpp>
 #include <EclipseMonitor/PlatformInterfaces.hpp>
 
 
@@ -34,7 +34,7 @@ public:
 
 private:
 
-	mutable DecentEnclave::Trusted::Sgx::RandGenerator m_randGen;
+	mutable DecentEnclave::Common::Platform::RandGenerator m_randGen;
 }; // class RandomGenerator
 
 
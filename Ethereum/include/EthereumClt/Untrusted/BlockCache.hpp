@@ -0,0 +1,1064 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <EclipseMonitor/Eth/DataTypes.hpp>
+#include <SimpleSysIO/SysCall/Files.hpp>
+
+#include "BlockCorpus.hpp"
+
+
+namespace EthereumClt
+{
+
+
+enum class BlockCacheItem : uint32_t
+{
+	Header   = 0,
+	Receipts = 1,
+}; // enum class BlockCacheItem
+
+
+/**
+ * @brief The layout of the files of a block cache range, which keeps the
+ *        raw headers and the RLP lists of raw receipts of the blocks whose
+ *        numbers fall in the range.
+ *        All integers are stored in little-endian:
+ *          data file, append-only:
+ *            magic                                    8 bytes
+ *            records:
+ *              block number                           u64
+ *              item, payload size                     u32, u32
+ *              CRC-32 of the payload                  u32
+ *              payload
+ *          index file, append-only:
+ *            magic                                    8 bytes
+ *            entries:
+ *              block number                           u64
+ *              item, payload size                     u32, u32
+ *              record offset                          u64
+ *        A record is appended to the data file before its entry is appended
+ *        to the index, so an entry never refers to a record that is not
+ *        fully written; a torn write only leaves garbage that no entry
+ *        refers to.
+ *        A record whose payload doesn't match its checksum (e.g., the file
+ *        was corrupted on the disk) is dropped when it's read.
+ *
+ */
+struct BlockCacheFormat
+{
+	static constexpr size_t sk_magicSize = 8;
+	static constexpr size_t sk_recordHeaderSize = 8 + 4 + 4 + 4;
+	static constexpr size_t sk_indexEntrySize = 8 + 4 + 4 + 8;
+
+	static const char* GetDataMagic()
+	{
+		return "ECLTBCD2";
+	}
+
+	static const char* GetIndexMagic()
+	{
+		return "ECLTBCI2";
+	}
+
+	/**
+	 * @brief CRC-32 (the one used by zlib), which is enough to catch a
+	 *        corrupted record; the records are not trusted anyway, since
+	 *        the enclave validates the blocks
+	 *
+	 */
+	static uint32_t Crc32(const uint8_t* data, size_t size)
+	{
+		static const std::vector<uint32_t> sk_table = BuildCrc32Table();
+
+		uint32_t crc = 0xFFFFFFFFU;
+		for (size_t i = 0; i < size; ++i)
+		{
+			crc = sk_table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8);
+		}
+		return crc ^ 0xFFFFFFFFU;
+	}
+
+private:
+
+	static std::vector<uint32_t> BuildCrc32Table()
+	{
+		std::vector<uint32_t> table(256);
+		for (uint32_t i = 0; i < table.size(); ++i)
+		{
+			uint32_t crc = i;
+			for (size_t bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc & 1U) ? ((crc >> 1) ^ 0xEDB88320U) : (crc >> 1);
+			}
+			table[i] = crc;
+		}
+		return table;
+	}
+}; // struct BlockCacheFormat
+
+
+/**
+ * @brief One range of block numbers in the block cache, which is the unit
+ *        of eviction.
+ *        The index is kept in memory, and the records are read through a
+ *        read-only memory mapping of the data file, which is extended when
+ *        a record beyond the mapped part is requested.
+ *        A read-only range never modifies its files, and is kept up to date
+ *        with the ones written by another process through `Reload`.
+ *        NOTE: it's not thread-safe; `BlockCache` serializes the access
+ *
+ */
+class BlockCacheRange
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+	using Format = BlockCacheFormat;
+	using IntFormat = BlockCorpusFormat;
+
+public:
+
+	BlockCacheRange(
+		BlockNumber startNum,
+		const std::string& dataPath,
+		const std::string& indexPath,
+		bool isReadOnly = false
+	) :
+		m_startNum(startNum),
+		m_dataPath(dataPath),
+		m_indexPath(indexPath),
+		m_isReadOnly(isReadOnly),
+		m_index(),
+		m_dataSize(0),
+		m_indexSize(0),
+		m_map(nullptr),
+		m_mapSize(0),
+		m_dataWriter(),
+		m_indexWriter(),
+		m_lastUsed(0)
+	{
+		LoadIndex();
+	}
+
+	// LCOV_EXCL_START
+	~BlockCacheRange()
+	{
+		Unmap();
+	}
+	// LCOV_EXCL_STOP
+
+	BlockCacheRange(const BlockCacheRange&) = delete;
+
+	BlockCacheRange& operator=(const BlockCacheRange&) = delete;
+
+	BlockNumber GetStartNum() const
+	{
+		return m_startNum;
+	}
+
+	/**
+	 * @brief The number of bytes this range takes on disk
+	 *
+	 */
+	uint64_t GetDiskSize() const
+	{
+		return m_dataSize + m_indexSize;
+	}
+
+	uint64_t GetLastUsed() const
+	{
+		return m_lastUsed;
+	}
+
+	void SetLastUsed(uint64_t lastUsed)
+	{
+		m_lastUsed = lastUsed;
+	}
+
+	bool Has(BlockNumber blockNum, BlockCacheItem item) const
+	{
+		return m_index.find(ToKey(blockNum, item)) != m_index.end();
+	}
+
+	/**
+	 * @brief Read the payload of the given item of the given block
+	 *
+	 * @return true if the item is in the range, and it's read into `out`
+	 */
+	bool TryGet(
+		BlockNumber blockNum,
+		BlockCacheItem item,
+		std::vector<uint8_t>& out
+	)
+	{
+		auto it = m_index.find(ToKey(blockNum, item));
+		if (it == m_index.end())
+		{
+			return false;
+		}
+
+		const uint64_t offset = it->second.first;
+		const uint64_t size = it->second.second;
+		const uint64_t end = offset + Format::sk_recordHeaderSize + size;
+		if (end > m_mapSize)
+		{
+			Remap();
+		}
+		if (end > m_mapSize)
+		{
+			// the data file has been truncated behind our back
+			m_index.erase(it);
+			return false;
+		}
+
+		const uint8_t* ptr = static_cast<const uint8_t*>(m_map) + offset;
+		const uint8_t* payload = ptr + Format::sk_recordHeaderSize;
+		if (
+			(IntFormat::ReadInt<uint64_t>(ptr) != blockNum) ||
+			(IntFormat::ReadInt<uint32_t>(ptr + 8) !=
+				static_cast<uint32_t>(item)) ||
+			(IntFormat::ReadInt<uint32_t>(ptr + 12) != size) ||
+			(IntFormat::ReadInt<uint32_t>(ptr + 16) !=
+				Format::Crc32(payload, static_cast<size_t>(size)))
+		)
+		{
+			// the entry is dropped, so the item is fetched again, and a
+			// new record of it is appended
+			m_index.erase(it);
+			return false;
+		}
+
+		out.assign(payload, payload + size);
+		return true;
+	}
+
+	/**
+	 * @brief Append the given item of the given block; an item that is in
+	 *        the range already is skipped
+	 *
+	 */
+	void Put(
+		BlockNumber blockNum,
+		BlockCacheItem item,
+		const std::vector<uint8_t>& payload
+	)
+	{
+		if (m_isReadOnly)
+		{
+			throw std::logic_error("BlockCacheRange - the range is read-only");
+		}
+		if (Has(blockNum, item))
+		{
+			return;
+		}
+		OpenWriters();
+
+		std::vector<uint8_t> recHeader;
+		recHeader.reserve(Format::sk_recordHeaderSize);
+		IntFormat::AppendInt<uint64_t>(recHeader, blockNum);
+		IntFormat::AppendInt<uint32_t>(recHeader, static_cast<uint32_t>(item));
+		IntFormat::AppendInt<uint32_t>(
+			recHeader, static_cast<uint32_t>(payload.size()));
+		IntFormat::AppendInt<uint32_t>(
+			recHeader, Format::Crc32(payload.data(), payload.size()));
+
+		const uint64_t offset = m_dataSize;
+		m_dataWriter->WriteBytes(recHeader);
+		m_dataWriter->WriteBytes(payload);
+		m_dataWriter->Flush();
+		m_dataSize += recHeader.size() + payload.size();
+
+		std::vector<uint8_t> entry;
+		entry.reserve(Format::sk_indexEntrySize);
+		IntFormat::AppendInt<uint64_t>(entry, blockNum);
+		IntFormat::AppendInt<uint32_t>(entry, static_cast<uint32_t>(item));
+		IntFormat::AppendInt<uint32_t>(
+			entry, static_cast<uint32_t>(payload.size()));
+		IntFormat::AppendInt<uint64_t>(entry, offset);
+		m_indexWriter->WriteBytes(entry);
+		m_indexWriter->Flush();
+		m_indexSize += entry.size();
+
+		m_index[ToKey(blockNum, item)] =
+			Location(offset, static_cast<uint32_t>(payload.size()));
+	}
+
+	/**
+	 * @brief Close the files opened for appending; they are reopened on the
+	 *        next `Put`
+	 *
+	 */
+	void CloseWriters()
+	{
+		m_dataWriter.reset();
+		m_indexWriter.reset();
+	}
+
+	/**
+	 * @brief Reload the index of a read-only range, to pick up the records
+	 *        written since it was loaded; the data file is mapped again on
+	 *        the next read, in case it has been replaced
+	 *
+	 */
+	void Reload()
+	{
+		Unmap();
+		m_index.clear();
+		LoadIndex();
+	}
+
+	/**
+	 * @brief Delete the files of this range; it must not be used afterwards
+	 *
+	 */
+	void Remove()
+	{
+		if (m_isReadOnly)
+		{
+			throw std::logic_error("BlockCacheRange - the range is read-only");
+		}
+		CloseWriters();
+		Unmap();
+		m_index.clear();
+		std::remove(m_indexPath.c_str());
+		std::remove(m_dataPath.c_str());
+		m_dataSize = 0;
+		m_indexSize = 0;
+	}
+
+private:
+
+	/**
+	 * @brief Offset of the record, and the size of its payload
+	 *
+	 */
+	using Location = std::pair<uint64_t, uint32_t>;
+
+	static uint64_t ToKey(BlockNumber blockNum, BlockCacheItem item)
+	{
+		return (blockNum << 1) | static_cast<uint64_t>(item);
+	}
+
+	static uint64_t GetFileSize(const std::string& path)
+	{
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0)
+		{
+			return 0;
+		}
+		return static_cast<uint64_t>(st.st_size);
+	}
+
+	void LoadIndex()
+	{
+		std::vector<uint8_t> indexBytes;
+		if (GetFileSize(m_indexPath) > 0)
+		{
+			auto file = SimpleSysIO::SysCall::RBinaryFile::Open(m_indexPath);
+			indexBytes = file->ReadBytes<std::vector<uint8_t> >();
+		}
+		// the data file is appended to before the index is, so all the
+		// entries read are covered by its size
+		m_dataSize = GetFileSize(m_dataPath);
+
+		if (
+			(indexBytes.size() < Format::sk_magicSize) ||
+			(std::memcmp(
+				indexBytes.data(),
+				Format::GetIndexMagic(),
+				Format::sk_magicSize
+			) != 0) ||
+			(m_dataSize < Format::sk_magicSize)
+		)
+		{
+			// nothing usable, so the range starts over
+			if (!m_isReadOnly)
+			{
+				std::remove(m_indexPath.c_str());
+				std::remove(m_dataPath.c_str());
+			}
+			m_dataSize = 0;
+			m_indexSize = 0;
+			return;
+		}
+
+		// a partially written entry at the end is dropped
+		bool isClean = (
+			(indexBytes.size() - Format::sk_magicSize) %
+				Format::sk_indexEntrySize
+		) == 0;
+
+		std::vector<uint8_t> validEntries;
+		for (
+			size_t pos = Format::sk_magicSize;
+			pos + Format::sk_indexEntrySize <= indexBytes.size();
+			pos += Format::sk_indexEntrySize
+		)
+		{
+			const uint8_t* ptr = indexBytes.data() + pos;
+			const uint64_t blockNum = IntFormat::ReadInt<uint64_t>(ptr);
+			const uint32_t item = IntFormat::ReadInt<uint32_t>(ptr + 8);
+			const uint32_t size = IntFormat::ReadInt<uint32_t>(ptr + 12);
+			const uint64_t offset = IntFormat::ReadInt<uint64_t>(ptr + 16);
+			if (
+				(item > static_cast<uint32_t>(BlockCacheItem::Receipts)) ||
+				(offset < Format::sk_magicSize) ||
+				(offset + Format::sk_recordHeaderSize + size > m_dataSize)
+			)
+			{
+				// the entry reached the disk, but its record didn't
+				isClean = false;
+				continue;
+			}
+
+			m_index[ToKey(blockNum, static_cast<BlockCacheItem>(item))] =
+				Location(offset, size);
+			validEntries.insert(
+				validEntries.end(),
+				ptr,
+				ptr + Format::sk_indexEntrySize
+			);
+		}
+		m_indexSize = Format::sk_magicSize + validEntries.size();
+
+		if (!isClean && !m_isReadOnly)
+		{
+			// rewrite the index, so new entries are appended at an entry
+			// boundary
+			auto file = SimpleSysIO::SysCall::WBinaryFile::Create(m_indexPath);
+			file->WriteBytes(
+				std::string(Format::GetIndexMagic(), Format::sk_magicSize)
+			);
+			file->WriteBytes(validEntries);
+			file->Flush();
+		}
+	}
+
+	void OpenWriters()
+	{
+		if (m_dataWriter != nullptr)
+		{
+			return;
+		}
+
+		m_dataWriter = SimpleSysIO::SysCall::WBinaryFile::Append(m_dataPath);
+		if (m_dataSize == 0)
+		{
+			m_dataWriter->WriteBytes(
+				std::string(Format::GetDataMagic(), Format::sk_magicSize)
+			);
+			m_dataSize = Format::sk_magicSize;
+		}
+
+		m_indexWriter = SimpleSysIO::SysCall::WBinaryFile::Append(m_indexPath);
+		if (m_indexSize == 0)
+		{
+			m_indexWriter->WriteBytes(
+				std::string(Format::GetIndexMagic(), Format::sk_magicSize)
+			);
+			m_indexSize = Format::sk_magicSize;
+		}
+	}
+
+	void Remap()
+	{
+		if (m_dataWriter != nullptr)
+		{
+			m_dataWriter->Flush();
+		}
+		Unmap();
+
+		const uint64_t size = GetFileSize(m_dataPath);
+		if (size == 0)
+		{
+			return;
+		}
+
+		int fd = open(m_dataPath.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			throw std::runtime_error(
+				"BlockCacheRange - failed to open " + m_dataPath + ": " +
+				std::strerror(errno)
+			);
+		}
+		void* map = mmap(
+			nullptr,
+			static_cast<size_t>(size),
+			PROT_READ,
+			MAP_SHARED,
+			fd,
+			0
+		);
+		// the mapping stays valid after the descriptor is closed
+		close(fd);
+		if (map == MAP_FAILED)
+		{
+			throw std::runtime_error(
+				"BlockCacheRange - failed to map " + m_dataPath + ": " +
+				std::strerror(errno)
+			);
+		}
+
+		m_map = map;
+		m_mapSize = size;
+	}
+
+	void Unmap()
+	{
+		if (m_map != nullptr)
+		{
+			munmap(m_map, static_cast<size_t>(m_mapSize));
+			m_map = nullptr;
+			m_mapSize = 0;
+		}
+	}
+
+	BlockNumber m_startNum;
+	std::string m_dataPath;
+	std::string m_indexPath;
+	bool m_isReadOnly;
+	std::unordered_map<uint64_t, Location> m_index;
+	uint64_t m_dataSize;
+	uint64_t m_indexSize;
+	void* m_map;
+	uint64_t m_mapSize;
+	std::unique_ptr<SimpleSysIO::WBinaryIOSBase> m_dataWriter;
+	std::unique_ptr<SimpleSysIO::WBinaryIOSBase> m_indexWriter;
+	uint64_t m_lastUsed;
+
+}; // class BlockCacheRange
+
+
+/**
+ * @brief A persistent cache of the raw headers and receipts fetched from
+ *        Geth, so restarting the client, re-bootstrapping a monitor, or
+ *        running another client on the same host doesn't fetch them again.
+ *        Blocks are grouped into ranges of consecutive block numbers, each
+ *        kept in its own pair of append-only files in the cache directory;
+ *        when the cache grows beyond its size limit, the least recently used
+ *        ranges are deleted as a whole.
+ *        Blocks are only persisted once they are `confirmations` blocks
+ *        behind the newest header put into the cache, so a block that is
+ *        later reorganized out of the chain is never persisted; until then
+ *        they are kept in memory.
+ *        The recency of the ranges is tracked in memory, and starts from the
+ *        modification time of their files when the cache is opened.
+ *        Only one instance writes to a cache directory, the one that holds
+ *        the `flock` on it; an instance opened while another one holds it
+ *        (e.g., in another client on the same host) is read-only: it never
+ *        writes or evicts, and reloads the index of a range when a block
+ *        is missing from it, to pick up what the writer has added since.
+ *
+ */
+class BlockCache
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+
+	static constexpr uint64_t sk_defBlocksPerRange = 4096;
+	static constexpr uint64_t sk_defConfirmations = 64;
+
+public:
+
+	/**
+	 * @brief Construct a new Block Cache object
+	 *
+	 * @param dirPath        The directory of the cache files; it's created
+	 *                       if it doesn't exist
+	 * @param maxSize        Maximum number of bytes the cache takes on disk;
+	 *                       the range being written is never evicted, so it
+	 *                       may be exceeded by up to one range
+	 * @param blocksPerRange Number of blocks in each range; a cache must be
+	 *                       reopened with the same value
+	 * @param confirmations  Number of blocks a block must be behind the
+	 *                       newest header before it's persisted
+	 */
+	BlockCache(
+		const std::string& dirPath,
+		uint64_t maxSize,
+		uint64_t blocksPerRange = sk_defBlocksPerRange,
+		uint64_t confirmations = sk_defConfirmations
+	) :
+		m_mutex(),
+		m_dirPath(dirPath),
+		m_dirFd(-1),
+		m_isReadOnly(false),
+		m_maxSize(maxSize),
+		m_blocksPerRange(blocksPerRange == 0 ? 1 : blocksPerRange),
+		m_confirmations(confirmations),
+		m_ranges(),
+		m_pending(),
+		m_headNum(0),
+		m_hasHead(false),
+		m_writeRange(nullptr),
+		m_useCounter(0),
+		m_numOfHits(0),
+		m_numOfMisses(0)
+	{
+		OpenDir();
+	}
+
+	// LCOV_EXCL_START
+	~BlockCache()
+	{
+		// the ranges are closed before the lock is released
+		m_writeRange = nullptr;
+		m_ranges.clear();
+		if (m_dirFd >= 0)
+		{
+			close(m_dirFd);
+		}
+	}
+	// LCOV_EXCL_STOP
+
+	BlockCache(const BlockCache&) = delete;
+
+	BlockCache& operator=(const BlockCache&) = delete;
+
+	bool TryGetHeaderRlp(BlockNumber blockNum, std::vector<uint8_t>& out)
+	{
+		return TryGet(blockNum, BlockCacheItem::Header, out);
+	}
+
+	/**
+	 * @brief Get the RLP list of the raw receipts of the given block
+	 *
+	 */
+	bool TryGetReceiptsRlp(BlockNumber blockNum, std::vector<uint8_t>& out)
+	{
+		return TryGet(blockNum, BlockCacheItem::Receipts, out);
+	}
+
+	void PutHeaderRlp(
+		BlockNumber blockNum,
+		const std::vector<uint8_t>& headerRlp
+	)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_hasHead || blockNum > m_headNum)
+		{
+			m_hasHead = true;
+			m_headNum = blockNum;
+		}
+		PutPending(blockNum, BlockCacheItem::Header, headerRlp);
+		PersistConfirmed();
+	}
+
+	/**
+	 * @brief Put the RLP list of the raw receipts of the given block
+	 *
+	 */
+	void PutReceiptsRlp(
+		BlockNumber blockNum,
+		const std::vector<uint8_t>& receiptsRlp
+	)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		PutPending(blockNum, BlockCacheItem::Receipts, receiptsRlp);
+		PersistConfirmed();
+	}
+
+	/**
+	 * @brief Whether another instance holds the lock on the cache directory,
+	 *        so this one doesn't write to it
+	 *
+	 */
+	bool IsReadOnly() const
+	{
+		return m_isReadOnly;
+	}
+
+	uint64_t GetDiskSize() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return CalcDiskSize();
+	}
+
+	size_t GetNumOfRanges() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_ranges.size();
+	}
+
+	uint64_t GetNumOfHits() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numOfHits;
+	}
+
+	uint64_t GetNumOfMisses() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numOfMisses;
+	}
+
+private:
+
+	using PendingKey = std::pair<BlockNumber, BlockCacheItem>;
+	using RangeMap = std::map<BlockNumber, std::unique_ptr<BlockCacheRange> >;
+
+	static const char* GetDataExt()
+	{
+		return ".dat";
+	}
+
+	static const char* GetIndexExt()
+	{
+		return ".idx";
+	}
+
+	std::string GetRangePath(BlockNumber startNum, const char* ext) const
+	{
+		return m_dirPath + "/range_" + std::to_string(startNum) + ext;
+	}
+
+	void OpenDir()
+	{
+		if (mkdir(m_dirPath.c_str(), 0755) != 0 && errno != EEXIST)
+		{
+			throw std::runtime_error(
+				"BlockCache - failed to create " + m_dirPath + ": " +
+				std::strerror(errno)
+			);
+		}
+
+		LockDir();
+
+		DIR* dir = opendir(m_dirPath.c_str());
+		if (dir == nullptr)
+		{
+			// the destructor isn't called if the constructor throws
+			close(m_dirFd);
+			m_dirFd = -1;
+			throw std::runtime_error(
+				"BlockCache - failed to open " + m_dirPath + ": " +
+				std::strerror(errno)
+			);
+		}
+
+		std::vector<std::pair<int64_t, BlockNumber> > mtimes;
+		for (dirent* ent = readdir(dir); ent != nullptr; ent = readdir(dir))
+		{
+			unsigned long long startNum = 0;
+			char ext[8] = { 0 };
+			if (
+				std::sscanf(ent->d_name, "range_%llu%7s", &startNum, ext) != 2 ||
+				std::string(ext) != GetDataExt() ||
+				(startNum % m_blocksPerRange) != 0
+			)
+			{
+				continue;
+			}
+
+			struct stat st;
+			const std::string dataPath = GetRangePath(startNum, GetDataExt());
+			if (stat(dataPath.c_str(), &st) != 0)
+			{
+				continue;
+			}
+			mtimes.emplace_back(static_cast<int64_t>(st.st_mtime), startNum);
+		}
+		closedir(dir);
+
+		// the least recently written range is the first to be evicted
+		std::sort(mtimes.begin(), mtimes.end());
+		for (const auto& mtime : mtimes)
+		{
+			BlockCacheRange& range = GetOrOpenRange(mtime.second);
+			range.SetLastUsed(++m_useCounter);
+		}
+
+		EvictIfNeeded();
+	}
+
+	/**
+	 * @brief Take the lock on the cache directory, or become read-only if
+	 *        another instance holds it; the lock is released when the
+	 *        descriptor is closed, including when the process dies
+	 *
+	 */
+	void LockDir()
+	{
+		m_dirFd = open(m_dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (m_dirFd < 0)
+		{
+			throw std::runtime_error(
+				"BlockCache - failed to open " + m_dirPath + ": " +
+				std::strerror(errno)
+			);
+		}
+
+		if (flock(m_dirFd, LOCK_EX | LOCK_NB) == 0)
+		{
+			m_isReadOnly = false;
+		}
+		else if (errno == EWOULDBLOCK)
+		{
+			m_isReadOnly = true;
+		}
+		else
+		{
+			const int err = errno;
+			close(m_dirFd);
+			m_dirFd = -1;
+			throw std::runtime_error(
+				"BlockCache - failed to lock " + m_dirPath + ": " +
+				std::strerror(err)
+			);
+		}
+	}
+
+	BlockCacheRange& GetOrOpenRange(BlockNumber startNum)
+	{
+		auto it = m_ranges.find(startNum);
+		if (it == m_ranges.end())
+		{
+			it = m_ranges.emplace(
+				startNum,
+				std::unique_ptr<BlockCacheRange>(new BlockCacheRange(
+					startNum,
+					GetRangePath(startNum, GetDataExt()),
+					GetRangePath(startNum, GetIndexExt()),
+					m_isReadOnly
+				))
+			).first;
+		}
+		return *(it->second);
+	}
+
+	/**
+	 * @brief Reload the range of the given block from the disk, for a
+	 *        read-only cache; the caller must hold the lock
+	 *
+	 * @return The range, or nullptr if the writer hasn't created it
+	 */
+	BlockCacheRange* ReloadRange(BlockNumber blockNum)
+	{
+		const BlockNumber startNum = ToRangeStart(blockNum);
+		auto it = m_ranges.find(startNum);
+		if (it != m_ranges.end())
+		{
+			it->second->Reload();
+			return it->second.get();
+		}
+
+		struct stat st;
+		const std::string dataPath = GetRangePath(startNum, GetDataExt());
+		if (stat(dataPath.c_str(), &st) != 0)
+		{
+			return nullptr;
+		}
+		return &GetOrOpenRange(startNum);
+	}
+
+	BlockNumber ToRangeStart(BlockNumber blockNum) const
+	{
+		return blockNum - (blockNum % m_blocksPerRange);
+	}
+
+	bool TryGet(
+		BlockNumber blockNum,
+		BlockCacheItem item,
+		std::vector<uint8_t>& out
+	)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto pendIt = m_pending.find(PendingKey(blockNum, item));
+		if (pendIt != m_pending.end())
+		{
+			out = pendIt->second;
+			++m_numOfHits;
+			return true;
+		}
+
+		auto it = m_ranges.find(ToRangeStart(blockNum));
+		if (it != m_ranges.end() && it->second->TryGet(blockNum, item, out))
+		{
+			it->second->SetLastUsed(++m_useCounter);
+			++m_numOfHits;
+			return true;
+		}
+
+		if (m_isReadOnly)
+		{
+			BlockCacheRange* range = ReloadRange(blockNum);
+			if (range != nullptr && range->TryGet(blockNum, item, out))
+			{
+				range->SetLastUsed(++m_useCounter);
+				++m_numOfHits;
+				return true;
+			}
+		}
+
+		++m_numOfMisses;
+		return false;
+	}
+
+	void PutPending(
+		BlockNumber blockNum,
+		BlockCacheItem item,
+		const std::vector<uint8_t>& payload
+	)
+	{
+		m_pending[PendingKey(blockNum, item)] = payload;
+	}
+
+	/**
+	 * @brief Persist the pending blocks that are deep enough; a read-only
+	 *        cache drops them instead, since they're the writer's to
+	 *        persist; the caller must hold the lock
+	 *
+	 */
+	void PersistConfirmed()
+	{
+		if (!m_hasHead || m_headNum < m_confirmations)
+		{
+			return;
+		}
+		const BlockNumber lastConfirmed = m_headNum - m_confirmations;
+
+		if (m_isReadOnly)
+		{
+			m_pending.erase(
+				m_pending.begin(),
+				m_pending.lower_bound(PendingKey(
+					lastConfirmed + 1,
+					BlockCacheItem::Header
+				))
+			);
+			return;
+		}
+
+		bool hasWritten = false;
+		auto it = m_pending.begin();
+		while (it != m_pending.end() && it->first.first <= lastConfirmed)
+		{
+			BlockCacheRange& range =
+				GetOrOpenRange(ToRangeStart(it->first.first));
+			if (m_writeRange != &range)
+			{
+				// only one range is kept open for appending, since blocks
+				// are mostly fetched in order
+				if (m_writeRange != nullptr)
+				{
+					m_writeRange->CloseWriters();
+				}
+				m_writeRange = &range;
+			}
+			range.Put(it->first.first, it->first.second, it->second);
+			range.SetLastUsed(++m_useCounter);
+			hasWritten = true;
+
+			it = m_pending.erase(it);
+		}
+
+		if (hasWritten)
+		{
+			EvictIfNeeded();
+		}
+	}
+
+	uint64_t CalcDiskSize() const
+	{
+		uint64_t size = 0;
+		for (const auto& range : m_ranges)
+		{
+			size += range.second->GetDiskSize();
+		}
+		return size;
+	}
+
+	/**
+	 * @brief Evict the least recently used ranges, other than the one being
+	 *        written, until the cache fits in its size limit; only the
+	 *        writer evicts; the caller must hold the lock
+	 *
+	 */
+	void EvictIfNeeded()
+	{
+		if (m_isReadOnly)
+		{
+			return;
+		}
+
+		uint64_t size = CalcDiskSize();
+		while (size > m_maxSize)
+		{
+			RangeMap::iterator victim = m_ranges.end();
+			for (auto it = m_ranges.begin(); it != m_ranges.end(); ++it)
+			{
+				if (
+					(it->second.get() != m_writeRange) &&
+					(
+						(victim == m_ranges.end()) ||
+						(it->second->GetLastUsed() <
+							victim->second->GetLastUsed())
+					)
+				)
+				{
+					victim = it;
+				}
+			}
+			if (victim == m_ranges.end())
+			{
+				return;
+			}
+
+			size -= victim->second->GetDiskSize();
+			victim->second->Remove();
+			m_ranges.erase(victim);
+		}
+	}
+
+	mutable std::mutex m_mutex;
+	std::string m_dirPath;
+	int m_dirFd;
+	bool m_isReadOnly;
+	uint64_t m_maxSize;
+	uint64_t m_blocksPerRange;
+	uint64_t m_confirmations;
+	RangeMap m_ranges;
+	std::map<PendingKey, std::vector<uint8_t> > m_pending;
+	BlockNumber m_headNum;
+	bool m_hasHead;
+	BlockCacheRange* m_writeRange;
+	uint64_t m_useCounter;
+	uint64_t m_numOfHits;
+	uint64_t m_numOfMisses;
+
+}; // class BlockCache
+
+
+} // namespace EthereumClt
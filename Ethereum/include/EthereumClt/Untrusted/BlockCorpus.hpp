@@ -0,0 +1,582 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <EclipseMonitor/Eth/DataTypes.hpp>
+#include <SimpleSysIO/SysCall/Files.hpp>
+
+
+namespace EthereumClt
+{
+
+
+/**
+ * @brief The layout of a block corpus file, which keeps the raw header and
+ *        the raw receipts of a range of blocks, so they can be replayed
+ *        without Geth.
+ *        All integers are stored in little-endian:
+ *          magic                                      8 bytes
+ *          records, one per block:
+ *            block number                             u64
+ *            header RLP size, receipts RLP size       u32, u32
+ *            header RLP, receipts RLP
+ *          index:
+ *            number of records                        u64
+ *            (block number, record offset) * N        (u64, u64) * N
+ *          footer:
+ *            index offset                             u64
+ *            magic                                    8 bytes
+ *        The receipts RLP is the RLP list of the raw receipts, which is
+ *        what `ocall_ethereum_clt_get_receipts` hands to the enclave.
+ *
+ */
+struct BlockCorpusFormat
+{
+	static constexpr size_t sk_magicSize = 8;
+	static constexpr size_t sk_recordHeaderSize = 8 + 4 + 4;
+	static constexpr size_t sk_footerSize = 8 + sk_magicSize;
+
+	static const char* GetMagic()
+	{
+		return "ECLTCRP1";
+	}
+
+	template<typename _IntType>
+	static void AppendInt(std::vector<uint8_t>& dest, _IntType val)
+	{
+		for (size_t i = 0; i < sizeof(_IntType); ++i)
+		{
+			dest.push_back(static_cast<uint8_t>(val >> (i * 8)));
+		}
+	}
+
+	template<typename _IntType>
+	static _IntType ReadInt(const uint8_t* src)
+	{
+		_IntType val = 0;
+		for (size_t i = 0; i < sizeof(_IntType); ++i)
+		{
+			val |= static_cast<_IntType>(src[i]) << (i * 8);
+		}
+		return val;
+	}
+}; // struct BlockCorpusFormat
+
+
+/**
+ * @brief Records blocks into a new corpus file.
+ *        The index is written by `Finish`, which is also called by the
+ *        destructor; a file without the index can't be read.
+ *        The receipts of the last few recorded blocks are kept in memory,
+ *        so the ones requested right after the block is recorded don't
+ *        have to be fetched again.
+ *
+ */
+class BlockCorpusWriter
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+	using Format = BlockCorpusFormat;
+
+	static constexpr size_t sk_numRecentReceipts = 16;
+
+public:
+
+	BlockCorpusWriter(const std::string& path) :
+		m_mutex(),
+		m_file(SimpleSysIO::SysCall::WBinaryFile::Create(path)),
+		m_offset(0),
+		m_index(),
+		m_recentReceipts(),
+		m_isFinished(false),
+		m_hasFailed(false)
+	{
+		WriteRaw(std::string(Format::GetMagic(), Format::sk_magicSize));
+	}
+
+	// LCOV_EXCL_START
+	~BlockCorpusWriter()
+	{
+		try
+		{
+			Finish();
+		}
+		catch (...)
+		{}
+	}
+	// LCOV_EXCL_STOP
+
+	BlockCorpusWriter(const BlockCorpusWriter&) = delete;
+
+	BlockCorpusWriter& operator=(const BlockCorpusWriter&) = delete;
+
+	/**
+	 * @brief Record a block; a block that has been recorded already is
+	 *        skipped
+	 *
+	 * @param blockNum    The number of the block
+	 * @param headerRlp   The raw header
+	 * @param receiptsRlp The RLP list of the raw receipts of the block
+	 *
+	 * @exception std::length_error If the header or the receipts don't fit
+	 *                              in the 32-bit sizes of the record
+	 */
+	void Record(
+		BlockNumber blockNum,
+		const std::vector<uint8_t>& headerRlp,
+		const std::vector<uint8_t>& receiptsRlp
+	)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_isFinished)
+		{
+			throw std::logic_error(
+				"BlockCorpusWriter - the corpus has been finished"
+			);
+		}
+		if (m_hasFailed)
+		{
+			throw std::runtime_error(
+				"BlockCorpusWriter - a previous write has failed"
+			);
+		}
+		if (headerRlp.size() > std::numeric_limits<uint32_t>::max() ||
+			receiptsRlp.size() > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::length_error(
+				"BlockCorpusWriter - block " + std::to_string(blockNum) +
+				" is too large to be recorded"
+			);
+		}
+
+		auto it = std::lower_bound(
+			m_index.begin(),
+			m_index.end(),
+			IndexEntry(blockNum, 0),
+			[](const IndexEntry& a, const IndexEntry& b)
+			{
+				return a.first < b.first;
+			}
+		);
+		if (it != m_index.end() && it->first == blockNum)
+		{
+			return;
+		}
+
+		std::vector<uint8_t> record;
+		record.reserve(
+			Format::sk_recordHeaderSize + headerRlp.size() + receiptsRlp.size()
+		);
+		Format::AppendInt<uint64_t>(record, blockNum);
+		Format::AppendInt<uint32_t>(
+			record, static_cast<uint32_t>(headerRlp.size()));
+		Format::AppendInt<uint32_t>(
+			record, static_cast<uint32_t>(receiptsRlp.size()));
+		record.insert(record.end(), headerRlp.begin(), headerRlp.end());
+		record.insert(record.end(), receiptsRlp.begin(), receiptsRlp.end());
+
+		// the block is indexed only once the whole record is written; a
+		// failed write may leave a part of it in the file, so the offsets
+		// of later records can't be trusted anymore
+		const uint64_t recordOffset = m_offset;
+		try
+		{
+			WriteRaw(record);
+		}
+		catch (...)
+		{
+			m_hasFailed = true;
+			throw;
+		}
+		m_index.insert(it, IndexEntry(blockNum, recordOffset));
+
+		m_recentReceipts.emplace_back(blockNum, receiptsRlp);
+		if (m_recentReceipts.size() > sk_numRecentReceipts)
+		{
+			m_recentReceipts.pop_front();
+		}
+	}
+
+	/**
+	 * @brief Get the receipts of a recently recorded block
+	 *
+	 * @return true if the block is one of the last `sk_numRecentReceipts`
+	 *         recorded blocks, and `receiptsRlp` is set
+	 */
+	bool TryGetRecentReceiptsRlp(
+		BlockNumber blockNum,
+		std::vector<uint8_t>& receiptsRlp
+	) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const auto& recent : m_recentReceipts)
+		{
+			if (recent.first == blockNum)
+			{
+				receiptsRlp = recent.second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t GetNumOfBlocks() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_index.size();
+	}
+
+	/**
+	 * @brief Write the index and the footer, and close the file; if a write
+	 *        has failed, the file is closed without the index
+	 *
+	 */
+	void Finish()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_isFinished)
+		{
+			return;
+		}
+		m_recentReceipts.clear();
+		if (m_hasFailed)
+		{
+			m_file.reset();
+			m_isFinished = true;
+			return;
+		}
+
+		const uint64_t indexOffset = m_offset;
+
+		std::vector<uint8_t> tail;
+		tail.reserve(8 + (m_index.size() * 16) + Format::sk_footerSize);
+		Format::AppendInt<uint64_t>(tail, m_index.size());
+		for (const auto& entry : m_index)
+		{
+			Format::AppendInt<uint64_t>(tail, entry.first);
+			Format::AppendInt<uint64_t>(tail, entry.second);
+		}
+		Format::AppendInt<uint64_t>(tail, indexOffset);
+		tail.insert(
+			tail.end(),
+			Format::GetMagic(),
+			Format::GetMagic() + Format::sk_magicSize
+		);
+
+		WriteRaw(tail);
+		m_file->Flush();
+		m_file.reset();
+
+		m_isFinished = true;
+	}
+
+private:
+
+	using IndexEntry = std::pair<BlockNumber, uint64_t>;
+
+	template<typename _ContainerType>
+	void WriteRaw(const _ContainerType& bytes)
+	{
+		m_file->WriteBytes(bytes);
+		m_offset += bytes.size();
+	}
+
+	mutable std::mutex m_mutex;
+	std::unique_ptr<SimpleSysIO::WBinaryIOSBase> m_file;
+	uint64_t m_offset;
+	std::vector<IndexEntry> m_index;
+	std::deque<std::pair<BlockNumber, std::vector<uint8_t> > >
+		m_recentReceipts;
+	bool m_isFinished;
+	bool m_hasFailed;
+
+}; // class BlockCorpusWriter
+
+
+/**
+ * @brief Reads blocks from a corpus file written by `BlockCorpusWriter`.
+ *        Only the index is kept in memory; the blocks are read from the file
+ *        when they are requested.
+ *
+ */
+class BlockCorpusReader
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+	using Format = BlockCorpusFormat;
+
+public:
+
+	BlockCorpusReader(const std::string& path) :
+		m_mutex(),
+		m_file(SimpleSysIO::SysCall::RBinaryFile::Open(path)),
+		m_index()
+	{
+		LoadIndex();
+	}
+
+	// LCOV_EXCL_START
+	~BlockCorpusReader() = default;
+	// LCOV_EXCL_STOP
+
+	BlockCorpusReader(const BlockCorpusReader&) = delete;
+
+	BlockCorpusReader& operator=(const BlockCorpusReader&) = delete;
+
+	size_t GetNumOfBlocks() const
+	{
+		return m_index.size();
+	}
+
+	/**
+	 * @brief Get the block numbers in the corpus, in ascending order
+	 *
+	 */
+	std::vector<BlockNumber> GetBlockNums() const
+	{
+		std::vector<BlockNumber> res;
+		res.reserve(m_index.size());
+		for (const auto& entry : m_index)
+		{
+			res.push_back(entry.first);
+		}
+		return res;
+	}
+
+	BlockNumber GetFirstBlockNum() const
+	{
+		CheckNotEmpty();
+		return m_index.front().first;
+	}
+
+	BlockNumber GetLastBlockNum() const
+	{
+		CheckNotEmpty();
+		return m_index.back().first;
+	}
+
+	bool HasBlock(BlockNumber blockNum) const
+	{
+		return FindEntry(blockNum) != m_index.end();
+	}
+
+	std::vector<uint8_t> GetHeaderRlp(BlockNumber blockNum) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto sizes = SeekRecord(blockNum);
+		return ReadExact(sizes.first);
+	}
+
+	std::vector<uint8_t> GetReceiptsRlp(BlockNumber blockNum) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto sizes = SeekRecord(blockNum);
+		m_file->Seek(
+			static_cast<std::ptrdiff_t>(sizes.first),
+			SimpleSysIO::SeekWhence::Current
+		);
+		return ReadExact(sizes.second);
+	}
+
+	/**
+	 * @brief Get both the raw header and the RLP list of raw receipts of the
+	 *        given block
+	 *
+	 */
+	std::pair<std::vector<uint8_t>, std::vector<uint8_t> >
+	ReadRecord(BlockNumber blockNum) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto sizes = SeekRecord(blockNum);
+		auto headerRlp = ReadExact(sizes.first);
+		auto receiptsRlp = ReadExact(sizes.second);
+
+		return std::make_pair(std::move(headerRlp), std::move(receiptsRlp));
+	}
+
+private:
+
+	using IndexEntry = std::pair<BlockNumber, uint64_t>;
+
+	void LoadIndex()
+	{
+		const size_t fileSize = m_file->GetFileSize();
+		if (fileSize < Format::sk_magicSize + 8 + Format::sk_footerSize)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - the file is too small to be a corpus"
+			);
+		}
+
+		auto head = ReadExact(Format::sk_magicSize);
+		CheckMagic(head.data());
+
+		m_file->Seek(static_cast<std::ptrdiff_t>(
+			fileSize - Format::sk_footerSize
+		));
+		auto footer = ReadExact(Format::sk_footerSize);
+		CheckMagic(footer.data() + 8);
+		const uint64_t indexOffset = Format::ReadInt<uint64_t>(footer.data());
+		if (indexOffset + 8 + Format::sk_footerSize > fileSize)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - the corpus index is corrupted"
+			);
+		}
+
+		m_file->Seek(static_cast<std::ptrdiff_t>(indexOffset));
+		auto countBytes = ReadExact(8);
+		const uint64_t count = Format::ReadInt<uint64_t>(countBytes.data());
+		if (count > (fileSize - indexOffset - 8 - Format::sk_footerSize) / 16)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - the corpus index is corrupted"
+			);
+		}
+
+		auto indexBytes = ReadExact(static_cast<size_t>(count * 16));
+		m_index.reserve(static_cast<size_t>(count));
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint8_t* ptr = indexBytes.data() + (i * 16);
+			const IndexEntry entry(
+				Format::ReadInt<uint64_t>(ptr),
+				Format::ReadInt<uint64_t>(ptr + 8)
+			);
+
+			// the lookups are binary searches, so the block numbers must be
+			// strictly ascending; and every record is before the index
+			if (
+				(!m_index.empty() && m_index.back().first >= entry.first) ||
+				(entry.second < Format::sk_magicSize) ||
+				(entry.second > indexOffset) ||
+				(indexOffset - entry.second < Format::sk_recordHeaderSize)
+			)
+			{
+				throw std::runtime_error(
+					"BlockCorpusReader - the corpus index is corrupted"
+				);
+			}
+			m_index.push_back(entry);
+		}
+	}
+
+	std::vector<IndexEntry>::const_iterator FindEntry(
+		BlockNumber blockNum
+	) const
+	{
+		auto it = std::lower_bound(
+			m_index.begin(),
+			m_index.end(),
+			IndexEntry(blockNum, 0),
+			[](const IndexEntry& a, const IndexEntry& b)
+			{
+				return a.first < b.first;
+			}
+		);
+		if (it != m_index.end() && it->first == blockNum)
+		{
+			return it;
+		}
+		return m_index.end();
+	}
+
+	/**
+	 * @brief Move the file cursor to the header RLP of the given block;
+	 *        the caller must hold the lock
+	 *
+	 * @return The sizes of the header RLP and the receipts RLP
+	 */
+	std::pair<size_t, size_t> SeekRecord(BlockNumber blockNum) const
+	{
+		auto it = FindEntry(blockNum);
+		if (it == m_index.end())
+		{
+			throw std::out_of_range(
+				"BlockCorpusReader - block " + std::to_string(blockNum) +
+				" is not in the corpus"
+			);
+		}
+
+		m_file->Seek(static_cast<std::ptrdiff_t>(it->second));
+		auto recHeader = ReadExact(Format::sk_recordHeaderSize);
+		const uint8_t* ptr = recHeader.data();
+		if (Format::ReadInt<uint64_t>(ptr) != blockNum)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - the corpus index is corrupted"
+			);
+		}
+
+		return std::make_pair(
+			static_cast<size_t>(Format::ReadInt<uint32_t>(ptr + 8)),
+			static_cast<size_t>(Format::ReadInt<uint32_t>(ptr + 12))
+		);
+	}
+
+	std::vector<uint8_t> ReadExact(size_t size) const
+	{
+		if (size == 0)
+		{
+			return std::vector<uint8_t>();
+		}
+		auto res = m_file->ReadBytes<std::vector<uint8_t> >(size);
+		if (res.size() != size)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - unexpected end of the corpus file"
+			);
+		}
+		return res;
+	}
+
+	static void CheckMagic(const uint8_t* ptr)
+	{
+		if (std::memcmp(ptr, Format::GetMagic(), Format::sk_magicSize) != 0)
+		{
+			throw std::runtime_error(
+				"BlockCorpusReader - the file is not a block corpus"
+			);
+		}
+	}
+
+	void CheckNotEmpty() const
+	{
+		if (m_index.empty())
+		{
+			throw std::out_of_range("BlockCorpusReader - the corpus is empty");
+		}
+	}
+
+	mutable std::mutex m_mutex;
+	std::unique_ptr<SimpleSysIO::RBinaryIOSBase> m_file;
+	std::vector<IndexEntry> m_index;
+
+}; // class BlockCorpusReader
+
+
+} // namespace EthereumClt
@@ -0,0 +1,168 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "../Common/PipelineTrace.hpp"
+#include "BlockCorpus.hpp"
+#include "BlockReceiver.hpp"
+
+
+namespace EthereumClt
+{
+
+
+/**
+ * @brief Feeds the headers in a block corpus to a BlockReceiver as fast as
+ *        it accepts them, and measures how long each block takes
+ *
+ */
+class BlockCorpusReplayer
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+
+	struct Stats
+	{
+		Stats() :
+			m_totalNanoSec(0),
+			m_blockNanoSec()
+		{}
+
+		size_t GetNumOfBlocks() const
+		{
+			return m_blockNanoSec.size();
+		}
+
+		double GetBlocksPerSec() const
+		{
+			return m_totalNanoSec == 0 ?
+				0.0 :
+				(GetNumOfBlocks() * 1e9) / m_totalNanoSec;
+		}
+
+		/**
+		 * @brief Get the per-block latency at the given percentile
+		 *
+		 * @param percentile In the range of [0, 100]
+		 */
+		uint64_t GetLatencyNanoSec(double percentile) const
+		{
+			if (m_blockNanoSec.empty())
+			{
+				return 0;
+			}
+			std::vector<uint64_t> sorted = m_blockNanoSec;
+			std::sort(sorted.begin(), sorted.end());
+			const double rank = (percentile / 100.0) * (sorted.size() - 1);
+			return sorted[static_cast<size_t>(rank + 0.5)];
+		}
+
+		uint64_t m_totalNanoSec;
+		std::vector<uint64_t> m_blockNanoSec;
+	}; // struct Stats
+
+public:
+
+	BlockCorpusReplayer(std::shared_ptr<BlockCorpusReader> corpus) :
+		m_corpus(corpus)
+	{}
+
+	~BlockCorpusReplayer() = default;
+
+	/**
+	 * @brief Replay all blocks in the corpus
+	 *
+	 */
+	Stats Replay(BlockReceiver& receiver) const
+	{
+		return ReplayBlocks(receiver, m_corpus->GetBlockNums());
+	}
+
+	/**
+	 * @brief Replay the blocks in the range of [startBlockNum, endBlockNum);
+	 *        all of them must be in the corpus
+	 *
+	 */
+	Stats Replay(
+		BlockReceiver& receiver,
+		BlockNumber startBlockNum,
+		BlockNumber endBlockNum
+	) const
+	{
+		std::vector<BlockNumber> blockNums;
+		for (BlockNumber i = startBlockNum; i < endBlockNum; ++i)
+		{
+			blockNums.push_back(i);
+		}
+		return ReplayBlocks(receiver, blockNums);
+	}
+
+private:
+
+	Stats ReplayBlocks(
+		BlockReceiver& receiver,
+		const std::vector<BlockNumber>& blockNums
+	) const
+	{
+		using _Clock = std::chrono::steady_clock;
+
+		// headers are loaded before the clock starts, so only the time
+		// spent by the receiver is measured
+		std::vector<std::vector<uint8_t> > headers;
+		headers.reserve(blockNums.size());
+		for (const auto& blockNum : blockNums)
+		{
+			headers.push_back(m_corpus->GetHeaderRlp(blockNum));
+		}
+
+		Stats stats;
+		stats.m_blockNanoSec.reserve(headers.size());
+
+		const auto start = _Clock::now();
+		auto blockStart = start;
+		Metrics::Tracer& tracer = Metrics::Tracer::GetInstance();
+		for (size_t i = 0; i < headers.size(); ++i)
+		{
+			// headers are already in memory, so fetching takes no time
+			tracer.StampFetch(blockNums[i]);
+			tracer.StampIngest(blockNums[i]);
+			receiver.RecvBlock(headers[i]);
+
+			const auto blockEnd = _Clock::now();
+			stats.m_blockNanoSec.push_back(ToNanoSec(blockEnd - blockStart));
+			blockStart = blockEnd;
+		}
+		stats.m_totalNanoSec = ToNanoSec(blockStart - start);
+
+		return stats;
+	}
+
+	template<typename _DurationType>
+	static uint64_t ToNanoSec(const _DurationType& duration)
+	{
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				duration
+			).count()
+		);
+	}
+
+	std::shared_ptr<BlockCorpusReader> m_corpus;
+
+}; // class BlockCorpusReplayer
+
+
+} // namespace EthereumClt
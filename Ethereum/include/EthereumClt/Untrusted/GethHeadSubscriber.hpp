@@ -0,0 +1,604 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cctype>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <EclipseMonitor/Eth/DataTypes.hpp>
+#include <SimpleJson/SimpleJson.hpp>
+#include <SimpleObjects/Codec/Base64.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#include "WebSocket.hpp"
+
+
+namespace EthereumClt
+{
+
+
+/**
+ * @brief Follows the chain head through the `eth_subscribe("newHeads")`
+ *        interface of Geth over WebSocket, so the block updator learns
+ *        about a new block as soon as Geth does, instead of polling for it.
+ *        The connection is kept on a dedicated thread, and is re-established
+ *        whenever it's lost; meanwhile, and whenever no head has been
+ *        notified for a while, the head is reported as unknown, so the
+ *        updator falls back to polling.
+ *        The socket is only used by that thread, through asynchronous
+ *        operations run on its own `io_service`, so `Stop` can interrupt
+ *        any of them, including resolving and connecting, by stopping the
+ *        `io_service`.
+ *        Only plain `ws://` URLs are supported.
+ *
+ */
+class GethHeadSubscriber
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+	using SocketType = boost::asio::ip::tcp::socket;
+	using HeadCallback = std::function<void(BlockNumber)>;
+
+	static constexpr size_t sk_recvBufSize = 4096;
+	static constexpr size_t sk_maxHeaderSize = 16 * 1024;
+	static constexpr size_t sk_maxMsgSize = 1024 * 1024;
+
+	static constexpr int64_t sk_defReconnectMilSec = 1000;
+	/**
+	 * @brief A new block is expected about every 12 seconds, so a head that
+	 *        is older than a few block intervals means the subscription has
+	 *        silently stopped working
+	 *
+	 */
+	static constexpr int64_t sk_defStaleAfterMilSec = 60 * 1000;
+
+public:
+
+	GethHeadSubscriber(
+		const std::string& wsUrl,
+		int64_t reconnectMilSec = sk_defReconnectMilSec,
+		int64_t staleAfterMilSec = sk_defStaleAfterMilSec
+	) :
+		m_host(),
+		m_port(),
+		m_path(),
+		m_reconnectMilSec(reconnectMilSec),
+		m_staleAfterMilSec(staleAfterMilSec),
+		m_mutex(),
+		m_cond(),
+		m_isRunning(true),
+		m_headCallback(),
+		m_ioService(),
+		m_socket(),
+		m_recvBuf(),
+		m_isSubscribed(false),
+		m_headBlockNum(0),
+		m_headNanoSec(0),
+		m_numOfHeads(0),
+		m_numOfConnects(0),
+		m_rand(std::random_device()()),
+		m_thread()
+	{
+		ParseUrl(wsUrl);
+		m_thread = std::thread(&GethHeadSubscriber::RunLoop, this);
+	}
+
+	// LCOV_EXCL_START
+	~GethHeadSubscriber()
+	{
+		Stop();
+	}
+	// LCOV_EXCL_STOP
+
+	GethHeadSubscriber(const GethHeadSubscriber&) = delete;
+
+	GethHeadSubscriber& operator=(const GethHeadSubscriber&) = delete;
+
+	/**
+	 * @brief Get the number of the latest head notified by Geth
+	 *
+	 * @return true if the subscription is alive, and a recent head is known
+	 */
+	bool TryGetHeadBlockNum(BlockNumber& headBlockNum) const
+	{
+		if (!m_isSubscribed)
+		{
+			return false;
+		}
+
+		const int64_t headNanoSec = m_headNanoSec.load();
+		if (
+			(headNanoSec == 0) ||
+			(NowNanoSec() - headNanoSec > m_staleAfterMilSec * 1000000)
+		)
+		{
+			return false;
+		}
+
+		headBlockNum = m_headBlockNum.load();
+		return true;
+	}
+
+	bool IsSubscribed() const
+	{
+		return m_isSubscribed;
+	}
+
+	uint64_t GetNumOfHeads() const
+	{
+		return m_numOfHeads.load();
+	}
+
+	uint64_t GetNumOfConnects() const
+	{
+		return m_numOfConnects.load();
+	}
+
+	/**
+	 * @brief Set the function called, on the subscriber thread, with the
+	 *        number of each new head notified by Geth (e.g., to wake up the
+	 *        block updator); it must not block
+	 *
+	 */
+	void SetHeadCallback(HeadCallback callback)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_headCallback = std::move(callback);
+	}
+
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_isRunning)
+			{
+				return;
+			}
+			m_isRunning = false;
+		}
+		// interrupt the pending operation on the subscriber thread; the
+		// socket itself is only touched by that thread
+		m_ioService.stop();
+		m_cond.notify_all();
+
+		m_thread.join();
+	}
+
+private:
+
+	static int64_t NowNanoSec()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count();
+	}
+
+	static std::string ToLower(std::string str)
+	{
+		std::transform(
+			str.begin(),
+			str.end(),
+			str.begin(),
+			[](char ch) -> char
+			{
+				return static_cast<char>(
+					std::tolower(static_cast<unsigned char>(ch))
+				);
+			}
+		);
+		return str;
+	}
+
+	void ParseUrl(const std::string& wsUrl)
+	{
+		static const std::string sk_scheme = "ws://";
+
+		if (ToLower(wsUrl.substr(0, sk_scheme.size())) != sk_scheme)
+		{
+			throw std::invalid_argument(
+				"GethHeadSubscriber - only ws:// URLs are supported"
+			);
+		}
+
+		const std::string rest = wsUrl.substr(sk_scheme.size());
+		const size_t pathPos = rest.find('/');
+		const std::string hostPort = rest.substr(0, pathPos);
+		m_path = (pathPos == std::string::npos) ? "/" : rest.substr(pathPos);
+
+		const size_t portPos = hostPort.rfind(':');
+		if (portPos == std::string::npos)
+		{
+			m_host = hostPort;
+			m_port = "80";
+		}
+		else
+		{
+			m_host = hostPort.substr(0, portPos);
+			m_port = hostPort.substr(portPos + 1);
+		}
+		if (m_host.empty() || m_port.empty())
+		{
+			throw std::invalid_argument(
+				"GethHeadSubscriber - invalid URL " + wsUrl
+			);
+		}
+	}
+
+	void RunLoop()
+	{
+		while (m_isRunning)
+		{
+			try
+			{
+				Connect();
+				Handshake();
+				Subscribe();
+				RecvLoop();
+			}
+			catch(const std::exception&)
+			{
+				// Geth is not reachable, or the connection is broken;
+				// either way, it's retried after a while
+			}
+
+			m_isSubscribed = false;
+			m_headNanoSec = 0;
+			if (m_socket != nullptr)
+			{
+				boost::system::error_code ec;
+				m_socket->close(ec);
+				m_socket.reset();
+			}
+			m_recvBuf.clear();
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cond.wait_for(
+					lock,
+					std::chrono::milliseconds(m_reconnectMilSec),
+					[this]()
+					{
+						return !m_isRunning;
+					}
+				);
+			}
+		}
+	}
+
+	/**
+	 * @brief The result of an asynchronous operation; it's shared with the
+	 *        completion handler, since an interrupted operation completes
+	 *        after `RunUntilDone` has returned
+	 *
+	 */
+	struct AsyncResult
+	{
+		AsyncResult() :
+			m_isDone(false),
+			m_ec(),
+			m_size(0)
+		{}
+
+		bool m_isDone;
+		boost::system::error_code m_ec;
+		size_t m_size;
+	}; // struct AsyncResult
+
+	/**
+	 * @brief Run the `io_service` until the operation completes
+	 *
+	 */
+	void RunUntilDone(const std::shared_ptr<AsyncResult>& res)
+	{
+		m_ioService.restart();
+		// `Stop` sets the flag before stopping the `io_service`, so either
+		// it's seen here, or `run_one` returns
+		if (!m_isRunning)
+		{
+			throw std::runtime_error("GethHeadSubscriber - stopped");
+		}
+		while (!res->m_isDone)
+		{
+			if (m_ioService.run_one() == 0)
+			{
+				throw std::runtime_error("GethHeadSubscriber - stopped");
+			}
+		}
+		if (res->m_ec)
+		{
+			throw boost::system::system_error(res->m_ec);
+		}
+	}
+
+	void Connect()
+	{
+		using Resolver = boost::asio::ip::tcp::resolver;
+
+		Resolver resolver(m_ioService);
+		auto resolveRes = std::make_shared<AsyncResult>();
+		auto endpoints = std::make_shared<Resolver::results_type>();
+		resolver.async_resolve(
+			m_host,
+			m_port,
+			[resolveRes, endpoints](
+				const boost::system::error_code& ec,
+				Resolver::results_type results
+			)
+			{
+				resolveRes->m_isDone = true;
+				resolveRes->m_ec = ec;
+				*endpoints = std::move(results);
+			}
+		);
+		RunUntilDone(resolveRes);
+
+		m_socket.reset(new SocketType(m_ioService));
+		auto connectRes = std::make_shared<AsyncResult>();
+		boost::asio::async_connect(
+			*m_socket,
+			*endpoints,
+			[connectRes](
+				const boost::system::error_code& ec,
+				const boost::asio::ip::tcp::endpoint&
+			)
+			{
+				connectRes->m_isDone = true;
+				connectRes->m_ec = ec;
+			}
+		);
+		RunUntilDone(connectRes);
+		m_socket->set_option(boost::asio::ip::tcp::no_delay(true));
+
+		++m_numOfConnects;
+	}
+
+	void Handshake()
+	{
+		std::array<uint8_t, 16> keyBytes;
+		for (auto& byte : keyBytes)
+		{
+			byte = static_cast<uint8_t>(m_rand());
+		}
+		const std::string key = SimpleObjects::Codec::Base64::
+			template Encode<std::string>(keyBytes);
+
+		SendRaw(
+			"GET " + m_path + " HTTP/1.1\r\n"
+			"Host: " + m_host + ":" + m_port + "\r\n"
+			"Upgrade: websocket\r\n"
+			"Connection: Upgrade\r\n"
+			"Sec-WebSocket-Key: " + key + "\r\n"
+			"Sec-WebSocket-Version: 13\r\n"
+			"\r\n"
+		);
+
+		size_t headerEnd = std::string::npos;
+		while ((headerEnd = m_recvBuf.find("\r\n\r\n")) == std::string::npos)
+		{
+			if (m_recvBuf.size() > sk_maxHeaderSize)
+			{
+				throw std::runtime_error(
+					"GethHeadSubscriber - HTTP response header is too large"
+				);
+			}
+			RecvSome();
+		}
+		const std::string header = ToLower(m_recvBuf.substr(0, headerEnd));
+		// frames sent right after the response stay in the buffer
+		m_recvBuf.erase(0, headerEnd + 4);
+
+		const std::string accept = "\r\nsec-websocket-accept: " +
+			ToLower(WebSocketFrame::ComputeAcceptKey(key));
+		if (
+			(header.compare(0, 13, "http/1.1 101 ") != 0) ||
+			(header.find(accept) == std::string::npos)
+		)
+		{
+			throw std::runtime_error(
+				"GethHeadSubscriber - WebSocket handshake failed"
+			);
+		}
+	}
+
+	void Subscribe()
+	{
+		SendFrame(
+			WebSocketOpcode::Text,
+			"{\"jsonrpc\":\"2.0\",\"id\":1,"
+			"\"method\":\"eth_subscribe\",\"params\":[\"newHeads\"]}"
+		);
+	}
+
+	void RecvLoop()
+	{
+		std::string msg;
+		while (m_isRunning)
+		{
+			WebSocketFrame frame;
+			while (!WebSocketFrame::TryDecode(m_recvBuf, frame, sk_maxMsgSize))
+			{
+				RecvSome();
+			}
+
+			switch (frame.m_opcode)
+			{
+			case WebSocketOpcode::Ping:
+				SendFrame(WebSocketOpcode::Pong, frame.m_payload);
+				break;
+			case WebSocketOpcode::Pong:
+				break;
+			case WebSocketOpcode::Close:
+				// echo the status code, and let the server close the TCP
+				// connection
+				SendFrame(
+					WebSocketOpcode::Close,
+					frame.m_payload.substr(0, 2)
+				);
+				return;
+			default:
+				msg += frame.m_payload;
+				if (msg.size() > sk_maxMsgSize)
+				{
+					throw std::runtime_error(
+						"GethHeadSubscriber - the message is too large"
+					);
+				}
+				if (frame.m_isFinal)
+				{
+					HandleMessage(msg);
+					msg.clear();
+				}
+				break;
+			}
+		}
+	}
+
+	void HandleMessage(const std::string& msgStr)
+	{
+		using namespace SimpleObjects;
+
+		const auto msg = SimpleJson::LoadStr(msgStr);
+		const auto& msgDict = msg.AsDict();
+
+		if (!msgDict.HasKey(String("method")))
+		{
+			// the response to the subscription request
+			if (
+				msgDict.HasKey(String("error")) ||
+				!msgDict.HasKey(String("result"))
+			)
+			{
+				throw std::runtime_error(
+					"GethHeadSubscriber - the subscription is rejected"
+				);
+			}
+			m_isSubscribed = true;
+			return;
+		}
+
+		const std::string method =
+			msgDict[String("method")].AsString().c_str();
+		if (method != "eth_subscription")
+		{
+			return;
+		}
+		const auto& head =
+			msgDict[String("params")].AsDict()[String("result")].AsDict();
+		const std::string numHex = head[String("number")].AsString().c_str();
+		if (numHex.size() < 3 || numHex.compare(0, 2, "0x") != 0)
+		{
+			throw std::runtime_error(
+				"GethHeadSubscriber - invalid head notification"
+			);
+		}
+
+		const BlockNumber headBlockNum = static_cast<BlockNumber>(
+			std::stoull(numHex.substr(2), nullptr, 16)
+		);
+		m_headBlockNum = headBlockNum;
+		m_headNanoSec = NowNanoSec();
+		++m_numOfHeads;
+
+		HeadCallback callback;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			callback = m_headCallback;
+		}
+		if (callback)
+		{
+			callback(headBlockNum);
+		}
+	}
+
+	void SendFrame(WebSocketOpcode opcode, const std::string& payload)
+	{
+		SendRaw(WebSocketFrame::Encode(
+			opcode,
+			payload,
+			true,
+			static_cast<uint32_t>(m_rand())
+		));
+	}
+
+	void SendRaw(const std::string& bytes)
+	{
+		auto res = std::make_shared<AsyncResult>();
+		auto buf = std::make_shared<std::string>(bytes);
+		boost::asio::async_write(
+			*m_socket,
+			boost::asio::buffer(*buf),
+			[res, buf](const boost::system::error_code& ec, size_t size)
+			{
+				res->m_isDone = true;
+				res->m_ec = ec;
+				res->m_size = size;
+			}
+		);
+		RunUntilDone(res);
+	}
+
+	void RecvSome()
+	{
+		auto res = std::make_shared<AsyncResult>();
+		auto buf = std::make_shared<std::array<char, sk_recvBufSize> >();
+		m_socket->async_read_some(
+			boost::asio::buffer(*buf),
+			[res, buf](const boost::system::error_code& ec, size_t size)
+			{
+				res->m_isDone = true;
+				res->m_ec = ec;
+				res->m_size = size;
+			}
+		);
+		RunUntilDone(res);
+		m_recvBuf.append(buf->data(), res->m_size);
+	}
+
+	std::string m_host;
+	std::string m_port;
+	std::string m_path;
+	int64_t m_reconnectMilSec;
+	int64_t m_staleAfterMilSec;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::atomic<bool> m_isRunning;
+	HeadCallback m_headCallback;
+	boost::asio::io_service m_ioService;
+	std::unique_ptr<SocketType> m_socket;
+	std::string m_recvBuf;
+
+	std::atomic<bool> m_isSubscribed;
+	std::atomic<BlockNumber> m_headBlockNum;
+	std::atomic<int64_t> m_headNanoSec;
+	std::atomic<uint64_t> m_numOfHeads;
+	std::atomic<uint64_t> m_numOfConnects;
+
+	std::mt19937 m_rand;
+	std::thread m_thread;
+
+}; // class GethHeadSubscriber
+
+
+} // namespace EthereumClt
@@ -8,6 +8,8 @@
 
 #include <cstdint>
 
+#include <exception>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -17,6 +19,8 @@
 #include <SimpleObjects/Codec/Hex.hpp>
 #include <SimpleObjects/SimpleObjects.hpp>
 
+#include "GethRespSinks.hpp"
+
 
 namespace EthereumClt
 {
@@ -27,9 +31,6 @@ class GethRequester
 public: // static members:
 
 
-
-
-
 public:
 
 
@@ -61,9 +62,7 @@ public:
 			}
 		);
 
-		std::string respBodyJson = PostRequest(reqBodyJson);
-
-		return ProcRespSingleByte(respBodyJson);
+		return PostRequestSingleBytes(reqBodyJson);
 	}
 
 
@@ -87,9 +86,7 @@ public:
 			}
 		);
 
-		std::string respBodyJson = PostRequest(reqBodyJson);
-
-		return ProcRespSingleByte(respBodyJson);
+		return PostRequestSingleBytes(reqBodyJson);
 	}
 
 
@@ -114,9 +111,7 @@ public:
 			}
 		);
 
-		std::string respBodyJson = PostRequest(reqBodyJson);
-
-		return ProcRespListOfBytes<_RetType>(respBodyJson);
+		return PostRequestListOfBytes<_RetType>(reqBodyJson);
 	}
 
 
@@ -175,16 +170,36 @@ protected:
 	}
 
 
-	std::string PostRequest(
-		const std::string& reqBody
+	/**
+	 * @brief Post the request, and feed the response body to the given
+	 *        handler as it is received, so the body is never buffered as a
+	 *        whole
+	 *
+	 */
+	void PostRequest(
+		const std::string& reqBody,
+		SimpleJson::SaxHandlerIf& respHandler
 	) const
 	{
-		std::string respBody;
+		SimpleJson::SaxParser parser(respHandler);
+		std::exception_ptr parseErr;
 		DecentEnclave::Untrusted::CUrlContentCallBack contentCallback =
-			[&respBody]
+			[&parser, &parseErr]
 			(char* ptr, size_t size, size_t nmemb, void*) -> size_t
 			{
-				respBody += std::string(ptr, size * nmemb);
+				// exceptions must not be thrown across curl; keep the first
+				// one, and drop the rest of the body
+				if (parseErr == nullptr)
+				{
+					try
+					{
+						parser.Feed(ptr, size * nmemb);
+					}
+					catch(...)
+					{
+						parseErr = std::current_exception();
+					}
+				}
 
 				return size * nmemb;
 			};
@@ -201,78 +216,35 @@ protected:
 			200
 		);
 
-		return respBody;
-	}
-
-
-	static std::vector<uint8_t> ProcRespSingleByte(
-		const std::string& respBody
-	)
-	{
-		static const SimpleObjects::String sk_respBodyLabelResult = "result";
-
-		auto respBodyJson = SimpleJson::LoadStr(respBody);
-		const auto& resHex =
-			respBodyJson.AsDict()[sk_respBodyLabelResult].AsString();
-
-		if (
-			resHex.size() < 3 ||
-			resHex[0] != '0' ||
-			resHex[1] != 'x'
-		)
+		if (parseErr != nullptr)
 		{
-			throw std::runtime_error("Invalid response from Geth.");
+			std::rethrow_exception(parseErr);
 		}
+		parser.Finish();
+	}
 
-		std::vector<uint8_t> res =
-			SimpleObjects::Codec::Hex::Decode<std::vector<uint8_t> >(
-				resHex.begin() + 2,
-				resHex.end()
-			);
 
-		return res;
+	std::vector<uint8_t> PostRequestSingleBytes(
+		const std::string& reqBody
+	) const
+	{
+		GethBytesResp resp;
+		PostRequest(reqBody, resp.GetHandler());
+		return resp.ReleaseBytes();
 	}
 
 
 	template<typename _RetType>
-	static _RetType ProcRespListOfBytes(
-		const std::string& respBody
-	)
+	_RetType PostRequestListOfBytes(
+		const std::string& reqBody
+	) const
 	{
-		using _RetTypeValType = typename _RetType::value_type;
-
-		static const SimpleObjects::String sk_respBodyLabelResult = "result";
-
-		auto respBodyJson = SimpleJson::LoadStr(respBody);
-		const auto& resList =
-			respBodyJson.AsDict()[sk_respBodyLabelResult].AsList();
-
-		_RetType res;
-		res.reserve(resList.size());
-		for (const auto& resHexObj : resList)
-		{
-			const auto& resHex = resHexObj.AsString();
-
-			if (
-				resHex.size() < 3 ||
-				resHex[0] != '0' ||
-				resHex[1] != 'x'
-			)
-			{
-				throw std::runtime_error("Invalid response from Geth.");
-			}
-
-			res.push_back(_RetTypeValType(
-				SimpleObjects::Codec::Hex::Decode<std::vector<uint8_t> >(
-					resHex.begin() + 2,
-					resHex.end()
-				)
-			));
-		}
-
-		return res;
+		GethBytesListResp<_RetType> resp;
+		PostRequest(reqBody, resp.GetHandler());
+		return resp.ReleaseList();
 	}
 
+
 	static std::string ConvertBlkNumToHex(
 		EclipseMonitor::Eth::BlockNumber blockNum
 	)
@@ -0,0 +1,389 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SimpleJson/SimpleJson.hpp>
+#include <SimpleObjects/Codec/Hex.hpp>
+
+
+namespace EthereumClt
+{
+
+
+/**
+ * @brief Decodes a "0x"-prefixed hex string as its chunks arrive, so
+ *        neither the hex string nor the JSON document around it is ever
+ *        held in memory
+ *
+ */
+class HexBytesSink :
+	public SimpleJson::SaxStringSinkIf
+{
+public:
+
+	HexBytesSink() :
+		m_bytes(),
+		m_prefixLen(0),
+		m_hasPendingDigit(false),
+		m_pendingDigit(0),
+		m_valueCount(0)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~HexBytesSink() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnBegin() override
+	{
+		m_bytes.clear();
+		m_prefixLen = 0;
+		m_hasPendingDigit = false;
+	}
+
+	virtual void OnChunk(const char* data, size_t size) override
+	{
+		static const char sk_prefix[] = "0x";
+
+		for (; m_prefixLen < 2 && size > 0; ++m_prefixLen, ++data, --size)
+		{
+			if (*data != sk_prefix[m_prefixLen])
+			{
+				throw std::runtime_error("Invalid response from Geth.");
+			}
+		}
+
+		if (size > 0 && m_hasPendingDigit)
+		{
+			// the byte split by the previous chunk
+			const char digits[2] = { m_pendingDigit, *data };
+			m_bytes.push_back(0);
+			SimpleObjects::Codec::Hex::DecodeInto(
+				&m_bytes.back(), 1, digits, digits + 2
+			);
+			m_hasPendingDigit = false;
+			++data;
+			--size;
+		}
+
+		const size_t byteNum = size / 2;
+		if (byteNum > 0)
+		{
+			const size_t oriSize = m_bytes.size();
+			m_bytes.resize(oriSize + byteNum);
+			SimpleObjects::Codec::Hex::DecodeInto(
+				&m_bytes[oriSize], byteNum, data, data + (byteNum * 2)
+			);
+		}
+
+		if (size % 2 != 0)
+		{
+			m_pendingDigit = data[size - 1];
+			m_hasPendingDigit = true;
+		}
+	}
+
+	virtual void OnEnd() override
+	{
+		if (m_prefixLen < 2 || (m_bytes.empty() && !m_hasPendingDigit))
+		{
+			throw std::runtime_error("Invalid response from Geth.");
+		}
+		if (m_hasPendingDigit)
+		{
+			throw std::invalid_argument("Odd number of hex digits");
+		}
+		++m_valueCount;
+		OnBytes(m_bytes);
+	}
+
+	size_t GetValueCount() const
+	{
+		return m_valueCount;
+	}
+
+	std::vector<uint8_t> ReleaseBytes()
+	{
+		return std::move(m_bytes);
+	}
+
+protected:
+
+	/**
+	 * @brief Called when a complete hex string has been decoded
+	 *
+	 */
+	virtual void OnBytes(std::vector<uint8_t>&)
+	{}
+
+private:
+
+	std::vector<uint8_t> m_bytes;
+	size_t m_prefixLen;
+	bool m_hasPendingDigit;
+	char m_pendingDigit;
+	size_t m_valueCount;
+
+}; // class HexBytesSink
+
+
+/**
+ * @brief Decodes a list of "0x"-prefixed hex strings straight into the
+ *        returned list
+ *
+ */
+template<typename _RetType>
+class HexBytesListSink :
+	public HexBytesSink
+{
+public:
+
+	using RetValType = typename _RetType::value_type;
+
+	HexBytesListSink() :
+		HexBytesSink(),
+		m_list()
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~HexBytesListSink() = default;
+	// LCOV_EXCL_STOP
+
+	_RetType ReleaseList()
+	{
+		return std::move(m_list);
+	}
+
+protected:
+
+	virtual void OnBytes(std::vector<uint8_t>& bytes) override
+	{
+		m_list.push_back(RetValType(std::move(bytes)));
+	}
+
+private:
+
+	_RetType m_list;
+
+}; // class HexBytesListSink
+
+
+/**
+ * @brief Records whether a list is found, which tells a missing (or null)
+ *        result apart from an empty one
+ *
+ */
+class ListFoundSink :
+	public SimpleJson::SaxListSinkIf
+{
+public:
+
+	ListFoundSink() :
+		m_isFound(false)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~ListFoundSink() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnBegin() override
+	{
+		m_isFound = true;
+	}
+
+	virtual void OnEnd() override
+	{}
+
+	bool IsFound() const
+	{
+		return m_isFound;
+	}
+
+private:
+
+	bool m_isFound;
+
+}; // class ListFoundSink
+
+
+/**
+ * @brief Collects the error message that Geth returns in place of the
+ *        result
+ *
+ */
+class ErrorMsgSink :
+	public SimpleJson::SaxStringSinkIf
+{
+public:
+
+	ErrorMsgSink() :
+		m_msg()
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~ErrorMsgSink() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnBegin() override
+	{
+		m_msg.clear();
+	}
+
+	virtual void OnChunk(const char* data, size_t size) override
+	{
+		m_msg.append(data, size);
+	}
+
+	virtual void OnEnd() override
+	{}
+
+	const std::string& GetMsg() const
+	{
+		return m_msg;
+	}
+
+private:
+
+	std::string m_msg;
+
+}; // class ErrorMsgSink
+
+
+inline void ThrowInvalidGethResp(const ErrorMsgSink& errSink)
+{
+	if (errSink.GetMsg().empty())
+	{
+		throw std::runtime_error("Invalid response from Geth.");
+	}
+	throw std::runtime_error(
+		"Invalid response from Geth - " + errSink.GetMsg()
+	);
+}
+
+
+/**
+ * @brief Picks the bytes of a response whose result is a single hex string
+ *        out of the response body, as it is parsed
+ *
+ */
+class GethBytesResp
+{
+public:
+
+	GethBytesResp() :
+		m_resSink(),
+		m_errSink(),
+		m_extractor()
+	{
+		m_extractor.Bind("result", m_resSink);
+		m_extractor.Bind("error.message", m_errSink);
+	}
+
+	// LCOV_EXCL_START
+	~GethBytesResp() = default;
+	// LCOV_EXCL_STOP
+
+	GethBytesResp(const GethBytesResp&) = delete;
+
+	GethBytesResp& operator=(const GethBytesResp&) = delete;
+
+	SimpleJson::SaxHandlerIf& GetHandler()
+	{
+		return m_extractor;
+	}
+
+	/**
+	 * @brief Get the bytes, once the whole response is parsed
+	 *
+	 * @exception std::runtime_error If the response has no result, e.g., it
+	 *                               has an error instead
+	 */
+	std::vector<uint8_t> ReleaseBytes()
+	{
+		if (m_resSink.GetValueCount() != 1)
+		{
+			ThrowInvalidGethResp(m_errSink);
+		}
+		return m_resSink.ReleaseBytes();
+	}
+
+private:
+
+	HexBytesSink m_resSink;
+	ErrorMsgSink m_errSink;
+	SimpleJson::SaxExtractor m_extractor;
+
+}; // class GethBytesResp
+
+
+/**
+ * @brief Picks the bytes of a response whose result is a list of hex strings
+ *        out of the response body, as it is parsed
+ *
+ */
+template<typename _RetType>
+class GethBytesListResp
+{
+public:
+
+	GethBytesListResp() :
+		m_listSink(),
+		m_resSink(),
+		m_errSink(),
+		m_extractor()
+	{
+		m_extractor.Bind("result", m_listSink);
+		m_extractor.Bind("result[*]", m_resSink);
+		m_extractor.Bind("error.message", m_errSink);
+	}
+
+	// LCOV_EXCL_START
+	~GethBytesListResp() = default;
+	// LCOV_EXCL_STOP
+
+	GethBytesListResp(const GethBytesListResp&) = delete;
+
+	GethBytesListResp& operator=(const GethBytesListResp&) = delete;
+
+	SimpleJson::SaxHandlerIf& GetHandler()
+	{
+		return m_extractor;
+	}
+
+	/**
+	 * @brief Get the list, once the whole response is parsed
+	 *
+	 * @exception std::runtime_error If the response has no result list,
+	 *                               e.g., it has an error instead
+	 */
+	_RetType ReleaseList()
+	{
+		if (!m_listSink.IsFound())
+		{
+			ThrowInvalidGethResp(m_errSink);
+		}
+		return m_resSink.ReleaseList();
+	}
+
+private:
+
+	ListFoundSink m_listSink;
+	HexBytesListSink<_RetType> m_resSink;
+	ErrorMsgSink m_errSink;
+	SimpleJson::SaxExtractor m_extractor;
+
+}; // class GethBytesListResp
+
+
+} // namespace EthereumClt
@@ -0,0 +1,897 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cctype>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <EclipseMonitor/Eth/DataTypes.hpp>
+#include <SimpleJson/SimpleJson.hpp>
+#include <SimpleObjects/Codec/Hex.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
+#include <SimpleRlp/SimpleRlp.hpp>
+#include <SimpleSysIO/SysCall/TCPAcceptor.hpp>
+
+#include "BlockCorpus.hpp"
+#include "WebSocket.hpp"
+
+
+namespace EthereumClt
+{
+
+
+/**
+ * @brief A local HTTP JSON-RPC server that stands in for Geth, serving
+ *        `debug_getRawHeader`, `debug_getRawReceipts`, `debug_getRawBlock`
+ *        and `eth_blockNumber` from a block corpus, so the untrusted fetch
+ *        path can be measured under controlled RPC conditions.
+ *        Each connection serves one request, and is then closed, unless
+ *        it's upgraded to WebSocket; a WebSocket connection serves requests
+ *        until it subscribes to `newHeads`, and is then sent a notification
+ *        each time the head advances, until it's closed. A WebSocket
+ *        connection takes up a worker for as long as it's open.
+ *
+ */
+class GethStandInServer
+{
+public: // static members:
+
+	using BlockNumber = EclipseMonitor::Eth::BlockNumber;
+	using SocketType = SimpleSysIO::SysCall::TCPSocket;
+
+	struct Config
+	{
+		Config() :
+			m_latencyMilSec(0),
+			m_latencyJitterMilSec(0),
+			m_bandwidthBytesPerSec(0),
+			m_httpErrorRate(0.0),
+			m_rpcErrorRate(0.0),
+			m_headStartBlockNum(0),
+			m_headBlocksPerSec(0.0),
+			m_randSeed(0),
+			m_numOfWorkers(4)
+		{}
+
+		/**
+		 * @brief Delay added before each response is sent
+		 *
+		 */
+		uint64_t m_latencyMilSec;
+
+		/**
+		 * @brief Upper bound of a uniformly random delay added on top of
+		 *        `m_latencyMilSec`
+		 *
+		 */
+		uint64_t m_latencyJitterMilSec;
+
+		/**
+		 * @brief Rate at which each response is sent; 0 means unlimited
+		 *
+		 */
+		uint64_t m_bandwidthBytesPerSec;
+
+		/**
+		 * @brief Probability that a request is answered with HTTP 503
+		 *
+		 */
+		double m_httpErrorRate;
+
+		/**
+		 * @brief Probability that a request is answered with a JSON-RPC
+		 *        error
+		 *
+		 */
+		double m_rpcErrorRate;
+
+		/**
+		 * @brief The chain head when the server starts; it is raised to the
+		 *        first block in the corpus if it is lower
+		 *
+		 */
+		BlockNumber m_headStartBlockNum;
+
+		/**
+		 * @brief Rate at which the chain head advances, until it reaches
+		 *        the last block in the corpus; 0 means the whole corpus is
+		 *        available from the start
+		 *
+		 */
+		double m_headBlocksPerSec;
+
+		uint32_t m_randSeed;
+
+		size_t m_numOfWorkers;
+	}; // struct Config
+
+	static constexpr size_t sk_recvBufSize = 4096;
+	static constexpr size_t sk_maxHeaderSize = 64 * 1024;
+	static constexpr size_t sk_maxBodySize = 1024 * 1024;
+	static constexpr int64_t sk_headCheckMilSec = 5;
+
+public:
+
+	GethStandInServer(
+		std::shared_ptr<BlockCorpusReader> corpus,
+		const Config& config,
+		const std::string& ipv4 = "127.0.0.1",
+		uint16_t port = 0
+	) :
+		m_corpus(corpus),
+		m_config(config),
+		m_headStartBlockNum(
+			std::max(config.m_headStartBlockNum, corpus->GetFirstBlockNum())
+		),
+		m_startTime(std::chrono::steady_clock::now()),
+		m_ipv4(ipv4),
+		m_acceptor(SimpleSysIO::SysCall::TCPAcceptor::BindV4(ipv4, port)),
+		m_port(m_acceptor->GetLocalPort()),
+		m_isRunning(true),
+		m_queueMutex(),
+		m_queueCond(),
+		m_pendingConns(),
+		m_servingConns(),
+		m_randMutex(),
+		m_rand(config.m_randSeed),
+		m_numOfRequests(0),
+		m_numOfInjectedErrors(0),
+		m_acceptThread(),
+		m_workerThreads()
+	{
+		const size_t numOfWorkers = std::max<size_t>(config.m_numOfWorkers, 1);
+		for (size_t i = 0; i < numOfWorkers; ++i)
+		{
+			m_workerThreads.emplace_back(&GethStandInServer::WorkerLoop, this);
+		}
+		m_acceptThread = std::thread(&GethStandInServer::AcceptLoop, this);
+	}
+
+	// LCOV_EXCL_START
+	~GethStandInServer()
+	{
+		Stop();
+	}
+	// LCOV_EXCL_STOP
+
+	GethStandInServer(const GethStandInServer&) = delete;
+
+	GethStandInServer& operator=(const GethStandInServer&) = delete;
+
+	uint16_t GetPort() const
+	{
+		return m_port;
+	}
+
+	/**
+	 * @brief Get the URL to be given to GethRequester or HostBlockService
+	 *
+	 */
+	std::string GetUrl() const
+	{
+		return "http://" + GetConnectIp() + ":" + std::to_string(m_port);
+	}
+
+	/**
+	 * @brief Get the URL to be given to GethHeadSubscriber
+	 *
+	 */
+	std::string GetWsUrl() const
+	{
+		return "ws://" + GetConnectIp() + ":" + std::to_string(m_port);
+	}
+
+	/**
+	 * @brief Get the chain head as it is seen by the clients right now
+	 *
+	 */
+	BlockNumber GetHeadBlockNum() const
+	{
+		const BlockNumber lastBlockNum = m_corpus->GetLastBlockNum();
+		if (m_config.m_headBlocksPerSec <= 0.0)
+		{
+			return lastBlockNum;
+		}
+
+		const double elapsedSec = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - m_startTime
+		).count();
+		const BlockNumber advanced = static_cast<BlockNumber>(
+			elapsedSec * m_config.m_headBlocksPerSec
+		);
+		return std::min(lastBlockNum, m_headStartBlockNum + advanced);
+	}
+
+	uint64_t GetNumOfRequests() const
+	{
+		return m_numOfRequests.load();
+	}
+
+	uint64_t GetNumOfInjectedErrors() const
+	{
+		return m_numOfInjectedErrors.load();
+	}
+
+	/**
+	 * @brief Stop accepting connections, and wait for the worker threads to
+	 *        exit; connections that are being served are shut down, and the
+	 *        ones that are not served yet are dropped
+	 *
+	 */
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			if (!m_isRunning)
+			{
+				return;
+			}
+			m_isRunning = false;
+
+			// workers may be blocked on receiving from these connections
+			for (SocketType* socket : m_servingConns)
+			{
+				socket->Shutdown();
+			}
+		}
+		m_queueCond.notify_all();
+
+		// the accept call blocks, so wake it up with a connection of our own
+		try
+		{
+			SocketType::ConnectV4(GetConnectIp(), m_port);
+		}
+		catch(const std::exception&)
+		{}
+
+		m_acceptThread.join();
+		for (auto& worker : m_workerThreads)
+		{
+			worker.join();
+		}
+
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_pendingConns.clear();
+	}
+
+private:
+
+	struct Response
+	{
+		Response(uint32_t statusCode, std::string body) :
+			m_statusCode(statusCode),
+			m_body(std::move(body))
+		{}
+
+		uint32_t m_statusCode;
+		std::string m_body;
+	}; // struct Response
+
+	std::string GetConnectIp() const
+	{
+		return m_ipv4 == "0.0.0.0" ? std::string("127.0.0.1") : m_ipv4;
+	}
+
+	void AcceptLoop()
+	{
+		while (m_isRunning)
+		{
+			std::unique_ptr<SocketType> socket;
+			try
+			{
+				socket = m_acceptor->TCPAccept();
+			}
+			catch(const std::exception&)
+			{
+				// the acceptor is not usable anymore
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			if (!m_isRunning)
+			{
+				return;
+			}
+			m_pendingConns.push_back(std::move(socket));
+			m_queueCond.notify_one();
+		}
+	}
+
+	void WorkerLoop()
+	{
+		while (true)
+		{
+			std::unique_ptr<SocketType> socket;
+			{
+				std::unique_lock<std::mutex> lock(m_queueMutex);
+				m_queueCond.wait(
+					lock,
+					[this]()
+					{
+						return !m_isRunning || !m_pendingConns.empty();
+					}
+				);
+				if (!m_isRunning)
+				{
+					return;
+				}
+				socket = std::move(m_pendingConns.front());
+				m_pendingConns.pop_front();
+				// registered under the same lock as the check above, so
+				// `Stop` either sees it, or it's never served
+				m_servingConns.insert(socket.get());
+			}
+
+			try
+			{
+				ServeConnection(*socket);
+			}
+			catch(const std::exception&)
+			{
+				// the client has gone away, or sent a broken request;
+				// either way, the connection is dropped
+			}
+
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_servingConns.erase(socket.get());
+		}
+	}
+
+	void ServeConnection(SocketType& socket)
+	{
+		std::string req;
+		size_t headerEnd = std::string::npos;
+		while ((headerEnd = req.find("\r\n\r\n")) == std::string::npos)
+		{
+			if (req.size() > sk_maxHeaderSize)
+			{
+				throw std::runtime_error("HTTP request header is too large");
+			}
+			req += socket.RecvSomeBytes<std::string>(sk_recvBufSize);
+		}
+
+		const std::string rawHeader = req.substr(0, headerEnd);
+		std::string header = rawHeader;
+		std::transform(
+			header.begin(),
+			header.end(),
+			header.begin(),
+			[](char ch) -> char
+			{
+				return static_cast<char>(
+					std::tolower(static_cast<unsigned char>(ch))
+				);
+			}
+		);
+
+		if (
+			(header.compare(0, 4, "get ") == 0) &&
+			(header.find("\r\nupgrade: websocket") != std::string::npos)
+		)
+		{
+			ServeWebSocket(
+				socket,
+				rawHeader,
+				header,
+				req.substr(headerEnd + 4)
+			);
+			return;
+		}
+
+		const size_t bodyLen = GetContentLength(header);
+		if (bodyLen > sk_maxBodySize)
+		{
+			throw std::runtime_error("HTTP request body is too large");
+		}
+		if (header.find("\r\nexpect: 100-continue") != std::string::npos)
+		{
+			socket.SendBytes(std::string("HTTP/1.1 100 Continue\r\n\r\n"));
+		}
+
+		std::string body = req.substr(headerEnd + 4);
+		while (body.size() < bodyLen)
+		{
+			body += socket.RecvSomeBytes<std::string>(bodyLen - body.size());
+		}
+		body.resize(bodyLen);
+
+		Response resp = (header.compare(0, 5, "post ") == 0) ?
+			HandleRequest(body) :
+			Response(405, std::string());
+
+		Delay();
+		SendResponse(socket, resp);
+	}
+
+	void ServeWebSocket(
+		SocketType& socket,
+		const std::string& rawHeader,
+		const std::string& lowerHeader,
+		std::string recvBuf
+	)
+	{
+		static const std::string sk_keyLabel = "\r\nsec-websocket-key:";
+
+		// the key is case-sensitive, so it's taken from the raw header
+		const size_t keyPos = lowerHeader.find(sk_keyLabel);
+		if (keyPos == std::string::npos)
+		{
+			throw std::runtime_error("WebSocket key is missing");
+		}
+		const size_t keyBegin = rawHeader.find_first_not_of(
+			' ', keyPos + sk_keyLabel.size()
+		);
+		const size_t keyEnd = rawHeader.find("\r\n", keyBegin);
+		const std::string key = rawHeader.substr(keyBegin, keyEnd - keyBegin);
+
+		socket.SendBytes(
+			"HTTP/1.1 101 Switching Protocols\r\n"
+			"Upgrade: websocket\r\n"
+			"Connection: Upgrade\r\n"
+			"Sec-WebSocket-Accept: " +
+				WebSocketFrame::ComputeAcceptKey(key) + "\r\n"
+			"\r\n"
+		);
+
+		// serve requests until the client subscribes to the new heads
+		while (true)
+		{
+			WebSocketFrame frame;
+			while (!WebSocketFrame::TryDecode(recvBuf, frame, sk_maxBodySize))
+			{
+				recvBuf += socket.RecvSomeBytes<std::string>(sk_recvBufSize);
+			}
+
+			if (frame.m_opcode == WebSocketOpcode::Close)
+			{
+				SendWsFrame(socket, WebSocketOpcode::Close, std::string());
+				return;
+			}
+			if (frame.m_opcode == WebSocketOpcode::Ping)
+			{
+				SendWsFrame(socket, WebSocketOpcode::Pong, frame.m_payload);
+				continue;
+			}
+			if (frame.m_opcode != WebSocketOpcode::Text)
+			{
+				continue;
+			}
+
+			if (IsNewHeadsSubscription(frame.m_payload))
+			{
+				++m_numOfRequests;
+				SendWsFrame(
+					socket,
+					WebSocketOpcode::Text,
+					BuildResult(GetRequestId(frame.m_payload), "\"0x1\"")
+				);
+				break;
+			}
+
+			Response resp = HandleRequest(frame.m_payload);
+			Delay();
+			if (resp.m_statusCode != 200)
+			{
+				// there is no HTTP status on a WebSocket, so an injected
+				// HTTP error drops the connection instead
+				SendWsFrame(socket, WebSocketOpcode::Close, std::string());
+				return;
+			}
+			SendWsFrame(socket, WebSocketOpcode::Text, resp.m_body);
+		}
+
+		// like Geth, only the heads after the subscription are notified
+		BlockNumber lastHeadNum = GetHeadBlockNum();
+		while (m_isRunning)
+		{
+			const BlockNumber headNum = GetHeadBlockNum();
+			while (lastHeadNum < headNum)
+			{
+				++lastHeadNum;
+				SendWsFrame(
+					socket,
+					WebSocketOpcode::Text,
+					"{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\","
+					"\"params\":{\"subscription\":\"0x1\",\"result\":{"
+					"\"number\":\"" +
+					SimpleObjects::Codec::Hex::
+						template Encode<std::string>(lastHeadNum) +
+					"\"}}}"
+				);
+			}
+			std::this_thread::sleep_for(
+				std::chrono::milliseconds(int64_t(sk_headCheckMilSec))
+			);
+		}
+	}
+
+	static bool IsNewHeadsSubscription(const std::string& body)
+	{
+		try
+		{
+			const auto req = SimpleJson::LoadStr(body);
+			const auto& reqDict = req.AsDict();
+			const std::string method =
+				reqDict[SimpleObjects::String("method")].AsString().c_str();
+			const auto& params =
+				reqDict[SimpleObjects::String("params")].AsList();
+			return
+				(method == "eth_subscribe") &&
+				(params.size() > 0) &&
+				(std::string(params[0].AsString().c_str()) == "newHeads");
+		}
+		catch(const std::exception&)
+		{
+			return false;
+		}
+	}
+
+	static std::string GetRequestId(const std::string& body)
+	{
+		const auto req = SimpleJson::LoadStr(body);
+		const auto& reqDict = req.AsDict();
+		return reqDict.HasKey(SimpleObjects::String("id")) ?
+			SimpleJson::DumpStr(reqDict[SimpleObjects::String("id")]) :
+			std::string("null");
+	}
+
+	static void SendWsFrame(
+		SocketType& socket,
+		WebSocketOpcode opcode,
+		const std::string& payload
+	)
+	{
+		// frames sent by a server are not masked
+		socket.SendBytes(WebSocketFrame::Encode(opcode, payload, false));
+	}
+
+	Response HandleRequest(const std::string& body)
+	{
+		++m_numOfRequests;
+
+		if (DrawInjection(m_config.m_httpErrorRate))
+		{
+			++m_numOfInjectedErrors;
+			return Response(503, std::string());
+		}
+
+		SimpleObjects::Object req;
+		try
+		{
+			req = SimpleJson::LoadStr(body);
+		}
+		catch(const std::exception&)
+		{
+			return Response(200, BuildError("null", -32700, "parse error"));
+		}
+
+		std::string id = "null";
+		std::string method;
+		std::string param;
+		try
+		{
+			const auto& reqDict = req.AsDict();
+			if (reqDict.HasKey(SimpleObjects::String("id")))
+			{
+				id = SimpleJson::DumpStr(reqDict[SimpleObjects::String("id")]);
+			}
+			method =
+				reqDict[SimpleObjects::String("method")].AsString().c_str();
+			if (reqDict.HasKey(SimpleObjects::String("params")))
+			{
+				const auto& params =
+					reqDict[SimpleObjects::String("params")].AsList();
+				if (params.size() > 0)
+				{
+					param = params[0].AsString().c_str();
+				}
+			}
+		}
+		catch(const std::exception&)
+		{
+			return Response(200, BuildError(id, -32600, "invalid request"));
+		}
+
+		if (DrawInjection(m_config.m_rpcErrorRate))
+		{
+			++m_numOfInjectedErrors;
+			return Response(200, BuildError(id, -32000, "injected error"));
+		}
+
+		return Response(200, Dispatch(id, method, param));
+	}
+
+	std::string Dispatch(
+		const std::string& id,
+		const std::string& method,
+		const std::string& param
+	) const
+	{
+		const BlockNumber headBlockNum = GetHeadBlockNum();
+
+		if (method == "eth_blockNumber")
+		{
+			return BuildResult(
+				id,
+				'\"' +
+				SimpleObjects::Codec::Hex::
+					template Encode<std::string>(headBlockNum) +
+				'\"'
+			);
+		}
+
+		const bool isHeader = (method == "debug_getRawHeader");
+		const bool isReceipts = (method == "debug_getRawReceipts");
+		if (!isHeader && !isReceipts && method != "debug_getRawBlock")
+		{
+			return BuildError(
+				id,
+				-32601,
+				"the method " + method + " does not exist/is not available"
+			);
+		}
+
+		BlockNumber blockNum = 0;
+		try
+		{
+			blockNum = ParseBlockParam(param, headBlockNum);
+		}
+		catch(const std::exception&)
+		{
+			return BuildError(id, -32602, "invalid argument 0: " + param);
+		}
+
+		if (blockNum > headBlockNum || !m_corpus->HasBlock(blockNum))
+		{
+			return BuildError(
+				id,
+				-32000,
+				(isHeader ? "header #" : "block #") +
+					std::to_string(blockNum) + " not found"
+			);
+		}
+
+		if (isHeader)
+		{
+			return BuildResult(
+				id,
+				'\"' + EncodeBytes(m_corpus->GetHeaderRlp(blockNum)) + '\"'
+			);
+		}
+		if (isReceipts)
+		{
+			return BuildResult(id, EncodeReceipts(blockNum));
+		}
+
+		// the corpus keeps headers and receipts only
+		return BuildError(
+			id,
+			-32000,
+			"block bodies are not available in the corpus"
+		);
+	}
+
+	std::string EncodeReceipts(BlockNumber blockNum) const
+	{
+		const auto receipts =
+			SimpleRlp::ParseRlp(m_corpus->GetReceiptsRlp(blockNum));
+
+		std::string res = "[";
+		for (const auto& receipt : receipts.AsList().CSpan())
+		{
+			const auto& bytes = receipt.AsBytes();
+			if (res.size() > 1)
+			{
+				res += ',';
+			}
+			res += '\"';
+			res += SimpleObjects::Codec::Hex::template Encode<std::string>(
+				bytes.data(),
+				bytes.data() + bytes.size(),
+				"0x"
+			);
+			res += '\"';
+		}
+		res += ']';
+		return res;
+	}
+
+	static std::string EncodeBytes(const std::vector<uint8_t>& bytes)
+	{
+		return SimpleObjects::Codec::Hex::
+			template Encode<std::string>(bytes, "0x");
+	}
+
+	static BlockNumber ParseBlockParam(
+		const std::string& param,
+		BlockNumber headBlockNum
+	)
+	{
+		if (param == "latest" || param == "pending")
+		{
+			return headBlockNum;
+		}
+		if (param == "earliest")
+		{
+			return 0;
+		}
+		if (
+			param.size() < 3 ||
+			param.size() > 18 ||
+			param.compare(0, 2, "0x") != 0
+		)
+		{
+			throw std::invalid_argument("Invalid block number");
+		}
+		size_t parsedLen = 0;
+		const BlockNumber blockNum = static_cast<BlockNumber>(
+			std::stoull(param.substr(2), &parsedLen, 16)
+		);
+		if (parsedLen != param.size() - 2)
+		{
+			throw std::invalid_argument("Invalid block number");
+		}
+		return blockNum;
+	}
+
+	static size_t GetContentLength(const std::string& lowerHeader)
+	{
+		static const std::string sk_label = "\r\ncontent-length:";
+
+		const size_t pos = lowerHeader.find(sk_label);
+		if (pos == std::string::npos)
+		{
+			return 0;
+		}
+		return static_cast<size_t>(
+			std::stoull(lowerHeader.substr(pos + sk_label.size()))
+		);
+	}
+
+	static std::string BuildResult(
+		const std::string& id,
+		const std::string& resultJson
+	)
+	{
+		return "{\"jsonrpc\":\"2.0\",\"id\":" + id +
+			",\"result\":" + resultJson + "}";
+	}
+
+	static std::string BuildError(
+		const std::string& id,
+		int64_t code,
+		const std::string& msg
+	)
+	{
+		return "{\"jsonrpc\":\"2.0\",\"id\":" + id +
+			",\"error\":{\"code\":" + std::to_string(code) +
+			",\"message\":" +
+			SimpleJson::DumpStr(SimpleObjects::String(msg)) + "}}";
+	}
+
+	static const char* GetStatusText(uint32_t statusCode)
+	{
+		switch (statusCode)
+		{
+		case 200:
+			return "OK";
+		case 405:
+			return "Method Not Allowed";
+		case 503:
+			return "Service Unavailable";
+		default:
+			return "Unknown";
+		}
+	}
+
+	bool DrawInjection(double rate)
+	{
+		if (rate <= 0.0)
+		{
+			return false;
+		}
+		std::lock_guard<std::mutex> lock(m_randMutex);
+		return std::uniform_real_distribution<double>(0.0, 1.0)(m_rand) < rate;
+	}
+
+	void Delay()
+	{
+		uint64_t delayMilSec = m_config.m_latencyMilSec;
+		if (m_config.m_latencyJitterMilSec > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_randMutex);
+			delayMilSec += std::uniform_int_distribution<uint64_t>(
+				0, m_config.m_latencyJitterMilSec
+			)(m_rand);
+		}
+		if (delayMilSec > 0)
+		{
+			std::this_thread::sleep_for(
+				std::chrono::milliseconds(delayMilSec)
+			);
+		}
+	}
+
+	void SendResponse(SocketType& socket, const Response& resp) const
+	{
+		std::string msg =
+			"HTTP/1.1 " + std::to_string(resp.m_statusCode) + " " +
+			GetStatusText(resp.m_statusCode) + "\r\n"
+			"Content-Type: application/json\r\n"
+			"Content-Length: " + std::to_string(resp.m_body.size()) + "\r\n"
+			"Connection: close\r\n"
+			"\r\n";
+		msg += resp.m_body;
+
+		const uint64_t bandwidth = m_config.m_bandwidthBytesPerSec;
+		if (bandwidth == 0)
+		{
+			socket.SendBytes(msg);
+			return;
+		}
+
+		// send in slices of about 10ms, and pace each slice against the
+		// time the whole message should have taken so far
+		const size_t sliceSize =
+			std::max<size_t>(static_cast<size_t>(bandwidth / 100), 1);
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t sent = 0; sent < msg.size(); )
+		{
+			const size_t size = std::min(sliceSize, msg.size() - sent);
+			socket.SendBytes(msg.substr(sent, size));
+			sent += size;
+
+			std::this_thread::sleep_until(
+				start + std::chrono::microseconds(
+					(static_cast<uint64_t>(sent) * 1000000) / bandwidth
+				)
+			);
+		}
+	}
+
+	std::shared_ptr<BlockCorpusReader> m_corpus;
+	Config m_config;
+	BlockNumber m_headStartBlockNum;
+	std::chrono::steady_clock::time_point m_startTime;
+	std::string m_ipv4;
+	std::unique_ptr<SimpleSysIO::SysCall::TCPAcceptor> m_acceptor;
+	uint16_t m_port;
+
+	std::atomic<bool> m_isRunning;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCond;
+	std::deque<std::unique_ptr<SocketType> > m_pendingConns;
+	std::set<SocketType*> m_servingConns;
+
+	std::mutex m_randMutex;
+	std::mt19937 m_rand;
+
+	std::atomic<uint64_t> m_numOfRequests;
+	std::atomic<uint64_t> m_numOfInjectedErrors;
+
+	std::thread m_acceptThread;
+	std::vector<std::thread> m_workerThreads;
+
+}; // class GethStandInServer
+
+
+} // namespace EthereumClt
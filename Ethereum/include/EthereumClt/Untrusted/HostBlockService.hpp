@@ -12,8 +12,13 @@
 #include <memory>
 
 #include <EclipseMonitor/Eth/DataTypes.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
 #include <SimpleRlp/SimpleRlp.hpp>
 
+#include "../Common/PipelineMetrics.hpp"
+#include "../Common/PipelineTrace.hpp"
+#include "BlockCache.hpp"
+#include "BlockCorpus.hpp"
 #include "BlockReceiver.hpp"
 #include "GethRequester.hpp"
 
@@ -32,16 +37,34 @@ public: // static members:
 	)
 	{
 		return std::shared_ptr<HostBlockService>(
-			new HostBlockService(gethUrl)
+			new HostBlockService(gethUrl, nullptr)
+		);
+	}
+
+	/**
+	 * @brief Create a HostBlockService that serves the blocks in the given
+	 *        corpus, instead of requesting them from Geth
+	 *
+	 */
+	static std::shared_ptr<HostBlockService> CreateReplay(
+		std::shared_ptr<BlockCorpusReader> corpus
+	)
+	{
+		return std::shared_ptr<HostBlockService>(
+			new HostBlockService(std::string(), corpus)
 		);
 	}
 
 private: // Constructor - not allowed to be called directly
 
 	HostBlockService(
-		const std::string& gethUrl
+		const std::string& gethUrl,
+		std::shared_ptr<BlockCorpusReader> corpus
 	) :
 		m_gethReq(gethUrl),
+		m_corpusReader(corpus),
+		m_corpusWriter(),
+		m_cache(),
 		m_blockReceiver(),
 		//m_isUpdSvcStarted(false),
 		m_currBlockNum(0)
@@ -83,6 +106,41 @@ public:
 		m_blockReceiver = blockReceiver;
 	}
 
+	/**
+	 * @brief Record every block fetched from Geth, together with its
+	 *        receipts, into the given corpus.
+	 *        NOTE: it must be called before blocks are pushed
+	 *
+	 */
+	void EnableCapture(std::shared_ptr<BlockCorpusWriter> corpus)
+	{
+		if (m_corpusReader != nullptr)
+		{
+			throw std::logic_error(
+				"HostBlockService - can't capture blocks while replaying"
+			);
+		}
+		m_corpusWriter = corpus;
+	}
+
+	/**
+	 * @brief Look up the headers and receipts in the given cache before
+	 *        requesting them from Geth, and put the ones fetched from Geth
+	 *        into it.
+	 *        NOTE: it must be called before blocks are pushed
+	 *
+	 */
+	void EnableCache(std::shared_ptr<BlockCache> cache)
+	{
+		if (m_corpusReader != nullptr)
+		{
+			throw std::logic_error(
+				"HostBlockService - can't cache blocks while replaying"
+			);
+		}
+		m_cache = cache;
+	}
+
 	void PushBlock(const std::vector<uint8_t>& headerRlp) const
 	{
 		std::shared_ptr<BlockReceiver> blockReceiver =
@@ -101,8 +159,9 @@ public:
 
 	void PushBlock(EclipseMonitor::Eth::BlockNumber blockNum) const
 	{
-		auto headerRlp = m_gethReq.GetHeaderRlpByNum(blockNum);
+		auto headerRlp = GetHeaderRlpByNum(blockNum);
 
+		Metrics::Tracer::GetInstance().StampIngest(blockNum);
 		return PushBlock(headerRlp);
 	}
 
@@ -118,13 +177,14 @@ public:
 		std::vector<uint8_t> headerRlp;
 		try
 		{
-			headerRlp = m_gethReq.GetHeaderRlpByNum(m_currBlockNum);
+			headerRlp = GetHeaderRlpByNum(m_currBlockNum);
 		}
 		catch(const std::exception& e)
 		{
 			return false;
 		}
 
+		Metrics::Tracer::GetInstance().StampIngest(m_currBlockNum);
 		PushBlock(headerRlp);
 		++m_currBlockNum;
 		return true;
@@ -135,12 +195,89 @@ public:
 		uint64_t blockNum
 	) const
 	{
+		using _RetValType = typename _RetType::value_type;
+
+		if (
+			(m_corpusReader != nullptr) ||
+			(m_corpusWriter != nullptr) ||
+			(m_cache != nullptr)
+		)
+		{
+			// the corpus and the cache keep the receipts in the form the
+			// enclave expects, so they're obtained in that form, and split
+			auto receipts = SimpleRlp::ParseRlp(
+				GetReceiptsListRlpByNum(blockNum)
+			);
+
+			_RetType res;
+			for (const auto& receipt : receipts.AsList().CSpan())
+			{
+				const auto& bytes = receipt.AsBytes();
+				res.push_back(_RetValType(std::vector<uint8_t>(
+					bytes.data(), bytes.data() + bytes.size()
+				)));
+			}
+			return res;
+		}
+
+		Metrics::StageTimer timer(Metrics::Stage::GethFetchReceipts);
 		return m_gethReq.GetReceiptsRlpByNum<_RetType>(blockNum);
 	}
 
 
+	/**
+	 * @brief Get the RLP list of the raw receipts of the given block, which
+	 *        is the form the enclave expects
+	 *
+	 */
+	std::vector<uint8_t> GetReceiptsListRlpByNum(uint64_t blockNum) const
+	{
+		using _ListBytesType = SimpleObjects::ListT<SimpleObjects::Bytes>;
+
+		if (m_corpusReader != nullptr)
+		{
+			// the corpus has it in this form already
+			return m_corpusReader->GetReceiptsRlp(blockNum);
+		}
+
+		std::vector<uint8_t> receiptsRlp;
+		if (
+			(m_corpusWriter != nullptr) &&
+			m_corpusWriter->TryGetRecentReceiptsRlp(blockNum, receiptsRlp)
+		)
+		{
+			// fetched already when the block was captured
+			return receiptsRlp;
+		}
+		if (
+			(m_cache != nullptr) &&
+			m_cache->TryGetReceiptsRlp(blockNum, receiptsRlp)
+		)
+		{
+			return receiptsRlp;
+		}
+
+		_ListBytesType receipts;
+		{
+			Metrics::StageTimer timer(Metrics::Stage::GethFetchReceipts);
+			receipts = m_gethReq.GetReceiptsRlpByNum<_ListBytesType>(blockNum);
+		}
+		receiptsRlp = SimpleRlp::WriteRlp(receipts);
+		if (m_cache != nullptr)
+		{
+			m_cache->PutReceiptsRlp(blockNum, receiptsRlp);
+		}
+		return receiptsRlp;
+	}
+
+
 	uint64_t GetLatestBlockNum() const
 	{
+		if (m_corpusReader != nullptr)
+		{
+			return m_corpusReader->GetLastBlockNum();
+		}
+
 		auto hdrRlp = m_gethReq.GetHeaderRlpByParam("latest");
 		auto hdr = SimpleRlp::EthHeaderParser().Parse(hdrRlp);
 		return
@@ -149,7 +286,50 @@ public:
 
 
 private:
+
+	std::vector<uint8_t> GetHeaderRlpByNum(
+		EclipseMonitor::Eth::BlockNumber blockNum
+	) const
+	{
+		Metrics::Tracer::GetInstance().StampFetch(blockNum);
+
+		if (m_corpusReader != nullptr)
+		{
+			return m_corpusReader->GetHeaderRlp(blockNum);
+		}
+
+		std::vector<uint8_t> headerRlp;
+		if (
+			(m_cache == nullptr) ||
+			!m_cache->TryGetHeaderRlp(blockNum, headerRlp)
+		)
+		{
+			{
+				Metrics::StageTimer timer(Metrics::Stage::GethFetchHeader);
+				headerRlp = m_gethReq.GetHeaderRlpByNum(blockNum);
+			}
+			if (m_cache != nullptr)
+			{
+				m_cache->PutHeaderRlp(blockNum, headerRlp);
+			}
+		}
+		if (m_corpusWriter != nullptr)
+		{
+			// receipts are captured for every block, since the blocks that
+			// need them depend on the receiver
+			m_corpusWriter->Record(
+				blockNum,
+				headerRlp,
+				GetReceiptsListRlpByNum(blockNum)
+			);
+		}
+		return headerRlp;
+	}
+
 	GethRequester m_gethReq;
+	std::shared_ptr<BlockCorpusReader> m_corpusReader;
+	std::shared_ptr<BlockCorpusWriter> m_corpusWriter;
+	std::shared_ptr<BlockCache> m_cache;
 	std::weak_ptr<BlockReceiver> m_blockReceiver;
 	//std::atomic_bool m_isUpdSvcStarted;
 	std::atomic<EclipseMonitor::Eth::BlockNumber> m_currBlockNum;
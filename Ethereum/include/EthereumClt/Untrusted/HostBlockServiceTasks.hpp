@@ -7,17 +7,30 @@
 
 
 #include <chrono>
-#include <iostream>
+#include <string>
 #include <thread>
 
+#include <DecentEnclave/Common/Platform/Print.hpp>
 #include <SimpleConcurrency/Threading/TickingTask.hpp>
 
+#include "GethHeadSubscriber.hpp"
 #include "HostBlockService.hpp"
 
 
 namespace EthereumClt
 {
 
+/**
+ * @brief Pushes new blocks to the enclave as soon as they are available.
+ *        When a head subscriber is given, and it knows the chain head, the
+ *        task doesn't ask Geth for a block beyond the head; it's woken up
+ *        through its `TimerWheel` handle when the subscriber is notified of
+ *        a new head (see `GethHeadSubscriber::SetHeadCallback`), and only
+ *        checks again on its own every `retryIntervalMilSec`, in case the
+ *        subscription goes down. Otherwise, it polls Geth for the next
+ *        block every `retryIntervalMilSec`.
+ *
+ */
 class BlockUpdatorServiceTask :
 	public SimpleConcurrency::Threading::TickingTask<int64_t>
 {
@@ -30,11 +43,14 @@ public: // static members:
 public:
 	BlockUpdatorServiceTask(
 		std::shared_ptr<HostBlockService> blockUpdator,
-		int64_t retryIntervalMilSec
+		int64_t retryIntervalMilSec,
+		std::shared_ptr<const GethHeadSubscriber> headSubscriber = nullptr
 	) :
 		Base(),
 		m_blockUpdator(blockUpdator),
-		m_retryIntervalMilSec(retryIntervalMilSec)
+		m_retryIntervalMilSec(retryIntervalMilSec),
+		m_headSubscriber(headSubscriber),
+		m_waitIntervalMilSec(0)
 	{}
 
 	virtual ~BlockUpdatorServiceTask() = default;
@@ -47,7 +63,13 @@ protected:
 		auto blockUpdator = m_blockUpdator.lock();
 		if (blockUpdator)
 		{
-			if (blockUpdator->TryPushNewBlock())
+			if (IsAheadOfHead(*blockUpdator))
+			{
+				// the next block is not there yet, and we'll be woken up
+				// when it is
+				WaitFor(m_retryIntervalMilSec);
+			}
+			else if (blockUpdator->TryPushNewBlock())
 			{
 				// Successfully pushed a new block to the enclave
 				// keep pushing without delay
@@ -60,13 +82,7 @@ protected:
 			{
 				// Failed to push a new block to the enclave
 				// wait for a while before retry
-				if (!Base::IsTickIntervalEnabled())
-				{
-					Base::SetInterval(
-						sk_taskUpdIntervalMliSec,
-						m_retryIntervalMilSec
-					);
-				}
+				WaitFor(m_retryIntervalMilSec);
 			}
 		}
 		else
@@ -85,8 +101,37 @@ protected:
 
 
 private:
+
+	bool IsAheadOfHead(const HostBlockService& blockUpdator) const
+	{
+		EclipseMonitor::Eth::BlockNumber headBlockNum = 0;
+		return
+			(m_headSubscriber != nullptr) &&
+			m_headSubscriber->TryGetHeadBlockNum(headBlockNum) &&
+			(headBlockNum < blockUpdator.GetCurrBlockNum());
+	}
+
+	void WaitFor(int64_t tickIntervalMilSec)
+	{
+		if (
+			!Base::IsTickIntervalEnabled() ||
+			(m_waitIntervalMilSec != tickIntervalMilSec)
+		)
+		{
+			Base::SetInterval(
+				(tickIntervalMilSec < sk_taskUpdIntervalMliSec) ?
+					tickIntervalMilSec :
+					sk_taskUpdIntervalMliSec,
+				tickIntervalMilSec
+			);
+			m_waitIntervalMilSec = tickIntervalMilSec;
+		}
+	}
+
 	std::weak_ptr<HostBlockService> m_blockUpdator;
 	int64_t m_retryIntervalMilSec;
+	std::shared_ptr<const GethHeadSubscriber> m_headSubscriber;
+	int64_t m_waitIntervalMilSec;
 
 }; // class BlockUpdatorServiceTask
 
@@ -127,10 +172,11 @@ protected:
 			size_t diff = currBlockNum - m_lastBlockNum;
 			float rate = diff / m_updIntervalSec;
 
-			std::cout << "HostBlockServiceStatus: " <<
-				"BlockNum=" << currBlockNum << ", " <<
-				"Rate=" << rate << " blocks/sec" <<
-				std::endl;
+			DecentEnclave::Common::Platform::Print::StrInfo(
+				"HostBlockServiceStatus: "
+				"BlockNum=" + std::to_string(currBlockNum) + ", "
+				"Rate=" + std::to_string(rate) + " blocks/sec"
+			);
 
 			m_lastBlockNum = currBlockNum;
 		}
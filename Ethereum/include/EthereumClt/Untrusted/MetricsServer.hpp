@@ -0,0 +1,189 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <SimpleSysIO/SysCall/TCPAcceptor.hpp>
+
+#include "../Common/PipelineMetrics.hpp"
+
+
+namespace EthereumClt
+{
+namespace Metrics
+{
+
+
+/**
+ * @brief A minimal HTTP server that serves `GET /metrics` in the Prometheus
+ *        text format, so the pipeline can be scraped locally.
+ *        Requests are served one at a time on a single thread, and each
+ *        connection is closed after its response.
+ *
+ */
+class MetricsServer
+{
+public: // static members:
+
+	using SocketType = SimpleSysIO::SysCall::TCPSocket;
+
+	static constexpr size_t sk_recvBufSize = 4096;
+	static constexpr size_t sk_maxHeaderSize = 16 * 1024;
+
+public:
+
+	MetricsServer(
+		const MetricsPage& page,
+		const std::string& ipv4 = "127.0.0.1",
+		uint16_t port = 0
+	) :
+		m_page(page),
+		m_ipv4(ipv4),
+		m_acceptor(SimpleSysIO::SysCall::TCPAcceptor::BindV4(ipv4, port)),
+		m_port(m_acceptor->GetLocalPort()),
+		m_isRunning(true),
+		m_thread(&MetricsServer::AcceptLoop, this)
+	{}
+
+	// LCOV_EXCL_START
+	~MetricsServer()
+	{
+		Stop();
+	}
+	// LCOV_EXCL_STOP
+
+	MetricsServer(const MetricsServer&) = delete;
+
+	MetricsServer& operator=(const MetricsServer&) = delete;
+
+	uint16_t GetPort() const
+	{
+		return m_port;
+	}
+
+	void Stop()
+	{
+		if (!m_isRunning.exchange(false))
+		{
+			return;
+		}
+
+		// the accept call blocks, so wake it up with a connection of our own
+		try
+		{
+			SocketType::ConnectV4(
+				m_ipv4 == "0.0.0.0" ? std::string("127.0.0.1") : m_ipv4,
+				m_port
+			);
+		}
+		catch(const std::exception&)
+		{}
+
+		m_thread.join();
+	}
+
+private:
+
+	void AcceptLoop()
+	{
+		while (m_isRunning)
+		{
+			std::unique_ptr<SocketType> socket;
+			try
+			{
+				socket = m_acceptor->TCPAccept();
+			}
+			catch(const std::exception&)
+			{
+				// the acceptor is not usable anymore
+				return;
+			}
+
+			if (!m_isRunning)
+			{
+				return;
+			}
+
+			try
+			{
+				ServeConnection(*socket);
+			}
+			catch(const std::exception&)
+			{
+				// the scraper has gone away, or sent a broken request;
+				// either way, the connection is dropped
+			}
+		}
+	}
+
+	void ServeConnection(SocketType& socket)
+	{
+		std::string req;
+		while (req.find("\r\n\r\n") == std::string::npos)
+		{
+			if (req.size() > sk_maxHeaderSize)
+			{
+				throw std::runtime_error("HTTP request header is too large");
+			}
+			req += socket.RecvSomeBytes<std::string>(sk_recvBufSize);
+		}
+
+		const std::string reqLine = req.substr(0, req.find("\r\n"));
+		if (
+			reqLine.compare(0, 13, "GET /metrics ") == 0 ||
+			reqLine.compare(0, 13, "GET /metrics?") == 0
+		)
+		{
+			SendResponse(
+				socket,
+				"200 OK",
+				"text/plain; version=0.0.4",
+				ToPrometheusText(m_page)
+			);
+		}
+		else
+		{
+			SendResponse(socket, "404 Not Found", "text/plain", "");
+		}
+	}
+
+	static void SendResponse(
+		SocketType& socket,
+		const std::string& status,
+		const std::string& contentType,
+		const std::string& body
+	)
+	{
+		socket.SendBytes(
+			"HTTP/1.1 " + status + "\r\n"
+			"Content-Type: " + contentType + "\r\n"
+			"Content-Length: " + std::to_string(body.size()) + "\r\n"
+			"Connection: close\r\n"
+			"\r\n" +
+			body
+		);
+	}
+
+	const MetricsPage& m_page;
+	std::string m_ipv4;
+	std::unique_ptr<SimpleSysIO::SysCall::TCPAcceptor> m_acceptor;
+	uint16_t m_port;
+	std::atomic<bool> m_isRunning;
+	std::thread m_thread;
+
+}; // class MetricsServer
+
+
+} // namespace Metrics
+} // namespace EthereumClt
@@ -0,0 +1,234 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include <mbedtls/sha1.h>
+#include <SimpleObjects/Codec/Base64.hpp>
+
+
+namespace EthereumClt
+{
+
+
+enum class WebSocketOpcode : uint8_t
+{
+	Continuation = 0x0,
+	Text         = 0x1,
+	Binary       = 0x2,
+	Close        = 0x8,
+	Ping         = 0x9,
+	Pong         = 0xA,
+}; // enum class WebSocketOpcode
+
+
+/**
+ * @brief A single frame of the WebSocket protocol (RFC 6455); only the
+ *        parts needed to talk JSON-RPC to Geth are supported, so extensions
+ *        are rejected
+ *
+ */
+struct WebSocketFrame
+{
+	WebSocketFrame() :
+		m_isFinal(true),
+		m_opcode(WebSocketOpcode::Text),
+		m_payload()
+	{}
+
+	/**
+	 * @brief Encode a frame; frames sent by a client must be masked, and
+	 *        frames sent by a server must not be
+	 *
+	 */
+	static std::string Encode(
+		WebSocketOpcode opcode,
+		const std::string& payload,
+		bool isMasked,
+		uint32_t maskKey = 0
+	)
+	{
+		std::string res;
+		res.reserve(2 + 8 + 4 + payload.size());
+
+		// always final, since messages are never fragmented by us
+		res.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+
+		const uint8_t maskBit = isMasked ? 0x80 : 0x00;
+		const uint64_t size = payload.size();
+		if (size < 126)
+		{
+			res.push_back(static_cast<char>(maskBit | size));
+		}
+		else if (size <= 0xFFFF)
+		{
+			res.push_back(static_cast<char>(maskBit | 126));
+			AppendBigEndian(res, size, 2);
+		}
+		else
+		{
+			res.push_back(static_cast<char>(maskBit | 127));
+			AppendBigEndian(res, size, 8);
+		}
+
+		if (!isMasked)
+		{
+			res += payload;
+			return res;
+		}
+
+		std::array<uint8_t, 4> mask;
+		for (size_t i = 0; i < mask.size(); ++i)
+		{
+			mask[i] = static_cast<uint8_t>(maskKey >> (24 - (i * 8)));
+			res.push_back(static_cast<char>(mask[i]));
+		}
+		for (size_t i = 0; i < payload.size(); ++i)
+		{
+			res.push_back(static_cast<char>(
+				static_cast<uint8_t>(payload[i]) ^ mask[i % 4]
+			));
+		}
+		return res;
+	}
+
+	/**
+	 * @brief Decode a frame from the front of the given buffer, which holds
+	 *        the bytes received so far; the bytes of the frame are removed
+	 *        from the buffer
+	 *
+	 * @return true if a whole frame is decoded into `frame`, or false if
+	 *         more bytes are needed
+	 */
+	static bool TryDecode(
+		std::string& buf,
+		WebSocketFrame& frame,
+		size_t maxPayloadSize
+	)
+	{
+		if (buf.size() < 2)
+		{
+			return false;
+		}
+
+		const uint8_t byte0 = static_cast<uint8_t>(buf[0]);
+		const uint8_t byte1 = static_cast<uint8_t>(buf[1]);
+		if ((byte0 & 0x70) != 0)
+		{
+			throw std::runtime_error(
+				"WebSocketFrame - extensions are not supported"
+			);
+		}
+
+		size_t pos = 2;
+		uint64_t size = byte1 & 0x7F;
+		if (size >= 126)
+		{
+			const size_t sizeLen = (size == 126) ? 2 : 8;
+			if (buf.size() < pos + sizeLen)
+			{
+				return false;
+			}
+			size = 0;
+			for (size_t i = 0; i < sizeLen; ++i, ++pos)
+			{
+				size = (size << 8) | static_cast<uint8_t>(buf[pos]);
+			}
+		}
+		if (size > maxPayloadSize)
+		{
+			throw std::runtime_error(
+				"WebSocketFrame - the frame is too large"
+			);
+		}
+
+		const bool isMasked = (byte1 & 0x80) != 0;
+		std::array<uint8_t, 4> mask = { 0, 0, 0, 0 };
+		if (isMasked)
+		{
+			if (buf.size() < pos + mask.size())
+			{
+				return false;
+			}
+			for (size_t i = 0; i < mask.size(); ++i, ++pos)
+			{
+				mask[i] = static_cast<uint8_t>(buf[pos]);
+			}
+		}
+
+		if (buf.size() < pos + size)
+		{
+			return false;
+		}
+
+		frame.m_isFinal = (byte0 & 0x80) != 0;
+		frame.m_opcode = static_cast<WebSocketOpcode>(byte0 & 0x0F);
+		frame.m_payload = buf.substr(pos, static_cast<size_t>(size));
+		if (isMasked)
+		{
+			for (size_t i = 0; i < frame.m_payload.size(); ++i)
+			{
+				frame.m_payload[i] = static_cast<char>(
+					static_cast<uint8_t>(frame.m_payload[i]) ^ mask[i % 4]
+				);
+			}
+		}
+
+		buf.erase(0, pos + static_cast<size_t>(size));
+		return true;
+	}
+
+	/**
+	 * @brief Compute the `Sec-WebSocket-Accept` value of the opening
+	 *        handshake, from the `Sec-WebSocket-Key` of the client
+	 *
+	 */
+	static std::string ComputeAcceptKey(const std::string& clientKey)
+	{
+		static const std::string sk_guid =
+			"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+		const std::string input = clientKey + sk_guid;
+		std::array<uint8_t, 20> digest;
+		if (
+			mbedtls_sha1(
+				reinterpret_cast<const unsigned char*>(input.data()),
+				input.size(),
+				digest.data()
+			) != 0
+		)
+		{
+			throw std::runtime_error(
+				"WebSocketFrame - failed to compute the accept key"
+			);
+		}
+		return SimpleObjects::Codec::Base64::
+			template Encode<std::string>(digest);
+	}
+
+	bool m_isFinal;
+	WebSocketOpcode m_opcode;
+	std::string m_payload;
+
+private:
+
+	static void AppendBigEndian(std::string& dest, uint64_t val, size_t len)
+	{
+		for (size_t i = len; i > 0; --i)
+		{
+			dest.push_back(static_cast<char>(val >> ((i - 1) * 8)));
+		}
+	}
+}; // struct WebSocketFrame
+
+
+} // namespace EthereumClt
@@ -5,7 +5,9 @@
 
 
 #include <sgx_edger8r.h>
+#include <sgx_trts.h>
 
+#include <DecentEnclave/Common/LogBuffer.hpp>
 #include <DecentEnclave/Common/Platform/Print.hpp>
 #include <DecentEnclave/Common/Sgx/MbedTlsInit.hpp>
 
@@ -15,6 +17,7 @@
 #include <DecentEnclave/Trusted/SKeyring.hpp>
 #include <DecentEnclave/Trusted/Sgx/EnclaveIdentity.hpp>
 
+#include <EthereumClt/Common/PipelineMetrics.hpp>
 #include <EthereumClt/Trusted/BlockchainMgr.hpp>
 #include <EthereumClt/Trusted/Pubsub/SubscriberHandler.hpp>
 #include <EthereumClt/Trusted/ReceiptSubscriber.hpp>
@@ -201,6 +204,8 @@ extern "C" sgx_status_t ecall_ethereum_clt_init(
 {
 	using namespace EthereumClt;
 
+	DecentEnclave::Common::LogFlushGuard logFlushGuard;
+
 	try
 	{
 		std::vector<uint8_t> mConfAdvRlp(in_conf, in_conf + in_conf_size);
@@ -252,6 +257,8 @@ extern "C" sgx_status_t ecall_ethereum_clt_recv_block(
 	size_t hdr_size
 )
 {
+	DecentEnclave::Common::LogFlushGuard logFlushGuard;
+
 	try
 	{
 		std::vector<uint8_t> hdrRlp(hdr_rlp, hdr_rlp + hdr_size);
@@ -266,3 +273,26 @@ extern "C" sgx_status_t ecall_ethereum_clt_recv_block(
 		return SGX_ERROR_UNEXPECTED;
 	}
 }
+
+
+extern "C" sgx_status_t ecall_ethereum_clt_bind_metrics(
+	void* metrics_page
+)
+{
+	using namespace EthereumClt;
+
+	// the page is written by the enclave, so it must not overlap with the
+	// enclave's own memory
+	if (
+		(metrics_page == nullptr) ||
+		!sgx_is_outside_enclave(metrics_page, sizeof(Metrics::MetricsPage))
+	)
+	{
+		return SGX_ERROR_INVALID_PARAMETER;
+	}
+
+	Metrics::Registry::GetInstance().Bind(
+		static_cast<Metrics::MetricsPage*>(metrics_page)
+	);
+	return SGX_SUCCESS;
+}
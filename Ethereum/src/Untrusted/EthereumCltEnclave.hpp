@@ -11,6 +11,7 @@
 #include <EclipseMonitor/Eth/DataTypes.hpp>
 #include <EclipseMonitor/MonitorReport.hpp>
 
+#include <EthereumClt/Common/PipelineMetrics.hpp>
 #include <EthereumClt/Untrusted/BlockReceiver.hpp>
 #include <EthereumClt/Untrusted/HostBlockService.hpp>
 
@@ -32,6 +33,11 @@ extern "C" sgx_status_t ecall_ethereum_clt_recv_block(
 	const uint8_t*   blk_data,
 	size_t           blk_size
 );
+extern "C" sgx_status_t ecall_ethereum_clt_bind_metrics(
+	sgx_enclave_id_t eid,
+	sgx_status_t*    retval,
+	void*            metrics_page
+);
 
 
 namespace EthereumClt
@@ -81,6 +87,7 @@ public:
 
 	virtual void RecvBlock(const std::vector<uint8_t>& blockRlp) override
 	{
+		Metrics::StageTimer timer(Metrics::Stage::EcallRecvBlock);
 		DECENTENCLAVE_SGX_ECALL_CHECK_ERROR_E_R(
 			ecall_ethereum_clt_recv_block,
 			m_encId,
@@ -90,6 +97,21 @@ public:
 	}
 
 
+	/**
+	 * @brief Have the enclave record its metrics into the given page, which
+	 *        must outlive the enclave
+	 *
+	 */
+	void BindMetrics(Metrics::MetricsPage& page)
+	{
+		DECENTENCLAVE_SGX_ECALL_CHECK_ERROR_E_R(
+			ecall_ethereum_clt_bind_metrics,
+			m_encId,
+			&page
+		);
+	}
+
+
 private:
 	std::shared_ptr<HostBlockService> m_hostBlockService;
 }; // class EthereumCltEnclave
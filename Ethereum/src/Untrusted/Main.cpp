@@ -13,13 +13,22 @@
 
 #include <DecentEnclave/Untrusted/Config/AuthList.hpp>
 #include <DecentEnclave/Untrusted/Config/EndpointsMgr.hpp>
+#include <DecentEnclave/Untrusted/Config/Executor.hpp>
+#include <DecentEnclave/Untrusted/Config/Logging.hpp>
+#include <DecentEnclave/Untrusted/Config/SharedClock.hpp>
 #include <DecentEnclave/Untrusted/Hosting/BoostAsioService.hpp>
 #include <DecentEnclave/Untrusted/Hosting/HeartbeatEmitterService.hpp>
 #include <DecentEnclave/Untrusted/Hosting/LambdaFuncServer.hpp>
+#include <DecentEnclave/Untrusted/RunUntilSignal.hpp>
+#include <DecentEnclave/Untrusted/SharedClockTicker.hpp>
 
+#include <EthereumClt/Common/PipelineTrace.hpp>
+#include <EthereumClt/Untrusted/BlockCache.hpp>
 #include <EthereumClt/Untrusted/HostBlockServiceTasks.hpp>
+#include <EthereumClt/Untrusted/MetricsServer.hpp>
 
-#include <SimpleConcurrency/Threading/ThreadPool.hpp>
+#include <SimpleConcurrency/Threading/PartitionedExecutor.hpp>
+#include <SimpleConcurrency/Threading/TimerWheel.hpp>
 #include <SimpleJson/SimpleJson.hpp>
 #include <SimpleRlp/SimpleRlp.hpp>
 #include <SimpleObjects/Internal/make_unique.hpp>
@@ -28,7 +37,6 @@
 #include <SimpleSysIO/SysCall/Files.hpp>
 
 #include "EthereumCltEnclave.hpp"
-#include "RunUntilSignal.hpp"
 
 
 using namespace DecentEnclave;
@@ -40,18 +48,11 @@ using namespace SimpleObjects;
 using namespace SimpleSysIO::SysCall;
 
 
-std::shared_ptr<ThreadPool> GetThreadPool()
-{
-	static  std::shared_ptr<ThreadPool> threadPool =
-		std::make_shared<ThreadPool>(5);
-
-	return threadPool;
-}
-
-
 static void StartSendingBlocks(
+	std::shared_ptr<TimerWheel> timerWheel,
 	HostBlockService& blkSvc,
-	uint64_t startBlockNum
+	uint64_t startBlockNum,
+	std::shared_ptr<GethHeadSubscriber> headSubscriber
 )
 {
 	if (blkSvc.GetCurrBlockNum() != 0)
@@ -66,13 +67,28 @@ static void StartSendingBlocks(
 		new HostBlockStatusLogTask(blkSvcSPtr, 10 * 1000)
 	);
 	auto blkUpdSvc = std::unique_ptr<BlockUpdatorServiceTask>(
-		new BlockUpdatorServiceTask(blkSvcSPtr, 1 * 1000)
+		new BlockUpdatorServiceTask(blkSvcSPtr, 1 * 1000, headSubscriber)
 	);
 
-	std::shared_ptr<ThreadPool> threadPool = GetThreadPool();
+	timerWheel->AddTickingTask(std::move(blkUpdStatusSvc));
+	TimerWheel::JobHandle blkUpdJob =
+		timerWheel->AddTickingTask(std::move(blkUpdSvc));
 
-	threadPool->AddTask(std::move(blkUpdStatusSvc));
-	threadPool->AddTask(std::move(blkUpdSvc));
+	if (headSubscriber != nullptr)
+	{
+		// a new head wakes up the updator, instead of it polling for one
+		std::weak_ptr<TimerWheel> weakWheel = timerWheel;
+		headSubscriber->SetHeadCallback(
+			[weakWheel, blkUpdJob](GethHeadSubscriber::BlockNumber)
+			{
+				std::shared_ptr<TimerWheel> wheel = weakWheel.lock();
+				if (wheel != nullptr)
+				{
+					wheel->Wake(blkUpdJob);
+				}
+			}
+		);
+	}
 }
 
 
@@ -100,10 +116,6 @@ int main(int argc, char* argv[])
 	Common::Sgx::MbedTlsInit::Init();
 
 
-	// Thread pool
-	std::shared_ptr<ThreadPool> threadPool = GetThreadPool();
-
-
 	// Read in components config
 	auto configFile = RBinaryFile::Open(configPath);
 	auto configJson = configFile->ReadBytes<std::string>();
@@ -111,6 +123,30 @@ int main(int argc, char* argv[])
 	std::vector<uint8_t> authListAdvRlp = Config::ConfigToAuthListAdvRlp(config);
 
 
+	// Logging (optional)
+	// where the host writes the log messages, and the log levels, which
+	// are applied to the host's loggers here, and to the enclave's once
+	// it's created
+	Config::ConfigureLogWriter(config);
+	const Config::LogLevelList logLevels = Config::ConfigToLogLevels(config);
+	Config::ApplyLogLevels(logLevels);
+
+
+	// Executor
+	// long-running services get dedicated threads, so the worker pool is
+	// left for incoming lambda calls
+	std::shared_ptr<PartitionedExecutor> executor =
+		std::make_shared<PartitionedExecutor>(
+			Config::ConfigToWorkerPoolSize(config, 4),
+			Config::ConfigToTimerPoolSize(config, 2)
+		);
+	// periodic tasks are driven by a timer wheel, which posts their ticks
+	// to the timer pool, instead of each of them sleeping on its own thread;
+	// their ECALLs may be long, so they are kept off the worker pool
+	std::shared_ptr<TimerWheel> timerWheel =
+		TimerWheel::Create(executor->GetTimerPool());
+
+
 	// Boost IO Service
 	std::unique_ptr<Hosting::BoostAsioService> asioService =
 		SimpleObjects::Internal::make_unique<Hosting::BoostAsioService>();
@@ -144,6 +180,47 @@ int main(int argc, char* argv[])
 		HostBlockService::Create(gethUrl);
 
 
+	// Chain head subscription (optional)
+	// new blocks are pushed as soon as Geth has them, instead of being
+	// polled for; polling is still used while the subscription is down
+	std::shared_ptr<GethHeadSubscriber> headSubscriber;
+	if (gethConfig.HasKey(String("WsPort")))
+	{
+		uint32_t gethWsPort = gethConfig[String("WsPort")].AsCppUInt32();
+		headSubscriber = std::make_shared<GethHeadSubscriber>(
+			"ws://" + gethHost + ":" + std::to_string(gethWsPort)
+		);
+	}
+
+
+	// Block cache
+	// headers and receipts already fetched from Geth, e.g., before a
+	// restart, are read from the disk instead
+	if (config.AsDict().HasKey(String("BlockCache")))
+	{
+		const auto& cacheConfig = config.AsDict()[String("BlockCache")].AsDict();
+		std::string cacheDir = cacheConfig[String("Dir")].AsString().c_str();
+		uint64_t cacheMaxSizeMB =
+			cacheConfig[String("MaxSizeMB")].AsCppUInt64();
+		uint64_t cacheConfirmations =
+			cacheConfig[String("Confirmations")].AsCppUInt64();
+		auto cache = std::make_shared<BlockCache>(
+			cacheDir,
+			cacheMaxSizeMB * 1024 * 1024,
+			BlockCache::sk_defBlocksPerRange,
+			cacheConfirmations
+		);
+		if (cache->IsReadOnly())
+		{
+			Common::Platform::Print::StrInfo(
+				"Block cache at " + cacheDir + " is written by another "
+				"client; it's used read-only"
+			);
+		}
+		hostBlkSvc->EnableCache(cache);
+	}
+
+
 	// Pubsub configs
 	const auto& pubsubConfig = config.AsDict()[String("PubSub")].AsDict();
 	std::string pubsubAddrHex = pubsubConfig[String("PubSubAddr")].AsString().c_str();
@@ -157,6 +234,21 @@ int main(int argc, char* argv[])
 	std::copy(pubsubAddrBytes.begin(), pubsubAddrBytes.end(), pubsubAddr.begin());
 
 
+	// Shared clock
+	// the enclave reads the time for every header and heartbeat, so it's
+	// read from a page ticked by the host, instead of an OCALL each time
+	const uint64_t clockTickMicroSec =
+		Config::ConfigToSharedClockTick(config, 1000);
+	std::unique_ptr<SharedClockTicker> clockTicker;
+	if (clockTickMicroSec != 0)
+	{
+		clockTicker =
+			SimpleObjects::Internal::make_unique<SharedClockTicker>(
+				clockTickMicroSec
+			);
+	}
+
+
 	// Enclave
 	const auto& imgConfig = config.AsDict()[String("EnclaveImage")].AsDict();
 	std::string imgPath = imgConfig[String("ImagePath")].AsString().c_str();
@@ -173,14 +265,63 @@ int main(int argc, char* argv[])
 			imgPath,
 			tokenPath
 		);
+	if (clockTicker != nullptr)
+	{
+		enclave->BindSharedClock(clockTicker->GetPage());
+	}
+	for (const auto& logLevel : logLevels)
+	{
+		enclave->SetLogLevel(logLevel.first, logLevel.second);
+	}
 	hostBlkSvc->BindReceiver(enclave);
-	StartSendingBlocks(*hostBlkSvc, startBlockNum);
+
+
+	// Metrics
+	std::unique_ptr<Metrics::MetricsServer> metricsSvr;
+	if (config.AsDict().HasKey(String("Metrics")))
+	{
+		// the enclave times its stages against the shared clock
+		if (clockTicker == nullptr)
+		{
+			throw std::runtime_error(
+				"Metrics need the shared clock to be enabled."
+			);
+		}
+
+		const auto& metricsConfig = config.AsDict()[String("Metrics")].AsDict();
+		std::string metricsIp = metricsConfig[String("IP")].AsString().c_str();
+		uint16_t metricsPort = static_cast<uint16_t>(
+			metricsConfig[String("Port")].AsCppUInt32()
+		);
+		uint64_t traceSampleInterval =
+			metricsConfig[String("TraceSampleInterval")].AsCppUInt64();
+
+		// the enclave records into the same page as the host, so the
+		// exporter can read both sides without any ECALL
+		Metrics::MetricsPage& metricsPage =
+			Metrics::Registry::GetInstance().GetPage();
+		metricsSvr = SimpleObjects::Internal::make_unique<Metrics::MetricsServer>(
+			metricsPage,
+			metricsIp,
+			metricsPort
+		);
+		enclave->BindMetrics(metricsPage);
+		Metrics::Tracer::GetInstance().SetSampleInterval(traceSampleInterval);
+	}
+
+
+	StartSendingBlocks(
+		timerWheel,
+		*hostBlkSvc,
+		startBlockNum,
+		headSubscriber
+	);
 
 
 	// API call server
 	Hosting::LambdaFuncServer lambdaFuncSvr(
 		endpointMgr,
-		threadPool
+		executor
 	);
 	// Setup Lambda call handlers and start to run multi-threaded-ly
 	lambdaFuncSvr.AddFunction("EthereumClt", enclave);
@@ -190,23 +331,33 @@ int main(int argc, char* argv[])
 	auto heartbeatEmitter = std::unique_ptr<Hosting::HeartbeatEmitterService>(
 		new Hosting::HeartbeatEmitterService(enclave, 100)
 	);
-	threadPool->AddTask(std::move(heartbeatEmitter));
+	timerWheel->AddTickingTask(std::move(heartbeatEmitter));
 
 
 	// Start IO service
-	threadPool->AddTask(std::move(asioService));
+	executor->AddServiceTask(std::move(asioService));
 
 
 	RunUntilSignal(
 		[&]()
 		{
-			threadPool->Update();
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			executor->WaitAndUpdate();
+		},
+		[&]()
+		{
+			executor->WakeUp();
 		}
 	);
 
 
-	threadPool->Terminate();
+	// the ticking tasks are terminated with the wheel, before the executor
+	// joins the threads that may be running their ticks
+	timerWheel->Terminate();
+	executor->Terminate();
+	if (metricsSvr != nullptr)
+	{
+		metricsSvr->Stop();
+	}
 
 
 	return 0;
@@ -220,17 +371,12 @@ extern "C" sgx_status_t ocall_ethereum_clt_get_receipts(
 	size_t* out_buf_size
 )
 {
-	using _ListBytesType = SimpleObjects::ListT<SimpleObjects::Bytes>;
-
 	const HostBlockService* blkSvc =
 		static_cast<const HostBlockService*>(host_blk_svc);
 
 	try
 	{
-		_ListBytesType listOfReceipts =
-			blkSvc->GetReceiptsRlpByNum<_ListBytesType>(blk_num);
-
-		std::vector<uint8_t> bytes = SimpleRlp::WriteRlp(listOfReceipts);
+		std::vector<uint8_t> bytes = blkSvc->GetReceiptsListRlpByNum(blk_num);
 
 		*out_buf = new uint8_t[bytes.size()];
 		*out_buf_size = bytes.size();
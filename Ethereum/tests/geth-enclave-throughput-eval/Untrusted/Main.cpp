@@ -14,6 +14,8 @@
 #include <DecentEnclave/Common/Sgx/MbedTlsInit.hpp>
 #include <DecentEnclave/Untrusted/Config/AuthList.hpp>
 
+#include <EthereumClt/Untrusted/BlockCorpusReplayer.hpp>
+#include <EthereumClt/Untrusted/GethStandInServer.hpp>
 #include <EthereumClt/Untrusted/HostBlockService.hpp>
 
 #include <SimpleJson/SimpleJson.hpp>
@@ -67,15 +69,85 @@ int main(int argc, char* argv[])
 	auto config = SimpleJson::LoadStr(configJson);
 
 
+	// Block corpus (optional)
+	//   "Capture": blocks are fetched from Geth, and recorded into the corpus
+	//   "Replay":  blocks are read from the corpus, without Geth
+	//   "StandIn": blocks are fetched from a local stand-in of Geth that
+	//              serves the corpus, with the optional RPC conditions in
+	//              "StandIn"
+	std::string corpusMode;
+	std::string corpusPath;
+	GethStandInServer::Config standInConfig;
+	if (config.AsDict().HasKey(String("BlockCorpus")))
+	{
+		const auto& corpusConfig =
+			config.AsDict()[String("BlockCorpus")].AsDict();
+		corpusMode = corpusConfig[String("Mode")].AsString().c_str();
+		corpusPath = corpusConfig[String("Path")].AsString().c_str();
+		if (
+			corpusMode != "Capture" &&
+			corpusMode != "Replay" &&
+			corpusMode != "StandIn"
+		)
+		{
+			Common::Platform::Print::StrErr(
+				"Unknown block corpus mode: " + corpusMode
+			);
+			return -1;
+		}
+
+		if (corpusConfig.HasKey(String("StandIn")))
+		{
+			const auto& rpcConfig = corpusConfig[String("StandIn")].AsDict();
+			standInConfig.m_latencyMilSec =
+				rpcConfig[String("LatencyMilSec")].AsCppUInt64();
+			standInConfig.m_latencyJitterMilSec =
+				rpcConfig[String("LatencyJitterMilSec")].AsCppUInt64();
+			standInConfig.m_bandwidthBytesPerSec =
+				rpcConfig[String("BandwidthBytesPerSec")].AsCppUInt64();
+			standInConfig.m_httpErrorRate =
+				rpcConfig[String("HttpErrorRate")].AsCppDouble();
+			standInConfig.m_rpcErrorRate =
+				rpcConfig[String("RpcErrorRate")].AsCppDouble();
+		}
+	}
+
+
 	// Host block service
-	const auto& gethConfig = config.AsDict()[String("Geth")].AsDict();
-	std::string gethProto = gethConfig[String("Protocol")].AsString().c_str();
-	std::string gethHost = gethConfig[String("Host")].AsString().c_str();
-	uint32_t gethPort = gethConfig[String("Port")].AsCppUInt32();
-	std::string gethUrl =
-		gethProto + "://" + gethHost + ":" + std::to_string(gethPort);
-	std::shared_ptr<HostBlockService> hostBlkSvc =
-		HostBlockService::Create(gethUrl);
+	std::shared_ptr<HostBlockService> hostBlkSvc;
+	std::shared_ptr<BlockCorpusReader> corpusReader;
+	std::shared_ptr<BlockCorpusWriter> corpusWriter;
+	std::unique_ptr<GethStandInServer> standInServer;
+	if (corpusMode == "Replay")
+	{
+		corpusReader = std::make_shared<BlockCorpusReader>(corpusPath);
+		hostBlkSvc = HostBlockService::CreateReplay(corpusReader);
+	}
+	else if (corpusMode == "StandIn")
+	{
+		standInServer = SimpleObjects::Internal::make_unique<GethStandInServer>(
+			std::make_shared<BlockCorpusReader>(corpusPath),
+			standInConfig
+		);
+		hostBlkSvc = HostBlockService::Create(standInServer->GetUrl());
+	}
+	else
+	{
+		const auto& gethConfig = config.AsDict()[String("Geth")].AsDict();
+		std::string gethProto =
+			gethConfig[String("Protocol")].AsString().c_str();
+		std::string gethHost = gethConfig[String("Host")].AsString().c_str();
+		uint32_t gethPort = gethConfig[String("Port")].AsCppUInt32();
+		std::string gethUrl =
+			gethProto + "://" + gethHost + ":" + std::to_string(gethPort);
+		hostBlkSvc = HostBlockService::Create(gethUrl);
+
+		if (corpusMode == "Capture")
+		{
+			corpusWriter = std::make_shared<BlockCorpusWriter>(corpusPath);
+			hostBlkSvc->EnableCapture(corpusWriter);
+		}
+	}
 
 	// Test configurations
 	std::vector<double> receiptRates = {
@@ -108,6 +180,54 @@ int main(int argc, char* argv[])
 	hostBlkSvc->BindReceiver(enclave);
 
 
+	if (corpusWriter != nullptr)
+	{
+		// a single pass records every block in the range
+		enclave->SetReceiptRate(0.00);
+		for (auto i = startBlockNum; i < endBlockNum; ++i)
+		{
+			hostBlkSvc->PushBlock(i);
+		}
+		corpusWriter->Finish();
+
+		std::cout
+			<< "Captured:   " << corpusWriter->GetNumOfBlocks() << " blocks"
+			<< std::endl
+			<< "Corpus:     " << corpusPath << std::endl;
+		return 0;
+	}
+
+
+	if (corpusReader != nullptr)
+	{
+		BlockCorpusReplayer replayer(corpusReader);
+
+		for (const double& receiptRate: receiptRates)
+		{
+			enclave->SetReceiptRate(receiptRate);
+
+			auto stats = replayer.Replay(*enclave, startBlockNum, endBlockNum);
+
+			std::cout
+				<< "Receipt %:  " << receiptRate * 100 << "%" << std::endl
+				<< "Pushed:     " << stats.GetNumOfBlocks() << " blocks"
+				<< std::endl
+				<< "Took:       " << (stats.m_totalNanoSec / 1e9) << " seconds"
+				<< std::endl
+				<< "Throughput: " << stats.GetBlocksPerSec()
+				<< " blocks / second" << std::endl
+				<< "Latency:    "
+				<< "p50=" << (stats.GetLatencyNanoSec(50) / 1e3) << "us, "
+				<< "p99=" << (stats.GetLatencyNanoSec(99) / 1e3) << "us, "
+				<< "max=" << (stats.GetLatencyNanoSec(100) / 1e3) << "us"
+				<< std::endl;
+		}
+		enclave->SetReceiptRate(0.00);
+
+		return 0;
+	}
+
+
 	for (const double& receiptRate: receiptRates)
 	{
 		enclave->SetReceiptRate(receiptRate);
@@ -115,7 +235,31 @@ int main(int argc, char* argv[])
 		auto start = TimeNow();
 		for (auto i = startBlockNum; i < endBlockNum; ++i)
 		{
-			hostBlkSvc->PushBlock(i);
+			if (standInServer == nullptr)
+			{
+				hostBlkSvc->PushBlock(i);
+				continue;
+			}
+
+			// the stand-in may inject errors; retry the block on those,
+			// like the block updator does
+			while (true)
+			{
+				const auto numOfErrors =
+					standInServer->GetNumOfInjectedErrors();
+				try
+				{
+					hostBlkSvc->PushBlock(i);
+					break;
+				}
+				catch(const std::exception&)
+				{
+					if (standInServer->GetNumOfInjectedErrors() == numOfErrors)
+					{
+						throw;
+					}
+				}
+			}
 		}
 		auto end = TimeNow();
 		auto duration = end - start;
@@ -130,6 +274,14 @@ int main(int argc, char* argv[])
 	}
 	enclave->SetReceiptRate(0.00);
 
+	if (standInServer != nullptr)
+	{
+		std::cout
+			<< "Requests:   " << standInServer->GetNumOfRequests()
+			<< " (" << standInServer->GetNumOfInjectedErrors()
+			<< " injected errors)" << std::endl;
+	}
+
 
 	return 0;
 }
@@ -142,17 +294,12 @@ extern "C" sgx_status_t ocall_ethereum_clt_get_receipts(
 	size_t* out_buf_size
 )
 {
-	using _ListBytesType = SimpleObjects::ListT<SimpleObjects::Bytes>;
-
 	const HostBlockService* blkSvc =
 		static_cast<const HostBlockService*>(host_blk_svc);
 
 	try
 	{
-		_ListBytesType listOfReceipts =
-			blkSvc->GetReceiptsRlpByNum<_ListBytesType>(blk_num);
-
-		std::vector<uint8_t> bytes = SimpleRlp::WriteRlp(listOfReceipts);
+		std::vector<uint8_t> bytes = blkSvc->GetReceiptsListRlpByNum(blk_num);
 
 		*out_buf = new uint8_t[bytes.size()];
 		*out_buf_size = bytes.size();
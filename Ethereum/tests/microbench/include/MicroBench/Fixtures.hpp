@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <EclipseMonitor/Eth/ChainGenerator.hpp>
+#include <SimpleObjects/Codec/Hex.hpp>
+
+
+namespace MicroBench
+{
+
+
+/**
+ * @brief Inputs shared by the benchmarks, taken from a synthetic chain, so
+ *        every run of every library works on the same bytes
+ *
+ */
+struct Fixtures
+{
+	using ChainGen =
+		EclipseMonitor::Eth::ChainGenerator<
+			EclipseMonitor::Eth::SyntheticPoWConfig
+		>;
+
+	static const Fixtures& GetInstance()
+	{
+		static const Fixtures sk_inst;
+		return sk_inst;
+	}
+
+	static std::string BuildRpcResponse(const std::vector<uint8_t>& bytes)
+	{
+		return
+			"{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"" +
+			SimpleObjects::Codec::Hex::template Encode<std::string>(
+				bytes,
+				"0x"
+			) +
+			"\"}";
+	}
+
+	Fixtures() :
+		m_header(),
+		m_receipts(),
+		m_receiptsListRlp(),
+		m_headerRpcResp(),
+		m_receiptsRpcResp(),
+		m_contractAddr(),
+		m_eventTopic()
+	{
+		ChainGen::Config config;
+		// about the size of a busy mainnet block
+		config.m_receiptsPerBlock = 200;
+		config.m_logsPerReceipt = 2;
+		config.m_topicsPerLog = 3;
+		config.m_logDataSize = 64;
+		config.m_seed = 1;
+
+		ChainGen chainGen(config);
+		const auto block = chainGen.Next().front();
+
+		m_header = block.m_header;
+		m_receipts = block.m_receipts;
+
+		const auto receiptsList = block.GetReceiptsList();
+		m_receiptsListRlp = EclipseMonitor::Internal::Rlp::WriteRlp(
+			receiptsList
+		);
+
+		m_headerRpcResp = BuildRpcResponse(m_header);
+		m_receiptsRpcResp = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":[";
+		for (size_t i = 0; i < m_receipts.size(); ++i)
+		{
+			m_receiptsRpcResp += (i == 0 ? "\"" : ",\"");
+			m_receiptsRpcResp +=
+				SimpleObjects::Codec::Hex::template Encode<std::string>(
+					m_receipts[i],
+					"0x"
+				);
+			m_receiptsRpcResp += "\"";
+		}
+		m_receiptsRpcResp += "]}";
+
+		m_contractAddr = chainGen.GetContractAddr(0);
+		m_eventTopic = chainGen.GetEventTopic(0);
+	}
+
+	std::vector<uint8_t> m_header;
+	std::vector<std::vector<uint8_t> > m_receipts;
+	std::vector<uint8_t> m_receiptsListRlp;
+
+	std::string m_headerRpcResp;
+	std::string m_receiptsRpcResp;
+
+	EclipseMonitor::Eth::ContractAddr m_contractAddr;
+	EclipseMonitor::Eth::EventTopic m_eventTopic;
+}; // struct Fixtures
+
+
+} // namespace MicroBench
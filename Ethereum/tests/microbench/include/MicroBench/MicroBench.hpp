@@ -0,0 +1,416 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <SimpleJson/SimpleJson.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
+
+
+namespace MicroBench
+{
+
+
+/**
+ * @brief Keep the compiler from optimizing away the computation of the given
+ *        value
+ *
+ */
+template<typename _T>
+inline void DoNotOptimize(const _T& val)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(val) : "memory");
+#else
+	static volatile const void* s_sink = nullptr;
+	s_sink = &val;
+#endif
+}
+
+
+/**
+ * @brief A benchmark body runs the operation under test the given number of
+ *        times
+ *
+ */
+using BenchFunc = std::function<void(size_t)>;
+
+
+struct BenchCase
+{
+	std::string m_name;
+	BenchFunc m_func;
+	/**
+	 * @brief Number of input bytes processed by one operation, or 0 if
+	 *        throughput doesn't apply
+	 *
+	 */
+	size_t m_bytesPerOp;
+}; // struct BenchCase
+
+
+struct BenchResult
+{
+	std::string m_name;
+	uint64_t m_iterations;
+	double m_nsPerOp;
+	double m_mbPerSec;
+}; // struct BenchResult
+
+
+class Registry
+{
+public:
+
+	Registry(std::string libName) :
+		m_libName(std::move(libName)),
+		m_cases()
+	{}
+
+	~Registry() = default;
+
+	void Add(std::string name, BenchFunc func, size_t bytesPerOp = 0)
+	{
+		m_cases.push_back(BenchCase{ std::move(name), std::move(func), bytesPerOp });
+	}
+
+	const std::string& GetLibName() const
+	{
+		return m_libName;
+	}
+
+	const std::vector<BenchCase>& GetCases() const
+	{
+		return m_cases;
+	}
+
+private:
+
+	std::string m_libName;
+	std::vector<BenchCase> m_cases;
+}; // class Registry
+
+
+struct RunConfig
+{
+	RunConfig() :
+		m_filter(),
+		m_outPath(),
+		m_baselinePath(),
+		m_threshold(10.0),
+		m_minTimeMs(200),
+		m_repetitions(5)
+	{}
+
+	std::string m_filter;
+	std::string m_outPath;
+	std::string m_baselinePath;
+	/**
+	 * @brief Allowed slowdown against the baseline, in percent
+	 *
+	 */
+	double m_threshold;
+	uint64_t m_minTimeMs;
+	size_t m_repetitions;
+}; // struct RunConfig
+
+
+namespace Internal
+{
+
+
+inline double TimeRunNs(const BenchFunc& func, size_t iterations)
+{
+	auto start = std::chrono::steady_clock::now();
+	func(iterations);
+	auto end = std::chrono::steady_clock::now();
+	return static_cast<double>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			end - start
+		).count()
+	);
+}
+
+
+/**
+ * @brief Grow the number of iterations until one run takes at least
+ *        the given time, then report the median of the repetitions
+ *
+ */
+inline BenchResult RunCase(const BenchCase& benchCase, const RunConfig& config)
+{
+	const double minTimeNs = static_cast<double>(config.m_minTimeMs) * 1e6;
+
+	// warm up and calibrate
+	size_t iterations = 1;
+	double elapsedNs = TimeRunNs(benchCase.m_func, iterations);
+	while (elapsedNs < minTimeNs && iterations < (size_t(1) << 40))
+	{
+		const double scale = (elapsedNs <= 0.0) ?
+			10.0 :
+			std::min(10.0, std::max(1.5, (minTimeNs * 1.2) / elapsedNs));
+		iterations = static_cast<size_t>(iterations * scale) + 1;
+		elapsedNs = TimeRunNs(benchCase.m_func, iterations);
+	}
+
+	std::vector<double> nsPerOps;
+	nsPerOps.reserve(config.m_repetitions);
+	for (size_t i = 0; i < config.m_repetitions; ++i)
+	{
+		nsPerOps.push_back(
+			TimeRunNs(benchCase.m_func, iterations) / iterations
+		);
+	}
+	std::sort(nsPerOps.begin(), nsPerOps.end());
+	const double nsPerOp = nsPerOps.empty() ?
+		(elapsedNs / iterations) :
+		nsPerOps[nsPerOps.size() / 2];
+
+	BenchResult res;
+	res.m_name = benchCase.m_name;
+	res.m_iterations = iterations;
+	res.m_nsPerOp = nsPerOp;
+	res.m_mbPerSec = (benchCase.m_bytesPerOp == 0 || nsPerOp <= 0.0) ?
+		0.0 :
+		(benchCase.m_bytesPerOp / nsPerOp) * 1e9 / (1024.0 * 1024.0);
+	return res;
+}
+
+
+inline std::string ReadFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error("Failed to open file " + path);
+	}
+	return std::string(
+		(std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>()
+	);
+}
+
+
+inline void WriteFile(const std::string& path, const std::string& content)
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error("Failed to open file " + path);
+	}
+	file << content;
+}
+
+
+/**
+ * @brief Results are stored as
+ *        {"Library": name, "Results": {case: {"NsPerOp", "MBPerSec",
+ *        "Iterations"}}}
+ *
+ */
+inline std::string ResultsToJson(
+	const std::string& libName,
+	const std::vector<BenchResult>& results
+)
+{
+	SimpleObjects::Dict resDict;
+	for (const auto& res : results)
+	{
+		SimpleObjects::Dict item;
+		item[SimpleObjects::String("Iterations")] =
+			SimpleObjects::UInt64(res.m_iterations);
+		item[SimpleObjects::String("NsPerOp")] =
+			SimpleObjects::Double(res.m_nsPerOp);
+		item[SimpleObjects::String("MBPerSec")] =
+			SimpleObjects::Double(res.m_mbPerSec);
+		resDict[SimpleObjects::String(res.m_name)] = std::move(item);
+	}
+
+	SimpleObjects::Dict root;
+	root[SimpleObjects::String("Library")] = SimpleObjects::String(libName);
+	root[SimpleObjects::String("Results")] = std::move(resDict);
+
+	SimpleJson::WriterConfig config;
+	config.m_indent = "\t";
+	config.m_orderDict = true;
+	return SimpleJson::DumpStr(root, config);
+}
+
+
+/**
+ * @brief Compare the results against the baseline file
+ *
+ * @return The number of cases slower than the baseline by more than the
+ *         threshold
+ */
+inline size_t CompareToBaseline(
+	const std::vector<BenchResult>& results,
+	const RunConfig& config
+)
+{
+	const auto baseline = SimpleJson::LoadStr(
+		ReadFile(config.m_baselinePath)
+	);
+	const auto& baseResults =
+		baseline.AsDict()[SimpleObjects::String("Results")].AsDict();
+
+	size_t numOfRegressions = 0;
+	std::cout << std::endl << "Compared to baseline "
+		<< config.m_baselinePath << " (threshold "
+		<< config.m_threshold << "%):" << std::endl;
+	for (const auto& res : results)
+	{
+		const SimpleObjects::String name(res.m_name);
+		if (!baseResults.HasKey(name))
+		{
+			std::cout << "  " << std::left << std::setw(40) << res.m_name
+				<< " new" << std::endl;
+			continue;
+		}
+
+		const double baseNsPerOp = baseResults[name].AsDict()
+			[SimpleObjects::String("NsPerOp")].AsRealNum().AsCppDouble();
+		const double change = (baseNsPerOp <= 0.0) ?
+			0.0 :
+			((res.m_nsPerOp - baseNsPerOp) / baseNsPerOp) * 100.0;
+		const bool isRegression = change > config.m_threshold;
+		numOfRegressions += isRegression ? 1 : 0;
+
+		std::cout << "  " << std::left << std::setw(40) << res.m_name
+			<< std::right << std::showpos << std::fixed
+			<< std::setprecision(1) << std::setw(8) << change << "%"
+			<< std::noshowpos
+			<< (isRegression ? "  REGRESSION" : "") << std::endl;
+	}
+	return numOfRegressions;
+}
+
+
+inline RunConfig ParseArgs(int argc, char* argv[])
+{
+	RunConfig config;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (i + 1 >= argc)
+		{
+			throw std::invalid_argument("Missing value for " + arg);
+		}
+		const std::string val = argv[++i];
+
+		if (arg == "--filter")
+		{
+			config.m_filter = val;
+		}
+		else if (arg == "--out")
+		{
+			config.m_outPath = val;
+		}
+		else if (arg == "--baseline")
+		{
+			config.m_baselinePath = val;
+		}
+		else if (arg == "--threshold")
+		{
+			config.m_threshold = std::stod(val);
+		}
+		else if (arg == "--min-time-ms")
+		{
+			config.m_minTimeMs = std::stoull(val);
+		}
+		else if (arg == "--repetitions")
+		{
+			config.m_repetitions = std::stoull(val);
+		}
+		else
+		{
+			throw std::invalid_argument("Unknown option " + arg);
+		}
+	}
+	return config;
+}
+
+
+} // namespace Internal
+
+
+/**
+ * @brief Run the registered benchmarks, according to the command line
+ *        options:
+ *        --filter <substr>, --out <json path>, --baseline <json path>,
+ *        --threshold <percent>, --min-time-ms <ms>, --repetitions <n>
+ *
+ * @return 0 on success, 1 if any benchmark regressed beyond the threshold,
+ *         or 2 on error
+ */
+inline int Main(const Registry& registry, int argc, char* argv[])
+{
+	try
+	{
+		const RunConfig config = Internal::ParseArgs(argc, argv);
+
+		std::cout << registry.GetLibName() << " benchmarks:" << std::endl;
+		std::vector<BenchResult> results;
+		for (const auto& benchCase : registry.GetCases())
+		{
+			if (
+				!config.m_filter.empty() &&
+				benchCase.m_name.find(config.m_filter) == std::string::npos
+			)
+			{
+				continue;
+			}
+
+			results.push_back(Internal::RunCase(benchCase, config));
+			const auto& res = results.back();
+			std::cout << "  " << std::left << std::setw(40) << res.m_name
+				<< std::right << std::fixed << std::setprecision(1)
+				<< std::setw(14) << res.m_nsPerOp << " ns/op";
+			if (res.m_mbPerSec > 0.0)
+			{
+				std::cout << std::setw(12) << res.m_mbPerSec << " MB/s";
+			}
+			std::cout << std::endl;
+		}
+
+		if (!config.m_outPath.empty())
+		{
+			Internal::WriteFile(
+				config.m_outPath,
+				Internal::ResultsToJson(registry.GetLibName(), results)
+			);
+		}
+
+		if (!config.m_baselinePath.empty())
+		{
+			return Internal::CompareToBaseline(results, config) == 0 ? 0 : 1;
+		}
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 2;
+	}
+}
+
+
+} // namespace MicroBench
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <DecentEnclave/Common/AesGcmPackager.hpp>
+#include <DecentEnclave/Common/Platform/AesGcm.hpp>
+#include <mbedTLScpp/DefaultRbg.hpp>
+
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+using PackagerType = DecentEnclave::Common::AesGcmPackager<
+	DecentEnclave::Common::Platform::AesGcmOneGoNative<128>
+>;
+
+
+void AddPackagerBenchmarks(
+	MicroBench::Registry& registry,
+	const std::string& name,
+	size_t dataSize
+)
+{
+	// same block size as the one used by AesGcmStreamSocket
+	static constexpr size_t sk_packBlockSize = 128;
+
+	auto rand = std::make_shared<mbedTLScpp::DefaultRbg>();
+	auto packager = std::make_shared<PackagerType>(
+		PackagerType::KeyType(),
+		sk_packBlockSize
+	);
+	auto data = std::make_shared<std::vector<uint8_t> >(dataSize, 0x5AU);
+	auto addData = std::make_shared<std::vector<uint8_t> >(24, 0x01U);
+
+	registry.Add(
+		"AesGcmPackager/Pack/" + name,
+		[rand, packager, data, addData](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					packager->Pack(
+						mbedTLScpp::CtnFullR(mbedTLScpp::gsk_emptyCtn),
+						mbedTLScpp::CtnFullR(mbedTLScpp::gsk_emptyCtn),
+						mbedTLScpp::CtnFullR(*data),
+						mbedTLScpp::CtnFullR(*addData),
+						*rand
+					)
+				);
+			}
+		},
+		dataSize
+	);
+
+	auto package = std::make_shared<std::vector<uint8_t> >(
+		packager->Pack(
+			mbedTLScpp::CtnFullR(mbedTLScpp::gsk_emptyCtn),
+			mbedTLScpp::CtnFullR(mbedTLScpp::gsk_emptyCtn),
+			mbedTLScpp::CtnFullR(*data),
+			mbedTLScpp::CtnFullR(*addData),
+			*rand
+		).first
+	);
+
+	registry.Add(
+		"AesGcmPackager/Unpack/" + name,
+		[packager, package, addData](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					packager->Unpack(
+						mbedTLScpp::CtnFullR(*package),
+						mbedTLScpp::CtnFullR(*addData),
+						nullptr
+					)
+				);
+			}
+		},
+		dataSize
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	MicroBench::Registry registry("DecentEnclave");
+	// a heartbeat-sized message and a large block of receipts
+	AddPackagerBenchmarks(registry, "1KiB", 1024);
+	AddPackagerBenchmarks(registry, "64KiB", 64 * 1024);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <EclipseMonitor/Eth/AbiParser.hpp>
+#include <EclipseMonitor/Eth/BloomFilter.hpp>
+#include <EclipseMonitor/Eth/HeaderMgr.hpp>
+#include <EclipseMonitor/Eth/Keccak256.hpp>
+#include <EclipseMonitor/Eth/ReceiptsMgr.hpp>
+
+#include <MicroBench/Fixtures.hpp>
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+void AddHeaderBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	const auto& header = fixtures.m_header;
+	registry.Add(
+		"Keccak256/Header",
+		[&header](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					EclipseMonitor::Eth::Keccak256(header)
+				);
+			}
+		},
+		header.size()
+	);
+
+	registry.Add(
+		"HeaderMgr/ParseAndHash",
+		[&header](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					EclipseMonitor::Eth::HeaderMgr(header, 0)
+				);
+			}
+		},
+		header.size()
+	);
+}
+
+
+void AddReceiptBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	auto receipts = std::make_shared<SimpleObjects::List>();
+	size_t totalSize = 0;
+	for (const auto& receipt : fixtures.m_receipts)
+	{
+		receipts->push_back(SimpleObjects::Bytes(receipt));
+		totalSize += receipt.size();
+	}
+
+	// parses every receipt and builds the receipts trie
+	registry.Add(
+		"ReceiptsMgr/ParseAndRoot",
+		[receipts](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				EclipseMonitor::Eth::ReceiptsMgr mgr(*receipts);
+				MicroBench::DoNotOptimize(mgr.GetRootHashBytes());
+			}
+		},
+		totalSize
+	);
+
+	registry.Add(
+		"PatriciaTrie/ReceiptsRoot",
+		[receipts](size_t n)
+		{
+			using _IntWriter = EclipseMonitor::Internal::Rlp::
+				EncodePrimitiveIntValue<
+					uint64_t,
+					EclipseMonitor::Internal::Rlp::Endian::native,
+					false
+				>;
+			using _KeyRlpWriter = EclipseMonitor::Internal::Rlp::
+				WriterBytesImpl<std::vector<uint8_t> >;
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				EclipseMonitor::Eth::Trie::PatriciaTrie trie;
+				SimpleObjects::Bytes keyBigEndian;
+				for (size_t j = 0; j < receipts->size(); ++j)
+				{
+					keyBigEndian.resize(0);
+					_IntWriter::Encode(j, std::back_inserter(keyBigEndian));
+					trie.Put(
+						_KeyRlpWriter::Write(keyBigEndian),
+						(*receipts)[j].AsBytes()
+					);
+				}
+				MicroBench::DoNotOptimize(trie.Hash());
+			}
+		},
+		totalSize
+	);
+}
+
+
+void AddEventBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	EclipseMonitor::Eth::HeaderMgr headerMgr(fixtures.m_header, 0);
+	const auto bloom = std::make_shared<EclipseMonitor::Eth::BloomFilter>(
+		headerMgr.GetRawHeader().get_LogsBloom()
+	);
+	const auto& addr = fixtures.m_contractAddr;
+	const auto& topic = fixtures.m_eventTopic;
+
+	registry.Add(
+		"BloomFilter/IsEventInBloom",
+		[bloom, &addr, &topic](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(bloom->IsEventInBloom(addr, topic));
+			}
+		}
+	);
+
+	// ABI encoded `bytes`: offset, length, then the padded data
+	static constexpr size_t sk_dataSize = 256;
+	std::vector<uint8_t> abiData(32 + 32 + sk_dataSize, 0);
+	abiData[31] = 0x20U;
+	abiData[62] = static_cast<uint8_t>(sk_dataSize >> 8);
+	abiData[63] = static_cast<uint8_t>(sk_dataSize & 0xFFU);
+	const auto abiBytes = std::make_shared<SimpleObjects::Bytes>(abiData);
+
+	registry.Add(
+		"AbiParser/DecodeBytes",
+		[abiBytes](size_t n)
+		{
+			using _BytesParser = EclipseMonitor::Eth::AbiParser<
+				SimpleObjects::ObjCategory::Bytes,
+				std::true_type
+			>;
+			for (size_t i = 0; i < n; ++i)
+			{
+				auto abiBegin = abiBytes->begin();
+				auto abiEnd = abiBytes->end();
+				MicroBench::DoNotOptimize(
+					_BytesParser().ToPrimitive(abiBegin, abiEnd, abiBegin)
+				);
+			}
+		},
+		abiData.size()
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	MicroBench::Registry registry("EclipseMonitor");
+	AddHeaderBenchmarks(registry);
+	AddReceiptBenchmarks(registry);
+	AddEventBenchmarks(registry);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <SimpleJson/SimpleJson.hpp>
+
+#include <MicroBench/Fixtures.hpp>
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+void AddLoadBenchmark(
+	MicroBench::Registry& registry,
+	const std::string& name,
+	const std::string& json
+)
+{
+	registry.Add(
+		name,
+		[&json](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleJson::LoadStr(json));
+			}
+		},
+		json.size()
+	);
+}
+
+
+void AddDumpBenchmark(
+	MicroBench::Registry& registry,
+	const std::string& name,
+	const std::string& json
+)
+{
+	const auto obj = std::make_shared<SimpleObjects::Object>(
+		SimpleJson::LoadStr(json)
+	);
+	registry.Add(
+		name,
+		[obj](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleJson::DumpStr(*obj));
+			}
+		},
+		json.size()
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	MicroBench::Registry registry("SimpleJson");
+	AddLoadBenchmark(
+		registry, "Load/HeaderResponse", fixtures.m_headerRpcResp
+	);
+	AddLoadBenchmark(
+		registry, "Load/ReceiptsResponse", fixtures.m_receiptsRpcResp
+	);
+	AddDumpBenchmark(
+		registry, "Dump/HeaderResponse", fixtures.m_headerRpcResp
+	);
+	AddDumpBenchmark(
+		registry, "Dump/ReceiptsResponse", fixtures.m_receiptsRpcResp
+	);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <SimpleObjects/Codec/Hex.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#include <MicroBench/Fixtures.hpp>
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+void AddObjectBenchmarks(MicroBench::Registry& registry)
+{
+	static constexpr size_t sk_numOfKeys = 64;
+
+	auto keys = std::make_shared<std::vector<SimpleObjects::String> >();
+	auto dict = std::make_shared<SimpleObjects::Dict>();
+	for (size_t i = 0; i < sk_numOfKeys; ++i)
+	{
+		keys->push_back(SimpleObjects::String("Key" + std::to_string(i)));
+		(*dict)[keys->back()] = SimpleObjects::UInt64(i);
+	}
+
+	registry.Add(
+		"Dict/Build",
+		[keys](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				SimpleObjects::Dict d;
+				for (const auto& key : *keys)
+				{
+					d[key] = SimpleObjects::Null();
+				}
+				MicroBench::DoNotOptimize(d);
+			}
+		}
+	);
+
+	registry.Add(
+		"Dict/Lookup",
+		[keys, dict](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				const auto& key = (*keys)[i % keys->size()];
+				MicroBench::DoNotOptimize((*dict)[key]);
+			}
+		}
+	);
+
+	registry.Add(
+		"List/PushBack",
+		[](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				SimpleObjects::List l;
+				for (size_t j = 0; j < sk_numOfKeys; ++j)
+				{
+					l.push_back(SimpleObjects::UInt64(j));
+				}
+				MicroBench::DoNotOptimize(l);
+			}
+		}
+	);
+
+	registry.Add(
+		"Bytes/Compare",
+		[](size_t n)
+		{
+			const SimpleObjects::Bytes a(std::vector<uint8_t>(256, 0x5AU));
+			const SimpleObjects::Bytes b(std::vector<uint8_t>(256, 0x5AU));
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(a == b);
+			}
+		},
+		256
+	);
+}
+
+
+void AddHexBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	const auto& bytes = fixtures.m_receiptsListRlp;
+	registry.Add(
+		"Hex/Encode",
+		[&bytes](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					SimpleObjects::Codec::Hex::
+						template Encode<std::string>(bytes)
+				);
+			}
+		},
+		bytes.size()
+	);
+
+	const auto hex = std::make_shared<std::string>(
+		SimpleObjects::Codec::Hex::template Encode<std::string>(bytes)
+	);
+	registry.Add(
+		"Hex/Decode",
+		[hex](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					SimpleObjects::Codec::Hex::
+						template Decode<std::vector<uint8_t> >(*hex)
+				);
+			}
+		},
+		hex->size()
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	MicroBench::Registry registry("SimpleObjects");
+	AddObjectBenchmarks(registry);
+	AddHexBenchmarks(registry);
+	return MicroBench::Main(registry, argc, argv);
+}
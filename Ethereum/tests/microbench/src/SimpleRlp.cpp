@@ -0,0 +1,160 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <AdvancedRlp/AdvancedRlp.hpp>
+#include <SimpleRlp/SimpleRlp.hpp>
+
+#include <MicroBench/Fixtures.hpp>
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+void AddSimpleRlpBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	const auto& header = fixtures.m_header;
+	registry.Add(
+		"SimpleRlp/ParseHeader",
+		[&header](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					SimpleRlp::EthHeaderParser().Parse(header)
+				);
+			}
+		},
+		header.size()
+	);
+
+	const auto headerObj = std::make_shared<SimpleRlp::RetObjType>(
+		SimpleRlp::ParseRlp(header)
+	);
+	registry.Add(
+		"SimpleRlp/WriteHeader",
+		[headerObj](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleRlp::WriteRlp(*headerObj));
+			}
+		},
+		header.size()
+	);
+
+	// the receipt RLP follows the transaction type byte
+	const auto receipt = std::make_shared<std::vector<uint8_t> >(
+		fixtures.m_receipts.front().begin() + 1,
+		fixtures.m_receipts.front().end()
+	);
+	registry.Add(
+		"SimpleRlp/ParseReceipt",
+		[receipt](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleRlp::ParseRlp(*receipt));
+			}
+		},
+		receipt->size()
+	);
+
+	const auto& receiptsListRlp = fixtures.m_receiptsListRlp;
+	registry.Add(
+		"SimpleRlp/ParseReceiptsList",
+		[&receiptsListRlp](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleRlp::ParseRlp(receiptsListRlp));
+			}
+		},
+		receiptsListRlp.size()
+	);
+
+	const auto receiptsListObj = std::make_shared<SimpleRlp::RetObjType>(
+		SimpleRlp::ParseRlp(receiptsListRlp)
+	);
+	registry.Add(
+		"SimpleRlp/WriteReceiptsList",
+		[receiptsListObj](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					SimpleRlp::WriteRlp(*receiptsListObj)
+				);
+			}
+		},
+		receiptsListRlp.size()
+	);
+}
+
+
+void AddAdvancedRlpBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	// in the shape of the messages emitted to subscribers
+	SimpleObjects::List events;
+	for (const auto& receipt : fixtures.m_receipts)
+	{
+		events.push_back(SimpleObjects::Bytes(receipt));
+	}
+	SimpleObjects::Dict msg;
+	msg[SimpleObjects::String("SecState")] =
+		SimpleObjects::Bytes(std::vector<uint8_t>(32, 0xAAU));
+	msg[SimpleObjects::String("LatestBlkNum")] =
+		SimpleObjects::Bytes({ 0x01U, 0x02U, 0x03U });
+	msg[SimpleObjects::String("Events")] = std::move(events);
+
+	const auto msgObj = std::make_shared<SimpleObjects::Dict>(std::move(msg));
+	const auto msgAdvRlp = std::make_shared<std::vector<uint8_t> >(
+		AdvancedRlp::GenericWriter::Write(*msgObj)
+	);
+
+	registry.Add(
+		"AdvancedRlp/WriteMsg",
+		[msgObj](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					AdvancedRlp::GenericWriter::Write(*msgObj)
+				);
+			}
+		},
+		msgAdvRlp->size()
+	);
+
+	registry.Add(
+		"AdvancedRlp/ParseMsg",
+		[msgAdvRlp](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(AdvancedRlp::Parse(*msgAdvRlp));
+			}
+		},
+		msgAdvRlp->size()
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	MicroBench::Registry registry("SimpleRlp");
+	AddSimpleRlpBenchmarks(registry);
+	AddAdvancedRlpBenchmarks(registry);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <SimpleUtf/Utf.hpp>
+
+#include <MicroBench/MicroBench.hpp>
+
+
+int main(int argc, char* argv[])
+{
+	// 1-, 2-, 3- and 4-byte UTF-8 sequences
+	std::string utf8;
+	for (size_t i = 0; i < 1024; ++i)
+	{
+		utf8 += "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80";
+	}
+	const std::u32string utf32 = SimpleUtf::Utf8ToUtf32(utf8);
+
+	MicroBench::Registry registry("SimpleUtf");
+	registry.Add(
+		"Utf8ToUtf32",
+		[&utf8](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleUtf::Utf8ToUtf32(utf8));
+			}
+		},
+		utf8.size()
+	);
+	registry.Add(
+		"Utf32ToUtf8",
+		[&utf32](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(SimpleUtf::Utf32ToUtf8(utf32));
+			}
+		},
+		utf32.size() * sizeof(char32_t)
+	);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <mbedTLScpp/DefaultRbg.hpp>
+#include <mbedTLScpp/EcKey.hpp>
+#include <mbedTLScpp/Hash.hpp>
+
+#include <MicroBench/Fixtures.hpp>
+#include <MicroBench/MicroBench.hpp>
+
+
+namespace
+{
+
+
+using EcKeyPairType = mbedTLScpp::EcKeyPair<mbedTLScpp::EcType::SECP256R1>;
+using HashType = mbedTLScpp::Hash<mbedTLScpp::HashType::SHA256>;
+
+
+void AddHashBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	const auto& bytes = fixtures.m_receiptsListRlp;
+	registry.Add(
+		"Sha256/ReceiptsList",
+		[&bytes](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					mbedTLScpp::Hasher<mbedTLScpp::HashType::SHA256>().Calc(
+						mbedTLScpp::CtnFullR(bytes)
+					)
+				);
+			}
+		},
+		bytes.size()
+	);
+}
+
+
+void AddEcKeyBenchmarks(MicroBench::Registry& registry)
+{
+	const auto& fixtures = MicroBench::Fixtures::GetInstance();
+
+	auto rand = std::make_shared<mbedTLScpp::DefaultRbg>();
+	auto keyPair = std::make_shared<EcKeyPairType>(
+		EcKeyPairType::Generate(*rand)
+	);
+	auto hash = std::make_shared<HashType>(
+		mbedTLScpp::Hasher<mbedTLScpp::HashType::SHA256>().Calc(
+			mbedTLScpp::CtnFullR(fixtures.m_header)
+		)
+	);
+
+	registry.Add(
+		"EcKey/SignSecp256r1",
+		[rand, keyPair, hash](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				MicroBench::DoNotOptimize(
+					keyPair->SignInBigNum(*hash, *rand)
+				);
+			}
+		}
+	);
+
+	mbedTLScpp::BigNum r;
+	mbedTLScpp::BigNum s;
+	std::tie(r, s) = keyPair->SignInBigNum(*hash, *rand);
+	auto sign = std::make_shared<
+		std::pair<mbedTLScpp::BigNum, mbedTLScpp::BigNum>
+	>(std::move(r), std::move(s));
+
+	registry.Add(
+		"EcKey/VerifySecp256r1",
+		[keyPair, hash, sign](size_t n)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				keyPair->VerifySign(
+					mbedTLScpp::CtnFullR(*hash),
+					sign->first,
+					sign->second
+				);
+			}
+		}
+	);
+}
+
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	MicroBench::Registry registry("mbedTLScpp");
+	AddHashBenchmarks(registry);
+	AddEcKeyBenchmarks(registry);
+	return MicroBench::Main(registry, argc, argv);
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+#include <cstdio>
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <EclipseMonitor/Eth/ChainGenerator.hpp>
+#include <EclipseMonitor/MonitorReport.hpp>
+
+#include <EthereumClt/Common/PipelineMetrics.hpp>
+#include <EthereumClt/Trusted/BlockchainMgr.hpp>
+#include <EthereumClt/Untrusted/BlockCorpusReplayer.hpp>
+#include <EthereumClt/Untrusted/HostBlockService.hpp>
+
+#include <SimpleObjects/Internal/make_unique.hpp>
+
+
+using namespace EthereumClt;
+
+
+/**
+ * @brief Hands every block straight to the BlockchainMgr, which is where the
+ *        ECALL would be on SGX
+ *
+ */
+template<typename _NetConfig>
+class NativeBlockchainMgr : public BlockReceiver
+{
+public: // static members:
+
+	using BlockchainMgrType = Trusted::BlockchainMgr<_NetConfig>;
+
+public:
+
+	NativeBlockchainMgr(
+		std::shared_ptr<HostBlockService> hostBlkSvc,
+		EclipseMonitor::Eth::BlockNumber startBlockNum
+	) :
+		m_hostBlkSvc(hostBlkSvc),
+		m_bcMgr(
+			EclipseMonitor::BuildEthereumMonitorConfig(),
+			startBlockNum,
+			EclipseMonitor::Eth::ContractAddr(),
+			"SyncMsg(bytes16,bytes32)",
+			SimpleObjects::Internal::
+				make_unique<Trusted::Pubsub::SubscriberService>(
+					EclipseMonitor::Eth::ContractAddr(),
+					"ServiceDeployed(address)",
+					"PublisherRegistered(address,address)",
+					"NotifySubscribers(bytes)"
+			),
+			SimpleObjects::Internal::
+				make_unique<Trusted::HostBlockService>(hostBlkSvc.get())
+		)
+	{}
+
+	virtual ~NativeBlockchainMgr() = default;
+
+	virtual void RecvBlock(const std::vector<uint8_t>& blockRlp) override
+	{
+		m_bcMgr.AppendBlock(blockRlp);
+	}
+
+private:
+
+	std::shared_ptr<HostBlockService> m_hostBlkSvc;
+	BlockchainMgrType m_bcMgr;
+}; // class NativeBlockchainMgr
+
+
+template<typename _NetConfig>
+static void RunPipeline(
+	std::shared_ptr<BlockCorpusReader> corpus,
+	EclipseMonitor::Eth::BlockNumber startBlockNum
+)
+{
+	auto hostBlkSvc = HostBlockService::CreateReplay(corpus);
+	NativeBlockchainMgr<_NetConfig> bcMgr(hostBlkSvc, startBlockNum);
+
+	// Headers after bootstrap I are checked against the time they arrive,
+	// which a replay at full speed can't satisfy, so only the blocks of
+	// bootstrap I are replayed (same plan as the monitor's)
+	const uint64_t chkptSize = EclipseMonitor::BuildEthereumMonitorConfig().
+		get_checkpointSize().GetVal();
+	const uint64_t numOfIntervals =
+		(corpus->GetLastBlockNum() - startBlockNum + 1) / chkptSize;
+	if (numOfIntervals <= 2)
+	{
+		throw std::invalid_argument(
+			"The corpus needs at least " + std::to_string(chkptSize * 3) +
+			" blocks after the start block"
+		);
+	}
+	const auto endBlockNum =
+		startBlockNum + ((numOfIntervals - 2) * chkptSize);
+
+	BlockCorpusReplayer replayer(corpus);
+	auto stats = replayer.Replay(bcMgr, startBlockNum, endBlockNum);
+
+	std::cout
+		<< "Pushed:     " << stats.GetNumOfBlocks() << " blocks" << std::endl
+		<< "Took:       " << (stats.m_totalNanoSec / 1e9) << " seconds"
+		<< std::endl
+		<< "Throughput: " << stats.GetBlocksPerSec() << " blocks / second"
+		<< std::endl
+		<< "Latency:    "
+		<< "p50=" << (stats.GetLatencyNanoSec(50) / 1e3) << "us, "
+		<< "p99=" << (stats.GetLatencyNanoSec(99) / 1e3) << "us, "
+		<< "max=" << (stats.GetLatencyNanoSec(100) / 1e3) << "us"
+		<< std::endl;
+
+	// there is no enclave boundary, so the host and the "enclave" stages
+	// are recorded into the same page
+	const auto& page = Metrics::Registry::GetInstance().GetPage();
+	std::cout << "Stages:" << std::endl;
+	for (size_t i = 0; i < Metrics::sk_numOfStages; ++i)
+	{
+		const auto& stage = page.m_stages[i];
+		const uint64_t count = stage.m_count.load();
+		if (count == 0)
+		{
+			continue;
+		}
+		std::cout
+			<< "  " << Metrics::GetStageInfo(i).m_name << ": "
+			<< count << " samples, mean="
+			<< ((stage.m_sumNanoSec.load() / count) / 1e3) << "us"
+			<< std::endl;
+	}
+}
+
+
+/**
+ * @brief Write the canonical blocks of a synthetic chain into a corpus, so
+ *        the pipeline can be run without any captured data
+ *
+ */
+static EclipseMonitor::Eth::BlockNumber GenSyntheticCorpus(
+	const std::string& path,
+	size_t numOfBlocks
+)
+{
+	using ChainGen =
+		EclipseMonitor::Eth::ChainGenerator<
+			EclipseMonitor::Eth::SyntheticPoWConfig
+		>;
+
+	ChainGen::Config config;
+	config.m_seed = 1;
+	ChainGen chainGen(config);
+
+	BlockCorpusWriter corpus(path);
+	const auto& startBlock = chainGen.GetStartBlock();
+	corpus.Record(
+		startBlock.m_number,
+		startBlock.m_header,
+		SimpleRlp::WriteRlp(startBlock.GetReceiptsList())
+	);
+	while (corpus.GetNumOfBlocks() < numOfBlocks)
+	{
+		for (const auto& block : chainGen.Next())
+		{
+			if (block.m_isCanonical)
+			{
+				corpus.Record(
+					block.m_number,
+					block.m_header,
+					SimpleRlp::WriteRlp(block.GetReceiptsList())
+				);
+			}
+		}
+	}
+	corpus.Finish();
+
+	return startBlock.m_number;
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3)
+	{
+		std::cerr
+			<< "Usage: " << argv[0] << " <corpus path> [<start block>]"
+			<< std::endl
+			<< "       " << argv[0] << " --synthetic <num of blocks>"
+			<< std::endl;
+		return -1;
+	}
+
+	try
+	{
+		const std::string arg = argv[1];
+		if (arg == "--synthetic")
+		{
+			if (argc != 3)
+			{
+				std::cerr << "Missing the number of blocks" << std::endl;
+				return -1;
+			}
+			const std::string corpusPath = "native_pipeline_synthetic.corpus";
+			const auto startBlockNum = GenSyntheticCorpus(
+				corpusPath,
+				std::stoull(argv[2])
+			);
+
+			RunPipeline<EclipseMonitor::Eth::SyntheticPoWConfig>(
+				std::make_shared<BlockCorpusReader>(corpusPath),
+				startBlockNum
+			);
+			std::remove(corpusPath.c_str());
+		}
+		else
+		{
+			auto corpus = std::make_shared<BlockCorpusReader>(arg);
+			const auto startBlockNum = (argc == 3) ?
+				std::stoull(argv[2]) :
+				corpus->GetFirstBlockNum();
+
+			// same network as the client enclave
+			RunPipeline<EclipseMonitor::Eth::GoerliConfig>(
+				corpus,
+				startBlockNum
+			);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
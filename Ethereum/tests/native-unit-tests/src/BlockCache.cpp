@@ -0,0 +1,275 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <EthereumClt/Untrusted/BlockCache.hpp>
+
+
+namespace
+{
+
+
+using namespace EthereumClt;
+
+
+static std::vector<uint8_t> MakeBytes(size_t size, uint8_t seed)
+{
+	std::vector<uint8_t> res(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		res[i] = static_cast<uint8_t>((i * 7) + seed);
+	}
+	return res;
+}
+
+
+/**
+ * @brief A cache directory that starts empty, and is removed afterwards
+ *
+ */
+class CacheDir
+{
+public:
+
+	explicit CacheDir(const std::string& path) :
+		m_path(path)
+	{
+		Clear();
+	}
+
+	~CacheDir()
+	{
+		Clear();
+	}
+
+	const std::string& GetPath() const
+	{
+		return m_path;
+	}
+
+	std::string GetFilePath(uint64_t startNum, const char* ext) const
+	{
+		return m_path + "/range_" + std::to_string(startNum) + ext;
+	}
+
+	uint64_t GetFileSize(uint64_t startNum, const char* ext) const
+	{
+		struct stat st;
+		if (stat(GetFilePath(startNum, ext).c_str(), &st) != 0)
+		{
+			return 0;
+		}
+		return static_cast<uint64_t>(st.st_size);
+	}
+
+private:
+
+	void Clear()
+	{
+		for (uint64_t startNum = 0; startNum < 64; ++startNum)
+		{
+			std::remove(GetFilePath(startNum, ".dat").c_str());
+			std::remove(GetFilePath(startNum, ".idx").c_str());
+		}
+		rmdir(m_path.c_str());
+	}
+
+	std::string m_path;
+}; // class CacheDir
+
+
+static constexpr uint64_t sk_blocksPerRange = 4;
+static constexpr size_t sk_headerSize = 100;
+
+
+static void PutHeaders(BlockCache& cache, uint64_t begin, uint64_t end)
+{
+	for (uint64_t blockNum = begin; blockNum < end; ++blockNum)
+	{
+		cache.PutHeaderRlp(
+			blockNum,
+			MakeBytes(sk_headerSize, static_cast<uint8_t>(blockNum))
+		);
+	}
+}
+
+
+static bool HasHeader(BlockCache& cache, uint64_t blockNum)
+{
+	std::vector<uint8_t> header;
+	return cache.TryGetHeaderRlp(blockNum, header) &&
+		(header == MakeBytes(sk_headerSize, static_cast<uint8_t>(blockNum)));
+}
+
+
+} // namespace
+
+
+TEST(TestBlockCache, RecoverFromTornIndex)
+{
+	CacheDir dir("TestBlockCache_TornIndex");
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		PutHeaders(cache, 0, 3);
+	}
+
+	// a partially written entry at the end of the index
+	{
+		FILE* file = std::fopen(dir.GetFilePath(0, ".idx").c_str(), "ab");
+		ASSERT_NE(file, nullptr);
+		const std::vector<uint8_t> partial(10, 0xAB);
+		std::fwrite(partial.data(), 1, partial.size(), file);
+		std::fclose(file);
+	}
+
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		EXPECT_TRUE(HasHeader(cache, 0));
+		EXPECT_TRUE(HasHeader(cache, 1));
+		EXPECT_TRUE(HasHeader(cache, 2));
+
+		// new entries are appended after the last complete one
+		PutHeaders(cache, 3, 4);
+	}
+
+	BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+	for (uint64_t blockNum = 0; blockNum < 4; ++blockNum)
+	{
+		EXPECT_TRUE(HasHeader(cache, blockNum)) << "block " << blockNum;
+	}
+}
+
+
+TEST(TestBlockCache, RecoverFromTruncatedData)
+{
+	CacheDir dir("TestBlockCache_TruncatedData");
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		PutHeaders(cache, 0, 3);
+	}
+
+	// the last record didn't fully reach the disk, but its entry did
+	const uint64_t dataSize = dir.GetFileSize(0, ".dat");
+	ASSERT_EQ(
+		truncate(dir.GetFilePath(0, ".dat").c_str(), dataSize - 10),
+		0
+	);
+
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		EXPECT_TRUE(HasHeader(cache, 0));
+		EXPECT_TRUE(HasHeader(cache, 1));
+		EXPECT_FALSE(HasHeader(cache, 2));
+
+		// it's fetched again, and appended
+		PutHeaders(cache, 2, 3);
+		EXPECT_TRUE(HasHeader(cache, 2));
+	}
+
+	BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+	EXPECT_TRUE(HasHeader(cache, 2));
+}
+
+
+TEST(TestBlockCache, DropCorruptedRecord)
+{
+	CacheDir dir("TestBlockCache_Corrupted");
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		PutHeaders(cache, 0, 2);
+	}
+
+	// flip a byte in the payload of the last record
+	{
+		FILE* file = std::fopen(dir.GetFilePath(0, ".dat").c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		std::fseek(file, -1, SEEK_END);
+		const int byte = std::fgetc(file);
+		std::fseek(file, -1, SEEK_END);
+		std::fputc(byte ^ 0xFF, file);
+		std::fclose(file);
+	}
+
+	BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+	EXPECT_TRUE(HasHeader(cache, 0));
+	EXPECT_FALSE(HasHeader(cache, 1));
+	EXPECT_EQ(cache.GetNumOfMisses(), 1U);
+
+	PutHeaders(cache, 1, 2);
+	EXPECT_TRUE(HasHeader(cache, 1));
+}
+
+
+TEST(TestBlockCache, EvictLeastRecentlyUsedRange)
+{
+	CacheDir dir("TestBlockCache_Evict");
+
+	// room for a bit more than two full ranges
+	uint64_t rangeSize = 0;
+	{
+		BlockCache cache(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+		PutHeaders(cache, 0, sk_blocksPerRange);
+		rangeSize = cache.GetDiskSize();
+	}
+	CacheDir dir2("TestBlockCache_Evict2");
+	BlockCache cache(
+		dir2.GetPath(),
+		(rangeSize * 2) + (rangeSize / 2),
+		sk_blocksPerRange,
+		0
+	);
+
+	PutHeaders(cache, 0, 2 * sk_blocksPerRange);
+	EXPECT_EQ(cache.GetNumOfRanges(), 2U);
+
+	// the first range is used more recently than the second one
+	EXPECT_TRUE(HasHeader(cache, 0));
+
+	PutHeaders(cache, 2 * sk_blocksPerRange, 3 * sk_blocksPerRange);
+	EXPECT_EQ(cache.GetNumOfRanges(), 2U);
+	EXPECT_LE(cache.GetDiskSize(), (rangeSize * 2) + (rangeSize / 2));
+
+	EXPECT_TRUE(HasHeader(cache, 1));
+	EXPECT_FALSE(HasHeader(cache, sk_blocksPerRange + 1));
+	EXPECT_EQ(dir2.GetFileSize(sk_blocksPerRange, ".dat"), 0U);
+	EXPECT_TRUE(HasHeader(cache, (2 * sk_blocksPerRange) + 1));
+}
+
+
+TEST(TestBlockCache, SecondInstanceIsReadOnly)
+{
+	CacheDir dir("TestBlockCache_ReadOnly");
+
+	BlockCache writer(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+	EXPECT_FALSE(writer.IsReadOnly());
+	PutHeaders(writer, 0, 2);
+
+	BlockCache reader(dir.GetPath(), 1 << 20, sk_blocksPerRange, 0);
+	EXPECT_TRUE(reader.IsReadOnly());
+	EXPECT_TRUE(HasHeader(reader, 1));
+
+	// a miss reloads the index, so what the writer added since is found
+	PutHeaders(writer, 2, sk_blocksPerRange + 1);
+	EXPECT_TRUE(HasHeader(reader, 2));
+	EXPECT_TRUE(HasHeader(reader, sk_blocksPerRange));
+
+	// the reader doesn't write
+	const uint64_t diskSize = writer.GetDiskSize();
+	PutHeaders(reader, 10 * sk_blocksPerRange, (10 * sk_blocksPerRange) + 1);
+	EXPECT_EQ(dir.GetFileSize(10 * sk_blocksPerRange, ".dat"), 0U);
+	EXPECT_EQ(writer.GetDiskSize(), diskSize);
+	EXPECT_FALSE(HasHeader(reader, 10 * sk_blocksPerRange));
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <EthereumClt/Untrusted/BlockCorpus.hpp>
+
+
+namespace
+{
+
+
+using namespace EthereumClt;
+
+
+static std::vector<uint8_t> MakeBytes(size_t size, uint8_t seed)
+{
+	std::vector<uint8_t> res(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		res[i] = static_cast<uint8_t>((i * 7) + seed);
+	}
+	return res;
+}
+
+
+static uint64_t ReadU64At(const std::string& path, long offset)
+{
+	FILE* file = std::fopen(path.c_str(), "rb");
+	uint8_t bytes[8] = { 0 };
+	if (file != nullptr)
+	{
+		std::fseek(file, offset, offset < 0 ? SEEK_END : SEEK_SET);
+		if (std::fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes))
+		{
+			ADD_FAILURE() << "failed to read " << path;
+		}
+		std::fclose(file);
+	}
+	return BlockCorpusFormat::ReadInt<uint64_t>(bytes);
+}
+
+
+static void WriteU64At(const std::string& path, long offset, uint64_t val)
+{
+	std::vector<uint8_t> bytes;
+	BlockCorpusFormat::AppendInt<uint64_t>(bytes, val);
+
+	FILE* file = std::fopen(path.c_str(), "r+b");
+	ASSERT_NE(file, nullptr);
+	std::fseek(file, offset, SEEK_SET);
+	std::fwrite(bytes.data(), 1, bytes.size(), file);
+	std::fclose(file);
+}
+
+
+/**
+ * @brief Records blocks 10, 11, and 12, and returns the offset of the first
+ *        index entry
+ *
+ */
+static long WriteCorpus(const std::string& path)
+{
+	{
+		BlockCorpusWriter writer(path);
+		for (uint64_t blockNum = 10; blockNum < 13; ++blockNum)
+		{
+			writer.Record(
+				blockNum,
+				MakeBytes(10, static_cast<uint8_t>(blockNum)),
+				MakeBytes(20, static_cast<uint8_t>(blockNum))
+			);
+		}
+	}
+	const long indexOffset = static_cast<long>(ReadU64At(
+		path,
+		-static_cast<long>(BlockCorpusFormat::sk_footerSize)
+	));
+	// skip the number of records
+	return indexOffset + 8;
+}
+
+
+} // namespace
+
+
+TEST(TestBlockCorpus, RecordAndRead)
+{
+	const std::string path = "TestBlockCorpus_RecordAndRead.corpus";
+	{
+		BlockCorpusWriter writer(path);
+		writer.Record(12, MakeBytes(100, 12), MakeBytes(300, 112));
+		writer.Record(10, MakeBytes(90, 10), MakeBytes(0, 110));
+		writer.Record(11, MakeBytes(80, 11), MakeBytes(200, 111));
+		// recorded already, so it's skipped
+		writer.Record(12, MakeBytes(1, 0), MakeBytes(1, 0));
+		EXPECT_EQ(writer.GetNumOfBlocks(), 3U);
+
+		std::vector<uint8_t> receipts;
+		EXPECT_TRUE(writer.TryGetRecentReceiptsRlp(11, receipts));
+		EXPECT_EQ(receipts, MakeBytes(200, 111));
+		EXPECT_FALSE(writer.TryGetRecentReceiptsRlp(13, receipts));
+
+		writer.Finish();
+		EXPECT_THROW(
+			writer.Record(13, MakeBytes(1, 0), MakeBytes(1, 0)),
+			std::logic_error
+		);
+	}
+
+	BlockCorpusReader reader(path);
+	EXPECT_EQ(
+		reader.GetBlockNums(),
+		std::vector<BlockCorpusReader::BlockNumber>({ 10, 11, 12 })
+	);
+	EXPECT_EQ(reader.GetHeaderRlp(10), MakeBytes(90, 10));
+	EXPECT_EQ(reader.GetHeaderRlp(11), MakeBytes(80, 11));
+	EXPECT_EQ(reader.GetHeaderRlp(12), MakeBytes(100, 12));
+	EXPECT_EQ(reader.GetReceiptsRlp(12), MakeBytes(300, 112));
+	EXPECT_EQ(reader.GetReceiptsRlp(10), MakeBytes(0, 110));
+	EXPECT_FALSE(reader.HasBlock(13));
+
+	std::remove(path.c_str());
+}
+
+
+TEST(TestBlockCorpus, RecentReceiptsAreBounded)
+{
+	const std::string path = "TestBlockCorpus_RecentReceipts.corpus";
+	BlockCorpusWriter writer(path);
+	const size_t numBlocks = BlockCorpusWriter::sk_numRecentReceipts + 4;
+	for (size_t i = 0; i < numBlocks; ++i)
+	{
+		writer.Record(
+			i,
+			MakeBytes(10, static_cast<uint8_t>(i)),
+			MakeBytes(20, static_cast<uint8_t>(i))
+		);
+	}
+
+	std::vector<uint8_t> receipts;
+	EXPECT_FALSE(writer.TryGetRecentReceiptsRlp(0, receipts));
+	EXPECT_TRUE(writer.TryGetRecentReceiptsRlp(numBlocks - 1, receipts));
+	EXPECT_EQ(receipts, MakeBytes(20, static_cast<uint8_t>(numBlocks - 1)));
+
+	writer.Finish();
+	std::remove(path.c_str());
+}
+
+
+TEST(TestBlockCorpus, RejectUnsortedIndex)
+{
+	const std::string path = "TestBlockCorpus_UnsortedIndex.corpus";
+
+	// the first two entries swapped
+	{
+		const long entryOffset = WriteCorpus(path);
+		WriteU64At(path, entryOffset, 11);
+		WriteU64At(path, entryOffset + 16, 10);
+		EXPECT_THROW(BlockCorpusReader reader(path), std::runtime_error);
+	}
+
+	// the same block twice
+	{
+		const long entryOffset = WriteCorpus(path);
+		WriteU64At(path, entryOffset + 16, 10);
+		EXPECT_THROW(BlockCorpusReader reader(path), std::runtime_error);
+	}
+
+	// a record offset past the index
+	{
+		const long entryOffset = WriteCorpus(path);
+		WriteU64At(path, entryOffset + 8, 1 << 20);
+		EXPECT_THROW(BlockCorpusReader reader(path), std::runtime_error);
+	}
+
+	// and the corpus is read after it's written again
+	WriteCorpus(path);
+	BlockCorpusReader reader(path);
+	EXPECT_EQ(reader.GetNumOfBlocks(), 3U);
+	EXPECT_EQ(reader.GetHeaderRlp(11), MakeBytes(10, 11));
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,523 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SimpleConcurrency/Threading/LambdaTask.hpp>
+#include <SimpleConcurrency/Threading/PartitionedExecutor.hpp>
+#include <SimpleConcurrency/Threading/TickingTask.hpp>
+#include <SimpleConcurrency/Threading/TimerWheel.hpp>
+#include <SimpleConcurrency/Threading/WorkStealingPool.hpp>
+
+
+namespace
+{
+
+
+using namespace SimpleConcurrency::Threading;
+
+
+/**
+ * @brief A one-shot gate that test tasks can block on
+ *
+ */
+class Gate
+{
+public:
+	Gate() :
+		m_mutex(),
+		m_cv(),
+		m_isOpen(false)
+	{}
+
+	void Open()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isOpen = true;
+		}
+		m_cv.notify_all();
+	}
+
+	bool WaitFor(std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_cv.wait_for(lock, timeout, [this]() { return m_isOpen; });
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_isOpen;
+}; // class Gate
+
+
+static const std::chrono::milliseconds sk_timeout(5000);
+
+
+} // namespace
+
+
+TEST(TestWorkStealingPool, RunsInAddedOrderOnOneWorker)
+{
+	WorkStealingPool pool(1);
+
+	// hold the only worker, so all later tasks are queued
+	Gate started;
+	Gate release;
+	pool.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool&)
+		{
+			started.Open();
+			release.WaitFor(sk_timeout);
+		}
+	));
+	ASSERT_TRUE(started.WaitFor(sk_timeout));
+
+	static constexpr size_t sk_numTasks = 20;
+	std::mutex mutex;
+	std::vector<size_t> order;
+	Gate allDone;
+	for (size_t i = 0; i < sk_numTasks; ++i)
+	{
+		pool.AddTask(MakeLambdaTask(
+			[&, i](const std::atomic_bool&)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				order.push_back(i);
+				if (order.size() == sk_numTasks)
+				{
+					allDone.Open();
+				}
+			}
+		));
+	}
+	release.Open();
+	ASSERT_TRUE(allDone.WaitFor(sk_timeout));
+
+	std::vector<size_t> expOrder;
+	for (size_t i = 0; i < sk_numTasks; ++i)
+	{
+		expOrder.push_back(i);
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_EQ(order, expOrder);
+}
+
+
+TEST(TestWorkStealingPool, IdleWorkerStealsFromBusyWorker)
+{
+	WorkStealingPool pool(2);
+
+	// a task added from a worker goes to that worker's own deque, and the
+	// worker is blocked until it's done, so only a steal can run it
+	Gate childDone;
+	std::thread::id parentId;
+	std::thread::id childId;
+	Gate parentDone;
+	pool.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool&)
+		{
+			parentId = std::this_thread::get_id();
+			pool.AddTask(MakeLambdaTask(
+				[&](const std::atomic_bool&)
+				{
+					childId = std::this_thread::get_id();
+					childDone.Open();
+				}
+			));
+			EXPECT_TRUE(childDone.WaitFor(sk_timeout));
+			parentDone.Open();
+		}
+	));
+
+	ASSERT_TRUE(parentDone.WaitFor(sk_timeout));
+	EXPECT_NE(parentId, childId);
+}
+
+
+TEST(TestWorkStealingPool, StolenTasksRunInAddedOrder)
+{
+	WorkStealingPool pool(2);
+
+	// tasks added from a worker are queued on its own deque, and it's
+	// blocked until they're done, so the idle worker steals all of them
+	static constexpr size_t sk_numTasks = 20;
+	std::mutex mutex;
+	std::vector<size_t> order;
+	Gate allDone;
+	Gate parentDone;
+	pool.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool&)
+		{
+			for (size_t i = 0; i < sk_numTasks; ++i)
+			{
+				pool.AddTask(MakeLambdaTask(
+					[&, i](const std::atomic_bool&)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						order.push_back(i);
+						if (order.size() == sk_numTasks)
+						{
+							allDone.Open();
+						}
+					}
+				));
+			}
+			EXPECT_TRUE(allDone.WaitFor(sk_timeout));
+			parentDone.Open();
+		}
+	));
+	ASSERT_TRUE(parentDone.WaitFor(sk_timeout));
+
+	std::vector<size_t> expOrder;
+	for (size_t i = 0; i < sk_numTasks; ++i)
+	{
+		expOrder.push_back(i);
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_EQ(order, expOrder);
+}
+
+
+TEST(TestWorkStealingPool, TerminateWithQueuedTasks)
+{
+	std::unique_ptr<WorkStealingPool> pool(new WorkStealingPool(1));
+
+	Gate started;
+	std::atomic_bool isRunningTerminated(false);
+	pool->AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool& isTerminated)
+		{
+			started.Open();
+			while (!isTerminated)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		},
+		[]() {},
+		[&]() { isRunningTerminated = true; }
+	));
+	ASSERT_TRUE(started.WaitFor(sk_timeout));
+
+	std::atomic<size_t> numQueuedRun(0);
+	std::atomic<size_t> numQueuedFinished(0);
+	for (size_t i = 0; i < 10; ++i)
+	{
+		pool->AddTask(MakeLambdaTask(
+			[&](const std::atomic_bool&) { ++numQueuedRun; },
+			[&]() { ++numQueuedFinished; }
+		));
+	}
+
+	// the running task is terminated, and the queued ones are dropped
+	pool->Terminate();
+	EXPECT_TRUE(isRunningTerminated);
+	EXPECT_EQ(numQueuedRun.load(), 0U);
+
+	pool->Update();
+	EXPECT_EQ(numQueuedFinished.load(), 0U);
+
+	// terminating again (e.g., in the destructor) is a no-op
+	pool->Terminate();
+	pool.reset();
+}
+
+
+TEST(TestWorkStealingPool, FinishingCalledByUpdate)
+{
+	WorkStealingPool pool(2);
+
+	std::atomic<size_t> numFinished(0);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		pool.AddTask(MakeLambdaTask(
+			[](const std::atomic_bool&) {},
+			[&]() { ++numFinished; }
+		));
+	}
+
+	// `Finishing` is only called from the owner thread, through `Update`
+	while (numFinished < 8)
+	{
+		pool.WaitAndUpdate();
+	}
+	EXPECT_EQ(numFinished.load(), 8U);
+}
+
+
+TEST(TestPartitionedExecutor, ServicesDoNotOccupyWorkers)
+{
+	PartitionedExecutor executor(1);
+
+	static constexpr size_t sk_numServices = 4;
+	std::atomic<size_t> numServicesStarted(0);
+	std::atomic<size_t> numServicesTerminated(0);
+	for (size_t i = 0; i < sk_numServices; ++i)
+	{
+		executor.AddServiceTask(MakeLambdaTask(
+			[&](const std::atomic_bool& isTerminated)
+			{
+				++numServicesStarted;
+				while (!isTerminated)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			},
+			[]() {},
+			[&]() { ++numServicesTerminated; }
+		));
+	}
+
+	// more services than workers, yet short tasks still run
+	Gate taskDone;
+	executor.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool&) { taskDone.Open(); }
+	));
+	EXPECT_TRUE(taskDone.WaitFor(sk_timeout));
+
+	executor.Terminate();
+	EXPECT_EQ(numServicesStarted.load(), sk_numServices);
+	EXPECT_EQ(numServicesTerminated.load(), sk_numServices);
+
+	// no more services are accepted after termination
+	executor.AddServiceTask(MakeLambdaTask(
+		[&](const std::atomic_bool&) { ++numServicesStarted; }
+	));
+	EXPECT_EQ(numServicesStarted.load(), sk_numServices);
+}
+
+
+TEST(TestPartitionedExecutor, FinishedServicesJoinedByUpdate)
+{
+	PartitionedExecutor executor(1);
+
+	std::atomic<size_t> numFinished(0);
+	executor.AddServiceTask(MakeLambdaTask(
+		[](const std::atomic_bool&) {},
+		[&]() { ++numFinished; }
+	));
+	executor.AddTask(MakeLambdaTask(
+		[](const std::atomic_bool&) {},
+		[&]() { ++numFinished; }
+	));
+
+	// both partitions wake up the same notifier
+	while (numFinished < 2)
+	{
+		executor.WaitAndUpdate();
+	}
+	EXPECT_EQ(numFinished.load(), 2U);
+}
+
+
+TEST(TestPartitionedExecutor, TerminateWithQueuedTasks)
+{
+	PartitionedExecutor executor(1);
+
+	Gate started;
+	executor.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool& isTerminated)
+		{
+			started.Open();
+			while (!isTerminated)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	));
+	ASSERT_TRUE(started.WaitFor(sk_timeout));
+
+	std::atomic<size_t> numQueuedRun(0);
+	for (size_t i = 0; i < 10; ++i)
+	{
+		executor.AddTask(MakeLambdaTask(
+			[&](const std::atomic_bool&) { ++numQueuedRun; }
+		));
+	}
+
+	executor.Terminate();
+	EXPECT_EQ(numQueuedRun.load(), 0U);
+}
+
+
+namespace
+{
+
+
+class CountingTickTask :
+	public TickingTask<int64_t>
+{
+public:
+	CountingTickTask(std::atomic<size_t>& numTicks, Gate& firstTick) :
+		TickingTask<int64_t>(1, 1),
+		m_numTicks(numTicks),
+		m_firstTick(firstTick)
+	{}
+
+	virtual ~CountingTickTask() = default;
+
+protected:
+
+	virtual void Tick() override
+	{
+		++m_numTicks;
+		m_firstTick.Open();
+	}
+
+	virtual void SleepFor(int64_t) const override
+	{}
+
+private:
+	std::atomic<size_t>& m_numTicks;
+	Gate& m_firstTick;
+}; // class CountingTickTask
+
+
+} // namespace
+
+
+TEST(TestPartitionedExecutor, TimerJobsRunOnTimerPool)
+{
+	PartitionedExecutor executor(1, 1);
+	std::shared_ptr<TimerWheel> timerWheel =
+		TimerWheel::Create(executor.GetTimerPool(), 1);
+
+	// hold the only worker; ticks still run on the timer pool
+	Gate release;
+	executor.AddTask(MakeLambdaTask(
+		[&](const std::atomic_bool&) { release.WaitFor(sk_timeout); }
+	));
+
+	std::atomic<size_t> numTicks(0);
+	Gate firstTick;
+	std::unique_ptr<CountingTickTask> task(
+		new CountingTickTask(numTicks, firstTick)
+	);
+	CountingTickTask* taskPtr = task.get();
+	timerWheel->AddTickingTask(std::move(task));
+	EXPECT_TRUE(firstTick.WaitFor(sk_timeout));
+
+	// terminating the wheel terminates the ticking tasks it drives
+	timerWheel->Terminate();
+	EXPECT_TRUE(taskPtr->IsTerminating());
+	const size_t numTicksAtTerminate = numTicks;
+
+	release.Open();
+	executor.Terminate();
+	EXPECT_LE(numTicks.load(), numTicksAtTerminate + 1);
+}
+
+
+TEST(TestTimerWheel, WakeBeforeDue)
+{
+	std::shared_ptr<PartitionedExecutor> executor =
+		std::make_shared<PartitionedExecutor>(1, 1);
+	std::shared_ptr<TimerWheel> timerWheel =
+		TimerWheel::Create(executor->GetTimerPool(), 1);
+
+	std::mutex mutex;
+	std::condition_variable cond;
+	size_t numCalls = 0;
+	Gate release;
+
+	// due far beyond the test timeout, so only a wake-up runs it
+	TimerWheel::JobHandle job = timerWheel->ScheduleWakeable(
+		60 * 1000,
+		[&]() -> TimerWheel::TimeType
+		{
+			size_t callIdx = 0;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				callIdx = ++numCalls;
+			}
+			cond.notify_all();
+			if (callIdx == 1)
+			{
+				// woken up again while this call is running
+				release.WaitFor(sk_timeout);
+			}
+			return 60 * 1000;
+		}
+	);
+
+	auto waitForCalls = [&](size_t expNumCalls)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		return cond.wait_for(
+			lock,
+			sk_timeout,
+			[&]() { return numCalls >= expNumCalls; }
+		);
+	};
+
+	timerWheel->Wake(job);
+	ASSERT_TRUE(waitForCalls(1));
+
+	// the wake-up isn't missed, although the job isn't in the wheel now
+	timerWheel->Wake(job);
+	release.Open();
+	ASSERT_TRUE(waitForCalls(2));
+
+	// and then it's back in the wheel, waiting for the next wake-up
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		EXPECT_EQ(numCalls, 2U);
+	}
+	timerWheel->Wake(job);
+	EXPECT_TRUE(waitForCalls(3));
+
+	timerWheel->Terminate();
+	executor->Terminate();
+}
+
+
+TEST(TestTimerWheel, ReleaseWhileDispatching)
+{
+	std::shared_ptr<PartitionedExecutor> executor =
+		std::make_shared<PartitionedExecutor>(1, 2);
+
+	// the wheel thread keeps dispatching due jobs while the only owner of
+	// the wheel releases it, so the wheel must be destroyed on this thread
+	for (size_t i = 0; i < 50; ++i)
+	{
+		std::shared_ptr<TimerWheel> timerWheel =
+			TimerWheel::Create(executor->GetTimerPool(), 1);
+		// shared with the jobs, since the dispatched ones may outlive
+		// this iteration
+		auto numCalls = std::make_shared<std::atomic<size_t> >(0);
+		for (size_t j = 0; j < 8; ++j)
+		{
+			timerWheel->Schedule(
+				1,
+				[numCalls]() -> TimerWheel::TimeType
+				{
+					++(*numCalls);
+					return 1;
+				}
+			);
+		}
+		while (*numCalls < 8)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		timerWheel.reset();
+	}
+
+	executor->Terminate();
+}
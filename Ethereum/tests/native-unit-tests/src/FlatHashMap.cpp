@@ -0,0 +1,292 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <SimpleObjects/SimpleObjects.hpp>
+
+
+namespace
+{
+
+
+using namespace SimpleObjects;
+
+
+/**
+ * @brief Maps the keys to a few hash values only, so the keys collide both
+ *        in the cached hash values and in the index
+ *
+ */
+struct CollidingHash
+{
+	size_t operator()(uint64_t key) const
+	{
+		return static_cast<size_t>(key % 3);
+	}
+}; // struct CollidingHash
+
+
+using CollidingMap = FlatHashMap<uint64_t, uint64_t, 8, CollidingHash>;
+
+
+/**
+ * @brief Expects the map to hold exactly the entries of the reference map
+ *
+ */
+template<typename _MapType>
+static void ExpectSameEntries(
+	const _MapType& map,
+	const std::map<uint64_t, uint64_t>& refMap
+)
+{
+	ASSERT_EQ(map.size(), refMap.size());
+	for (const auto& refEntry : refMap)
+	{
+		auto it = map.find(refEntry.first);
+		ASSERT_NE(it, map.end()) << "key " << refEntry.first;
+		EXPECT_EQ(it->first, refEntry.first);
+		EXPECT_EQ(it->second, refEntry.second);
+	}
+	for (const auto& entry : map)
+	{
+		EXPECT_EQ(refMap.count(entry.first), 1U) << "key " << entry.first;
+	}
+}
+
+
+/**
+ * @brief Applies the same random inserts and erases to the map and to a
+ *        reference map, and checks them against each other after each step
+ *
+ */
+template<typename _MapType>
+static void RandomOps(size_t keyRange, size_t numOfOps, uint32_t seed)
+{
+	std::mt19937 rand(seed);
+	_MapType map;
+	std::map<uint64_t, uint64_t> refMap;
+
+	for (size_t i = 0; i < numOfOps; ++i)
+	{
+		const uint64_t key = rand() % keyRange;
+		if (rand() % 3 == 0)
+		{
+			EXPECT_EQ(map.erase(key), refMap.erase(key)) << "key " << key;
+		}
+		else
+		{
+			const bool isNew = refMap.count(key) == 0;
+			auto res = map.insert(std::make_pair(key, key * 10));
+			refMap.insert(std::make_pair(key, key * 10));
+			EXPECT_EQ(res.second, isNew) << "key " << key;
+			EXPECT_EQ(res.first->first, key);
+		}
+		ExpectSameEntries(map, refMap);
+		if (::testing::Test::HasFailure())
+		{
+			FAIL() << "after op " << i;
+		}
+	}
+}
+
+
+} // namespace
+
+
+TEST(TestFlatHashMap, CollidingHashes)
+{
+	// small enough to stay in linear scan
+	RandomOps<CollidingMap>(8, 200, 1);
+	// crosses the linear scan limit back and forth
+	RandomOps<CollidingMap>(16, 1000, 2);
+	// long probe chains in the index
+	RandomOps<CollidingMap>(200, 5000, 3);
+	RandomOps<FlatHashMap<uint64_t, uint64_t> >(200, 5000, 4);
+}
+
+
+TEST(TestFlatHashMap, LookupAndAssign)
+{
+	CollidingMap map;
+	for (uint64_t key = 0; key < 20; ++key)
+	{
+		map[key] = key + 1;
+	}
+	EXPECT_EQ(map.size(), 20U);
+	EXPECT_EQ(map.at(19), 20U);
+	EXPECT_EQ(map.count(3), 1U);
+	EXPECT_EQ(map.count(20), 0U);
+	EXPECT_THROW(map.at(20), std::out_of_range);
+
+	map[3] = 100;
+	EXPECT_EQ(map.size(), 20U);
+	EXPECT_EQ(map.at(3), 100U);
+
+	auto res = map.emplace(3, 0);
+	EXPECT_FALSE(res.second);
+	EXPECT_EQ(res.first->second, 100U);
+}
+
+
+TEST(TestFlatHashMap, EraseDuringIteration)
+{
+	for (uint64_t size : { 6, 40 })
+	{
+		CollidingMap map;
+		for (uint64_t key = 0; key < size; ++key)
+		{
+			map[key] = key;
+		}
+
+		size_t visited = 0;
+		for (auto it = map.begin(); it != map.end(); )
+		{
+			++visited;
+			if (it->first % 2 == 1)
+			{
+				// the last entry is moved into the erased place, and is
+				// visited next
+				it = map.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		EXPECT_EQ(visited, size);
+
+		EXPECT_EQ(map.size(), size / 2);
+		for (uint64_t key = 0; key < size; ++key)
+		{
+			EXPECT_EQ(map.count(key), (key % 2 == 0) ? 1U : 0U)
+				<< "key " << key;
+		}
+	}
+}
+
+
+TEST(TestFlatHashMap, GrowAndShrink)
+{
+	FlatHashMap<std::string, uint64_t> map;
+
+	// grows past the linear scan limit, and rehashes several times
+	for (uint64_t i = 0; i < 1000; ++i)
+	{
+		map["key" + std::to_string(i)] = i;
+	}
+	ASSERT_EQ(map.size(), 1000U);
+	for (uint64_t i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(map.at("key" + std::to_string(i)), i);
+	}
+
+	// shrinks below the linear scan limit, while the index is kept
+	for (uint64_t i = 0; i < 995; ++i)
+	{
+		EXPECT_EQ(map.erase("key" + std::to_string(i)), 1U);
+	}
+	ASSERT_EQ(map.size(), 5U);
+	for (uint64_t i = 995; i < 1000; ++i)
+	{
+		EXPECT_EQ(map.at("key" + std::to_string(i)), i);
+	}
+	EXPECT_EQ(map.count("key0"), 0U);
+
+	// and grows again
+	for (uint64_t i = 0; i < 100; ++i)
+	{
+		map["key" + std::to_string(i)] = i;
+	}
+	EXPECT_EQ(map.size(), 105U);
+	EXPECT_EQ(map.at("key50"), 50U);
+	EXPECT_EQ(map.at("key997"), 997U);
+}
+
+
+TEST(TestFlatHashMap, ReserveAndCopy)
+{
+	CollidingMap map;
+	std::map<uint64_t, uint64_t> refMap;
+	for (uint64_t key = 0; key < 5; ++key)
+	{
+		map[key] = key;
+		refMap[key] = key;
+	}
+
+	// builds the index ahead of the growth
+	map.reserve(100);
+	ExpectSameEntries(map, refMap);
+	for (uint64_t key = 5; key < 100; ++key)
+	{
+		map[key] = key;
+		refMap[key] = key;
+	}
+	ExpectSameEntries(map, refMap);
+
+	CollidingMap copied(map);
+	CollidingMap moved(std::move(copied));
+	ExpectSameEntries(moved, refMap);
+	EXPECT_TRUE(moved == map);
+
+	moved.erase(7);
+	EXPECT_TRUE(moved != map);
+	moved[7] = 8;
+	EXPECT_TRUE(moved != map);
+	moved[7] = 7;
+	EXPECT_TRUE(moved == map);
+
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.find(7), map.end());
+	map[7] = 1;
+	EXPECT_EQ(map.at(7), 1U);
+}
+
+
+TEST(TestFlatHashMap, SameAsDict)
+{
+	Dict dict;
+	FlatDict flatDict;
+	FlatDict flatDictRev;
+	for (uint64_t i = 0; i < 30; ++i)
+	{
+		dict[String("key" + std::to_string(i))] = UInt64(i);
+		flatDict[String("key" + std::to_string(i))] = UInt64(i);
+		flatDictRev[String("key" + std::to_string(29 - i))] = UInt64(29 - i);
+	}
+	dict[UInt64(100)] = List({ String("a"), Null() });
+	flatDict[UInt64(100)] = List({ String("a"), Null() });
+	flatDictRev[UInt64(100)] = List({ String("a"), Null() });
+
+	EXPECT_TRUE(dict == flatDict);
+	EXPECT_TRUE(flatDict == dict);
+	// the order of insertion doesn't matter
+	EXPECT_TRUE(flatDict == flatDictRev);
+	EXPECT_TRUE(dict == flatDictRev);
+
+	flatDict.Remove(String("key3"));
+	EXPECT_FALSE(dict == flatDict);
+	dict.Remove(String("key3"));
+	EXPECT_TRUE(dict == flatDict);
+
+	flatDict[String("key4")] = UInt64(40);
+	EXPECT_FALSE(dict == flatDict);
+	EXPECT_FALSE(flatDict == dict);
+
+	EXPECT_EQ(flatDict.size(), 30U);
+	EXPECT_EQ(flatDict[String("key4")], UInt64(40));
+	EXPECT_EQ(flatDict[String("key29")], UInt64(29));
+	EXPECT_FALSE(flatDict.HasKey(String("key3")));
+}
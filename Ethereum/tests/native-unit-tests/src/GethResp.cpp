@@ -0,0 +1,175 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <EthereumClt/Untrusted/GethRespSinks.hpp>
+
+
+namespace
+{
+
+
+using namespace EthereumClt;
+
+
+using BytesList = std::vector<std::vector<uint8_t> >;
+
+
+static void FeedResp(
+	SimpleJson::SaxHandlerIf& handler,
+	const std::string& body,
+	size_t chunkSize
+)
+{
+	SimpleJson::SaxParser parser(handler);
+	for (size_t pos = 0; pos < body.size(); pos += chunkSize)
+	{
+		parser.Feed(body.substr(pos, chunkSize));
+	}
+	parser.Finish();
+}
+
+
+static std::vector<uint8_t> ParseBytesResp(
+	const std::string& body,
+	size_t chunkSize
+)
+{
+	GethBytesResp resp;
+	FeedResp(resp.GetHandler(), body, chunkSize);
+	return resp.ReleaseBytes();
+}
+
+
+static BytesList ParseBytesListResp(const std::string& body, size_t chunkSize)
+{
+	GethBytesListResp<BytesList> resp;
+	FeedResp(resp.GetHandler(), body, chunkSize);
+	return resp.ReleaseList();
+}
+
+
+static std::string GetErrorMsg(const std::string& body)
+{
+	try
+	{
+		ParseBytesResp(body, body.size());
+	}
+	catch (const std::runtime_error& e)
+	{
+		return e.what();
+	}
+	return std::string();
+}
+
+
+} // namespace
+
+
+TEST(TestGethResp, BytesResult)
+{
+	const std::string body =
+		R"({"jsonrpc":"2.0","id":1,"result":"0x00ff10abCD"})";
+	const std::vector<uint8_t> expBytes = { 0x00, 0xFF, 0x10, 0xAB, 0xCD };
+
+	// the hex string is split at every position, including between the two
+	// digits of a byte
+	for (size_t chunkSize = 1; chunkSize <= body.size(); ++chunkSize)
+	{
+		EXPECT_EQ(ParseBytesResp(body, chunkSize), expBytes)
+			<< "in chunks of " << chunkSize;
+	}
+}
+
+
+TEST(TestGethResp, NullResult)
+{
+	EXPECT_EQ(
+		GetErrorMsg(R"({"jsonrpc":"2.0","id":1,"result":null})"),
+		"Invalid response from Geth."
+	);
+	EXPECT_THROW(
+		ParseBytesListResp(R"({"jsonrpc":"2.0","id":1,"result":null})", 4),
+		std::runtime_error
+	);
+}
+
+
+TEST(TestGethResp, ErrorObject)
+{
+	const std::string body =
+		R"({"jsonrpc":"2.0","id":1,)"
+		R"("error":{"code":-32000,"message":"header not found"}})";
+
+	EXPECT_EQ(
+		GetErrorMsg(body),
+		"Invalid response from Geth - header not found"
+	);
+
+	try
+	{
+		ParseBytesListResp(body, 3);
+		ADD_FAILURE() << "an error response is taken as a list";
+	}
+	catch (const std::runtime_error& e)
+	{
+		EXPECT_EQ(
+			std::string(e.what()),
+			"Invalid response from Geth - header not found"
+		);
+	}
+}
+
+
+TEST(TestGethResp, InvalidHex)
+{
+	EXPECT_EQ(
+		GetErrorMsg(R"({"result":"0x"})"),
+		"Invalid response from Geth."
+	);
+	EXPECT_EQ(
+		GetErrorMsg(R"({"result":"00ff"})"),
+		"Invalid response from Geth."
+	);
+	EXPECT_THROW(ParseBytesResp(R"({"result":"0x123"})", 2),
+		std::invalid_argument);
+	EXPECT_ANY_THROW(ParseBytesResp(R"({"result":"0xzz"})", 2));
+	EXPECT_THROW(ParseBytesResp(R"({"result":12})", 2),
+		SimpleJson::ParseError);
+}
+
+
+TEST(TestGethResp, ListResult)
+{
+	EXPECT_TRUE(ParseBytesListResp(R"({"result":[]})", 1).empty());
+
+	const std::string body = R"({"id":7,"result":["0x0102","0xabcdef"]})";
+	const BytesList expList = {
+		{ 0x01, 0x02 },
+		{ 0xAB, 0xCD, 0xEF },
+	};
+	for (size_t chunkSize = 1; chunkSize <= body.size(); ++chunkSize)
+	{
+		EXPECT_EQ(ParseBytesListResp(body, chunkSize), expList)
+			<< "in chunks of " << chunkSize;
+	}
+
+	EXPECT_THROW(
+		ParseBytesListResp(R"({"result":["0x01","0x"]})", 5),
+		std::runtime_error
+	);
+	EXPECT_THROW(
+		ParseBytesListResp(R"({"id":7})", 5),
+		std::runtime_error
+	);
+}
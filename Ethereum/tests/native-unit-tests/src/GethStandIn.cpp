@@ -0,0 +1,197 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+#include <cstdio>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SimpleJson/SimpleJson.hpp>
+
+#include <EthereumClt/Untrusted/BlockCorpus.hpp>
+#include <EthereumClt/Untrusted/GethHeadSubscriber.hpp>
+#include <EthereumClt/Untrusted/GethStandInServer.hpp>
+
+
+namespace
+{
+
+
+using namespace EthereumClt;
+
+
+/**
+ * @brief A corpus of a few blocks, whose contents don't matter to the tests
+ *        that only use the connections of the stand-in server
+ *
+ */
+struct CorpusFixture
+{
+	CorpusFixture(const std::string& path) :
+		m_path(path)
+	{
+		BlockCorpusWriter writer(m_path);
+		for (uint64_t i = 100; i < 110; ++i)
+		{
+			writer.Record(
+				i,
+				std::vector<uint8_t>(10, static_cast<uint8_t>(i)),
+				std::vector<uint8_t>(1, 0xC0)
+			);
+		}
+		writer.Finish();
+	}
+
+	~CorpusFixture()
+	{
+		std::remove(m_path.c_str());
+	}
+
+	std::shared_ptr<BlockCorpusReader> Open() const
+	{
+		return std::make_shared<BlockCorpusReader>(m_path);
+	}
+
+	std::string m_path;
+}; // struct CorpusFixture
+
+
+} // namespace
+
+
+TEST(TestGethStandIn, StopWithIdleConnections)
+{
+	CorpusFixture corpus("TestGethStandIn_StopWithIdle.corpus");
+
+	GethStandInServer::Config config;
+	config.m_numOfWorkers = 2;
+	std::unique_ptr<GethStandInServer> server(
+		new GethStandInServer(corpus.Open(), config)
+	);
+
+	// connect, and never send a request, so the workers are blocked on
+	// receiving from these connections
+	std::vector<std::unique_ptr<GethStandInServer::SocketType> > clients;
+	for (size_t i = 0; i < config.m_numOfWorkers; ++i)
+	{
+		clients.push_back(
+			GethStandInServer::SocketType::ConnectV4(
+				"127.0.0.1",
+				server->GetPort()
+			)
+		);
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	const auto start = std::chrono::steady_clock::now();
+	server->Stop();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+	// the connections are closed by the server
+	for (auto& client : clients)
+	{
+		EXPECT_ANY_THROW(
+			client->RecvSomeBytes<std::string>(16)
+		);
+	}
+}
+
+
+TEST(TestGethHeadSubscriber, FollowStandInHead)
+{
+	CorpusFixture corpus("TestGethHeadSubscriber_FollowHead.corpus");
+
+	GethStandInServer::Config config;
+	config.m_numOfWorkers = 2;
+	config.m_headBlocksPerSec = 20.0;
+	GethStandInServer server(corpus.Open(), config);
+
+	std::mutex mutex;
+	std::condition_variable cond;
+	GethHeadSubscriber::BlockNumber lastHead = 0;
+
+	GethHeadSubscriber subscriber(server.GetWsUrl(), 100);
+	subscriber.SetHeadCallback(
+		[&](GethHeadSubscriber::BlockNumber headBlockNum)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				lastHead = headBlockNum;
+			}
+			cond.notify_all();
+		}
+	);
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		EXPECT_TRUE(cond.wait_for(
+			lock,
+			std::chrono::seconds(5),
+			[&]() { return lastHead == 109; }
+		));
+	}
+
+	GethHeadSubscriber::BlockNumber headBlockNum = 0;
+	EXPECT_TRUE(subscriber.IsSubscribed());
+	EXPECT_TRUE(subscriber.TryGetHeadBlockNum(headBlockNum));
+	EXPECT_EQ(headBlockNum, 109U);
+	EXPECT_GE(subscriber.GetNumOfHeads(), 2U);
+	EXPECT_EQ(subscriber.GetNumOfConnects(), 1U);
+
+	subscriber.Stop();
+	server.Stop();
+}
+
+
+TEST(TestGethHeadSubscriber, StopDuringHandshake)
+{
+	// the connection is accepted by the kernel, but the handshake is never
+	// answered, so the subscriber is left waiting for the response
+	boost::asio::io_service ioService;
+	boost::asio::ip::tcp::acceptor acceptor(
+		ioService,
+		boost::asio::ip::tcp::endpoint(
+			boost::asio::ip::address_v4::loopback(),
+			0
+		)
+	);
+	const std::string url = "ws://127.0.0.1:" +
+		std::to_string(acceptor.local_endpoint().port());
+
+	std::unique_ptr<GethHeadSubscriber> subscriber(
+		new GethHeadSubscriber(url, 100)
+	);
+	const auto connectDeadline =
+		std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (
+		(subscriber->GetNumOfConnects() == 0) &&
+		(std::chrono::steady_clock::now() < connectDeadline)
+	)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_EQ(subscriber->GetNumOfConnects(), 1U);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	const auto start = std::chrono::steady_clock::now();
+	subscriber->Stop();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	EXPECT_LT(elapsed, std::chrono::seconds(1));
+	EXPECT_FALSE(subscriber->IsSubscribed());
+
+	// stopping again (e.g., in the destructor) is a no-op
+	subscriber.reset();
+}
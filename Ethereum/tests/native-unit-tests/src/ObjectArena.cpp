@@ -0,0 +1,244 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SimpleJson/SimpleJson.hpp>
+#include <SimpleObjects/ObjectArena.hpp>
+#include <SimpleObjects/SimpleObjects.hpp>
+#include <SimpleRlp/SimpleRlp.hpp>
+
+
+namespace
+{
+
+
+using namespace SimpleObjects;
+
+
+static Object MakeTree()
+{
+	Dict dict;
+	dict[String("name")] = String("a string long enough to skip SSO");
+	dict[String("list")] = List({ UInt64(1), Null(), Bytes({ 0x01, 0x02 }) });
+	return Object(std::move(dict));
+}
+
+
+static Object MakeRlpTree()
+{
+	return Object(List({
+		Bytes({ 0x01, 0x02, 0x03 }),
+		List({ Bytes(std::vector<uint8_t>(100, 0xAB)), Bytes() }),
+		Bytes({ 0x7F }),
+	}));
+}
+
+
+} // namespace
+
+
+TEST(TestObjectArena, AllocateInScope)
+{
+	ObjectArena arena;
+	EXPECT_EQ(ObjectArenaScope::GetCurrent(), nullptr);
+
+	std::unique_ptr<String> inArena;
+	{
+		ObjectArenaScope scope(arena);
+		EXPECT_EQ(ObjectArenaScope::GetCurrent(), &arena);
+
+		inArena.reset(new String("allocated in the arena"));
+		// the object and the arena prefix, rounded up to the alignment
+		EXPECT_GE(arena.GetAllocatedSize(), sizeof(String) + 16);
+		EXPECT_EQ(arena.GetAllocatedSize() % ObjectArena::sk_alignment, 0U);
+	}
+	EXPECT_EQ(ObjectArenaScope::GetCurrent(), nullptr);
+
+	// allocations outside the scope don't come from the arena
+	const size_t allocatedSize = arena.GetAllocatedSize();
+	std::unique_ptr<String> onHeap(new String("allocated on the heap"));
+	EXPECT_EQ(arena.GetAllocatedSize(), allocatedSize);
+
+	// an arena object freed outside the scope is left to the arena
+	EXPECT_EQ(*inArena, String("allocated in the arena"));
+	inArena.reset();
+	EXPECT_EQ(arena.GetAllocatedSize(), allocatedSize);
+}
+
+
+TEST(TestObjectArena, FreeHeapObjectInScope)
+{
+	std::unique_ptr<Object> onHeap(new Object(MakeTree()));
+	Object replaced = MakeTree();
+
+	ObjectArena arena;
+	{
+		ObjectArenaScope scope(arena);
+
+		// a heap object freed while an arena is active goes back to the
+		// heap
+		EXPECT_EQ(*onHeap, MakeTree());
+		onHeap.reset();
+
+		// the old value is freed to the heap, and the new one is allocated
+		// in the arena
+		const size_t allocatedSize = arena.GetAllocatedSize();
+		replaced = String("replaced");
+		EXPECT_GT(arena.GetAllocatedSize(), allocatedSize);
+	}
+
+	// and the new value is left to the arena
+	EXPECT_EQ(replaced, String("replaced"));
+	replaced = Null();
+
+	arena.Release();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0U);
+}
+
+
+TEST(TestObjectArena, NestedScopes)
+{
+	ObjectArena outer;
+	ObjectArena inner;
+
+	std::unique_ptr<String> outerObj1;
+	std::unique_ptr<String> innerObj;
+	std::unique_ptr<String> outerObj2;
+	std::unique_ptr<String> heapObj;
+	{
+		ObjectArenaScope outerScope(outer);
+		outerObj1.reset(new String("outer 1"));
+		const size_t outerSize = outer.GetAllocatedSize();
+		EXPECT_GT(outerSize, 0U);
+
+		{
+			ObjectArenaScope innerScope(inner);
+			EXPECT_EQ(ObjectArenaScope::GetCurrent(), &inner);
+			innerObj.reset(new String("inner"));
+			EXPECT_GT(inner.GetAllocatedSize(), 0U);
+			EXPECT_EQ(outer.GetAllocatedSize(), outerSize);
+
+			// an outer arena object freed in the inner scope
+			outerObj1.reset();
+		}
+
+		EXPECT_EQ(ObjectArenaScope::GetCurrent(), &outer);
+		const size_t innerSize = inner.GetAllocatedSize();
+		outerObj2.reset(new String("outer 2"));
+		EXPECT_GT(outer.GetAllocatedSize(), outerSize);
+		EXPECT_EQ(inner.GetAllocatedSize(), innerSize);
+	}
+	EXPECT_EQ(ObjectArenaScope::GetCurrent(), nullptr);
+
+	heapObj.reset(new String("heap"));
+
+	EXPECT_EQ(*innerObj, String("inner"));
+	EXPECT_EQ(*outerObj2, String("outer 2"));
+	EXPECT_EQ(*heapObj, String("heap"));
+}
+
+
+TEST(TestObjectArena, Rewind)
+{
+	static constexpr size_t sk_blockSize = 256;
+	static constexpr size_t sk_allocSize = 16;
+	static constexpr size_t sk_allocsPerBlock = sk_blockSize / sk_allocSize;
+
+	ObjectArena arena(sk_blockSize);
+
+	// fills two blocks, and a part of a third one
+	std::vector<void*> ptrs;
+	for (size_t i = 0; i < (sk_allocsPerBlock * 2) + 3; ++i)
+	{
+		ptrs.push_back(arena.Allocate(sk_allocSize));
+	}
+	// a large allocation gets a block of its own
+	arena.Allocate(sk_blockSize);
+	EXPECT_EQ(
+		arena.GetAllocatedSize(),
+		(ptrs.size() * sk_allocSize) + sk_blockSize
+	);
+
+	// starts over from the beginning of the current block
+	arena.Rewind();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0U);
+	EXPECT_EQ(arena.Allocate(sk_allocSize), ptrs[sk_allocsPerBlock * 2]);
+	EXPECT_EQ(arena.Allocate(sk_allocSize), ptrs[(sk_allocsPerBlock * 2) + 1]);
+
+	// objects can be allocated again after a rewind
+	for (size_t round = 0; round < 10; ++round)
+	{
+		{
+			ObjectArenaScope scope(arena);
+			Object tree = MakeTree();
+			EXPECT_EQ(tree, MakeTree());
+		}
+		arena.Rewind();
+		EXPECT_EQ(arena.GetAllocatedSize(), 0U);
+	}
+
+	arena.Release();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0U);
+	EXPECT_NE(arena.Allocate(sk_allocSize), nullptr);
+}
+
+
+TEST(TestObjectArena, ParseRlp)
+{
+	const std::vector<uint8_t> rlp = SimpleRlp::WriteRlp(MakeRlpTree());
+
+	ObjectArena arena;
+	std::unique_ptr<Object> copy;
+	{
+		Object parsed = SimpleRlp::ParseRlp(rlp, arena);
+		EXPECT_EQ(ObjectArenaScope::GetCurrent(), nullptr);
+		EXPECT_GT(arena.GetAllocatedSize(), 0U);
+		EXPECT_EQ(parsed, SimpleRlp::ParseRlp(rlp));
+		EXPECT_EQ(parsed, MakeRlpTree());
+
+		// a copy made outside the scope is on the heap
+		const size_t allocatedSize = arena.GetAllocatedSize();
+		copy.reset(new Object(parsed));
+		EXPECT_EQ(arena.GetAllocatedSize(), allocatedSize);
+	}
+
+	// the arena is released once its objects are gone, while the copy
+	// stays valid
+	arena.Release();
+	EXPECT_EQ(*copy, MakeRlpTree());
+}
+
+
+TEST(TestObjectArena, LoadStr)
+{
+	const std::string json =
+		R"({"name":"a string long enough to skip SSO",)"
+		R"("nested":{"list":[1,2.5,null,true,"x"]}})";
+
+	ObjectArena arena;
+	std::unique_ptr<Object> copy;
+	{
+		Object parsed = SimpleJson::LoadStr(json, arena);
+		EXPECT_EQ(ObjectArenaScope::GetCurrent(), nullptr);
+		EXPECT_GT(arena.GetAllocatedSize(), 0U);
+		EXPECT_EQ(parsed, SimpleJson::LoadStr(json));
+
+		const size_t allocatedSize = arena.GetAllocatedSize();
+		copy.reset(new Object(parsed));
+		EXPECT_EQ(arena.GetAllocatedSize(), allocatedSize);
+	}
+
+	arena.Release();
+	EXPECT_EQ(*copy, SimpleJson::LoadStr(json));
+}
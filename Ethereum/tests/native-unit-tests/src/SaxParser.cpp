@@ -0,0 +1,434 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SimpleJson/SimpleJson.hpp>
+
+
+namespace
+{
+
+
+using namespace SimpleJson;
+
+
+/**
+ * @brief Records the events as a string, with the chunks of a string joined,
+ *        so the record doesn't depend on how the input is split
+ *
+ */
+class RecordHandler :
+	public SaxHandlerIf
+{
+public:
+
+	RecordHandler() :
+		m_rec()
+	{}
+
+	virtual ~RecordHandler() = default;
+
+	virtual void OnNull() override
+	{
+		m_rec += "null,";
+	}
+
+	virtual void OnBool(bool val) override
+	{
+		m_rec += (val ? "true," : "false,");
+	}
+
+	virtual void OnNumber(const std::string& num) override
+	{
+		m_rec += "#" + num + ",";
+	}
+
+	virtual void OnStringBegin() override
+	{
+		m_rec += "\"";
+	}
+
+	virtual void OnStringChunk(const char* data, size_t size) override
+	{
+		m_rec.append(data, size);
+	}
+
+	virtual void OnStringEnd() override
+	{
+		m_rec += "\",";
+	}
+
+	virtual void OnListBegin() override
+	{
+		m_rec += "[";
+	}
+
+	virtual void OnListEnd() override
+	{
+		m_rec += "],";
+	}
+
+	virtual void OnDictBegin() override
+	{
+		m_rec += "{";
+	}
+
+	virtual void OnKey(const std::string& key) override
+	{
+		m_rec += key + ":";
+	}
+
+	virtual void OnDictEnd() override
+	{
+		m_rec += "},";
+	}
+
+	const std::string& GetRec() const
+	{
+		return m_rec;
+	}
+
+private:
+
+	std::string m_rec;
+}; // class RecordHandler
+
+
+static std::string Parse(const std::string& input, size_t chunkSize)
+{
+	RecordHandler handler;
+	SaxParser parser(handler);
+	for (size_t pos = 0; pos < input.size(); pos += chunkSize)
+	{
+		parser.Feed(input.substr(pos, chunkSize));
+	}
+	parser.Finish();
+	return handler.GetRec();
+}
+
+
+static std::string ParseSplitAt(const std::string& input, size_t splitPos)
+{
+	RecordHandler handler;
+	SaxParser parser(handler);
+	parser.Feed(input.substr(0, splitPos));
+	parser.Feed(input.substr(splitPos));
+	parser.Finish();
+	return handler.GetRec();
+}
+
+
+/**
+ * @brief Expects the same events from the input in one chunk, split in two
+ *        at every position, and fed one byte at a time
+ *
+ */
+static void ExpectEvents(const std::string& input, const std::string& expRec)
+{
+	EXPECT_EQ(Parse(input, input.size()), expRec) << input;
+	for (size_t splitPos = 1; splitPos < input.size(); ++splitPos)
+	{
+		EXPECT_EQ(ParseSplitAt(input, splitPos), expRec)
+			<< input << " split at " << splitPos;
+	}
+	EXPECT_EQ(Parse(input, 1), expRec) << input << " in 1-byte chunks";
+}
+
+
+/**
+ * @brief Expects a parse error at the same position, however the input is
+ *        split
+ *
+ */
+static void ExpectError(
+	const std::string& input,
+	size_t lineNum,
+	size_t colNum
+)
+{
+	for (size_t chunkSize = 1; chunkSize <= input.size(); ++chunkSize)
+	{
+		try
+		{
+			Parse(input, chunkSize);
+			ADD_FAILURE() << input << " is parsed";
+		}
+		catch (const ParseError& e)
+		{
+			EXPECT_EQ(e.GetLineNum(), lineNum)
+				<< input << " in chunks of " << chunkSize << " - " << e.what();
+			EXPECT_EQ(e.GetColNum(), colNum)
+				<< input << " in chunks of " << chunkSize << " - " << e.what();
+		}
+	}
+}
+
+
+class StringSink :
+	public SaxStringSinkIf
+{
+public:
+
+	StringSink() :
+		m_values(),
+		m_curr()
+	{}
+
+	virtual ~StringSink() = default;
+
+	virtual void OnBegin() override
+	{
+		m_curr.clear();
+	}
+
+	virtual void OnChunk(const char* data, size_t size) override
+	{
+		m_curr.append(data, size);
+	}
+
+	virtual void OnEnd() override
+	{
+		m_values.push_back(m_curr);
+	}
+
+	std::vector<std::string> m_values;
+
+private:
+
+	std::string m_curr;
+}; // class StringSink
+
+
+class ListSink :
+	public SaxListSinkIf
+{
+public:
+
+	ListSink() :
+		m_beginCount(0),
+		m_endCount(0)
+	{}
+
+	virtual ~ListSink() = default;
+
+	virtual void OnBegin() override
+	{
+		++m_beginCount;
+	}
+
+	virtual void OnEnd() override
+	{
+		++m_endCount;
+	}
+
+	size_t m_beginCount;
+	size_t m_endCount;
+}; // class ListSink
+
+
+static void Extract(SaxExtractor& extractor, const std::string& input)
+{
+	for (size_t chunkSize = 1; chunkSize <= input.size(); chunkSize *= 3)
+	{
+		SaxParser parser(extractor);
+		for (size_t pos = 0; pos < input.size(); pos += chunkSize)
+		{
+			parser.Feed(input.substr(pos, chunkSize));
+		}
+		parser.Finish();
+	}
+}
+
+
+} // namespace
+
+
+TEST(TestSaxParser, Strings)
+{
+	ExpectEvents(R"("")", "\"\",");
+	ExpectEvents(R"("abc def")", "\"abc def\",");
+	ExpectEvents(
+		R"("a\"b\\c\/d\be\ff\ng\rh\ti")",
+		"\"a\"b\\c/d\be\ff\ng\rh\ti\","
+	);
+	ExpectEvents(R"("caf\u00e9")", "\"caf\xC3\xA9\",");
+	ExpectEvents(R"("\u20AC")", "\"\xE2\x82\xAC\",");
+	// a surrogate pair
+	ExpectEvents(R"("a\ud83d\ude00b")", "\"a\xF0\x9F\x98\x80" "b\",");
+	// raw multi-byte UTF-8
+	ExpectEvents(
+		"\"caf\xC3\xA9 \xF0\x9F\x98\x80\"",
+		"\"caf\xC3\xA9 \xF0\x9F\x98\x80\","
+	);
+}
+
+
+TEST(TestSaxParser, Numbers)
+{
+	ExpectEvents("0", "#0,");
+	ExpectEvents("-12345", "#-12345,");
+	ExpectEvents("1.5e+10", "#1.5e+10,");
+	ExpectEvents("-0.25E-3", "#-0.25E-3,");
+	ExpectEvents("[123,-4.5e6]", "[#123,#-4.5e6,],");
+	ExpectEvents(R"({"n":98765})", "{n:#98765,},");
+}
+
+
+TEST(TestSaxParser, Structures)
+{
+	ExpectEvents(
+		" { \"a\" : [ null , true , false , { } , [ ] ] ,\n\"b\":\"c\" } ",
+		"{a:[null,true,false,{},[],],b:\"c\",},"
+	);
+	ExpectEvents(
+		R"({"k\u0041y":{"x":[[1],[2,3]]}})",
+		"{kAy:{x:[[#1,],[#2,#3,],],},},"
+	);
+}
+
+
+TEST(TestSaxParser, Truncated)
+{
+	ExpectError(R"({"a": [1, 2)", 0, 11);
+	ExpectError(R"("abc)", 0, 4);
+	ExpectError("tru", 0, 3);
+	ExpectError("[1,\n2", 1, 1);
+	ExpectError(R"("\u00)", 0, 5);
+	EXPECT_THROW(Parse("", 1), ParseError);
+}
+
+
+TEST(TestSaxParser, Malformed)
+{
+	ExpectError(R"({"a" 1})", 0, 5);
+	ExpectError("[1,\n  x]", 1, 2);
+	ExpectError("[01]", 0, 3);
+	ExpectError("[1.]", 0, 3);
+	ExpectError("1 2", 0, 2);
+	ExpectError("[1,]", 0, 3);
+	ExpectError("{\"a\":1,}", 0, 7);
+	ExpectError("nul!", 0, 3);
+	ExpectError(R"("\x")", 0, 2);
+	ExpectError(R"("\u12g4")", 0, 5);
+	// a high surrogate that isn't followed by a low one
+	ExpectError(R"("\ud800x")", 0, 7);
+	ExpectError("\"\xFF\"", 0, 1);
+}
+
+
+TEST(TestSaxExtractor, NestedPaths)
+{
+	StringSink topSink;
+	StringSink nestedSink;
+	StringSink missingSink;
+	SaxExtractor extractor;
+	extractor.Bind("a", topSink);
+	extractor.Bind("b.c.d", nestedSink);
+	extractor.Bind("b.x", missingSink);
+
+	Extract(
+		extractor,
+		R"({"b":{"x2":"no","c":{"e":"no","d":"found"}},"a":"top",)"
+		R"("c":{"d":"no"},"d":"no"})"
+	);
+
+	ASSERT_FALSE(topSink.m_values.empty());
+	EXPECT_EQ(topSink.m_values.back(), "top");
+	ASSERT_FALSE(nestedSink.m_values.empty());
+	EXPECT_EQ(nestedSink.m_values.back(), "found");
+	EXPECT_TRUE(missingSink.m_values.empty());
+
+	// the sinks are notified once per parse
+	EXPECT_EQ(topSink.m_values.size(), nestedSink.m_values.size());
+}
+
+
+TEST(TestSaxExtractor, ListPaths)
+{
+	ListSink listSink;
+	StringSink itemSink;
+	StringSink secondSink;
+	StringSink nestedSink;
+	SaxExtractor extractor;
+	extractor.Bind("r", listSink);
+	extractor.Bind("r[1]", secondSink);
+	extractor.Bind("r[*]", itemSink);
+	extractor.Bind("n[*][0].v", nestedSink);
+
+	SaxParser parser(extractor);
+	parser.Feed(
+		R"({"r":["a","b","c"],"n":[[{"v":"x"},{"v":"no"}],[{"v":"y"}]]})"
+	);
+	parser.Finish();
+
+	EXPECT_EQ(listSink.m_beginCount, 1U);
+	EXPECT_EQ(listSink.m_endCount, 1U);
+	// a value goes to the first binding it matches only
+	EXPECT_EQ(secondSink.m_values, std::vector<std::string>({ "b" }));
+	EXPECT_EQ(itemSink.m_values, std::vector<std::string>({ "a", "c" }));
+	EXPECT_EQ(nestedSink.m_values, std::vector<std::string>({ "x", "y" }));
+}
+
+
+TEST(TestSaxExtractor, NullIsMissing)
+{
+	ListSink listSink;
+	StringSink strSink;
+	SaxExtractor extractor;
+	extractor.Bind("l", listSink);
+	extractor.Bind("s", strSink);
+
+	SaxParser parser(extractor);
+	parser.Feed(R"({"l":null,"s":null})");
+	parser.Finish();
+
+	EXPECT_EQ(listSink.m_beginCount, 0U);
+	EXPECT_TRUE(strSink.m_values.empty());
+}
+
+
+TEST(TestSaxExtractor, TypeMismatch)
+{
+	{
+		StringSink strSink;
+		SaxExtractor extractor;
+		extractor.Bind("a.b", strSink);
+		SaxParser parser(extractor);
+		EXPECT_THROW(parser.Feed(R"({"a":{"b":12}})"), ParseError);
+	}
+	{
+		StringSink strSink;
+		SaxExtractor extractor;
+		extractor.Bind("a", strSink);
+		SaxParser parser(extractor);
+		EXPECT_THROW(parser.Feed(R"({"a":["x"]})"), ParseError);
+	}
+	{
+		ListSink listSink;
+		SaxExtractor extractor;
+		extractor.Bind("a", listSink);
+		SaxParser parser(extractor);
+		EXPECT_THROW(parser.Feed(R"({"a":"x"})"), ParseError);
+	}
+}
+
+
+TEST(TestSaxExtractor, InvalidPaths)
+{
+	StringSink strSink;
+	SaxExtractor extractor;
+	EXPECT_THROW(extractor.Bind(".a", strSink), Exception);
+	EXPECT_THROW(extractor.Bind("a..b", strSink), Exception);
+	EXPECT_THROW(extractor.Bind("a[]", strSink), Exception);
+	EXPECT_THROW(extractor.Bind("a[x]", strSink), Exception);
+	EXPECT_THROW(extractor.Bind("a[1", strSink), Exception);
+}
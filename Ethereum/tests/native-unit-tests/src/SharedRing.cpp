@@ -0,0 +1,277 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <DecentEnclave/Common/SharedRing.hpp>
+#include <DecentEnclave/Untrusted/Hosting/SharedRingPump.hpp>
+#include <SimpleSysIO/SysCall/TCPAcceptor.hpp>
+
+
+namespace
+{
+
+
+using namespace DecentEnclave::Common;
+using DecentEnclave::Untrusted::Hosting::SharedRingPump;
+
+
+static constexpr uint64_t sk_capacity = 4096;
+
+
+/**
+ * @brief A connected pair of TCP sockets, where the client side is pumped
+ *        through a shared ring, and the enclave side of the ring is driven
+ *        the same way SharedRingStreamSocket does it
+ *
+ */
+struct RingFixture
+{
+	RingFixture() :
+		m_ioService(std::make_shared<boost::asio::io_service>()),
+		m_work(new boost::asio::io_service::work(*m_ioService)),
+		m_ioThread(),
+		m_peer(),
+		m_client(),
+		m_pump(),
+		m_txWriter(),
+		m_rxReader()
+	{
+		auto acceptor = SimpleSysIO::SysCall::TCPAcceptor::BindV4(
+			"127.0.0.1",
+			0,
+			m_ioService
+		);
+		m_client = SimpleSysIO::SysCall::TCPSocket::ConnectV4(
+			"127.0.0.1",
+			acceptor->GetLocalPort(),
+			m_ioService
+		);
+		m_peer = acceptor->TCPAccept();
+
+		m_ioThread = std::thread([this]() { m_ioService->run(); });
+
+		m_pump = SharedRingPump::Create(*m_client, sk_capacity);
+		void* mem = m_pump->GetSharedMemory();
+		m_txWriter.reset(new SharedRingWriter(
+			SharedRingLayout::GetTxHeader(mem),
+			SharedRingLayout::GetTxData(mem, sk_capacity),
+			sk_capacity
+		));
+		m_rxReader.reset(new SharedRingReader(
+			SharedRingLayout::GetRxHeader(mem),
+			SharedRingLayout::GetRxData(mem, sk_capacity),
+			sk_capacity
+		));
+	}
+
+	~RingFixture()
+	{
+		m_pump->Close();
+		m_work.reset();
+		m_ioService->stop();
+		m_ioThread.join();
+	}
+
+	void EnclaveSend(const std::vector<uint8_t>& data)
+	{
+		size_t sent = 0;
+		while (sent < data.size())
+		{
+			size_t size =
+				m_txWriter->TryWrite(data.data() + sent, data.size() - sent);
+			if (size == 0)
+			{
+				m_pump->WaitTxSpace();
+				continue;
+			}
+			sent += size;
+			if (m_txWriter->IsReaderWaiting())
+			{
+				m_pump->Notify();
+			}
+		}
+	}
+
+	std::vector<uint8_t> EnclaveRecv(size_t size)
+	{
+		std::vector<uint8_t> res(size);
+		size_t recv = 0;
+		while (recv < size)
+		{
+			size_t readSize =
+				m_rxReader->TryRead(res.data() + recv, size - recv);
+			if (readSize == 0)
+			{
+				m_pump->WaitRxData();
+				continue;
+			}
+			recv += readSize;
+			if (m_rxReader->IsWriterWaiting())
+			{
+				m_pump->Notify();
+			}
+		}
+		return res;
+	}
+
+	static std::vector<uint8_t> MakeData(size_t size, uint8_t seed)
+	{
+		std::vector<uint8_t> res(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			res[i] = static_cast<uint8_t>((i * 31) + seed);
+		}
+		return res;
+	}
+
+	std::shared_ptr<boost::asio::io_service> m_ioService;
+	std::unique_ptr<boost::asio::io_service::work> m_work;
+	std::thread m_ioThread;
+	std::unique_ptr<SimpleSysIO::SysCall::TCPSocket> m_peer;
+	std::unique_ptr<SimpleSysIO::SysCall::TCPSocket> m_client;
+	std::shared_ptr<SharedRingPump> m_pump;
+	std::unique_ptr<SharedRingWriter> m_txWriter;
+	std::unique_ptr<SharedRingReader> m_rxReader;
+}; // struct RingFixture
+
+
+} // namespace
+
+
+TEST(TestSharedRing, RingWrapAround)
+{
+	std::vector<uint8_t> mem(SharedRingLayout::GetSize(16));
+	new (SharedRingLayout::GetTxHeader(mem.data())) SharedRingHeader();
+
+	SharedRingWriter writer(
+		SharedRingLayout::GetTxHeader(mem.data()),
+		SharedRingLayout::GetTxData(mem.data(), 16),
+		16
+	);
+	SharedRingReader reader(
+		SharedRingLayout::GetTxHeader(mem.data()),
+		SharedRingLayout::GetTxData(mem.data(), 16),
+		16
+	);
+
+	std::vector<uint8_t> out(16);
+	for (uint8_t round = 0; round < 10; ++round)
+	{
+		auto in = RingFixture::MakeData(11, round);
+		EXPECT_EQ(writer.TryWrite(in.data(), in.size()), in.size());
+		EXPECT_EQ(writer.TryWrite(in.data(), in.size()), 5U);
+		EXPECT_EQ(reader.TryRead(out.data(), 11), 11U);
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + 11), in);
+		EXPECT_EQ(reader.TryRead(out.data(), out.size()), 5U);
+	}
+	EXPECT_EQ(reader.TryRead(out.data(), out.size()), 0U);
+}
+
+
+TEST(TestSharedRing, PumpRoundTrip)
+{
+	RingFixture fixture;
+
+	// larger than the ring, so both sides have to wait for each other
+	const auto txData = RingFixture::MakeData(sk_capacity * 50 + 123, 1);
+	std::thread sender([&]() { fixture.EnclaveSend(txData); });
+	std::vector<uint8_t> peerRecv;
+	while (peerRecv.size() < txData.size())
+	{
+		auto bytes = fixture.m_peer->RecvSomeBytes<std::vector<uint8_t> >(
+			txData.size() - peerRecv.size()
+		);
+		peerRecv.insert(peerRecv.end(), bytes.begin(), bytes.end());
+	}
+	sender.join();
+	EXPECT_EQ(peerRecv, txData);
+
+	const auto rxData = RingFixture::MakeData(sk_capacity * 50 + 321, 2);
+	std::thread receiver(
+		[&]()
+		{
+			EXPECT_EQ(fixture.EnclaveRecv(rxData.size()), rxData);
+		}
+	);
+	fixture.m_peer->SendBytes(rxData);
+	receiver.join();
+}
+
+
+TEST(TestSharedRing, PumpAsyncNotify)
+{
+	RingFixture fixture;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool isCalled = false;
+	bool hasError = true;
+	fixture.m_pump->AsyncNotifyOnRecv(
+		[&](std::vector<uint8_t>, bool hasErrorOccurred)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isCalled = true;
+			hasError = hasErrorOccurred;
+			cv.notify_all();
+		}
+	);
+
+	const auto data = RingFixture::MakeData(100, 3);
+	fixture.m_peer->SendBytes(data);
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		ASSERT_TRUE(cv.wait_for(
+			lock,
+			std::chrono::seconds(5),
+			[&]() { return isCalled; }
+		));
+	}
+	EXPECT_FALSE(hasError);
+	EXPECT_EQ(fixture.EnclaveRecv(data.size()), data);
+}
+
+
+TEST(TestSharedRing, PumpCloseCompletesPendingNotify)
+{
+	RingFixture fixture;
+
+	std::mutex mutex;
+	bool isCalled = false;
+	bool hasError = false;
+	fixture.m_pump->AsyncNotifyOnRecv(
+		[&](std::vector<uint8_t>, bool hasErrorOccurred)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isCalled = true;
+			hasError = hasErrorOccurred;
+		}
+	);
+
+	// Close joins the notifier thread, so the callback is done by then
+	fixture.m_pump->Close();
+	std::lock_guard<std::mutex> lock(mutex);
+	EXPECT_TRUE(isCalled);
+	EXPECT_TRUE(hasError);
+
+	EXPECT_THROW(
+		fixture.m_pump->AsyncNotifyOnRecv(
+			[](std::vector<uint8_t>, bool) {}
+		),
+		Exception
+	);
+}
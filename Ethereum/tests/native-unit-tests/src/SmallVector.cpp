@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Decentagram
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+
+#include <list>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SimpleObjects/SmallVector.hpp>
+
+
+namespace
+{
+
+
+using SmallVec = SimpleObjects::SmallVector<uint8_t, 16>;
+
+
+template<typename _VecType>
+std::vector<uint8_t> ToStdVector(const _VecType& vec)
+{
+	return std::vector<uint8_t>(vec.begin(), vec.end());
+}
+
+
+} // namespace
+
+
+TEST(TestSmallVector, InlineToHeap)
+{
+	SmallVec vec;
+	for (uint8_t i = 0; i < 40; ++i)
+	{
+		vec.push_back(i);
+	}
+	EXPECT_EQ(vec.size(), 40U);
+	EXPECT_GE(vec.capacity(), 40U);
+	for (uint8_t i = 0; i < 40; ++i)
+	{
+		EXPECT_EQ(vec[i], i);
+	}
+
+	SmallVec moved(std::move(vec));
+	EXPECT_EQ(moved.size(), 40U);
+	EXPECT_EQ(moved[39], 39);
+}
+
+
+TEST(TestSmallVector, InsertRange)
+{
+	SmallVec vec = { 0, 1, 2, 3 };
+	const std::list<uint8_t> src = { 7, 8, 9 };
+	vec.insert(vec.begin() + 2, src.begin(), src.end());
+	EXPECT_EQ(ToStdVector(vec), std::vector<uint8_t>({ 0, 1, 7, 8, 9, 2, 3 }));
+}
+
+
+TEST(TestSmallVector, InsertSelfSubRangeWithoutGrowth)
+{
+	// the gap shifts the source range, which is after the insert position
+	SmallVec vec = { 0, 1, 2, 3, 4, 5 };
+	ASSERT_GE(vec.capacity(), vec.size() + 3);
+	vec.insert(vec.begin() + 1, vec.begin() + 3, vec.begin() + 6);
+	EXPECT_EQ(
+		ToStdVector(vec),
+		std::vector<uint8_t>({ 0, 3, 4, 5, 1, 2, 3, 4, 5 })
+	);
+
+	// the source range covers the insert position
+	SmallVec vec2 = { 0, 1, 2, 3, 4, 5 };
+	vec2.insert(vec2.begin() + 2, vec2.begin() + 1, vec2.begin() + 4);
+	EXPECT_EQ(
+		ToStdVector(vec2),
+		std::vector<uint8_t>({ 0, 1, 1, 2, 3, 2, 3, 4, 5 })
+	);
+}
+
+
+TEST(TestSmallVector, InsertSelfSubRangeWithGrowth)
+{
+	SmallVec vec;
+	for (uint8_t i = 0; i < 16; ++i)
+	{
+		vec.push_back(i);
+	}
+	ASSERT_EQ(vec.capacity(), vec.size());
+
+	std::vector<uint8_t> expVec = { 0, 1, 2, 3 };
+	for (uint8_t i = 8; i < 16; ++i)
+	{
+		expVec.push_back(i);
+	}
+	for (uint8_t i = 4; i < 16; ++i)
+	{
+		expVec.push_back(i);
+	}
+
+	vec.insert(vec.begin() + 4, vec.begin() + 8, vec.end());
+	EXPECT_EQ(ToStdVector(vec), expVec);
+}
+
+
+TEST(TestSmallVector, InsertSelfValue)
+{
+	SmallVec vec = { 0, 1, 2, 3 };
+	vec.insert(vec.begin(), vec[3]);
+	EXPECT_EQ(ToStdVector(vec), std::vector<uint8_t>({ 3, 0, 1, 2, 3 }));
+}
@@ -5,6 +5,7 @@
 
 
 #include <DecentEnclave/Common/DecentTlsConfig.hpp>
+#include <DecentEnclave/Common/LogBuffer.hpp>
 #include <DecentEnclave/Common/Platform/Print.hpp>
 #include <DecentEnclave/Common/Sgx/MbedTlsInit.hpp>
 #include <DecentEnclave/Common/TlsSocket.hpp>
@@ -148,6 +149,8 @@ extern "C" sgx_status_t ecall_revoker_init(
 	const uint8_t* pub_addr
 )
 {
+	LogFlushGuard logFlushGuard;
+
 	try
 	{
 		EclipseMonitor::Eth::ContractAddr pubAddr;
@@ -7,14 +7,19 @@
 
 
 #include <cstdint>
+#include <exception>
+#include <string>
 #include <vector>
 
 #include <AdvancedRlp/AdvancedRlp.hpp>
 
 #include <DecentEnclave/Common/DeterministicMsg.hpp>
+#include <DecentEnclave/Common/LatencyTrace.hpp>
 #include <DecentEnclave/Common/Logging.hpp>
+#include <DecentEnclave/Trusted/Time.hpp>
 
 #include <EclipseMonitor/MonitorReport.hpp>
+#include <EclipseMonitor/TraceHop.hpp>
 #include <EclipseMonitor/Eth/DataTypes.hpp>
 
 #include <SimpleObjects/Codec/Hex.hpp>
@@ -61,6 +66,61 @@ inline EclipseMonitor::Eth::BlockNumber BlkNumFromBytesBase(
 }
 
 
+/**
+ * @brief Latencies of the events traced by the Ethereum client, from the
+ *        time it fetched their block to the time they are received here
+ *
+ */
+inline DecentEnclave::Common::LatencyTraceStats& GetEventLatencyStats()
+{
+	static DecentEnclave::Common::LatencyTraceStats s_stats(
+		EclipseMonitor::GetTraceHopNames()
+	);
+	return s_stats;
+}
+
+
+inline void RecordEventTrace(
+	const SimpleObjects::BytesBaseObj& traceBytes,
+	uint64_t recvNanoSec
+)
+{
+	static DecentEnclave::Common::Logger s_logger =
+		DecentEnclave::Common::LoggerFactory::GetLogger(
+			"HandleEthHeartbeatMsg"
+		);
+	static constexpr uint64_t sk_summaryInterval = 32;
+
+	DecentEnclave::Common::LatencyTrace trace;
+	try
+	{
+		trace = DecentEnclave::Common::LatencyTrace::FromBytes(traceBytes);
+	}
+	catch (const std::exception& e)
+	{
+		// the trace is only for measurements, so a bad one shouldn't stop
+		// the event from being handled
+		s_logger.Warn(
+			std::string("Dropped an invalid event trace: ") + e.what()
+		);
+		return;
+	}
+	trace.Stamp(
+		EclipseMonitor::TraceHopToIdx(EclipseMonitor::TraceHop::Recv),
+		recvNanoSec
+	);
+
+	auto& stats = GetEventLatencyStats();
+	stats.Add(trace);
+	if (stats.GetNumOfTraces() % sk_summaryInterval == 0)
+	{
+		s_logger.Info(
+			"Latency of the sampled events:\n" + stats.ToString()
+		);
+	}
+}
+
+
 inline void HandleRevokeEvent(const SimpleObjects::ListBaseObj& evList)
 {
 	static DecentEnclave::Common::Logger s_logger =
@@ -70,23 +130,37 @@ inline void HandleRevokeEvent(const SimpleObjects::ListBaseObj& evList)
 
 	s_logger.Debug("Received " + std::to_string(evList.size()) + " events");
 
+	// the receive time is only needed for the traced events, so the OCALL
+	// is taken once, for the first of them
+	uint64_t recvNanoSec = 0;
+
 	for (const auto& ev: evList)
 	{
 		const auto& evFields = ev.AsList();
 
-		// each event has 2 fields: [blkNum, evData]
+		// each event has 2 fields: [blkNum, evData],
+		// and a 3rd one if it's traced: [blkNum, evData, trace]
 		const auto& blkNumRef = evFields[0].AsBytes();
 		const auto& evDataRef = evFields[1].AsBytes();
+		if (evFields.size() > 2)
+		{
+			if (recvNanoSec == 0)
+			{
+				recvNanoSec =
+					DecentEnclave::Trusted::UntrustedTime::TimestampNanoSec();
+			}
+			RecordEventTrace(evFields[2].AsBytes(), recvNanoSec);
+		}
 
 		auto blkNum = BlkNumFromBytesBase(blkNumRef);
 
-		std::string dataHex = SimpleObjects::Codec::Hex::Encode<std::string>(
-			evDataRef
-		);
-
 		s_logger.Debug(
-			"Received Data: " + dataHex +
-			" @ block " + std::to_string(blkNum)
+			[&]()
+			{
+				return "Received Data: " +
+					SimpleObjects::Codec::Hex::Encode<std::string>(evDataRef) +
+					" @ block " + std::to_string(blkNum);
+			}
 		);
 	}
 }
@@ -99,7 +173,6 @@ inline void HandleEthHeartbeatMsg(std::vector<uint8_t> msgAdvRlp)
 			"HandleEthHeartbeatMsg"
 		);
 
-
 	auto msg = AdvancedRlp::Parse(msgAdvRlp);
 
 	static const SimpleObjects::String sk_labelSecState("SecState");
@@ -123,15 +196,17 @@ inline void HandleEthHeartbeatMsg(std::vector<uint8_t> msgAdvRlp)
 	const auto& chkptHash = secState.get_checkpointHash();
 	const auto& chkptNumBytes = secState.get_checkpointNum();
 
-	auto chkptHashHex =
-		SimpleObjects::Codec::Hex::Encode<std::string>(chkptHash);
 	auto chkptNum =
 		EclipseMonitor::Eth::BlkNumTypeTrait::FromBytes(chkptNumBytes);
 	s_logger.Info(
-		std::string("Received Decent Ethereum Heartbeat:\n") +
-		"Latest block number: " + std::to_string(latestBlkNum) + "\n" +
-		"Checkpoint number:   " + std::to_string(chkptNum) + "\n" +
-		"Checkpoint hash:     " + chkptHashHex
+		[&]()
+		{
+			return std::string("Received Decent Ethereum Heartbeat:\n") +
+				"Latest block number: " + std::to_string(latestBlkNum) + "\n" +
+				"Checkpoint number:   " + std::to_string(chkptNum) + "\n" +
+				"Checkpoint hash:     " +
+				SimpleObjects::Codec::Hex::Encode<std::string>(chkptHash);
+		}
 	);
 
 	HandleRevokeEvent(evQueue);
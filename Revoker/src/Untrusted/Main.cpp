@@ -11,8 +11,13 @@
 #include <DecentEnclave/Common/Sgx/MbedTlsInit.hpp>
 #include <DecentEnclave/Untrusted/Config/AuthList.hpp>
 #include <DecentEnclave/Untrusted/Config/EndpointsMgr.hpp>
+#include <DecentEnclave/Untrusted/Config/Executor.hpp>
+#include <DecentEnclave/Untrusted/Config/Logging.hpp>
+#include <DecentEnclave/Untrusted/Config/SharedClock.hpp>
 #include <DecentEnclave/Untrusted/Hosting/BoostAsioService.hpp>
-#include <SimpleConcurrency/Threading/ThreadPool.hpp>
+#include <DecentEnclave/Untrusted/RunUntilSignal.hpp>
+#include <DecentEnclave/Untrusted/SharedClockTicker.hpp>
+#include <SimpleConcurrency/Threading/PartitionedExecutor.hpp>
 #include <SimpleJson/SimpleJson.hpp>
 #include <SimpleObjects/Internal/make_unique.hpp>
 #include <SimpleObjects/Codec/Hex.hpp>
@@ -20,7 +25,6 @@
 #include <SimpleSysIO/SysCall/Files.hpp>
 
 #include "Revoker.hpp"
-#include "RunUntilSignal.hpp"
 
 
 using namespace DecentEnclave;
@@ -62,15 +66,27 @@ int main(int argc, char* argv[]) {
 	std::vector<uint8_t> authListAdvRlp = Config::ConfigToAuthListAdvRlp(config);
 
 
-	// Thread pool
-	std::shared_ptr<ThreadPool> threadPool = std::make_shared<ThreadPool>(5);
+	// Logging (optional)
+	// where the host writes the log messages, and the log levels, which
+	// are applied to the host's loggers here, and to the enclave's once
+	// it's created
+	Config::ConfigureLogWriter(config);
+	const Config::LogLevelList logLevels = Config::ConfigToLogLevels(config);
+	Config::ApplyLogLevels(logLevels);
+
+
+	// Executor
+	std::shared_ptr<PartitionedExecutor> executor =
+		std::make_shared<PartitionedExecutor>(
+			Config::ConfigToWorkerPoolSize(config, 4)
+		);
 
 
 	// Boost IO Service
 	std::unique_ptr<Hosting::BoostAsioService> asioService =
 		SimpleObjects::Internal::make_unique<Hosting::BoostAsioService>();
 	auto asioIoService = asioService->GetIoService();
-	threadPool->AddTask(std::move(asioService));
+	executor->AddServiceTask(std::move(asioService));
 
 
 	// Endpoints Manager
@@ -91,6 +107,20 @@ int main(int argc, char* argv[]) {
 	}
 	std::copy(pubAddrBytes.begin(), pubAddrBytes.end(), pubAddr.begin());
 
+	// Shared clock
+	// the enclave reads the time from it, instead of making an OCALL
+	const uint64_t clockTickMicroSec =
+		Config::ConfigToSharedClockTick(config, 1000);
+	std::unique_ptr<SharedClockTicker> clockTicker;
+	if (clockTickMicroSec != 0)
+	{
+		clockTicker =
+			SimpleObjects::Internal::make_unique<SharedClockTicker>(
+				clockTickMicroSec
+			);
+	}
+
+
 	// Create enclave
 	const auto& imgConfig = config.AsDict()[String("EnclaveImage")].AsDict();
 	std::string imgPath = imgConfig[String("ImagePath")].AsString().c_str();
@@ -101,18 +131,29 @@ int main(int argc, char* argv[]) {
 		imgPath,
 		tokenPath
 	);
+	if (clockTicker != nullptr)
+	{
+		enclave->BindSharedClock(clockTicker->GetPage());
+	}
+	for (const auto& logLevel : logLevels)
+	{
+		enclave->SetLogLevel(logLevel.first, logLevel.second);
+	}
 
 
 	RunUntilSignal(
 		[&]()
 		{
-			threadPool->Update();
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			executor->WaitAndUpdate();
+		},
+		[&]()
+		{
+			executor->WakeUp();
 		}
 	);
 
 
-	threadPool->Terminate();
+	executor->Terminate();
 
 
 	return 0;
@@ -28,7 +28,7 @@ using AuthListTupleCore = std::tuple<
 	>,
 	std::pair<
 		Internal::Obj::StrKey<SIMOBJ_KSTR("HashToName")>,
-		Internal::Obj::Dict
+		Internal::Obj::FlatDict
 	>
 >;
 
@@ -0,0 +1,326 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Exceptions.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Common
+{
+
+
+/**
+ * @brief A compact trace context carried along with a sampled item (e.g., a
+ *        block or an event), holding the wall-clock time, in nanoseconds
+ *        since the UNIX epoch, at which the item passed each hop;
+ *        0 means the item didn't pass that hop (yet).
+ *        Hops may be stamped in different components, so their clocks are
+ *        assumed to be synchronized.
+ *
+ */
+class LatencyTrace
+{
+public: // static members:
+
+	static constexpr size_t sk_stampSize = sizeof(uint64_t);
+
+	template<typename _ByteCtnType>
+	static LatencyTrace FromBytes(const _ByteCtnType& bytes)
+	{
+		if (bytes.size() % sk_stampSize != 0)
+		{
+			throw Exception("Invalid size for a latency trace");
+		}
+
+		LatencyTrace trace(bytes.size() / sk_stampSize);
+		auto it = bytes.begin();
+		for (auto& stamp : trace.m_stamps)
+		{
+			for (size_t i = 0; i < sk_stampSize; ++i, ++it)
+			{
+				stamp |= static_cast<uint64_t>(
+					static_cast<uint8_t>(*it)
+				) << (i * 8);
+			}
+		}
+		return trace;
+	}
+
+public:
+
+	LatencyTrace() :
+		m_stamps()
+	{}
+
+	explicit LatencyTrace(size_t numOfHops) :
+		m_stamps(numOfHops, 0)
+	{}
+
+	// LCOV_EXCL_START
+	~LatencyTrace() = default;
+	// LCOV_EXCL_STOP
+
+	size_t GetNumOfHops() const
+	{
+		return m_stamps.size();
+	}
+
+	uint64_t Get(size_t hop) const
+	{
+		return hop < m_stamps.size() ? m_stamps[hop] : 0;
+	}
+
+	/**
+	 * @brief Record the time the item passed the given hop; the trace grows
+	 *        if the hop is not in it yet
+	 *
+	 */
+	void Stamp(size_t hop, uint64_t timeNanoSec)
+	{
+		if (hop >= m_stamps.size())
+		{
+			m_stamps.resize(hop + 1, 0);
+		}
+		m_stamps[hop] = timeNanoSec;
+	}
+
+	/**
+	 * @brief Serialize into little-endian 64-bit stamps, in the order of
+	 *        the hops
+	 *
+	 */
+	std::vector<uint8_t> ToBytes() const
+	{
+		std::vector<uint8_t> res;
+		res.reserve(m_stamps.size() * sk_stampSize);
+		for (const auto& stamp : m_stamps)
+		{
+			for (size_t i = 0; i < sk_stampSize; ++i)
+			{
+				res.push_back(static_cast<uint8_t>(stamp >> (i * 8)));
+			}
+		}
+		return res;
+	}
+
+private:
+
+	std::vector<uint64_t> m_stamps;
+
+}; // class LatencyTrace
+
+
+/**
+ * @brief Aggregates the latency between consecutive stamped hops of the
+ *        traces it's given, and from the first to the last stamped hop, over
+ *        a sliding window of the most recent samples, so the percentiles
+ *        reflect the current behavior of a long-running pipeline
+ *
+ */
+class LatencyTraceStats
+{
+public: // static members:
+
+	static constexpr size_t sk_defWindowSize = 1024;
+
+	struct Summary
+	{
+		std::string m_name;
+		size_t m_numOfSamples;
+		uint64_t m_p50NanoSec;
+		uint64_t m_p90NanoSec;
+		uint64_t m_p99NanoSec;
+		uint64_t m_maxNanoSec;
+	}; // struct Summary
+
+public:
+
+	/**
+	 * @brief Construct a new Latency Trace Stats object
+	 *
+	 * @param hopNames   Names of the hops, in the order they're stamped
+	 * @param windowSize Number of most recent samples kept for each segment
+	 */
+	LatencyTraceStats(
+		std::vector<std::string> hopNames,
+		size_t windowSize = sk_defWindowSize
+	) :
+		m_hopNames(std::move(hopNames)),
+		m_windowSize(std::max<size_t>(windowSize, 1)),
+		m_mutex(),
+		m_numOfTraces(0),
+		m_segments(m_hopNames.size())
+	{}
+
+	// LCOV_EXCL_START
+	~LatencyTraceStats() = default;
+	// LCOV_EXCL_STOP
+
+	void Add(const LatencyTrace& trace)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		++m_numOfTraces;
+
+		// segment i ends at hop i + 1, and starts at the stamped hop before
+		// it (normally hop i); the last segment is the end-to-end one
+		size_t firstHop = m_hopNames.size();
+		size_t prevHop = m_hopNames.size();
+		for (size_t hop = 0; hop < m_hopNames.size(); ++hop)
+		{
+			const uint64_t stamp = trace.Get(hop);
+			if (stamp == 0)
+			{
+				continue;
+			}
+			if (prevHop < m_hopNames.size())
+			{
+				AddSample(
+					m_segments[hop - 1],
+					Elapsed(trace.Get(prevHop), stamp)
+				);
+			}
+			else
+			{
+				firstHop = hop;
+			}
+			prevHop = hop;
+		}
+
+		if (firstHop < prevHop && prevHop < m_hopNames.size())
+		{
+			AddSample(
+				m_segments.back(),
+				Elapsed(trace.Get(firstHop), trace.Get(prevHop))
+			);
+		}
+	}
+
+	uint64_t GetNumOfTraces() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numOfTraces;
+	}
+
+	/**
+	 * @brief Get the percentiles of each hop-to-hop segment, followed by
+	 *        the end-to-end one; segments without samples are skipped
+	 *
+	 */
+	std::vector<Summary> Summarize() const
+	{
+		std::vector<Summary> res;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (size_t i = 0; i < m_segments.size(); ++i)
+		{
+			const auto& window = m_segments[i].m_window;
+			if (window.empty())
+			{
+				continue;
+			}
+
+			std::vector<uint64_t> sorted = window;
+			std::sort(sorted.begin(), sorted.end());
+
+			Summary summary;
+			summary.m_name = (i + 1 < m_segments.size()) ?
+				(m_hopNames[i] + "->" + m_hopNames[i + 1]) :
+				std::string("end_to_end");
+			summary.m_numOfSamples = sorted.size();
+			summary.m_p50NanoSec = Percentile(sorted, 50);
+			summary.m_p90NanoSec = Percentile(sorted, 90);
+			summary.m_p99NanoSec = Percentile(sorted, 99);
+			summary.m_maxNanoSec = sorted.back();
+			res.push_back(summary);
+		}
+		return res;
+	}
+
+	std::string ToString() const
+	{
+		std::string res;
+		for (const auto& summary : Summarize())
+		{
+			res += (res.empty() ? "" : "\n") + summary.m_name + ": " +
+				"n=" + std::to_string(summary.m_numOfSamples) +
+				", p50=" + std::to_string(summary.m_p50NanoSec / 1000) + "us" +
+				", p90=" + std::to_string(summary.m_p90NanoSec / 1000) + "us" +
+				", p99=" + std::to_string(summary.m_p99NanoSec / 1000) + "us" +
+				", max=" + std::to_string(summary.m_maxNanoSec / 1000) + "us";
+		}
+		return res;
+	}
+
+private:
+
+	struct Segment
+	{
+		Segment() :
+			m_window(),
+			m_next(0)
+		{}
+
+		std::vector<uint64_t> m_window;
+		size_t m_next;
+	}; // struct Segment
+
+	static uint64_t Elapsed(uint64_t start, uint64_t end)
+	{
+		// clocks of different components may be slightly off
+		return end > start ? end - start : 0;
+	}
+
+	static uint64_t Percentile(const std::vector<uint64_t>& sorted, size_t p)
+	{
+		// nearest-rank
+		size_t rank = (sorted.size() * p + 99) / 100;
+		return sorted[rank == 0 ? 0 : rank - 1];
+	}
+
+	void AddSample(Segment& segment, uint64_t nanoSec)
+	{
+		if (segment.m_window.size() < m_windowSize)
+		{
+			segment.m_window.push_back(nanoSec);
+		}
+		else
+		{
+			segment.m_window[segment.m_next] = nanoSec;
+		}
+		segment.m_next = (segment.m_next + 1) % m_windowSize;
+	}
+
+	std::vector<std::string> m_hopNames;
+	size_t m_windowSize;
+
+	mutable std::mutex m_mutex;
+	uint64_t m_numOfTraces;
+	/**
+	 * @brief Segment i ends at hop i + 1, and the last one is end-to-end;
+	 *        there is one segment per hop, since the first hop doesn't end
+	 *        any segment
+	 *
+	 */
+	std::vector<Segment> m_segments;
+
+}; // class LatencyTraceStats
+
+
+} // namespace Common
+} // namespace DecentEnclave
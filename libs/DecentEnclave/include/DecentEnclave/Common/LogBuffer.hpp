@@ -0,0 +1,195 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+
+#include <mutex>
+#include <string>
+
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#include "../SgxEdgeSources/sys_io_t.h"
+#include "Sgx/Exceptions.hpp"
+#else
+#include "../Untrusted/AsyncLogWriter.hpp"
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+
+
+/**
+ * @brief The number of bytes buffered before the log buffer is flushed;
+ *        0 disables buffering, so that every message is printed immediately
+ */
+#ifndef DECENT_ENCLAVE_LOG_BUFFER_SIZE
+#	ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#		define DECENT_ENCLAVE_LOG_BUFFER_SIZE (16 * 1024)
+#	else
+#		define DECENT_ENCLAVE_LOG_BUFFER_SIZE 0
+#	endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#endif // !DECENT_ENCLAVE_LOG_BUFFER_SIZE
+
+
+namespace DecentEnclave
+{
+namespace Common
+{
+
+
+/**
+ * @brief Collects log messages in memory, and hands them to the untrusted
+ *        side in batches, so that each flush costs only one OCALL.
+ *        Everything printed goes through it (including `Platform::Print`),
+ *        so messages are never reordered against each other.
+ *        The buffer is flushed when it grows over the size threshold,
+ *        when `Flush` is called explicitly (e.g., by a `LogFlushGuard`
+ *        before an ECALL returns, or periodically by the heartbeat), and
+ *        right after an error message is appended.
+ */
+class LogBuffer
+{
+public: // static members:
+
+	static const char* GetPlatformSymbol()
+	{
+#if defined(DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED)
+		return "SGX-T";
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+		return "NAT-T";
+#else
+		return "APP-U";
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+	}
+
+	static LogBuffer& GetInstance()
+	{
+		static LogBuffer inst(DECENT_ENCLAVE_LOG_BUFFER_SIZE);
+		return inst;
+	}
+
+public:
+
+	LogBuffer(size_t flushSize) :
+		m_flushSize(flushSize),
+		m_flushMutex(),
+		m_bufMutex(),
+		m_buf()
+	{}
+
+	// LCOV_EXCL_START
+	~LogBuffer()
+	{
+		try
+		{
+			Flush();
+		}
+		catch (...)
+		{}
+	}
+	// LCOV_EXCL_STOP
+
+	void Append(const std::string& msg, bool flushNow = false)
+	{
+		if (m_flushSize == 0)
+		{
+			std::lock_guard<std::mutex> flushLock(m_flushMutex);
+			PrintBatch(msg, flushNow);
+			return;
+		}
+
+		bool needFlush = flushNow;
+		{
+			std::lock_guard<std::mutex> bufLock(m_bufMutex);
+			m_buf += msg;
+			needFlush = needFlush || (m_buf.size() >= m_flushSize);
+		}
+
+		if (needFlush)
+		{
+			Flush();
+		}
+	}
+
+	void Flush()
+	{
+		// flushes are serialized, so batches never overtake each other;
+		// appending only needs the buffer lock, so it is not blocked by the
+		// OCALL made here
+		std::lock_guard<std::mutex> flushLock(m_flushMutex);
+
+		std::string batch;
+		{
+			std::lock_guard<std::mutex> bufLock(m_bufMutex);
+			if (m_buf.empty())
+			{
+				return;
+			}
+			batch.swap(m_buf);
+			m_buf.reserve(batch.capacity());
+		}
+
+		PrintBatch(batch, false);
+	}
+
+private:
+
+	static void PrintBatch(const std::string& batch, bool waitWritten)
+	{
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+		(void)waitWritten;
+		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E(
+			ocall_decent_enclave_print_batch,
+			batch.data(),
+			batch.size()
+		);
+#else
+		auto& writer = Untrusted::AsyncLogWriter::GetInstance();
+		writer.Write(batch, GetPlatformSymbol());
+		if (waitWritten)
+		{
+			// e.g., errors are written out before the process may go down
+			writer.Flush();
+		}
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+	}
+
+	size_t m_flushSize;
+	std::mutex m_flushMutex;
+	std::mutex m_bufMutex;
+	std::string m_buf;
+}; // class LogBuffer
+
+
+/**
+ * @brief Flushes the log buffer when it goes out of scope; put one at the
+ *        top of an ECALL so buffered messages are delivered before the
+ *        ECALL returns.
+ */
+class LogFlushGuard
+{
+public:
+
+	LogFlushGuard() = default;
+
+	LogFlushGuard(const LogFlushGuard&) = delete;
+
+	// LCOV_EXCL_START
+	~LogFlushGuard()
+	{
+		try
+		{
+			LogBuffer::GetInstance().Flush();
+		}
+		catch (...)
+		{}
+	}
+	// LCOV_EXCL_STOP
+
+	LogFlushGuard& operator=(const LogFlushGuard&) = delete;
+}; // class LogFlushGuard
+
+
+} // namespace Common
+} // namespace DecentEnclave
@@ -6,9 +6,36 @@
 #pragma once
 
 
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "Exceptions.hpp"
+#include "LogBuffer.hpp"
+
+
+/**
+ * @brief Messages below this level are removed at compile time;
+ *        0 - DEBUG, 1 - INFO, 2 - WARN, 3 - ERROR, 4 - OFF
+ */
+#ifndef DECENT_ENCLAVE_LOG_MIN_LEVEL
+#	define DECENT_ENCLAVE_LOG_MIN_LEVEL 0
+#endif // !DECENT_ENCLAVE_LOG_MIN_LEVEL
+
 
-#include "Platform/Print.hpp"
+/**
+ * @brief The runtime level given to loggers that are not configured
+ *        individually; same values as `DECENT_ENCLAVE_LOG_MIN_LEVEL`
+ */
+#ifndef DECENT_ENCLAVE_LOG_DEFAULT_LEVEL
+#	define DECENT_ENCLAVE_LOG_DEFAULT_LEVEL 0
+#endif // !DECENT_ENCLAVE_LOG_DEFAULT_LEVEL
 
 
 namespace DecentEnclave
@@ -16,46 +43,261 @@ namespace DecentEnclave
 namespace Common
 {
 
+
+enum class LogLevel : uint8_t
+{
+	Debug = 0,
+	Info  = 1,
+	Warn  = 2,
+	Error = 3,
+	Off   = 4,
+}; // enum class LogLevel
+
+
+/**
+ * @brief Parse a level name ("Debug", "Info", "Warn", "Error" or "Off",
+ *        case-insensitive), as used in configs
+ */
+inline LogLevel ParseLogLevel(const std::string& name)
+{
+	std::string lower = name;
+	for (auto& ch : lower)
+	{
+		if (ch >= 'A' && ch <= 'Z')
+		{
+			ch = static_cast<char>(ch - 'A' + 'a');
+		}
+	}
+
+	if (lower == "debug")
+	{
+		return LogLevel::Debug;
+	}
+	else if (lower == "info")
+	{
+		return LogLevel::Info;
+	}
+	else if (lower == "warn")
+	{
+		return LogLevel::Warn;
+	}
+	else if (lower == "error")
+	{
+		return LogLevel::Error;
+	}
+	else if (lower == "off")
+	{
+		return LogLevel::Off;
+	}
+	throw Exception("Unknown log level " + name);
+}
+
+
+/**
+ * @brief Keeps the runtime level threshold of each logger name.
+ *        Each name maps to a shared atomic level, so a logger only needs a
+ *        single atomic load to decide whether a message should be dropped,
+ *        and changes made here take effect on loggers that already exist.
+ */
+class LogLevelRegistry
+{
+public: // static members:
+
+	using LevelPtr = std::shared_ptr<std::atomic<uint8_t> >;
+
+	static LogLevelRegistry& GetInstance()
+	{
+		static LogLevelRegistry inst;
+		return inst;
+	}
+
+public:
+
+	LogLevelRegistry() :
+		m_mutex(),
+		m_defaultLevel(static_cast<LogLevel>(DECENT_ENCLAVE_LOG_DEFAULT_LEVEL)),
+		m_entries()
+	{}
+
+	// LCOV_EXCL_START
+	~LogLevelRegistry() = default;
+	// LCOV_EXCL_STOP
+
+	LevelPtr GetLevelPtr(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return AfterLockGetEntry(name).m_level;
+	}
+
+	/**
+	 * @brief Set the level of a single logger name; the level will no longer
+	 *        follow the default level
+	 */
+	void SetLevel(const std::string& name, LogLevel level)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Entry& entry = AfterLockGetEntry(name);
+		entry.m_isExplicit = true;
+		entry.m_level->store(static_cast<uint8_t>(level));
+	}
+
+	/**
+	 * @brief Set the level used by all logger names that are not configured
+	 *        via `SetLevel`
+	 */
+	void SetDefaultLevel(LogLevel level)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_defaultLevel = level;
+		for (auto& kv : m_entries)
+		{
+			if (!kv.second.m_isExplicit)
+			{
+				kv.second.m_level->store(static_cast<uint8_t>(level));
+			}
+		}
+	}
+
+	LogLevel GetDefaultLevel() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_defaultLevel;
+	}
+
+private:
+
+	struct Entry
+	{
+		LevelPtr m_level;
+		bool m_isExplicit;
+	}; // struct Entry
+
+	Entry& AfterLockGetEntry(const std::string& name)
+	{
+		auto it = m_entries.find(name);
+		if (it == m_entries.end())
+		{
+			Entry entry;
+			entry.m_level = std::make_shared<std::atomic<uint8_t> >(
+				static_cast<uint8_t>(m_defaultLevel)
+			);
+			entry.m_isExplicit = false;
+			it = m_entries.emplace(name, std::move(entry)).first;
+		}
+		return it->second;
+	}
+
+	mutable std::mutex m_mutex;
+	LogLevel m_defaultLevel;
+	std::unordered_map<std::string, Entry> m_entries;
+}; // class LogLevelRegistry
+
+
+/**
+ * @brief Each of `Debug`, `Info`, `Warn`, and `Error` accepts either a
+ *        string, or a callable returning a string; the callable is only
+ *        invoked when the level is enabled, so any expensive formatting
+ *        (e.g., hex-encoding hashes) should be put inside it.
+ */
 class Logger
 {
+public: // static members:
+
+	static constexpr LogLevel sk_minLevel =
+		static_cast<LogLevel>(DECENT_ENCLAVE_LOG_MIN_LEVEL);
+
+	static constexpr bool IsCompiledIn(LogLevel level)
+	{
+		return level >= sk_minLevel;
+	}
+
 public:
 
 	Logger(const std::string& name) :
-		m_name(name)
+		m_name(name),
+		m_level(LogLevelRegistry::GetInstance().GetLevelPtr(name))
 	{}
 
 	~Logger() = default;
 
-	void Debug(const std::string& msg) const
+	bool IsEnabled(LogLevel level) const
+	{
+		return IsCompiledIn(level) &&
+			(level != LogLevel::Off) &&
+			(
+				static_cast<uint8_t>(level) >=
+				m_level->load(std::memory_order_relaxed)
+			);
+	}
+
+	template<typename _MsgT>
+	void Debug(_MsgT&& msg) const
 	{
-		return Log("DEBUG", msg);
+		return Log(LogLevel::Debug, "DEBUG", std::forward<_MsgT>(msg));
 	}
 
-	void Info(const std::string& msg) const
+	template<typename _MsgT>
+	void Info(_MsgT&& msg) const
 	{
-		return Log("INFO", msg);
+		return Log(LogLevel::Info, "INFO", std::forward<_MsgT>(msg));
 	}
 
-	void Warn(const std::string& msg) const
+	template<typename _MsgT>
+	void Warn(_MsgT&& msg) const
 	{
-		return Log("WARN", msg);
+		return Log(LogLevel::Warn, "WARN", std::forward<_MsgT>(msg));
 	}
 
-	void Error(const std::string& msg) const
+	template<typename _MsgT>
+	void Error(_MsgT&& msg) const
 	{
-		return Log("ERROR", msg);
+		return Log(LogLevel::Error, "ERROR", std::forward<_MsgT>(msg));
 	}
 
 private:
 
-	void Log(const std::string& level, const std::string& msg) const
+	template<typename _MsgT>
+	static const _MsgT& Format(
+		const _MsgT& msg,
+		typename std::enable_if<
+			std::is_convertible<const _MsgT&, std::string>::value,
+			int
+		>::type = 0
+	)
+	{
+		return msg;
+	}
+
+	template<typename _FormatterT>
+	static std::string Format(
+		const _FormatterT& formatter,
+		typename std::enable_if<
+			!std::is_convertible<const _FormatterT&, std::string>::value,
+			int
+		>::type = 0
+	)
 	{
-		Platform::Print::Str(
-			m_name + "(" + level + "): " + msg + "\n"
+		return formatter();
+	}
+
+	template<typename _MsgT>
+	void Log(LogLevel level, const char* levelStr, const _MsgT& msg) const
+	{
+		if (!IsEnabled(level))
+		{
+			return;
+		}
+
+		// errors are flushed right away, so they are not lost if the
+		// enclave is about to be torn down
+		LogBuffer::GetInstance().Append(
+			m_name + "(" + levelStr + "): " + Format(msg) + "\n",
+			level >= LogLevel::Error
 		);
 	}
 
 	std::string m_name;
+	LogLevelRegistry::LevelPtr m_level;
 }; // class Logger
 
 
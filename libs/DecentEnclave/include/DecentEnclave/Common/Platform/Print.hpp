@@ -9,22 +9,12 @@
 #include <cstdint>
 
 #include <string>
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
-// no C++ headers needed for SGX
-#else
-#include <iostream>
-#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 #include <SimpleObjects/Codec/Hex.hpp>
 
 #include "../Exceptions.hpp"
 #include "../Internal/SimpleObj.hpp"
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
-#include "../../SgxEdgeSources/sys_io_t.h"
-#include "../Sgx/Exceptions.hpp"
-#else
-// no DecentEncalve headers needed for Untrusted
-#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#include "../LogBuffer.hpp"
 
 
 namespace DecentEnclave
@@ -37,16 +27,14 @@ namespace Platform
 struct Print
 {
 
+	/**
+	 * @brief Print through the same buffer as the loggers, so the output
+	 *        stays in order with theirs
+	 *
+	 */
 	static void Str(const std::string& str)
 	{
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
-		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E(
-			ocall_decent_enclave_print_str,
-			str.c_str()
-		);
-#else
-		std::cout << str << std::flush;
-#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+		LogBuffer::GetInstance().Append(str);
 	}
 
 	static void StrDebug(const std::string& str)
@@ -61,7 +49,11 @@ struct Print
 
 	static void StrErr(const std::string& str)
 	{
-		Str(AsmLineLeader(GetErrLabel(), GetPlatformSymbol()) + str + "\n");
+		// errors are flushed right away, as the loggers do
+		LogBuffer::GetInstance().Append(
+			AsmLineLeader(GetErrLabel(), GetPlatformSymbol()) + str + "\n",
+			true
+		);
 	}
 
 	static void Hex(const void* data, const size_t size)
@@ -111,11 +103,7 @@ struct Print
 
 	static std::string GetPlatformSymbol()
 	{
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
-		return "SGX-T";
-#else
-		return "APP-U";
-#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+		return LogBuffer::GetPlatformSymbol();
 	}
 
 	static std::string GetInfoLabel()
@@ -0,0 +1,42 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <atomic>
+
+
+namespace DecentEnclave
+{
+namespace Common
+{
+
+
+/**
+ * @brief A clock value kept up to date by the host, in memory shared with
+ *        the enclave, so the enclave can read the untrusted time without an
+ *        OCALL
+ *
+ */
+struct SharedClockPage
+{
+	SharedClockPage() :
+		m_wallNanoSec(0)
+	{}
+
+	/**
+	 * @brief Wall-clock time in nanoseconds since the UNIX epoch;
+	 *        0 means the clock hasn't been ticked yet
+	 *
+	 */
+	std::atomic<uint64_t> m_wallNanoSec;
+}; // struct SharedClockPage
+
+
+} // namespace Common
+} // namespace DecentEnclave
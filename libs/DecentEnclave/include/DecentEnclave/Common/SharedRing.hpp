@@ -0,0 +1,341 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+
+#include "Exceptions.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Common
+{
+
+
+/**
+ * @brief The control block of a single-producer single-consumer byte ring
+ *        that lives in memory shared by the enclave and the host.
+ *        Both indices increase monotonically; the position in the data
+ *        buffer is the index modulo the capacity.
+ *        NOTE: the two indices are placed in different cache lines, so the
+ *        producer and the consumer don't keep invalidating each other.
+ */
+struct SharedRingHeader
+{
+	std::atomic<uint64_t> m_writeIdx;
+	uint8_t m_pad1[64 - sizeof(std::atomic<uint64_t>)];
+
+	std::atomic<uint64_t> m_readIdx;
+	uint8_t m_pad2[64 - sizeof(std::atomic<uint64_t>)];
+
+	/**
+	 * @brief Set by the writer when it is about to sleep because the ring
+	 *        is full; the reader should wake it up after it reads something
+	 */
+	std::atomic<uint8_t> m_writerWaiting;
+
+	/**
+	 * @brief Set by the reader when it is about to sleep because the ring
+	 *        is empty; the writer should wake it up after it writes something
+	 */
+	std::atomic<uint8_t> m_readerWaiting;
+
+	std::atomic<uint8_t> m_isClosed;
+	uint8_t m_pad3[64 - (3 * sizeof(std::atomic<uint8_t>))];
+
+	SharedRingHeader() :
+		m_writeIdx(0),
+		m_readIdx(0),
+		m_writerWaiting(0),
+		m_readerWaiting(0),
+		m_isClosed(0)
+	{}
+}; // struct SharedRingHeader
+
+
+/**
+ * @brief The layout of the shared memory used by a bi-directional
+ *        connection, which consists of two rings:
+ *        [tx header][rx header][tx data][rx data]
+ *        "tx" carries data from the enclave to the host, and
+ *        "rx" carries data from the host to the enclave.
+ */
+struct SharedRingLayout
+{
+	static bool IsValidCapacity(uint64_t capacity)
+	{
+		// must be a non-zero power of 2
+		return (capacity != 0) && ((capacity & (capacity - 1)) == 0);
+	}
+
+	static size_t GetSize(uint64_t capacity)
+	{
+		return (2 * sizeof(SharedRingHeader)) +
+			(2 * static_cast<size_t>(capacity));
+	}
+
+	static SharedRingHeader* GetTxHeader(void* mem)
+	{
+		return static_cast<SharedRingHeader*>(mem);
+	}
+
+	static SharedRingHeader* GetRxHeader(void* mem)
+	{
+		return static_cast<SharedRingHeader*>(mem) + 1;
+	}
+
+	static uint8_t* GetTxData(void* mem, uint64_t)
+	{
+		return static_cast<uint8_t*>(mem) + (2 * sizeof(SharedRingHeader));
+	}
+
+	static uint8_t* GetRxData(void* mem, uint64_t capacity)
+	{
+		return GetTxData(mem, capacity) + static_cast<size_t>(capacity);
+	}
+}; // struct SharedRingLayout
+
+
+/**
+ * @brief The common part of both ends of a shared ring.
+ *        NOTE: The peer may be untrusted, so every index read from the
+ *        shared header is validated against the locally kept index and
+ *        capacity, and the capacity itself is never read from shared memory.
+ */
+class SharedRingEnd
+{
+public:
+
+	SharedRingEnd(SharedRingHeader* hdr, uint8_t* data, uint64_t capacity) :
+		m_hdr(hdr),
+		m_data(data),
+		m_capacity(capacity)
+	{
+		if (!SharedRingLayout::IsValidCapacity(m_capacity))
+		{
+			throw InvalidArgumentException(
+				"SharedRingEnd - The capacity must be a power of 2"
+			);
+		}
+	}
+
+	// LCOV_EXCL_START
+	virtual ~SharedRingEnd() = default;
+	// LCOV_EXCL_STOP
+
+	uint64_t GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	bool IsClosed() const
+	{
+		return m_hdr->m_isClosed.load() != 0;
+	}
+
+	void Close()
+	{
+		m_hdr->m_isClosed.store(1);
+	}
+
+	/**
+	 * @brief Get the size of the data in the ring, as published by both ends.
+	 *        Unlike the functions in the child classes, this one doesn't
+	 *        touch the locally kept index, so it can be called from any thread.
+	 */
+	uint64_t GetPublishedUsedSize() const
+	{
+		uint64_t readIdx = m_hdr->m_readIdx.load(std::memory_order_acquire);
+		uint64_t writeIdx = m_hdr->m_writeIdx.load(std::memory_order_acquire);
+		return writeIdx - readIdx;
+	}
+
+protected:
+
+	size_t PosOf(uint64_t idx) const
+	{
+		return static_cast<size_t>(idx & (m_capacity - 1));
+	}
+
+	SharedRingHeader* m_hdr;
+	uint8_t* m_data;
+	uint64_t m_capacity;
+}; // class SharedRingEnd
+
+
+class SharedRingWriter : public SharedRingEnd
+{
+public:
+
+	SharedRingWriter(
+		SharedRingHeader* hdr,
+		uint8_t* data,
+		uint64_t capacity
+	) :
+		SharedRingEnd(hdr, data, capacity),
+		m_writeIdx(hdr->m_writeIdx.load(std::memory_order_acquire))
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~SharedRingWriter() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Write as much data as the free space allows, without blocking
+	 *
+	 * @return The number of bytes written; 0 if the ring is full
+	 */
+	size_t TryWrite(const void* data, size_t size)
+	{
+		uint64_t used = GetUsedSize();
+		size_t toWrite = static_cast<size_t>(
+			std::min<uint64_t>(size, m_capacity - used)
+		);
+		if (toWrite == 0)
+		{
+			return 0;
+		}
+
+		const uint8_t* src = static_cast<const uint8_t*>(data);
+		size_t pos = PosOf(m_writeIdx);
+		size_t firstPart =
+			std::min(toWrite, static_cast<size_t>(m_capacity) - pos);
+		std::memcpy(m_data + pos, src, firstPart);
+		std::memcpy(m_data, src + firstPart, toWrite - firstPart);
+
+		m_writeIdx += toWrite;
+		m_hdr->m_writeIdx.store(m_writeIdx, std::memory_order_release);
+
+		return toWrite;
+	}
+
+	/**
+	 * @brief Get the size of the data written but not yet consumed
+	 */
+	uint64_t GetUsedSize() const
+	{
+		uint64_t readIdx = m_hdr->m_readIdx.load(std::memory_order_acquire);
+		uint64_t used = m_writeIdx - readIdx;
+		if (used > m_capacity)
+		{
+			throw Exception(
+				"SharedRingWriter - The read index is out of range"
+			);
+		}
+		return used;
+	}
+
+	uint64_t GetFreeSize() const
+	{
+		return m_capacity - GetUsedSize();
+	}
+
+	bool IsReaderWaiting() const
+	{
+		// pairs with the fence in `SetReaderWaiting`, so that either the
+		// reader sees the new data, or we see the reader is waiting
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return m_hdr->m_readerWaiting.load() != 0;
+	}
+
+	void SetWriterWaiting(bool isWaiting)
+	{
+		m_hdr->m_writerWaiting.store(isWaiting ? 1 : 0);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+private:
+
+	uint64_t m_writeIdx;
+}; // class SharedRingWriter
+
+
+class SharedRingReader : public SharedRingEnd
+{
+public:
+
+	SharedRingReader(
+		SharedRingHeader* hdr,
+		uint8_t* data,
+		uint64_t capacity
+	) :
+		SharedRingEnd(hdr, data, capacity),
+		m_readIdx(hdr->m_readIdx.load(std::memory_order_acquire))
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~SharedRingReader() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Read as much data as available, up to `size` bytes,
+	 *        without blocking
+	 *
+	 * @return The number of bytes read; 0 if the ring is empty
+	 */
+	size_t TryRead(void* buf, size_t size)
+	{
+		uint64_t avail = GetReadableSize();
+		size_t toRead = static_cast<size_t>(std::min<uint64_t>(size, avail));
+		if (toRead == 0)
+		{
+			return 0;
+		}
+
+		uint8_t* dest = static_cast<uint8_t*>(buf);
+		size_t pos = PosOf(m_readIdx);
+		size_t firstPart =
+			std::min(toRead, static_cast<size_t>(m_capacity) - pos);
+		std::memcpy(dest, m_data + pos, firstPart);
+		std::memcpy(dest + firstPart, m_data, toRead - firstPart);
+
+		m_readIdx += toRead;
+		m_hdr->m_readIdx.store(m_readIdx, std::memory_order_release);
+
+		return toRead;
+	}
+
+	uint64_t GetReadableSize() const
+	{
+		uint64_t writeIdx = m_hdr->m_writeIdx.load(std::memory_order_acquire);
+		uint64_t avail = writeIdx - m_readIdx;
+		if (avail > m_capacity)
+		{
+			throw Exception(
+				"SharedRingReader - The write index is out of range"
+			);
+		}
+		return avail;
+	}
+
+	bool IsWriterWaiting() const
+	{
+		// pairs with the fence in `SetWriterWaiting`
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return m_hdr->m_writerWaiting.load() != 0;
+	}
+
+	void SetReaderWaiting(bool isWaiting)
+	{
+		m_hdr->m_readerWaiting.store(isWaiting ? 1 : 0);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+private:
+
+	uint64_t m_readIdx;
+}; // class SharedRingReader
+
+
+} // namespace Common
+} // namespace DecentEnclave
@@ -12,3 +12,17 @@
 #	define DECENT_ENCLAVE_PLATFORM_SGX
 
 #endif // defined(DECENT_ENCLAVE_SGX_UNTRUSTED) || defined(DECENT_ENCLAVE_SGX_TRUSTED)
+
+
+// DECENT_ENCLAVE_PLATFORM_NATIVE:
+//     The trusted code is compiled into the host process, instead of an
+//     enclave, so it can be profiled, benchmarked and fuzzed with the usual
+//     tools; there is no isolation, nor attestation, in this mode.
+//     It can't be combined with the SGX platforms.
+
+#if defined(DECENT_ENCLAVE_PLATFORM_NATIVE) && \
+	defined(DECENT_ENCLAVE_PLATFORM_SGX)
+
+#	error "DECENT_ENCLAVE_PLATFORM_NATIVE can't be used with the SGX platforms"
+
+#endif // defined(DECENT_ENCLAVE_PLATFORM_NATIVE) && defined(DECENT_ENCLAVE_PLATFORM_SGX)
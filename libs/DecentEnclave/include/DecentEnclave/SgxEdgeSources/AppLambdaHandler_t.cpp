@@ -12,6 +12,7 @@
 #include "../Common/DecentTlsConfig.hpp"
 #include "../Common/Internal/SimpleSysIO.hpp"
 #include "../Common/Internal/SimpleObj.hpp"
+#include "../Common/LogBuffer.hpp"
 #include "../Common/TlsSocket.hpp"
 #include "../Common/Platform/Print.hpp"
 
@@ -30,13 +31,16 @@ extern "C" sgx_status_t ecall_decent_lambda_handler(
 	using namespace DecentEnclave::Trusted::Sgx;
 	using namespace DecentEnclave::Common::Internal::SysIO;
 
+	LogFlushGuard logFlushGuard;
+
 	StreamSocketBase* realSockPtr = static_cast<StreamSocketBase*>(sock_ptr);
 
-	std::unique_ptr<StreamSocket> sock =
-		Obj::Internal::make_unique<StreamSocket>(realSockPtr);
+	std::unique_ptr<StreamSocket> sock;
 
 	try
 	{
+		sock = MakeStreamSocket(realSockPtr);
+
 		const auto& svrConfig = LambdaServerConfig::GetInstance();
 
 		auto tlsCfg = DecentTlsConfig::MakeTlsConfig(
@@ -75,6 +79,10 @@ extern "C" sgx_status_t ecall_decent_heartbeat()
 	using namespace DecentEnclave::Common;
 	using namespace DecentEnclave::Trusted;
 
+	// the heartbeat is emitted periodically by the host,
+	// which also makes it the periodic flush of the log buffer
+	LogFlushGuard logFlushGuard;
+
 	try
 	{
 		HeartbeatEmitterMgr::GetInstance().EmitAll();
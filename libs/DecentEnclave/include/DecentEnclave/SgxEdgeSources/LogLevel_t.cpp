@@ -0,0 +1,47 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <cstdint>
+
+#include <string>
+
+#include <sgx_error.h>
+
+#include "../Common/Logging.hpp"
+
+
+extern "C" sgx_status_t ecall_decent_set_log_level(
+	const char* name,
+	uint8_t level
+)
+{
+	using namespace DecentEnclave::Common;
+
+	if (
+		(name == nullptr) ||
+		(level > static_cast<uint8_t>(LogLevel::Off))
+	)
+	{
+		return SGX_ERROR_INVALID_PARAMETER;
+	}
+
+	// an empty name sets the level of all loggers not configured by name
+	const std::string nameStr(name);
+	if (nameStr.empty())
+	{
+		LogLevelRegistry::GetInstance().SetDefaultLevel(
+			static_cast<LogLevel>(level)
+		);
+	}
+	else
+	{
+		LogLevelRegistry::GetInstance().SetLevel(
+			nameStr,
+			static_cast<LogLevel>(level)
+		);
+	}
+	return SGX_SUCCESS;
+}
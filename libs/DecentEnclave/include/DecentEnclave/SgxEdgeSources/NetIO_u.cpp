@@ -13,6 +13,7 @@
 #include "../Common/Platform/Print.hpp"
 #include "../Common/Sgx/Exceptions.hpp"
 #include "../Untrusted/Config/EndpointsMgr.hpp"
+#include "../Untrusted/Hosting/SharedRingPump.hpp"
 #include "sys_io_u.h"
 
 
@@ -159,3 +160,116 @@ extern "C" sgx_status_t ocall_decent_ssocket_async_recv_raw(
 		return SGX_ERROR_UNEXPECTED;
 	}
 }
+
+
+// ====================
+// Shared ring transport
+// ====================
+
+
+using SharedRingPumpHolder =
+	std::shared_ptr<DecentEnclave::Untrusted::Hosting::SharedRingPump>;
+
+
+extern "C" sgx_status_t ocall_decent_ssocket_ring_open(
+	void* ptr,
+	uint64_t capacity,
+	void** ring_ptr,
+	void** ring_mem
+)
+{
+	using namespace DecentEnclave::Untrusted;
+	using _SSocketType = Config::EndpointsMgr::StreamSocketType;
+	_SSocketType* realPtr = static_cast<_SSocketType*>(ptr);
+
+	try
+	{
+		auto pump = Hosting::SharedRingPump::Create(*realPtr, capacity);
+		*ring_mem = pump->GetSharedMemory();
+		*ring_ptr = new SharedRingPumpHolder(std::move(pump));
+		return SGX_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		DecentEnclave::Common::Platform::Print::StrDebug(
+			"ocall_decent_ssocket_ring_open failed with error " +
+			std::string(e.what())
+		);
+		return SGX_ERROR_UNEXPECTED;
+	}
+}
+
+extern "C" void ocall_decent_ssocket_ring_close(
+	void* ring_ptr
+)
+{
+	std::unique_ptr<SharedRingPumpHolder> holder(
+		static_cast<SharedRingPumpHolder*>(ring_ptr)
+	);
+	if (holder != nullptr)
+	{
+		(*holder)->Close();
+	}
+}
+
+extern "C" void ocall_decent_ssocket_ring_notify(
+	void* ring_ptr
+)
+{
+	SharedRingPumpHolder* holder = static_cast<SharedRingPumpHolder*>(ring_ptr);
+	(*holder)->Notify();
+}
+
+extern "C" sgx_status_t ocall_decent_ssocket_ring_wait(
+	void* ring_ptr,
+	uint8_t direction
+)
+{
+	SharedRingPumpHolder* holder = static_cast<SharedRingPumpHolder*>(ring_ptr);
+
+	try
+	{
+		if (direction == 0)
+		{
+			(*holder)->WaitTxSpace();
+		}
+		else
+		{
+			(*holder)->WaitRxData();
+		}
+		return SGX_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		DecentEnclave::Common::Platform::Print::StrDebug(
+			"ocall_decent_ssocket_ring_wait failed with error " +
+			std::string(e.what())
+		);
+		return SGX_ERROR_UNEXPECTED;
+	}
+}
+
+extern "C" sgx_status_t ocall_decent_ssocket_ring_async_recv(
+	void* ring_ptr,
+	sgx_enclave_id_t enclave_id,
+	uint64_t handler_reg_id
+)
+{
+	SharedRingPumpHolder* holder = static_cast<SharedRingPumpHolder*>(ring_ptr);
+
+	try
+	{
+		(*holder)->AsyncNotifyOnRecv(
+			MakeAsyncRecvCallback(enclave_id, handler_reg_id)
+		);
+		return SGX_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		DecentEnclave::Common::Platform::Print::StrDebug(
+			"ocall_decent_ssocket_ring_async_recv failed with error " +
+			std::string(e.what())
+		);
+		return SGX_ERROR_UNEXPECTED;
+	}
+}
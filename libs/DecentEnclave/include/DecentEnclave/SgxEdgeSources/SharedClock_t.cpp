@@ -0,0 +1,36 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+
+#include <sgx_error.h>
+#include <sgx_trts.h>
+
+#include "../Common/SharedClock.hpp"
+#include "../Trusted/Sgx/SharedClock.hpp"
+
+
+extern "C" sgx_status_t ecall_decent_bind_shared_clock(
+	const void* clock_page
+)
+{
+	using namespace DecentEnclave::Common;
+	using namespace DecentEnclave::Trusted::Sgx;
+
+	// the page is only read by the enclave, but it must be in untrusted
+	// memory, or the host could have the enclave take its own data as the
+	// time
+	if (
+		(clock_page == nullptr) ||
+		!sgx_is_outside_enclave(clock_page, sizeof(SharedClockPage))
+	)
+	{
+		return SGX_ERROR_INVALID_PARAMETER;
+	}
+
+	SharedClock::GetInstance().Bind(
+		static_cast<const SharedClockPage*>(clock_page)
+	);
+	return SGX_SUCCESS;
+}
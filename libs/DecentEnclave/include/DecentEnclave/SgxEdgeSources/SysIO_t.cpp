@@ -12,6 +12,7 @@
 
 #include <sgx_error.h>
 
+#include "../Common/LogBuffer.hpp"
 #include "../Common/Platform/Print.hpp"
 #include "../Trusted/Sgx/ComponentConnection.hpp"
 
@@ -25,6 +26,8 @@ extern "C" sgx_status_t ecall_decent_ssocket_async_recv_raw_callback(
 {
 	using namespace DecentEnclave::Trusted::Sgx;
 
+	DecentEnclave::Common::LogFlushGuard logFlushGuard;
+
 	try
 	{
 		auto& handler = GetSSocketAsyncCallbackHandler();
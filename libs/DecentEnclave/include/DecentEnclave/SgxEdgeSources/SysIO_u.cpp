@@ -9,6 +9,8 @@
 #include <cstdint>
 #include <ctime>
 
+#include <chrono>
+
 #include <sgx_error.h>
 #include <SimpleObjects/Internal/make_unique.hpp>
 #include <SimpleSysIO/SysCall/Files.hpp>
@@ -17,11 +19,23 @@
 #include "../Common/Internal/SimpleSysIO.hpp"
 #include "../Common/Platform/Print.hpp"
 #include "../Common/Sgx/UntrustedBuffer.hpp"
+#include "../Untrusted/AsyncLogWriter.hpp"
 
 
 extern "C" void ocall_decent_enclave_print_str(const char* str)
 {
-	DecentEnclave::Common::Platform::Print::Str(str);
+	DecentEnclave::Untrusted::AsyncLogWriter::GetInstance().Write(
+		str,
+		"SGX-T"
+	);
+}
+
+extern "C" void ocall_decent_enclave_print_batch(const char* str, size_t size)
+{
+	DecentEnclave::Untrusted::AsyncLogWriter::GetInstance().Write(
+		std::string(str, size),
+		"SGX-T"
+	);
 }
 
 extern "C" void ocall_decent_untrusted_buffer_delete(
@@ -54,6 +68,15 @@ extern "C" uint64_t ocall_decent_untrusted_timestamp()
 	return static_cast<uint64_t>(std::time(nullptr));
 }
 
+extern "C" uint64_t ocall_decent_untrusted_timestamp_nano()
+{
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()
+		).count()
+	);
+}
+
 
 // ====================
 // Untrusted File
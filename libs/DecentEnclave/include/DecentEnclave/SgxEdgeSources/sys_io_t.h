@@ -14,6 +14,8 @@ extern "C" {
 
 sgx_status_t ocall_decent_enclave_print_str(const char* str);
 
+sgx_status_t ocall_decent_enclave_print_batch(const char* str, size_t size);
+
 sgx_status_t ocall_decent_untrusted_buffer_delete(
 	uint8_t data_type,
 	void* ptr
@@ -21,6 +23,8 @@ sgx_status_t ocall_decent_untrusted_buffer_delete(
 
 sgx_status_t ocall_decent_untrusted_timestamp(uint64_t* retval);
 
+sgx_status_t ocall_decent_untrusted_timestamp_nano(uint64_t* retval);
+
 
 // ====================
 // Untrusted File
@@ -110,6 +114,41 @@ sgx_status_t ocall_decent_ssocket_async_recv_raw(
 );
 
 
+// ====================
+// Shared ring transport
+// ====================
+
+
+sgx_status_t ocall_decent_ssocket_ring_open(
+	sgx_status_t* retval,
+	void* ptr,
+	uint64_t capacity,
+	void** ring_ptr,
+	void** ring_mem
+);
+
+sgx_status_t ocall_decent_ssocket_ring_close(
+	void* ring_ptr
+);
+
+sgx_status_t ocall_decent_ssocket_ring_notify(
+	void* ring_ptr
+);
+
+sgx_status_t ocall_decent_ssocket_ring_wait(
+	sgx_status_t* retval,
+	void* ring_ptr,
+	uint8_t direction
+);
+
+sgx_status_t ocall_decent_ssocket_ring_async_recv(
+	sgx_status_t* retval,
+	void* ring_ptr,
+	sgx_enclave_id_t enclave_id,
+	uint64_t handler_reg_id
+);
+
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -6,8 +6,10 @@
 #pragma once
 
 
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#if defined(DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED)
 #include "Sgx/ComponentConnection.hpp"
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+#include "Native/ComponentConnection.hpp"
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 
@@ -17,11 +19,16 @@ namespace Trusted
 {
 
 
-#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+#if defined(DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED)
 
 using StreamSocket = Sgx::StreamSocket;
 using ComponentConnection = Sgx::ComponentConnection;
 
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+
+using StreamSocket = Native::StreamSocket;
+using ComponentConnection = Native::ComponentConnection;
+
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 
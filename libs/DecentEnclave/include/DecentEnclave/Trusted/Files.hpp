@@ -28,6 +28,19 @@ using UntrustedFileImpl = Sgx::UntrustedFileImpl;
 } // namespace Trusted
 } // namespace DecentEnclave
 
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+#include "Native/Files.hpp"
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+
+using UntrustedFileImpl = Native::UntrustedFileImpl;
+
+} // namespace Trusted
+} // namespace DecentEnclave
+
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 
@@ -10,7 +10,7 @@
 #include <mutex>
 #include <vector>
 
-#include "../Common/Platform/Print.hpp"
+#include "../Common/Logging.hpp"
 
 
 namespace DecentEnclave
@@ -35,6 +35,7 @@ public: // static members:
 public:
 
 	HeartbeatEmitterMgr() :
+		m_logger(Common::LoggerFactory::GetLogger("HeartbeatEmitterMgr")),
 		m_emitterListMutex(),
 		m_emitterList()
 	{}
@@ -69,10 +70,13 @@ public:
 			catch (const std::exception& e)
 			{
 				// If an exception is thrown, then the emitter is no longer valid
-				Common::Platform::Print::StrDebug(
-					std::string("Exception thrown when emitting heartbeat: ") +
-					e.what() +
-					"; The emitter will be removed"
+				m_logger.Debug(
+					[&]()
+					{
+						return std::string(
+							"Exception thrown when emitting heartbeat: "
+						) + e.what() + "; The emitter will be removed";
+					}
 				);
 				it = tmpList.erase(it);
 			}
@@ -93,6 +97,7 @@ public:
 
 private:
 
+	Common::Logger m_logger;
 	mutable std::mutex m_emitterListMutex;
 	EmitterListType m_emitterList;
 
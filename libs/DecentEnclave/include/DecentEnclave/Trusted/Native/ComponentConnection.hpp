@@ -0,0 +1,65 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+
+
+#include <memory>
+#include <string>
+
+#include <SimpleSysIO/StreamSocketBase.hpp>
+
+#include "../../Common/Internal/SimpleSysIO.hpp"
+#include "../../Untrusted/Config/EndpointsMgr.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+namespace Native
+{
+
+
+/**
+ * @brief The host's sockets are used as they are, since there is no
+ *        enclave boundary to forward the calls over
+ *
+ */
+using StreamSocket = Common::Internal::SysIO::StreamSocketBase;
+
+
+struct ComponentConnection
+{
+
+	static std::unique_ptr<StreamSocket>
+	Connect(const std::string& componentName)
+	{
+		return Untrusted::Config::EndpointsMgr::GetInstance().
+			GetStreamSocket(componentName);
+	}
+
+	/**
+	 * @brief There is no boundary to cross, so this is the same as
+	 *        `Connect`
+	 *
+	 */
+	static std::unique_ptr<StreamSocket>
+	ConnectSharedRing(const std::string& componentName, uint64_t)
+	{
+		return Connect(componentName);
+	}
+
+}; // struct ComponentConnection
+
+
+} // namespace Native
+} // namespace Trusted
+} // namespace DecentEnclave
+
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
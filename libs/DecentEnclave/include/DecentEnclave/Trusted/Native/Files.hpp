@@ -0,0 +1,35 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+
+
+#include <SimpleSysIO/SysCall/Files.hpp>
+
+#include "../../Common/Internal/SimpleSysIO.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+namespace Native
+{
+
+
+// the host file is used directly, same as what the untrusted side of the
+// SGX file OCALLs does
+using UntrustedFileImpl =
+	Common::Internal::SysIO::SysCall::SysCallInternal::COpenImpl;
+
+
+} // namespace Native
+} // namespace Trusted
+} // namespace DecentEnclave
+
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
@@ -0,0 +1,316 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <mbedTLScpp/CtrDrbg.hpp>
+#include <mbedTLScpp/Hash.hpp>
+#include <mbedTLScpp/Hkdf.hpp>
+#include <mbedTLScpp/SecretVector.hpp>
+#include <mbedTLScpp/SKey.hpp>
+
+#include "../../Common/Exceptions.hpp"
+
+
+/**
+ * @brief Path of the file holding the host secret that every native seal
+ *        key and the platform ID are derived from; it's created with random
+ *        bytes on first use
+ *
+ */
+#ifndef DECENT_ENCLAVE_NATIVE_HOST_SECRET_PATH
+#	define DECENT_ENCLAVE_NATIVE_HOST_SECRET_PATH "decent_native_host_secret.bin"
+#endif // !DECENT_ENCLAVE_NATIVE_HOST_SECRET_PATH
+
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+namespace Native
+{
+
+
+/**
+ * @brief Stands in for the CPU's seal key fuses, so the same seal keys are
+ *        derived across runs on the same host.
+ *        The secret is a plain file, readable by the user running the
+ *        enclave (and root), so this is only meant for profiling and
+ *        testing.
+ *        The path can be overridden by the DECENT_ENCLAVE_NATIVE_HOST_SECRET
+ *        environment variable.
+ *
+ */
+struct HostSecret
+{
+	static constexpr size_t sk_secretSize = 32;
+
+	static const mbedTLScpp::SecretVector<uint8_t>& Get()
+	{
+		static const mbedTLScpp::SecretVector<uint8_t> sk_secret =
+			LoadOrCreate(GetPath());
+		return sk_secret;
+	}
+
+	static std::string GetPath()
+	{
+		const char* envPath = std::getenv("DECENT_ENCLAVE_NATIVE_HOST_SECRET");
+		return (envPath != nullptr && envPath[0] != '\0') ?
+			std::string(envPath) :
+			std::string(DECENT_ENCLAVE_NATIVE_HOST_SECRET_PATH);
+	}
+
+private:
+
+	static mbedTLScpp::SecretVector<uint8_t> LoadOrCreate(
+		const std::string& path
+	)
+	{
+		mbedTLScpp::SecretVector<uint8_t> secret(sk_secretSize);
+
+		if (TryLoad(path, secret))
+		{
+			return secret;
+		}
+
+		mbedTLScpp::CtrDrbg<> rand;
+		rand.Rand(secret.data(), secret.size());
+
+		if (!TryCreate(path, secret))
+		{
+			// another process has created it first
+			if (!TryLoad(path, secret))
+			{
+				throw Common::Exception(
+					"Failed to load the native host secret at " + path
+				);
+			}
+		}
+		return secret;
+	}
+
+	static bool TryLoad(
+		const std::string& path,
+		mbedTLScpp::SecretVector<uint8_t>& secret
+	)
+	{
+		std::ifstream inFile(path, std::ios::binary);
+		if (!inFile)
+		{
+			return false;
+		}
+
+		inFile.read(
+			reinterpret_cast<char*>(secret.data()),
+			secret.size()
+		);
+		if (static_cast<size_t>(inFile.gcount()) != secret.size())
+		{
+			throw Common::Exception(
+				"The native host secret at " + path + " is corrupted"
+			);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Write the secret to a temporary file that only the owner can
+	 *        access, and then publish it at `path`, so the secret is never
+	 *        seen half-written, or with looser permissions
+	 *
+	 * @return false if the secret at `path` exists already; it's never
+	 *         replaced, since seal keys may have been derived from it
+	 */
+	static bool TryCreate(
+		const std::string& path,
+		const mbedTLScpp::SecretVector<uint8_t>& secret
+	)
+	{
+		const std::string tmpPath =
+			path + ".tmp." + std::to_string(static_cast<long>(getpid()));
+
+		// a file left by a crashed process of the same PID isn't trusted
+		unlink(tmpPath.c_str());
+		int fd = open(
+			tmpPath.c_str(),
+			O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+			S_IRUSR | S_IWUSR
+		);
+		if (fd < 0)
+		{
+			throw Common::Exception(
+				"Failed to create the native host secret at " + tmpPath +
+				" - " + std::strerror(errno)
+			);
+		}
+
+		size_t written = 0;
+		while (written < secret.size())
+		{
+			ssize_t ret = write(
+				fd,
+				secret.data() + written,
+				secret.size() - written
+			);
+			if (ret < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (ret <= 0)
+			{
+				break;
+			}
+			written += static_cast<size_t>(ret);
+		}
+		const bool isSaved = (written == secret.size()) && (fsync(fd) == 0);
+		close(fd);
+		if (!isSaved)
+		{
+			unlink(tmpPath.c_str());
+			throw Common::Exception(
+				"Failed to save the native host secret to " + tmpPath
+			);
+		}
+
+		// unlike rename, link fails if the secret has been created by
+		// another process in the meantime, instead of replacing it
+		const int linkRet = link(tmpPath.c_str(), path.c_str());
+		const int linkErr = errno;
+		unlink(tmpPath.c_str());
+		if (linkRet != 0)
+		{
+			if (linkErr == EEXIST)
+			{
+				return false;
+			}
+			throw Common::Exception(
+				"Failed to save the native host secret to " + path +
+				" - " + std::strerror(linkErr)
+			);
+		}
+		return true;
+	}
+}; // struct HostSecret
+
+
+template<size_t _keySizeBits>
+struct DecentRootSealKey
+{
+public: // static members:
+
+	static constexpr size_t sk_keySizeBits = _keySizeBits;
+
+	using KeyType = mbedTLScpp::SKey<sk_keySizeBits>;
+
+	/**
+	 * @brief Same role as the key ID in the SGX key request
+	 *
+	 */
+	static std::vector<uint8_t> BuildKeyId()
+	{
+		static constexpr char sk_idStr[] = "Decent Root Seal Key - ";
+		return std::vector<uint8_t>(
+			std::begin(sk_idStr),
+			std::end(sk_idStr)
+		);
+	}
+
+public:
+
+	DecentRootSealKey() :
+		m_keyMeta(BuildKeyId())
+	{}
+
+	DecentRootSealKey(const std::vector<uint8_t>& keyMeta) :
+		m_keyMeta(keyMeta)
+	{
+		if (m_keyMeta.empty())
+		{
+			throw Common::Exception(
+				"Invalid meta data size for DecentRootSealKey"
+			);
+		}
+	}
+
+	~DecentRootSealKey() = default;
+
+	KeyType DeriveKey() const
+	{
+		static const std::string sk_salt = "DecentEnclave Native Seal";
+
+		return mbedTLScpp::Hkdf<mbedTLScpp::HashType::SHA512, sk_keySizeBits>(
+			mbedTLScpp::CtnFullR(HostSecret::Get()),
+			mbedTLScpp::CtnFullR(m_keyMeta),
+			mbedTLScpp::CtnFullR(sk_salt)
+		);
+	}
+
+	std::vector<uint8_t> GetKeyMeta() const
+	{
+		return m_keyMeta;
+	}
+
+private:
+
+	std::vector<uint8_t> m_keyMeta;
+
+}; // struct DecentRootSealKey
+
+
+struct PlatformId
+{
+
+	static constexpr size_t sk_idSizeBits = 256;
+	static constexpr size_t sk_idSizeBytes = sk_idSizeBits / 8;
+
+	static const std::array<uint8_t, sk_idSizeBytes>& GetId()
+	{
+		static std::array<uint8_t, sk_idSizeBytes> id = GenId();
+		return id;
+	}
+
+private:
+
+	static std::array<uint8_t, sk_idSizeBytes> GenId()
+	{
+		static const std::string sk_label = "Decent Platform ID";
+
+		mbedTLScpp::Hasher<mbedTLScpp::HashType::SHA256> hasher;
+		auto hash = hasher.Calc(
+			mbedTLScpp::CtnFullR(sk_label),
+			mbedTLScpp::CtnFullR(HostSecret::Get())
+		);
+
+		return hash.m_data;
+	}
+
+}; // struct PlatformId
+
+
+} // namespace Native
+} // namespace Trusted
+} // namespace DecentEnclave
+
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
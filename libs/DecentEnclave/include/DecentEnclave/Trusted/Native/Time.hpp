@@ -0,0 +1,50 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#ifdef DECENT_ENCLAVE_PLATFORM_NATIVE
+
+
+#include <cstdint>
+#include <ctime>
+
+#include <chrono>
+
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+namespace Native
+{
+
+
+struct UntrustedTime
+{
+
+	static uint64_t Timestamp()
+	{
+		return static_cast<uint64_t>(std::time(nullptr));
+	}
+
+	static uint64_t TimestampNanoSec()
+	{
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()
+			).count()
+		);
+	}
+
+}; // struct UntrustedTime
+
+
+} // namespace Native
+} // namespace Trusted
+} // namespace DecentEnclave
+
+#endif // DECENT_ENCLAVE_PLATFORM_NATIVE
@@ -26,6 +26,19 @@ using PlatformIdImpl = Sgx::PlatformId;
 } // namespace Trusted
 } // namespace DecentEnclave
 
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+#include "Native/SealKey.hpp"
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+
+using PlatformIdImpl = Native::PlatformId;
+
+} // namespace Trusted
+} // namespace DecentEnclave
+
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 
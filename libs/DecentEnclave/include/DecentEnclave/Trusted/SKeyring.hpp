@@ -40,6 +40,19 @@ using DecentRootSealKeyGenerator = Sgx::DecentRootSealKey<512>;
 } // namespace Trusted
 } // namespace DecentEnclave
 
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+#include "Native/SealKey.hpp"
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+
+using DecentRootSealKeyGenerator = Native::DecentRootSealKey<512>;
+
+} // namespace Trusted
+} // namespace DecentEnclave
+
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 namespace DecentEnclave
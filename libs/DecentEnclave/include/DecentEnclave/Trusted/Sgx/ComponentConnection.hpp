@@ -9,13 +9,16 @@
 // #ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
 
 #include <memory>
+#include <mutex>
 #include <string>
 
+#include <sgx_trts.h>
 #include <SimpleObjects/Internal/make_unique.hpp>
 #include <SimpleSysIO/StreamSocketBase.hpp>
 
 #include "../../Common/Internal/SimpleObj.hpp"
 #include "../../Common/Internal/SimpleSysIO.hpp"
+#include "../../Common/SharedRing.hpp"
 #include "../../Common/Sgx/Exceptions.hpp"
 #include "../../SgxEdgeSources/sys_io_t.h"
 #include "../UntrustedAsyncEventHandler.hpp"
@@ -107,17 +110,336 @@ public:
 		);
 	}
 
+protected:
+
+	Base* GetUntrustedPtr() const
+	{
+		return m_ptr;
+	}
+
 private:
 
 	Base* m_ptr;
 }; // class StreamSocket
 
 
+/**
+ * @brief A stream socket that exchanges data with the host through a pair of
+ *        rings in untrusted memory, instead of copying every payload through
+ *        an OCALL. OCALLs are only made when a ring is empty or full, or
+ *        when the host side is sleeping and needs to be woken up.
+ */
+class SharedRingStreamSocket : public StreamSocket
+{
+public: // static members:
+
+	using Base = StreamSocket;
+
+	struct RingState
+	{
+		RingState(void* ringPtr, void* ringMem, uint64_t capacity) :
+			m_ringPtr(ringPtr),
+			m_writer(
+				Common::SharedRingLayout::GetTxHeader(ringMem),
+				Common::SharedRingLayout::GetTxData(ringMem, capacity),
+				capacity
+			),
+			m_reader(
+				Common::SharedRingLayout::GetRxHeader(ringMem),
+				Common::SharedRingLayout::GetRxData(ringMem, capacity),
+				capacity
+			),
+			m_mutex(),
+			m_isReleased(false)
+		{}
+
+		void Notify()
+		{
+			DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E(
+				ocall_decent_ssocket_ring_notify,
+				m_ringPtr
+			);
+		}
+
+		void Wait(uint8_t direction)
+		{
+			DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
+				ocall_decent_ssocket_ring_wait,
+				m_ringPtr,
+				direction
+			);
+		}
+
+		size_t TryRead(void* data, size_t size)
+		{
+			size_t readSize = m_reader.TryRead(data, size);
+			if (readSize > 0 && m_reader.IsWriterWaiting())
+			{
+				Notify();
+			}
+			return readSize;
+		}
+
+		void* m_ringPtr;
+		Common::SharedRingWriter m_writer;
+		Common::SharedRingReader m_reader;
+		std::mutex m_mutex;
+		bool m_isReleased;
+	}; // struct RingState
+
+	static constexpr uint8_t sk_waitTxSpace = 0;
+	static constexpr uint8_t sk_waitRxData = 1;
+
+public:
+
+	SharedRingStreamSocket(
+		Common::Internal::SysIO::StreamSocketBase* ptr,
+		uint64_t capacity
+	) :
+		Base(ptr),
+		m_state()
+	{
+		if (!Common::SharedRingLayout::IsValidCapacity(capacity))
+		{
+			throw Common::InvalidArgumentException(
+				"SharedRingStreamSocket - The capacity must be a power of 2"
+			);
+		}
+
+		void* ringPtr = nullptr;
+		void* ringMem = nullptr;
+		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
+			ocall_decent_ssocket_ring_open,
+			GetUntrustedPtr(),
+			capacity,
+			&ringPtr,
+			&ringMem
+		);
+
+		if (
+			ringMem == nullptr ||
+			!sgx_is_outside_enclave(
+				ringMem,
+				Common::SharedRingLayout::GetSize(capacity)
+			)
+		)
+		{
+			DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E(
+				ocall_decent_ssocket_ring_close,
+				ringPtr
+			);
+			throw Common::Exception(
+				"SharedRingStreamSocket - "
+				"The shared memory must be outside of the enclave"
+			);
+		}
+
+		m_state = std::make_shared<RingState>(ringPtr, ringMem, capacity);
+	}
+
+	// LCOV_EXCL_START
+	virtual ~SharedRingStreamSocket()
+	{
+		try
+		{
+			Close();
+		}
+		catch (...)
+		{}
+	}
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Flush the tx ring and release the shared memory; this is done
+	 *        by the destructor, unless it's called explicitly before, so
+	 *        that a failure can be reported
+	 *
+	 */
+	void Close()
+	{
+		{
+			// pending asynchronous callbacks may still hold the state
+			std::lock_guard<std::mutex> lock(m_state->m_mutex);
+			if (m_state->m_isReleased)
+			{
+				return;
+			}
+			m_state->m_isReleased = true;
+		}
+		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E(
+			ocall_decent_ssocket_ring_close,
+			m_state->m_ringPtr
+		);
+	}
+
+	virtual size_t SendRaw(const void* data, size_t size) override
+	{
+		while (true)
+		{
+			size_t sent = m_state->m_writer.TryWrite(data, size);
+			if (sent > 0)
+			{
+				if (m_state->m_writer.IsReaderWaiting())
+				{
+					m_state->Notify();
+				}
+				return sent;
+			}
+
+			if (m_state->m_writer.IsClosed())
+			{
+				throw Common::Exception(
+					"SharedRingStreamSocket - The connection is closed"
+				);
+			}
+			m_state->Wait(sk_waitTxSpace);
+		}
+	}
+
+	virtual size_t RecvRaw(void* data, size_t size) override
+	{
+		while (true)
+		{
+			size_t recv = m_state->TryRead(data, size);
+			if (recv > 0)
+			{
+				return recv;
+			}
+
+			if (m_state->m_reader.IsClosed())
+			{
+				// data may arrive right before the ring is closed
+				recv = m_state->TryRead(data, size);
+				if (recv > 0)
+				{
+					return recv;
+				}
+				throw Common::Exception(
+					"SharedRingStreamSocket - The connection is closed"
+				);
+			}
+			m_state->Wait(sk_waitRxData);
+		}
+	}
+
+	virtual void AsyncRecvRaw(
+		size_t buffSize,
+		AsyncRecvCallback callback
+	) override
+	{
+		AsyncRecvFromRing(m_state, buffSize, std::move(callback));
+	}
+
+private:
+
+	static void AsyncRecvFromRing(
+		std::shared_ptr<RingState> state,
+		size_t buffSize,
+		AsyncRecvCallback callback
+	)
+	{
+		void* ringPtr = state->m_ringPtr;
+
+		// The host only tells us that the ring is readable;
+		// the data is read from the ring once we are back in the enclave
+		auto ringCallback =
+			[state, buffSize, callback](
+				const std::vector<uint8_t>,
+				bool hasErrorOccurred
+			)
+			{
+				std::vector<uint8_t> buf;
+				bool isClosed = hasErrorOccurred;
+				{
+					std::lock_guard<std::mutex> lock(state->m_mutex);
+					isClosed = isClosed || state->m_isReleased;
+					if (!isClosed)
+					{
+						buf.resize(buffSize);
+						buf.resize(state->TryRead(buf.data(), buf.size()));
+						isClosed = buf.empty() && state->m_reader.IsClosed();
+					}
+
+					if (buf.empty() && !isClosed)
+					{
+						// nothing to read yet (e.g., a spurious
+						// notification), but the connection is still open,
+						// so keep waiting; the lock keeps the ring from
+						// being released in the meantime
+						try
+						{
+							AsyncRecvFromRing(state, buffSize, callback);
+							return;
+						}
+						catch (const std::exception&)
+						{
+							// the receive can't be registered again
+							isClosed = true;
+						}
+					}
+				}
+				callback(std::move(buf), isClosed);
+			};
+
+		auto& handler = GetSSocketAsyncCallbackHandler();
+		auto regId = handler.RegisterCallback(std::move(ringCallback));
+		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
+			ocall_decent_ssocket_ring_async_recv,
+			ringPtr,
+			SelfEnclaveId::Get(),
+			regId
+		);
+	}
+
+	std::shared_ptr<RingState> m_state;
+}; // class SharedRingStreamSocket
+
+
+/**
+ * @brief Wrap the given untrusted socket with the transport chosen at
+ *        compile time; the shared ring transport is enabled by defining
+ *        `DECENT_ENCLAVE_SSOCKET_SHARED_RING_CAPACITY` to the ring size
+ *        (in bytes, must be a power of 2)
+ */
+inline std::unique_ptr<StreamSocket> MakeStreamSocket(
+	Common::Internal::SysIO::StreamSocketBase* ptr
+)
+{
+#ifdef DECENT_ENCLAVE_SSOCKET_SHARED_RING_CAPACITY
+	return Common::Internal::Obj::Internal::
+		make_unique<SharedRingStreamSocket>(
+			ptr,
+			DECENT_ENCLAVE_SSOCKET_SHARED_RING_CAPACITY
+		);
+#else // !DECENT_ENCLAVE_SSOCKET_SHARED_RING_CAPACITY
+	return Common::Internal::Obj::Internal::make_unique<StreamSocket>(ptr);
+#endif // DECENT_ENCLAVE_SSOCKET_SHARED_RING_CAPACITY
+}
+
+
 struct ComponentConnection
 {
 
 	static std::unique_ptr<StreamSocket>
 	Connect(const std::string& componentName)
+	{
+		return MakeStreamSocket(ConnectUntrusted(componentName));
+	}
+
+	static std::unique_ptr<StreamSocket>
+	ConnectSharedRing(const std::string& componentName, uint64_t capacity)
+	{
+		return Common::Internal::Obj::Internal::
+			make_unique<SharedRingStreamSocket>(
+				ConnectUntrusted(componentName),
+				capacity
+			);
+	}
+
+private:
+
+	static Common::Internal::SysIO::StreamSocketBase*
+	ConnectUntrusted(const std::string& componentName)
 	{
 		void* ptr = nullptr;
 		DECENTENCLAVE_SGX_OCALL_CHECK_ERROR_E_R(
@@ -125,10 +447,7 @@ struct ComponentConnection
 			&ptr,
 			componentName.c_str()
 		);
-		return Common::Internal::Obj::Internal::
-			make_unique<StreamSocket>(
-				static_cast<Common::Internal::SysIO::StreamSocketBase*>(ptr)
-			);
+		return static_cast<Common::Internal::SysIO::StreamSocketBase*>(ptr);
 	}
 
 }; // struct ComponentConnection
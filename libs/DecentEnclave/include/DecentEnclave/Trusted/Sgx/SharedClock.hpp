@@ -0,0 +1,109 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#ifdef DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+
+
+#include <cstdint>
+
+#include <atomic>
+
+#include "../../Common/SharedClock.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+namespace Sgx
+{
+
+
+/**
+ * @brief The enclave's view of the host's clock.
+ *        The host can report any time it likes, with or without an OCALL, so
+ *        the shared page is no less trustworthy than the OCALL; the only
+ *        guarantee the enclave can have is that the time it hands out never
+ *        goes backwards, which is enforced here for both sources.
+ *
+ */
+class SharedClock
+{
+public: // static members:
+
+	static SharedClock& GetInstance()
+	{
+		static SharedClock s_inst;
+		return s_inst;
+	}
+
+public:
+
+	SharedClock() :
+		m_page(nullptr),
+		m_lastNanoSec(0)
+	{}
+
+	// LCOV_EXCL_START
+	~SharedClock() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Read the time from the given page from now on; the page must be
+	 *        outside of the enclave, and outlive it
+	 *
+	 */
+	void Bind(const Common::SharedClockPage* page)
+	{
+		m_page.store(page);
+	}
+
+	/**
+	 * @brief Read the time from the shared page
+	 *
+	 * @return The time in nanoseconds, or 0 if the page is not bound or not
+	 *         ticked yet
+	 */
+	uint64_t Read() const
+	{
+		const Common::SharedClockPage* page = m_page.load();
+		return page == nullptr ?
+			0 :
+			page->m_wallNanoSec.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Make the given time monotonic with the times handed out before
+	 *
+	 */
+	uint64_t Monotonic(uint64_t nanoSec)
+	{
+		uint64_t last = m_lastNanoSec.load();
+		while (last < nanoSec)
+		{
+			if (m_lastNanoSec.compare_exchange_weak(last, nanoSec))
+			{
+				return nanoSec;
+			}
+		}
+		return last;
+	}
+
+private:
+
+	std::atomic<const Common::SharedClockPage*> m_page;
+	std::atomic<uint64_t> m_lastNanoSec;
+
+}; // class SharedClock
+
+
+} // namespace Sgx
+} // namespace Trusted
+} // namespace DecentEnclave
+
+#endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
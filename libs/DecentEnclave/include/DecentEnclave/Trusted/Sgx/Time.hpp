@@ -11,6 +11,7 @@
 
 #include "../../Common/Sgx/Exceptions.hpp"
 #include "../../SgxEdgeSources/sys_io_t.h"
+#include "SharedClock.hpp"
 
 
 namespace DecentEnclave
@@ -24,15 +25,37 @@ namespace Sgx
 struct UntrustedTime
 {
 
+	/**
+	 * @brief Wall-clock time in seconds since the UNIX epoch, as given by
+	 *        the host
+	 *
+	 */
 	static uint64_t Timestamp()
 	{
-		uint64_t ret = 0;
-		sgx_status_t edgeRet = ocall_decent_untrusted_timestamp(&ret);
-		DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
-			edgeRet,
-			ocall_decent_untrusted_timestamp
-		);
-		return ret;
+		return TimestampNanoSec() / 1000000000ULL;
+	}
+
+	/**
+	 * @brief Wall-clock time in nanoseconds since the UNIX epoch, as given by
+	 *        the host; it's read from the shared clock page if the host has
+	 *        bound one, which saves an OCALL per read, and it never goes
+	 *        backwards
+	 *
+	 */
+	static uint64_t TimestampNanoSec()
+	{
+		SharedClock& clock = SharedClock::GetInstance();
+
+		uint64_t ret = clock.Read();
+		if (ret == 0)
+		{
+			sgx_status_t edgeRet = ocall_decent_untrusted_timestamp_nano(&ret);
+			DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
+				edgeRet,
+				ocall_decent_untrusted_timestamp_nano
+			);
+		}
+		return clock.Monotonic(ret);
 	}
 
 }; // struct UntrustedTime
@@ -19,4 +19,17 @@ using UntrustedTime = Sgx::UntrustedTime;
 } // namespace Trusted
 } // namespace DecentEnclave
 
+#elif defined(DECENT_ENCLAVE_PLATFORM_NATIVE)
+#include "Native/Time.hpp"
+
+namespace DecentEnclave
+{
+namespace Trusted
+{
+
+using UntrustedTime = Native::UntrustedTime;
+
+} // namespace Trusted
+} // namespace DecentEnclave
+
 #endif // DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
@@ -0,0 +1,356 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <SimpleJson/SimpleJson.hpp>
+
+#include "../Common/Exceptions.hpp"
+#include "../Common/Internal/SimpleObj.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+
+
+/**
+ * @brief Writes log messages received from the enclave on a dedicated
+ *        thread, so that the OCALLs delivering them return right away.
+ *        The output goes to `std::cout` by default, or to a file that is
+ *        rotated once it grows over a given size.
+ */
+class AsyncLogWriter
+{
+public: // static members:
+
+	enum class Format
+	{
+		/**
+		 * @brief Messages are written as they are
+		 */
+		Plain,
+		/**
+		 * @brief Each line is written as a JSON object, e.g.,
+		 *        {"time":1690000000000,"source":"SGX-T","msg":"..."}
+		 */
+		JsonLines,
+	}; // enum class Format
+
+	static AsyncLogWriter& GetInstance()
+	{
+		static AsyncLogWriter inst;
+		return inst;
+	}
+
+public:
+
+	AsyncLogWriter() :
+		m_mutex(),
+		m_cv(),
+		m_queue(),
+		m_isWriting(false),
+		m_isStopping(false),
+		m_format(Format::Plain),
+		m_filePath(),
+		m_maxFileSize(0),
+		m_maxFileNum(0),
+		m_file(),
+		m_fileSize(0),
+		m_thread()
+	{}
+
+	AsyncLogWriter(const AsyncLogWriter&) = delete;
+	AsyncLogWriter(AsyncLogWriter&&) = delete;
+
+	// LCOV_EXCL_START
+	~AsyncLogWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_cv.notify_all();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+	// LCOV_EXCL_STOP
+
+	AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+	AsyncLogWriter& operator=(AsyncLogWriter&&) = delete;
+
+	/**
+	 * @brief Change where and how the messages are written
+	 *
+	 * @param format      The output format
+	 * @param filePath    The path to the log file; empty to use `std::cout`
+	 * @param maxFileSize The size (in bytes) at which the log file is
+	 *                    rotated; 0 to never rotate
+	 * @param maxFileNum  The number of rotated files to keep, named
+	 *                    `<filePath>.1` (the newest) to `<filePath>.N`
+	 */
+	void Configure(
+		Format format,
+		const std::string& filePath = std::string(),
+		size_t maxFileSize = 0,
+		size_t maxFileNum = 0
+	)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		// the writer thread reads the configuration without the lock,
+		// so wait until it's idle
+		AfterLockWaitIdle(lock);
+
+		m_format = format;
+		m_filePath = filePath;
+		m_maxFileSize = maxFileSize;
+		m_maxFileNum = maxFileNum;
+
+		m_file.close();
+		m_fileSize = 0;
+		if (!m_filePath.empty())
+		{
+			OpenFile();
+		}
+	}
+
+	/**
+	 * @brief Queue a message (that may contain several lines) to be written
+	 */
+	void Write(std::string msg, const char* source)
+	{
+		if (msg.empty())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queue.emplace_back(std::move(msg), source);
+
+			if (!m_thread.joinable())
+			{
+				m_thread = std::thread(
+					[this]()
+					{
+						WriterLoop();
+					}
+				);
+			}
+		}
+		m_cv.notify_all();
+	}
+
+	/**
+	 * @brief Block until all queued messages are written
+	 */
+	void Flush()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		AfterLockWaitIdle(lock);
+	}
+
+private:
+
+	void AfterLockWaitIdle(std::unique_lock<std::mutex>& lock)
+	{
+		m_cv.wait(
+			lock,
+			[this]()
+			{
+				return m_queue.empty() && !m_isWriting;
+			}
+		);
+	}
+
+	using Entry = std::pair<std::string, const char*>;
+
+	void WriterLoop()
+	{
+		std::deque<Entry> entries;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_cv.wait(
+				lock,
+				[this]()
+				{
+					return !m_queue.empty() || m_isStopping;
+				}
+			);
+			if (m_queue.empty())
+			{
+				// stopping, and everything has been written
+				return;
+			}
+
+			entries.swap(m_queue);
+			m_isWriting = true;
+
+			// the configuration is only changed while the writer is idle,
+			// so it's safe to read it without the lock here
+			lock.unlock();
+			try
+			{
+				for (const auto& entry : entries)
+				{
+					WriteEntry(entry.first, entry.second);
+				}
+				GetOutput().flush();
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "AsyncLogWriter - Failed to write logs: " <<
+					e.what() << std::endl;
+			}
+			entries.clear();
+			lock.lock();
+
+			m_isWriting = false;
+			m_cv.notify_all();
+		}
+	}
+
+	void WriteEntry(const std::string& msg, const char* source)
+	{
+		if (m_format == Format::Plain)
+		{
+			WriteOut(msg);
+			return;
+		}
+
+		const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()
+		).count();
+		const std::string prefix =
+			"{\"time\":" + std::to_string(now) +
+			",\"source\":\"" + source + "\",\"msg\":";
+
+		size_t begin = 0;
+		while (begin < msg.size())
+		{
+			size_t end = msg.find('\n', begin);
+			if (end == std::string::npos)
+			{
+				end = msg.size();
+			}
+
+			Common::Internal::Obj::String line(msg.substr(begin, end - begin));
+			WriteOut(prefix + SimpleJson::DumpStr(line) + "}\n");
+
+			begin = end + 1;
+		}
+	}
+
+	void WriteOut(const std::string& str)
+	{
+		if (m_filePath.empty())
+		{
+			std::cout << str;
+			return;
+		}
+
+		if (
+			(m_maxFileSize > 0) &&
+			(m_fileSize > 0) &&
+			(m_fileSize + str.size() > m_maxFileSize)
+		)
+		{
+			RotateFile();
+		}
+
+		m_file << str;
+		m_fileSize += str.size();
+	}
+
+	std::ostream& GetOutput()
+	{
+		if (m_filePath.empty())
+		{
+			return std::cout;
+		}
+		return m_file;
+	}
+
+	void RotateFile()
+	{
+		m_file.close();
+
+		if (m_maxFileNum == 0)
+		{
+			std::remove(m_filePath.c_str());
+		}
+		else
+		{
+			std::remove(GetRotatedPath(m_maxFileNum).c_str());
+			for (size_t i = m_maxFileNum; i > 1; --i)
+			{
+				std::rename(
+					GetRotatedPath(i - 1).c_str(),
+					GetRotatedPath(i).c_str()
+				);
+			}
+			std::rename(m_filePath.c_str(), GetRotatedPath(1).c_str());
+		}
+
+		m_fileSize = 0;
+		OpenFile();
+	}
+
+	std::string GetRotatedPath(size_t idx) const
+	{
+		return m_filePath + "." + std::to_string(idx);
+	}
+
+	void OpenFile()
+	{
+		m_file.open(m_filePath, std::ios::out | std::ios::app);
+		if (!m_file)
+		{
+			throw Common::Exception(
+				"AsyncLogWriter - Failed to open log file " + m_filePath
+			);
+		}
+		m_file.seekp(0, std::ios::end);
+		m_fileSize = static_cast<size_t>(m_file.tellp());
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::deque<Entry> m_queue;
+	bool m_isWriting;
+	bool m_isStopping;
+
+	Format m_format;
+	std::string m_filePath;
+	size_t m_maxFileSize;
+	size_t m_maxFileNum;
+	std::ofstream m_file;
+	size_t m_fileSize;
+
+	std::thread m_thread;
+}; // class AsyncLogWriter
+
+
+} // namespace Untrusted
+} // namespace DecentEnclave
@@ -0,0 +1,94 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+
+#include "../../Common/Internal/SimpleObj.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+namespace Config
+{
+
+
+/**
+ * @brief Get the number of worker threads for short tasks (e.g., incoming
+ *        lambda calls) from the optional "Executor" section of the
+ *        components config:
+ *        "Executor": { "WorkerThreads": 4 }
+ *
+ * @param config      The components config
+ * @param defaultSize The size to use if it's not given in the config
+ */
+inline size_t ConfigToWorkerPoolSize(
+	const Common::Internal::Obj::Object& config,
+	size_t defaultSize
+)
+{
+	using namespace Common::Internal::Obj;
+	static const String sk_labelExecutor("Executor");
+	static const String sk_labelWorkerThreads("WorkerThreads");
+
+	const auto& configDict = config.AsDict();
+	if (!configDict.HasKey(sk_labelExecutor))
+	{
+		return defaultSize;
+	}
+
+	const auto& executorConfig = configDict[sk_labelExecutor].AsDict();
+	if (!executorConfig.HasKey(sk_labelWorkerThreads))
+	{
+		return defaultSize;
+	}
+
+	size_t size = executorConfig[sk_labelWorkerThreads].AsCppUInt32();
+	return size == 0 ? defaultSize : size;
+}
+
+
+/**
+ * @brief Get the number of threads that run the periodic jobs (e.g., the
+ *        ticks of the block updater and the heartbeat emitter) from the
+ *        optional "Executor" section of the components config:
+ *        "Executor": { "TimerThreads": 2 }
+ *
+ * @param config      The components config
+ * @param defaultSize The size to use if it's not given in the config
+ */
+inline size_t ConfigToTimerPoolSize(
+	const Common::Internal::Obj::Object& config,
+	size_t defaultSize
+)
+{
+	using namespace Common::Internal::Obj;
+	static const String sk_labelExecutor("Executor");
+	static const String sk_labelTimerThreads("TimerThreads");
+
+	const auto& configDict = config.AsDict();
+	if (!configDict.HasKey(sk_labelExecutor))
+	{
+		return defaultSize;
+	}
+
+	const auto& executorConfig = configDict[sk_labelExecutor].AsDict();
+	if (!executorConfig.HasKey(sk_labelTimerThreads))
+	{
+		return defaultSize;
+	}
+
+	size_t size = executorConfig[sk_labelTimerThreads].AsCppUInt32();
+	return size == 0 ? defaultSize : size;
+}
+
+
+} // namespace Config
+} // namespace Untrusted
+} // namespace DecentEnclave
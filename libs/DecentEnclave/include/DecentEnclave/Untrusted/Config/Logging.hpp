@@ -0,0 +1,186 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../../Common/Internal/SimpleObj.hpp"
+#include "../../Common/Logging.hpp"
+#include "../AsyncLogWriter.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+namespace Config
+{
+
+
+using LogLevelList = std::vector<std::pair<std::string, Common::LogLevel> >;
+
+
+/**
+ * @brief Get the log levels from the optional "Logging" section of the
+ *        components config:
+ *        "Logging": {
+ *            "DefaultLevel": "Info",
+ *            "Levels": { "EclipseMonitor": "Warn" }
+ *        }
+ *
+ * @param config The components config
+ * @return Pairs of logger names and their levels; the default level, if it's
+ *         given, comes first, with an empty name
+ */
+inline LogLevelList ConfigToLogLevels(
+	const Common::Internal::Obj::Object& config
+)
+{
+	using namespace Common::Internal::Obj;
+	static const String sk_labelLogging("Logging");
+	static const String sk_labelDefaultLevel("DefaultLevel");
+	static const String sk_labelLevels("Levels");
+
+	LogLevelList res;
+
+	const auto& configDict = config.AsDict();
+	if (!configDict.HasKey(sk_labelLogging))
+	{
+		return res;
+	}
+
+	const auto& logConfig = configDict[sk_labelLogging].AsDict();
+	if (logConfig.HasKey(sk_labelDefaultLevel))
+	{
+		res.emplace_back(
+			std::string(),
+			Common::ParseLogLevel(
+				logConfig[sk_labelDefaultLevel].AsString().c_str()
+			)
+		);
+	}
+	if (logConfig.HasKey(sk_labelLevels))
+	{
+		const auto& levels = logConfig[sk_labelLevels].AsDict();
+		for (const auto& pair : levels)
+		{
+			const auto& name = std::get<0>(pair)->AsString();
+			const auto& level = std::get<1>(pair)->AsString();
+			res.emplace_back(
+				std::string(name.c_str(), name.size()),
+				Common::ParseLogLevel(std::string(level.c_str(), level.size()))
+			);
+		}
+	}
+
+	return res;
+}
+
+
+/**
+ * @brief Apply the given log levels to the loggers of this process
+ *        (the enclave has its own, set through an ECALL)
+ *
+ */
+inline void ApplyLogLevels(const LogLevelList& levels)
+{
+	auto& registry = Common::LogLevelRegistry::GetInstance();
+	for (const auto& level : levels)
+	{
+		if (level.first.empty())
+		{
+			registry.SetDefaultLevel(level.second);
+		}
+		else
+		{
+			registry.SetLevel(level.first, level.second);
+		}
+	}
+}
+
+
+/**
+ * @brief Configure where and how the host writes the log messages (both its
+ *        own and the enclave's), from the optional "Logging" section of the
+ *        components config:
+ *        "Logging": {
+ *            "Format": "JsonLines",
+ *            "File": "ethereum_clt.log",
+ *            "MaxFileSizeMB": 64,
+ *            "MaxFileNum": 4
+ *        }
+ *        `Format` is either "Plain" (the default) or "JsonLines"; without
+ *        `File`, the messages are written to `std::cout`
+ *
+ */
+inline void ConfigureLogWriter(const Common::Internal::Obj::Object& config)
+{
+	using namespace Common::Internal::Obj;
+	static const String sk_labelLogging("Logging");
+	static const String sk_labelFormat("Format");
+	static const String sk_labelFile("File");
+	static const String sk_labelMaxFileSizeMB("MaxFileSizeMB");
+	static const String sk_labelMaxFileNum("MaxFileNum");
+
+	const auto& configDict = config.AsDict();
+	if (!configDict.HasKey(sk_labelLogging))
+	{
+		return;
+	}
+	const auto& logConfig = configDict[sk_labelLogging].AsDict();
+
+	AsyncLogWriter::Format format = AsyncLogWriter::Format::Plain;
+	if (logConfig.HasKey(sk_labelFormat))
+	{
+		const auto& formatStr = logConfig[sk_labelFormat].AsString();
+		const std::string formatName(formatStr.c_str(), formatStr.size());
+		if (formatName == "JsonLines")
+		{
+			format = AsyncLogWriter::Format::JsonLines;
+		}
+		else if (formatName != "Plain")
+		{
+			throw Common::Exception("Unknown log format " + formatName);
+		}
+	}
+
+	std::string filePath;
+	if (logConfig.HasKey(sk_labelFile))
+	{
+		const auto& fileStr = logConfig[sk_labelFile].AsString();
+		filePath = std::string(fileStr.c_str(), fileStr.size());
+	}
+
+	size_t maxFileSize = 0;
+	if (logConfig.HasKey(sk_labelMaxFileSizeMB))
+	{
+		maxFileSize = static_cast<size_t>(
+			logConfig[sk_labelMaxFileSizeMB].AsCppUInt64() * 1024 * 1024
+		);
+	}
+
+	size_t maxFileNum = 0;
+	if (logConfig.HasKey(sk_labelMaxFileNum))
+	{
+		maxFileNum = logConfig[sk_labelMaxFileNum].AsCppUInt32();
+	}
+
+	AsyncLogWriter::GetInstance().Configure(
+		format,
+		filePath,
+		maxFileSize,
+		maxFileNum
+	);
+}
+
+
+} // namespace Config
+} // namespace Untrusted
+} // namespace DecentEnclave
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include "../../Common/Internal/SimpleObj.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+namespace Config
+{
+
+
+/**
+ * @brief Get the tick interval of the shared clock from the optional
+ *        "SharedClock" section of the components config:
+ *        "SharedClock": { "TickMicroSec": 1000 }
+ *
+ * @param config              The components config
+ * @param defaultTickMicroSec The interval to use if it's not given in the
+ *                            config
+ * @return The tick interval in microseconds; 0 means the shared clock is
+ *         disabled, and the enclave falls back to an OCALL per read
+ */
+inline uint64_t ConfigToSharedClockTick(
+	const Common::Internal::Obj::Object& config,
+	uint64_t defaultTickMicroSec
+)
+{
+	using namespace Common::Internal::Obj;
+	static const String sk_labelSharedClock("SharedClock");
+	static const String sk_labelTickMicroSec("TickMicroSec");
+
+	const auto& configDict = config.AsDict();
+	if (!configDict.HasKey(sk_labelSharedClock))
+	{
+		return defaultTickMicroSec;
+	}
+
+	const auto& clockConfig = configDict[sk_labelSharedClock].AsDict();
+	if (!clockConfig.HasKey(sk_labelTickMicroSec))
+	{
+		return defaultTickMicroSec;
+	}
+
+	return clockConfig[sk_labelTickMicroSec].AsCppUInt64();
+}
+
+
+} // namespace Config
+} // namespace Untrusted
+} // namespace DecentEnclave
@@ -9,7 +9,7 @@
 #include <memory>
 #include <unordered_map>
 
-#include <SimpleConcurrency/Threading/ThreadPool.hpp>
+#include <SimpleConcurrency/Threading/Executor.hpp>
 #include <SimpleObjects/Internal/make_unique.hpp>
 #include <SimpleSysIO/StreamSocketBase.hpp>
 
@@ -37,7 +37,7 @@ public: // static members:
 
 	using SocketType = Common::Internal::SysIO::StreamSocketBase;
 	using AcceptorType = Common::Internal::SysIO::StreamAcceptorBase;
-	using ThreadPoolType = Common::Internal::Concurrent::Threading::ThreadPool;
+	using ExecutorType = Common::Internal::Concurrent::Threading::Executor;
 
 	using ServerBinding = std::pair<
 		std::shared_ptr<DecentLambdaFunc>,
@@ -48,10 +48,10 @@ public:
 
 	LambdaFuncServer(
 		std::shared_ptr<Config::EndpointsMgr> endpointsMgr,
-		std::shared_ptr<ThreadPoolType> threadPool
+		std::shared_ptr<ExecutorType> executor
 	) :
 		m_endpointsMgr(std::move(endpointsMgr)),
-		m_threadPool(std::move(threadPool)),
+		m_executor(std::move(executor)),
 		m_funcMap()
 	{}
 
@@ -80,7 +80,7 @@ public:
 		StartAccepting(
 			res.first->second.first,
 			res.first->second.second,
-			m_threadPool
+			m_executor
 		);
 	}
 
@@ -88,29 +88,29 @@ public:
 private: // static members:
 
 	static void StartAccepting(
-		std::weak_ptr<DecentLambdaFunc> func,    // m_funcMap owns this object
-		std::weak_ptr<AcceptorType> acceptor,    // m_funcMap owns this object
-		std::weak_ptr<ThreadPoolType> threadPool // m_threadPool owns this object
+		std::weak_ptr<DecentLambdaFunc> func, // m_funcMap owns this object
+		std::weak_ptr<AcceptorType> acceptor, // m_funcMap owns this object
+		std::weak_ptr<ExecutorType> executor  // m_executor owns this object
 	)
 	{
 		auto callback =
-			[func, acceptor, threadPool](
+			[func, acceptor, executor](
 				std::unique_ptr<SocketType> sock,
 				bool hasErrorOccurred
 			)
 			{
 				auto funcPtr = func.lock();
 				auto acceptorPtr = acceptor.lock();
-				auto threadPoolPtr = threadPool.lock();
+				auto executorPtr = executor.lock();
 
 				if (
 					!hasErrorOccurred &&
-					(threadPoolPtr != nullptr) &&
+					(executorPtr != nullptr) &&
 					(funcPtr != nullptr)
 				)
 				{
 					// no error occurred
-					// and thread pool is still alive
+					// and executor is still alive
 					// lambda function is still alive
 
 					// log new connection
@@ -121,11 +121,11 @@ private: // static members:
 					if (acceptorPtr != nullptr)
 					{
 						// Repeat to accept new connection
-						StartAccepting(func, acceptor, threadPool);
+						StartAccepting(func, acceptor, executor);
 					}
 
 					// proceed to handle the call
-					threadPoolPtr->AddTask(
+					executorPtr->AddTask(
 						Common::Internal::Obj::Internal::make_unique<
 							LambdaFuncTask
 						>(
@@ -149,7 +149,7 @@ private: // static members:
 private:
 
 	std::shared_ptr<Config::EndpointsMgr> m_endpointsMgr;
-	std::shared_ptr<ThreadPoolType> m_threadPool;
+	std::shared_ptr<ExecutorType> m_executor;
 
 	std::unordered_map<std::string, ServerBinding> m_funcMap;
 
@@ -0,0 +1,512 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <SimpleSysIO/StreamSocketBase.hpp>
+
+#include "../../Common/Exceptions.hpp"
+#include "../../Common/Internal/SimpleSysIO.hpp"
+#include "../../Common/Platform/Print.hpp"
+#include "../../Common/SharedRing.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+namespace Hosting
+{
+
+
+/**
+ * @brief The host side of a shared-memory ring transport.
+ *        It owns the memory shared with the enclave, and moves bytes between
+ *        the rings and the underlying socket:
+ *        - A pump thread drains the tx ring into the socket;
+ *        - The rx ring is filled by asynchronous receives on the socket,
+ *          which run on the socket's io service.
+ *        The enclave only needs to make an OCALL when a ring is empty or full,
+ *        or when the other side has announced that it is sleeping.
+ */
+class SharedRingPump :
+	public std::enable_shared_from_this<SharedRingPump>
+{
+public: // static members:
+
+	using SocketType = Common::Internal::SysIO::StreamSocketBase;
+	using AsyncRecvCallback = typename SocketType::AsyncRecvCallback;
+
+	static constexpr size_t sk_chunkSize = 64 * 1024;
+
+	static std::shared_ptr<SharedRingPump> Create(
+		SocketType& socket,
+		uint64_t capacity
+	)
+	{
+		std::shared_ptr<SharedRingPump> pump(
+			new SharedRingPump(socket, capacity)
+		);
+		pump->Start();
+		return pump;
+	}
+
+public:
+
+	SharedRingPump(const SharedRingPump&) = delete;
+	SharedRingPump(SharedRingPump&&) = delete;
+
+	// LCOV_EXCL_START
+	~SharedRingPump()
+	{
+		Close();
+	}
+	// LCOV_EXCL_STOP
+
+
+	SharedRingPump& operator=(const SharedRingPump&) = delete;
+	SharedRingPump& operator=(SharedRingPump&&) = delete;
+
+
+	void* GetSharedMemory()
+	{
+		return m_mem.get();
+	}
+
+
+	/**
+	 * @brief Called by the enclave after it writes to the tx ring while the
+	 *        pump thread is sleeping, or after it reads from the rx ring
+	 *        while there is received data waiting for space
+	 */
+	void Notify()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			AfterLockFlushRxBacklog();
+		}
+		m_cv.notify_all();
+	}
+
+
+	/**
+	 * @brief Block until the tx ring has free space, or the connection is
+	 *        closed
+	 */
+	void WaitTxSpace()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(
+			lock,
+			[this]()
+			{
+				// the pump thread owns the reader,
+				// so only look at the published indices here
+				return m_txReader.GetPublishedUsedSize() < m_capacity ||
+					m_txReader.IsClosed();
+			}
+		);
+	}
+
+
+	/**
+	 * @brief Block until the rx ring has some data, or the connection is
+	 *        closed
+	 */
+	void WaitRxData()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(
+			lock,
+			[this]()
+			{
+				return m_rxWriter.GetUsedSize() > 0 || m_rxWriter.IsClosed();
+			}
+		);
+	}
+
+
+	/**
+	 * @brief Register a callback that is called (with no data) once the rx
+	 *        ring becomes readable; the enclave then reads the data directly
+	 *        from the ring.
+	 *        The callback is called from a dedicated thread, so that it can
+	 *        block on this connection without stalling the io service.
+	 *        If the connection is closed while the callback is pending, it's
+	 *        called with an error.
+	 */
+	void AsyncNotifyOnRecv(AsyncRecvCallback callback)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_isClosing)
+			{
+				throw Common::Exception(
+					"SharedRingPump - The connection is closed"
+				);
+			}
+			if (m_asyncCallback)
+			{
+				throw Common::Exception(
+					"SharedRingPump - Only one asynchronous receive can be "
+					"pending at a time"
+				);
+			}
+			m_asyncCallback = std::move(callback);
+
+			if (!m_notifierThread.joinable())
+			{
+				std::shared_ptr<SharedRingPump> self = shared_from_this();
+				m_notifierThread = std::thread(
+					[self]()
+					{
+						self->NotifierLoop();
+					}
+				);
+			}
+		}
+		m_cv.notify_all();
+	}
+
+
+	/**
+	 * @brief Close the connection; data already in the tx ring is still
+	 *        sent to the socket before this function returns.
+	 *        NOTE: the caller should release the underlying socket only after
+	 *        this function returns.
+	 */
+	void Close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_isClosing)
+			{
+				return;
+			}
+			m_isClosing = true;
+			m_rxWriter.Close();
+		}
+		m_cv.notify_all();
+
+		JoinOrDetach(m_txThread);
+		JoinOrDetach(m_notifierThread);
+	}
+
+
+private:
+
+	static void JoinOrDetach(std::thread& thr)
+	{
+		if (!thr.joinable())
+		{
+			return;
+		}
+
+		if (thr.get_id() == std::this_thread::get_id())
+		{
+			// the connection is closed from within a callback
+			thr.detach();
+		}
+		else
+		{
+			thr.join();
+		}
+	}
+
+
+	SharedRingPump(SocketType& socket, uint64_t capacity) :
+		m_socket(socket),
+		m_capacity(capacity),
+		m_mem(CreateSharedMemory(capacity)),
+		m_txReader(
+			Common::SharedRingLayout::GetTxHeader(m_mem.get()),
+			Common::SharedRingLayout::GetTxData(m_mem.get(), capacity),
+			capacity
+		),
+		m_rxWriter(
+			Common::SharedRingLayout::GetRxHeader(m_mem.get()),
+			Common::SharedRingLayout::GetRxData(m_mem.get(), capacity),
+			capacity
+		),
+		m_mutex(),
+		m_cv(),
+		m_isClosing(false),
+		m_rxBacklog(),
+		m_rxBacklogPos(0),
+		m_asyncCallback(),
+		m_txThread(),
+		m_notifierThread()
+	{}
+
+
+	static std::unique_ptr<uint8_t[]> CreateSharedMemory(uint64_t capacity)
+	{
+		if (!Common::SharedRingLayout::IsValidCapacity(capacity))
+		{
+			throw Common::InvalidArgumentException(
+				"SharedRingPump - The capacity must be a power of 2"
+			);
+		}
+
+		std::unique_ptr<uint8_t[]> mem(
+			new uint8_t[Common::SharedRingLayout::GetSize(capacity)]
+		);
+		new (Common::SharedRingLayout::GetTxHeader(mem.get()))
+			Common::SharedRingHeader();
+		new (Common::SharedRingLayout::GetRxHeader(mem.get()))
+			Common::SharedRingHeader();
+
+		return mem;
+	}
+
+
+	void Start()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		AfterLockStartRecv();
+
+		std::shared_ptr<SharedRingPump> self = shared_from_this();
+		m_txThread = std::thread(
+			[self]()
+			{
+				self->TxLoop();
+			}
+		);
+	}
+
+
+	void TxLoop()
+	{
+		std::vector<uint8_t> buf(sk_chunkSize);
+		try
+		{
+			while (true)
+			{
+				size_t size = m_txReader.TryRead(buf.data(), buf.size());
+				if (size > 0)
+				{
+					{
+						// let the enclave know there is space again
+						std::lock_guard<std::mutex> lock(m_mutex);
+					}
+					m_cv.notify_all();
+
+					size_t sent = 0;
+					while (sent < size)
+					{
+						sent += Common::Internal::SysIO::StreamSocketRaw::Send(
+							m_socket,
+							buf.data() + sent,
+							size - sent
+						);
+					}
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_txReader.SetReaderWaiting(true);
+				m_cv.wait(
+					lock,
+					[this]()
+					{
+						return m_txReader.GetReadableSize() > 0 ||
+							m_isClosing ||
+							m_txReader.IsClosed();
+					}
+				);
+				m_txReader.SetReaderWaiting(false);
+
+				if (
+					m_txReader.GetReadableSize() == 0 &&
+					(m_isClosing || m_txReader.IsClosed())
+				)
+				{
+					return;
+				}
+			}
+		}
+		catch (const std::exception& e)
+		{
+			Common::Platform::Print::StrDebug(
+				"SharedRingPump - Failed to send data: " +
+				std::string(e.what())
+			);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_txReader.Close();
+			}
+			m_cv.notify_all();
+		}
+	}
+
+
+	void AfterLockStartRecv()
+	{
+		std::weak_ptr<SharedRingPump> weakSelf = shared_from_this();
+		Common::Internal::SysIO::StreamSocketRaw::AsyncRecv(
+			m_socket,
+			sk_chunkSize,
+			[weakSelf](std::vector<uint8_t> data, bool hasErrorOccurred)
+			{
+				std::shared_ptr<SharedRingPump> self = weakSelf.lock();
+				if (self != nullptr)
+				{
+					self->OnRecv(std::move(data), hasErrorOccurred);
+				}
+			}
+		);
+	}
+
+
+	void OnRecv(std::vector<uint8_t> data, bool hasErrorOccurred)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_isClosing)
+			{
+				return;
+			}
+
+			if (hasErrorOccurred)
+			{
+				m_rxWriter.Close();
+			}
+			else
+			{
+				m_rxBacklog = std::move(data);
+				m_rxBacklogPos = 0;
+				AfterLockFlushRxBacklog();
+			}
+		}
+		m_cv.notify_all();
+	}
+
+
+	void AfterLockFlushRxBacklog()
+	{
+		if (m_rxBacklogPos >= m_rxBacklog.size())
+		{
+			return;
+		}
+
+		m_rxBacklogPos += m_rxWriter.TryWrite(
+			m_rxBacklog.data() + m_rxBacklogPos,
+			m_rxBacklog.size() - m_rxBacklogPos
+		);
+
+		if (m_rxBacklogPos < m_rxBacklog.size())
+		{
+			// the ring is full; ask the enclave to notify us after reading
+			m_rxWriter.SetWriterWaiting(true);
+			// the enclave may have read everything before it saw the flag
+			m_rxBacklogPos += m_rxWriter.TryWrite(
+				m_rxBacklog.data() + m_rxBacklogPos,
+				m_rxBacklog.size() - m_rxBacklogPos
+			);
+		}
+
+		if (m_rxBacklogPos >= m_rxBacklog.size())
+		{
+			m_rxWriter.SetWriterWaiting(false);
+			m_rxBacklog.clear();
+			m_rxBacklogPos = 0;
+
+			if (!m_isClosing)
+			{
+				AfterLockStartRecv();
+			}
+		}
+	}
+
+
+	void NotifierLoop()
+	{
+		while (true)
+		{
+			AsyncRecvCallback callback;
+			bool hasErrorOccurred = false;
+			bool isClosing = false;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cv.wait(
+					lock,
+					[this]()
+					{
+						return m_isClosing ||
+							(
+								m_asyncCallback &&
+								(
+									m_rxWriter.GetUsedSize() > 0 ||
+									m_rxWriter.IsClosed()
+								)
+							);
+					}
+				);
+				callback = std::move(m_asyncCallback);
+				m_asyncCallback = AsyncRecvCallback();
+				isClosing = m_isClosing;
+				hasErrorOccurred =
+					isClosing || (m_rxWriter.GetUsedSize() == 0);
+			}
+
+			if (callback)
+			{
+				try
+				{
+					callback(std::vector<uint8_t>(), hasErrorOccurred);
+				}
+				catch (const std::exception& e)
+				{
+					Common::Platform::Print::StrDebug(
+						"SharedRingPump - Receive callback failed: " +
+						std::string(e.what())
+					);
+				}
+			}
+
+			if (isClosing)
+			{
+				return;
+			}
+		}
+	}
+
+
+	SocketType& m_socket;
+	uint64_t m_capacity;
+	std::unique_ptr<uint8_t[]> m_mem;
+	Common::SharedRingReader m_txReader;
+	Common::SharedRingWriter m_rxWriter;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_isClosing;
+
+	std::vector<uint8_t> m_rxBacklog;
+	size_t m_rxBacklogPos;
+	AsyncRecvCallback m_asyncCallback;
+
+	std::thread m_txThread;
+	std::thread m_notifierThread;
+
+}; // class SharedRingPump
+
+
+} // namespace Hosting
+} // namespace Untrusted
+} // namespace DecentEnclave
@@ -0,0 +1,166 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cerrno>
+#include <csignal>
+
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "../Common/Exceptions.hpp"
+#include "../Common/Platform/Print.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+
+namespace Internal
+{
+
+inline std::atomic_int& GetSignalValue()
+{
+	static std::atomic_int sigVal(0);
+	return sigVal;
+}
+
+/**
+ * @brief The self-pipe used to wake up the watcher thread from the signal
+ *        handler
+ *
+ */
+inline int* GetSignalPipe()
+{
+	static int sigPipe[2] = { -1, -1 };
+	return sigPipe;
+}
+
+inline const char* GetSignalName(int sig)
+{
+	switch (sig)
+	{
+	case SIGINT:
+		return "SIGINT";
+	case SIGTERM:
+		return "SIGTERM";
+	default:
+		return "Unknown";
+	}
+}
+
+} // namespace Internal
+
+} // namespace Untrusted
+} // namespace DecentEnclave
+
+
+extern "C" inline void DecentEnclaveSignalHandler(int sig)
+{
+	using namespace DecentEnclave::Untrusted::Internal;
+
+	// only async-signal-safe calls here; the message is printed by the
+	// watcher thread
+	GetSignalValue() = sig;
+
+	int* sigPipe = GetSignalPipe();
+	if (sigPipe[1] >= 0)
+	{
+		char byte = 0;
+		ssize_t ret = write(sigPipe[1], &byte, 1);
+		(void)ret;
+	}
+}
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+
+/**
+ * @brief Keep calling `waitFunc` until SIGINT or SIGTERM is received;
+ *        `waitFunc` may block, since `wakeFunc` is called (from a watcher
+ *        thread) once a signal arrives, to make it return.
+ */
+template<typename _WaitFuncType, typename _WakeFuncType>
+inline void RunUntilSignal(
+	_WaitFuncType&& waitFunc,
+	_WakeFuncType&& wakeFunc
+)
+{
+	std::atomic_int& sigVal = Internal::GetSignalValue();
+	int* sigPipe = Internal::GetSignalPipe();
+
+	if (pipe(sigPipe) != 0)
+	{
+		throw Common::Exception("Failed to create the signal pipe");
+	}
+
+	std::thread sigWatcher(
+		[&]()
+		{
+			char byte = 0;
+			while ((read(sigPipe[0], &byte, 1) < 0) && (errno == EINTR))
+			{}
+
+			int sig = sigVal;
+			if (sig != 0)
+			{
+				Common::Platform::Print::StrInfo(
+					std::string("Signal received: ") +
+					Internal::GetSignalName(sig)
+				);
+			}
+			wakeFunc();
+		}
+	);
+
+	// We will handle the signal ourselves
+	std::signal(SIGINT, DecentEnclaveSignalHandler);
+	std::signal(SIGTERM, DecentEnclaveSignalHandler);
+
+	std::exception_ptr waitExcept;
+	try
+	{
+		while (sigVal == 0)
+		{
+			waitFunc();
+		}
+	}
+	catch (...)
+	{
+		waitExcept = std::current_exception();
+	}
+
+	// Restore the default signal handler
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	// release the watcher, in case we stopped for an exception
+	char byte = 0;
+	ssize_t ret = write(sigPipe[1], &byte, 1);
+	(void)ret;
+	sigWatcher.join();
+
+	close(sigPipe[0]);
+	close(sigPipe[1]);
+	sigPipe[0] = sigPipe[1] = -1;
+
+	if (waitExcept)
+	{
+		std::rethrow_exception(waitExcept);
+	}
+}
+
+} // namespace Untrusted
+} // namespace DecentEnclave
@@ -8,8 +8,11 @@
 
 #ifdef DECENT_ENCLAVE_PLATFORM_SGX_UNTRUSTED
 
+#include <string>
 #include <vector>
 
+#include "../../Common/Logging.hpp"
+#include "../../Common/SharedClock.hpp"
 #include "../DecentEnclaveBase.hpp"
 #include "SgxEnclave.hpp"
 
@@ -35,6 +38,21 @@ extern "C" sgx_status_t ecall_decent_heartbeat(
 );
 
 
+extern "C" sgx_status_t ecall_decent_bind_shared_clock(
+	sgx_enclave_id_t eid,
+	sgx_status_t* retval,
+	const void* clock_page
+);
+
+
+extern "C" sgx_status_t ecall_decent_set_log_level(
+	sgx_enclave_id_t eid,
+	sgx_status_t* retval,
+	const char* name,
+	uint8_t level
+);
+
+
 namespace DecentEnclave
 {
 namespace Untrusted
@@ -138,6 +156,58 @@ public:
 	}
 
 
+	/**
+	 * @brief Have the enclave read the untrusted time from the given page,
+	 *        instead of making an OCALL for each read; the page must outlive
+	 *        the enclave
+	 *
+	 */
+	void BindSharedClock(const Common::SharedClockPage& page)
+	{
+		sgx_status_t funcRet = SGX_ERROR_UNEXPECTED;
+		sgx_status_t edgeRet = ecall_decent_bind_shared_clock(
+			m_encId,
+			&funcRet,
+			&page
+		);
+		DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
+			edgeRet,
+			ecall_decent_bind_shared_clock
+		);
+		DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
+			funcRet,
+			ecall_decent_bind_shared_clock
+		);
+	}
+
+
+	/**
+	 * @brief Set the level of the enclave's logger with the given name, or
+	 *        the default level of the enclave's loggers if the name is empty;
+	 *        this can be called at any time, and takes effect on loggers that
+	 *        already exist
+	 *
+	 */
+	void SetLogLevel(const std::string& name, Common::LogLevel level)
+	{
+		sgx_status_t funcRet = SGX_ERROR_UNEXPECTED;
+		sgx_status_t edgeRet = ecall_decent_set_log_level(
+			m_encId,
+			&funcRet,
+			name.c_str(),
+			static_cast<uint8_t>(level)
+		);
+		DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
+			edgeRet,
+			ecall_decent_set_log_level
+		);
+		DECENTENCLAVE_CHECK_SGX_RUNTIME_ERROR(
+			funcRet,
+			ecall_decent_set_log_level
+		);
+	}
+
+
 }; // class DecentSgxEnclave
 
 
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 DecentEnclave
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../Common/SharedClock.hpp"
+
+
+namespace DecentEnclave
+{
+namespace Untrusted
+{
+
+
+/**
+ * @brief Owns a shared clock page, and ticks it on a dedicated thread;
+ *        the time read from the page by the enclave is as fine as the tick
+ *        interval.
+ *        The ticker must outlive the enclaves it's bound to.
+ *
+ */
+class SharedClockTicker
+{
+public: // static members:
+
+	static uint64_t WallNanoSec()
+	{
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()
+			).count()
+		);
+	}
+
+public:
+
+	SharedClockTicker(uint64_t tickMicroSec) :
+		m_page(),
+		m_tickMicroSec(tickMicroSec == 0 ? 1 : tickMicroSec),
+		m_isRunning(true),
+		m_thread()
+	{
+		// the page is valid before any enclave can read it
+		m_page.m_wallNanoSec.store(WallNanoSec());
+		m_thread = std::thread(&SharedClockTicker::TickLoop, this);
+	}
+
+	// LCOV_EXCL_START
+	~SharedClockTicker()
+	{
+		Stop();
+	}
+	// LCOV_EXCL_STOP
+
+	SharedClockTicker(const SharedClockTicker&) = delete;
+
+	SharedClockTicker& operator=(const SharedClockTicker&) = delete;
+
+	const Common::SharedClockPage& GetPage() const
+	{
+		return m_page;
+	}
+
+	void Stop()
+	{
+		if (m_isRunning.exchange(false))
+		{
+			m_thread.join();
+		}
+	}
+
+private:
+
+	void TickLoop()
+	{
+		while (m_isRunning)
+		{
+			std::this_thread::sleep_for(
+				std::chrono::microseconds(m_tickMicroSec)
+			);
+			m_page.m_wallNanoSec.store(
+				WallNanoSec(),
+				std::memory_order_relaxed
+			);
+		}
+	}
+
+	Common::SharedClockPage m_page;
+	uint64_t m_tickMicroSec;
+	std::atomic<bool> m_isRunning;
+	std::thread m_thread;
+
+}; // class SharedClockTicker
+
+
+} // namespace Untrusted
+} // namespace DecentEnclave
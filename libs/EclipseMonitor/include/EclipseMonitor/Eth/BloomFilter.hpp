@@ -59,6 +59,23 @@ public: // static members:
 	static constexpr size_t sk_bloomBitSize = 2048;
 	static constexpr size_t sk_bloomByteSize = sk_bloomBitSize / 8;
 
+	/**
+	 * @brief Set the bits of the given hash in the given bloom bytes, which
+	 *        must be `sk_bloomByteSize` long; this is how a bloom filter is
+	 *        built from the log addresses and topics
+	 *
+	 */
+	static void SetBloomBits(
+		uint8_t* bloomBytes,
+		const std::array<uint8_t, 32>& hashedData
+	)
+	{
+		bloomBytes[GetByteIdx(hashedData, 0)] |= GetBitMask(hashedData, 0);
+		bloomBytes[GetByteIdx(hashedData, 2)] |= GetBitMask(hashedData, 2);
+		bloomBytes[GetByteIdx(hashedData, 4)] |= GetBitMask(hashedData, 4);
+	}
+
+
 public:
 
 	BloomFilter(const Internal::Obj::Bytes& bloomBytes) :
@@ -74,26 +91,13 @@ public:
 	) const
 	{
 		// Adapted from: https://github.com/noxx3xxon/evm-by-example
-		uint8_t v1 = (1 << (hashedData[1] & 0x7));
-		uint8_t v2 = (1 << (hashedData[3] & 0x7));
-		uint8_t v3 = (1 << (hashedData[5] & 0x7));
-
-		uint16_t i1 = hashedData[0] << 8 | hashedData[1];
-		i1 = (i1 & 0x7FF) >> 3;
-		i1 = (256 - i1 - 1);
-
-		uint16_t i2 = hashedData[2] << 8 | hashedData[3];
-		i2 = (i2 & 0x7FF) >> 3;
-		i2 = (256 - i2 - 1);
-
-		uint16_t i3 = hashedData[4] << 8 | hashedData[5];
-		i3 = (i3 & 0x7FF) >> 3;
-		i3 = (256 - i3 - 1);
-
 		bool inBloom = (
-			(m_bloomBeginPtr[i1] & v1) &&
-			(m_bloomBeginPtr[i2] & v2) &&
-			(m_bloomBeginPtr[i3] & v3)
+			(m_bloomBeginPtr[GetByteIdx(hashedData, 0)] &
+				GetBitMask(hashedData, 0)) &&
+			(m_bloomBeginPtr[GetByteIdx(hashedData, 2)] &
+				GetBitMask(hashedData, 2)) &&
+			(m_bloomBeginPtr[GetByteIdx(hashedData, 4)] &
+				GetBitMask(hashedData, 4))
 		);
 
 		return inBloom;
@@ -162,6 +166,29 @@ public:
 
 private:
 
+	/**
+	 * @brief Each pair of bytes, starting at `pairIdx`, in the hash selects
+	 *        one bit in the 2048-bit filter
+	 *
+	 */
+	static uint16_t GetByteIdx(
+		const std::array<uint8_t, 32>& hashedData,
+		size_t pairIdx
+	)
+	{
+		uint16_t idx = hashedData[pairIdx] << 8 | hashedData[pairIdx + 1];
+		idx = (idx & 0x7FF) >> 3;
+		return (256 - idx - 1);
+	}
+
+	static uint8_t GetBitMask(
+		const std::array<uint8_t, 32>& hashedData,
+		size_t pairIdx
+	)
+	{
+		return static_cast<uint8_t>(1 << (hashedData[pairIdx + 1] & 0x7));
+	}
+
 	static size_t Count1BitsInByte(uint8_t byte)
 	{
 		size_t count = 0;
@@ -0,0 +1,591 @@
+// Copyright (c) 2023 EclipseMonitor
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Exceptions.hpp"
+#include "../Internal/SimpleObj.hpp"
+#include "../Internal/SimpleRlp.hpp"
+
+#include "BloomFilter.hpp"
+#include "DAA.hpp"
+#include "DataTypes.hpp"
+#include "HeaderMgr.hpp"
+#include "Keccak256.hpp"
+#include "Params.hpp"
+#include "Trie/Trie.hpp"
+
+
+namespace EclipseMonitor
+{
+namespace Eth
+{
+
+
+/**
+ * @brief Generates header chains, with receipts, that pass the validation
+ *        done by `Validator` and `ReceiptsMgr` under the given network
+ *        config, so the monitor and the event matching can be driven at
+ *        scales real chain segments don't reach.
+ *        The parent hashes, difficulty values, logs blooms and receipts
+ *        roots are all real; the state and transactions are not generated.
+ *
+ * @tparam _NetConfig The network config, e.g., `SyntheticPoWConfig`
+ */
+template<typename _NetConfig>
+class ChainGenerator
+{
+public: // static members:
+
+	using Self = ChainGenerator<_NetConfig>;
+	using NetConfig = _NetConfig;
+
+	using DAAType = typename DAASelector<NetConfig>::Calculator;
+
+	struct Config
+	{
+		Config() :
+			m_startBlockNum(1),
+			m_startTime(1600000000),
+			m_startDiff(Difficulty(1) << 32),
+			m_blockInterval(13),
+			m_blockIntervalJitter(0),
+			m_forkRate(0.0),
+			m_maxForkDepth(1),
+			m_maxUnclesPerBlock(2),
+			m_receiptsPerBlock(4),
+			m_logsPerReceipt(2),
+			m_topicsPerLog(2),
+			m_logDataSize(32),
+			m_numOfContracts(16),
+			m_numOfTopics(16),
+			m_seed(0)
+		{}
+
+		/**
+		 * @brief Number, time and difficulty of the first block, which has
+		 *        no parent
+		 *
+		 */
+		BlockNumber m_startBlockNum;
+		Timestamp m_startTime;
+		Difficulty m_startDiff;
+
+		/**
+		 * @brief Seconds between a block and its parent, plus a uniformly
+		 *        random value up to `m_blockIntervalJitter`
+		 *
+		 */
+		Timestamp m_blockInterval;
+		Timestamp m_blockIntervalJitter;
+
+		/**
+		 * @brief Expected number of new forks started per canonical block;
+		 *        each fork grows alongside the canonical chain for a random
+		 *        length of [1, m_maxForkDepth] blocks
+		 *
+		 */
+		double m_forkRate;
+		size_t m_maxForkDepth;
+
+		/**
+		 * @brief Maximum number of recent fork blocks referenced as uncles
+		 *        by a canonical block (proof-of-work only)
+		 *
+		 */
+		size_t m_maxUnclesPerBlock;
+
+		size_t m_receiptsPerBlock;
+		size_t m_logsPerReceipt;
+		size_t m_topicsPerLog;
+		size_t m_logDataSize;
+
+		/**
+		 * @brief Sizes of the pools that log addresses and topics are drawn
+		 *        from; see `GetContractAddr` and `GetEventTopic`
+		 *
+		 */
+		size_t m_numOfContracts;
+		size_t m_numOfTopics;
+
+		uint64_t m_seed;
+	}; // struct Config
+
+	struct Block
+	{
+		Block() :
+			m_header(),
+			m_receipts(),
+			m_number(0),
+			m_isCanonical(true)
+		{}
+
+		/**
+		 * @brief Get the receipts in the form `ReceiptsMgr` takes
+		 *
+		 */
+		Internal::Obj::List GetReceiptsList() const
+		{
+			Internal::Obj::List res;
+			res.reserve(m_receipts.size());
+			for (const auto& receipt : m_receipts)
+			{
+				res.push_back(Internal::Obj::Bytes(receipt));
+			}
+			return res;
+		}
+
+		std::vector<uint8_t> m_header;
+		std::vector<std::vector<uint8_t> > m_receipts;
+		BlockNumber m_number;
+		bool m_isCanonical;
+	}; // struct Block
+
+	/**
+	 * @brief Headers are generated in the London format, so the
+	 *        EthHeader items after BaseFee are left out
+	 *
+	 */
+	static constexpr size_t sk_numOfSkippedHeaderItems = 4;
+
+	/**
+	 * @brief Uncles must be within this many generations of the block
+	 *        including them
+	 *
+	 */
+	static constexpr BlockNumber sk_maxUncleDepth = 6;
+
+public:
+
+	ChainGenerator(const Config& config) :
+		m_config(config),
+		m_daa(),
+		m_rand(config.m_seed),
+		m_contracts(),
+		m_topics(),
+		m_startBlock(),
+		m_canonTip(),
+		m_forks(),
+		m_uncleCandidates(),
+		m_nextBranchId(1)
+	{
+		for (size_t i = 0; i < config.m_numOfContracts; ++i)
+		{
+			const auto hash = HashLabel("contract", i);
+			ContractAddr addr;
+			std::copy(hash.begin(), hash.begin() + addr.size(), addr.begin());
+			m_contracts.push_back(addr);
+		}
+		for (size_t i = 0; i < config.m_numOfTopics; ++i)
+		{
+			m_topics.push_back(HashLabel("topic", i));
+		}
+
+		m_startBlock = GenBlock(nullptr, 0, {});
+		m_canonTip = m_startBlock.m_header;
+	}
+
+	// LCOV_EXCL_START
+	~ChainGenerator() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Get the first block, which is the root of every later block
+	 *
+	 */
+	const Block& GetStartBlock() const
+	{
+		return m_startBlock;
+	}
+
+	const ContractAddr& GetContractAddr(size_t idx) const
+	{
+		return m_contracts.at(idx);
+	}
+
+	const EventTopic& GetEventTopic(size_t idx) const
+	{
+		return m_topics.at(idx);
+	}
+
+	/**
+	 * @brief Generate the blocks that arrive during the next block interval:
+	 *        the next canonical block, followed by the blocks of any forks.
+	 *        The parent of each block is always generated before the block.
+	 *
+	 */
+	std::vector<Block> Next()
+	{
+		std::vector<Block> res;
+
+		HeaderMgr canonParent(m_canonTip, 0);
+
+		// 1. the next canonical block
+		res.push_back(GenBlock(&canonParent, 0, TakeUncles(canonParent)));
+		m_canonTip = res.back().m_header;
+
+		// 2. grow the existing forks
+		for (auto it = m_forks.begin(); it != m_forks.end(); )
+		{
+			HeaderMgr forkParent(it->m_tip, 0);
+			res.push_back(GenBlock(&forkParent, it->m_branchId, {}));
+			res.back().m_isCanonical = false;
+			it->m_tip = res.back().m_header;
+
+			--(it->m_blocksLeft);
+			it = (it->m_blocksLeft == 0) ? m_forks.erase(it) : std::next(it);
+		}
+
+		// 3. start new forks, as siblings of the new canonical block
+		const size_t numOfNewForks = DrawNumOfNewForks();
+		for (size_t i = 0; i < numOfNewForks; ++i)
+		{
+			const uint64_t branchId = m_nextBranchId++;
+			res.push_back(GenBlock(&canonParent, branchId, {}));
+			res.back().m_isCanonical = false;
+			m_uncleCandidates.push_back(res.back().m_header);
+
+			const size_t depth = DrawUniform(1, m_config.m_maxForkDepth);
+			if (depth > 1)
+			{
+				Fork fork;
+				fork.m_tip = res.back().m_header;
+				fork.m_branchId = branchId;
+				fork.m_blocksLeft = depth - 1;
+				m_forks.push_back(fork);
+			}
+		}
+
+		return res;
+	}
+
+private:
+
+	struct Fork
+	{
+		std::vector<uint8_t> m_tip;
+		uint64_t m_branchId;
+		size_t m_blocksLeft;
+	}; // struct Fork
+
+	static std::array<uint8_t, 32> HashLabel(
+		const std::string& label,
+		uint64_t idx
+	)
+	{
+		return Keccak256(label + "#" + std::to_string(idx));
+	}
+
+	static Internal::Obj::Bytes ToBytesObj(const std::array<uint8_t, 32>& arr)
+	{
+		return Internal::Obj::Bytes(arr.begin(), arr.end());
+	}
+
+	static Internal::Obj::Bytes UIntToBytes(uint64_t val)
+	{
+		return PrimitiveTypeTrait<uint64_t>::ToBytes(val);
+	}
+
+	size_t DrawUniform(size_t minVal, size_t maxVal)
+	{
+		if (maxVal <= minVal)
+		{
+			return minVal;
+		}
+		return std::uniform_int_distribution<size_t>(minVal, maxVal)(m_rand);
+	}
+
+	size_t DrawNumOfNewForks()
+	{
+		size_t num = static_cast<size_t>(m_config.m_forkRate);
+		const double frac = m_config.m_forkRate - num;
+		if (
+			frac > 0.0 &&
+			std::uniform_real_distribution<double>(0.0, 1.0)(m_rand) < frac
+		)
+		{
+			++num;
+		}
+		return num;
+	}
+
+	/**
+	 * @brief Take the uncles to be included by the child of the given
+	 *        parent, and drop the candidates that are too old
+	 *
+	 */
+	std::vector<std::vector<uint8_t> > TakeUncles(const HeaderMgr& parent)
+	{
+		std::vector<std::vector<uint8_t> > uncles;
+		if (NetConfig::IsBlockOfParis(parent.GetNumber() + 1))
+		{
+			m_uncleCandidates.clear();
+			return uncles;
+		}
+
+		while (!m_uncleCandidates.empty())
+		{
+			HeaderMgr uncle(m_uncleCandidates.front(), 0);
+			if (uncle.GetNumber() + sk_maxUncleDepth > parent.GetNumber())
+			{
+				break;
+			}
+			m_uncleCandidates.pop_front();
+		}
+
+		while (
+			!m_uncleCandidates.empty() &&
+			uncles.size() < m_config.m_maxUnclesPerBlock
+		)
+		{
+			uncles.push_back(std::move(m_uncleCandidates.front()));
+			m_uncleCandidates.pop_front();
+		}
+		return uncles;
+	}
+
+	/**
+	 * @brief Generate a block
+	 *
+	 * @param parent   The parent, or null for the start block
+	 * @param branchId 0 for the canonical chain; each fork has its own ID,
+	 *                 so sibling blocks never share a hash
+	 * @param uncles   Raw headers of the uncles
+	 */
+	Block GenBlock(
+		const HeaderMgr* parent,
+		uint64_t branchId,
+		const std::vector<std::vector<uint8_t> >& uncles
+	)
+	{
+		Block block;
+
+		const BlockNumber number = (parent == nullptr) ?
+			m_config.m_startBlockNum :
+			parent->GetNumber() + 1;
+		const Timestamp time = (parent == nullptr) ?
+			m_config.m_startTime :
+			parent->GetTime() + m_config.m_blockInterval + (branchId % 3) +
+				DrawUniform(0, m_config.m_blockIntervalJitter);
+		const bool isPoS = NetConfig::IsBlockOfParis(number);
+
+		// receipts, their bloom and their root
+		std::array<uint8_t, BloomFilter::sk_bloomByteSize> bloom;
+		bloom.fill(0);
+		uint64_t gasUsed = 0;
+		GenReceipts(block.m_receipts, bloom, gasUsed);
+
+		HeaderMgr::RawHeaderType hdr;
+		hdr.get_ParentHash() = (parent == nullptr) ?
+			Internal::Obj::Bytes(std::vector<uint8_t>(32, 0)) :
+			ToBytesObj(parent->GetHash());
+		hdr.get_Sha3Uncles() = CalcUncleHash(uncles);
+		hdr.get_Miner() = Internal::Obj::Bytes(
+			m_contracts.empty() ?
+				std::vector<uint8_t>(20, 0) :
+				std::vector<uint8_t>(
+					m_contracts[branchId % m_contracts.size()].begin(),
+					m_contracts[branchId % m_contracts.size()].end()
+				)
+		);
+		hdr.get_StateRoot() = ToBytesObj(HashLabel("state", number ^ branchId));
+		hdr.get_TransactionsRoot() = Trie::EmptyNode::EmptyNodeHash();
+		hdr.get_ReceiptsRoot() = CalcReceiptsRoot(block.m_receipts);
+		hdr.get_LogsBloom() = Internal::Obj::Bytes(bloom.begin(), bloom.end());
+		hdr.get_Number() = UIntToBytes(number);
+		hdr.get_GasLimit() = UIntToBytes(30000000);
+		hdr.get_GasUsed() = UIntToBytes(gasUsed);
+		hdr.get_Timestamp() = UIntToBytes(time);
+		hdr.get_ExtraData() = UIntToBytes(branchId);
+		hdr.get_MixHash() = ToBytesObj(HashLabel("mix", number ^ branchId));
+		hdr.get_Nonce() = Internal::Obj::Bytes(std::vector<uint8_t>(8, 0));
+		hdr.get_BaseFee() = UIntToBytes(7000000000ULL);
+
+		// difficulty depends on the parent and this block's time only
+		Difficulty diff = 0;
+		if (!isPoS)
+		{
+			if (parent == nullptr)
+			{
+				diff = m_config.m_startDiff;
+			}
+			else
+			{
+				HeaderMgr current;
+				current.SetNumber(number);
+				current.SetTime(time);
+				diff = m_daa(*parent, current);
+			}
+		}
+		hdr.get_Difficulty() = UIntToBytes(diff);
+
+		block.m_header = Internal::Rlp::WriterStaticDictImpl<
+			Internal::Rlp::OutputContainerType,
+			Internal::Rlp::WriterGeneric
+		>::Write(hdr, sk_numOfSkippedHeaderItems);
+		block.m_number = number;
+
+		return block;
+	}
+
+	void GenReceipts(
+		std::vector<std::vector<uint8_t> >& receipts,
+		std::array<uint8_t, BloomFilter::sk_bloomByteSize>& blockBloom,
+		uint64_t& gasUsed
+	)
+	{
+		static const Internal::Obj::Bytes sk_statusSuccess({ 0x01U });
+		// EIP-1559 transaction type
+		static constexpr uint8_t sk_receiptType = 0x02U;
+
+		const bool hasLogs =
+			!m_contracts.empty() &&
+			(m_config.m_topicsPerLog == 0 || !m_topics.empty());
+
+		receipts.reserve(m_config.m_receiptsPerBlock);
+		for (size_t i = 0; i < m_config.m_receiptsPerBlock; ++i)
+		{
+			std::array<uint8_t, BloomFilter::sk_bloomByteSize> bloom;
+			bloom.fill(0);
+
+			Internal::Obj::List logs;
+			const size_t numOfLogs = hasLogs ? m_config.m_logsPerReceipt : 0;
+			for (size_t j = 0; j < numOfLogs; ++j)
+			{
+				const auto& addr = m_contracts[DrawUniform(
+					0, m_contracts.size() - 1)];
+				BloomFilter::SetBloomBits(bloom.data(), Keccak256(addr));
+
+				Internal::Obj::List topics;
+				for (size_t k = 0; k < m_config.m_topicsPerLog; ++k)
+				{
+					const auto& topic = m_topics[DrawUniform(
+						0, m_topics.size() - 1)];
+					BloomFilter::SetBloomBits(bloom.data(), Keccak256(topic));
+					topics.push_back(ToBytesObj(topic));
+				}
+
+				std::vector<uint8_t> data(m_config.m_logDataSize);
+				for (auto& b : data)
+				{
+					b = static_cast<uint8_t>(m_rand());
+				}
+
+				Internal::Obj::List logEntry;
+				logEntry.push_back(Internal::Obj::Bytes(addr.begin(), addr.end()));
+				logEntry.push_back(std::move(topics));
+				logEntry.push_back(Internal::Obj::Bytes(std::move(data)));
+				logs.push_back(std::move(logEntry));
+			}
+
+			// 21000 for the transaction, and 375 per log topic
+			gasUsed += 21000 + (375 * numOfLogs * (1 + m_config.m_topicsPerLog));
+
+			Internal::Obj::List receipt;
+			receipt.push_back(sk_statusSuccess);
+			receipt.push_back(UIntToBytes(gasUsed));
+			receipt.push_back(Internal::Obj::Bytes(bloom.begin(), bloom.end()));
+			receipt.push_back(std::move(logs));
+
+			std::vector<uint8_t> receiptBytes;
+			receiptBytes.reserve(1 + Internal::Rlp::CalcRlpSize(receipt));
+			receiptBytes.push_back(sk_receiptType);
+			Internal::Rlp::WriteRlp(receipt, std::back_inserter(receiptBytes));
+			receipts.push_back(std::move(receiptBytes));
+
+			for (size_t b = 0; b < bloom.size(); ++b)
+			{
+				blockBloom[b] |= bloom[b];
+			}
+		}
+	}
+
+	/**
+	 * @brief Same as the receipts root computed by `ReceiptsMgr`
+	 *
+	 */
+	static Internal::Obj::Bytes CalcReceiptsRoot(
+		const std::vector<std::vector<uint8_t> >& receipts
+	)
+	{
+		using _IntWriter = Internal::Rlp::EncodePrimitiveIntValue<
+			uint64_t,
+			Internal::Rlp::Endian::native,
+			false
+		>;
+		using _KeyRlpWriter =
+			Internal::Rlp::WriterBytesImpl<std::vector<uint8_t> >;
+
+		Trie::PatriciaTrie trie;
+		Internal::Obj::Bytes keyBigEndian;
+		for (size_t i = 0; i < receipts.size(); ++i)
+		{
+			keyBigEndian.resize(0);
+			_IntWriter::Encode(i, std::back_inserter(keyBigEndian));
+			trie.Put(
+				_KeyRlpWriter::Write(keyBigEndian),
+				Internal::Obj::Bytes(receipts[i])
+			);
+		}
+		return trie.Hash();
+	}
+
+	static Internal::Obj::Bytes CalcUncleHash(
+		const std::vector<std::vector<uint8_t> >& uncles
+	)
+	{
+		if (uncles.empty())
+		{
+			return HeaderMgr::GetEmptyUncleHash();
+		}
+
+		// the RLP list of the raw uncle headers
+		size_t payloadSize = 0;
+		for (const auto& uncle : uncles)
+		{
+			payloadSize += uncle.size();
+		}
+		std::vector<uint8_t> unclesRlp;
+		Internal::Rlp::SerializeLeadingBytes<
+			Internal::Rlp::RlpEncTypeCat::List,
+			uint8_t
+		>(payloadSize, std::back_inserter(unclesRlp));
+		for (const auto& uncle : uncles)
+		{
+			unclesRlp.insert(unclesRlp.end(), uncle.begin(), uncle.end());
+		}
+
+		return ToBytesObj(Keccak256(unclesRlp));
+	}
+
+	Config m_config;
+	DAAType m_daa;
+	std::mt19937_64 m_rand;
+	std::vector<ContractAddr> m_contracts;
+	std::vector<EventTopic> m_topics;
+
+	Block m_startBlock;
+	std::vector<uint8_t> m_canonTip;
+	std::vector<Fork> m_forks;
+	std::deque<std::vector<uint8_t> > m_uncleCandidates;
+	uint64_t m_nextBranchId;
+
+}; // class ChainGenerator
+
+
+} // namespace Eth
+} // namespace EclipseMonitor
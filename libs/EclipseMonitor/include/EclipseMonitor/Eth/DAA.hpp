@@ -658,6 +658,22 @@ struct DAASelector<GoerliConfig>
 }; // struct DAASelector<GoerliConfig>
 
 
+template<>
+struct DAASelector<SyntheticPoWConfig>
+{
+	using Calculator = EthashDAAImpl<SyntheticPoWConfig>;
+	using Estimator  = EthashDAAEstImpl<SyntheticPoWConfig>;
+}; // struct DAASelector<SyntheticPoWConfig>
+
+template<>
+struct DAASelector<SyntheticPoSConfig>
+{
+	// never called, since every block is after Paris
+	using Calculator = EthashDAAImpl<SyntheticPoSConfig>;
+	using Estimator  = EthashDAAEstImpl<SyntheticPoSConfig>;
+}; // struct DAASelector<SyntheticPoSConfig>
+
+
 using MainnetDAA          = typename DAASelector<MainnetConfig>::Calculator;
 using MainnetDAAEstimator = typename DAASelector<MainnetConfig>::Estimator;
 
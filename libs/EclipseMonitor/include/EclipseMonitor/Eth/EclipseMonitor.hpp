@@ -13,6 +13,7 @@
 
 #include "../EclipseMonitorBase.hpp"
 #include "../Internal/SimpleObj.hpp"
+#include "../Metrics.hpp"
 
 #include "CheckpointMgr.hpp"
 #include "DiffChecker.hpp"
@@ -216,9 +217,12 @@ protected:
 	{
 		// We're loading blocks before the latest checkpoint
 
-		std::unique_ptr<HeaderMgr> header =
-			Internal::Obj::Internal::make_unique<HeaderMgr>(
+		std::unique_ptr<HeaderMgr> header;
+		{
+			StageTimer timer(MetricsStage::HeaderParse);
+			header = Internal::Obj::Internal::make_unique<HeaderMgr>(
 				hdrBinary, 0);
+		}
 		BlockNumber blkNum = header->GetNumber();
 
 		// 1 check if this is the genesis (very first) block
@@ -228,23 +232,30 @@ protected:
 			// 1.a. update the monitor security state
 			Base::GetMonitorSecState().get_genesisHash() = header->GetHashObj();
 
-			using namespace Internal::Obj::Codec;
-			const auto hashStr = Hex::Encode<std::string>(header->GetHash());
 			Base::GetLogger().Info(
-				"Genesis block #" + std::to_string(blkNum) + "; Hash: " + hashStr
+				[&]()
+				{
+					using namespace Internal::Obj::Codec;
+					return "Genesis block #" + std::to_string(blkNum) +
+						"; Hash: " + Hex::Encode<std::string>(header->GetHash());
+				}
 			);
 		}
 		else
 		{
 			// b. it is not the genesis block
 			// 1.b validate the block
-			if (!m_validator->CommonValidate(
+			bool validateRes = false;
+			{
+				StageTimer timer(MetricsStage::HeaderValidate);
+				validateRes = m_validator->CommonValidate(
 					m_checkpoint.GetLastHeader(),
 					false,
 					*header,
 					false
-				)
-			)
+				);
+			}
+			if (!validateRes)
 			{
 				throw Exception(
 					"The given block failed common validation");
@@ -263,11 +274,15 @@ protected:
 
 	BlockNumber UpdateOnRuntime(const std::vector<uint8_t>& hdrBinary)
 	{
-		std::unique_ptr<HeaderMgr> header =
-			Internal::Obj::Internal::make_unique<HeaderMgr>(
+		const auto trustedTime = Base::GetTimestamper().NowInSec();
+		std::unique_ptr<HeaderMgr> header;
+		{
+			StageTimer timer(MetricsStage::HeaderParse);
+			header = Internal::Obj::Internal::make_unique<HeaderMgr>(
 				hdrBinary,
-				Base::GetTimestamper().NowInSec()
+				trustedTime
 			);
+		}
 		BlockNumber blkNum = header->GetNumber();
 
 		// Check offline nodes map first
@@ -398,21 +413,25 @@ private:
 
 		// common validation
 		bool isNewNodeLive = syncState->IsSynced();
-		bool validateRes = m_validator->CommonValidate(
-			parentNode->GetHeader(),
-			isParentNodeLive,
-			*header,
-			isNewNodeLive
-		);
-
-		// check difficulty
+		bool validateRes = false;
 		bool diffRes = false;
-		if (validateRes)
 		{
-			diffRes = m_diffChecker->CheckDifficulty(
+			StageTimer timer(MetricsStage::HeaderValidate);
+			validateRes = m_validator->CommonValidate(
 				parentNode->GetHeader(),
-				*header
+				isParentNodeLive,
+				*header,
+				isNewNodeLive
 			);
+
+			// check difficulty
+			if (validateRes)
+			{
+				diffRes = m_diffChecker->CheckDifficulty(
+					parentNode->GetHeader(),
+					*header
+				);
+			}
 		}
 
 		// if both check passed, add it to the parent node
@@ -482,10 +501,13 @@ private:
 			}
 		);
 		Base::GetLogger().Debug(
-			std::string("Confirmed blocks from: ") +
-				"block #" + std::to_string(startBlock) +
-				" to block #" + std::to_string(endBlock) +
-				" total: " + std::to_string(i) + " blocks"
+			[&]()
+			{
+				return std::string("Confirmed blocks from: ") +
+					"block #" + std::to_string(startBlock) +
+					" to block #" + std::to_string(endBlock) +
+					" total: " + std::to_string(i) + " blocks";
+			}
 		);
 	}
 
@@ -13,6 +13,7 @@
 
 #include "../Internal/SimpleObj.hpp"
 #include "../Logging.hpp"
+#include "../Metrics.hpp"
 
 #include "DataTypes.hpp"
 #include "EventDescription.hpp"
@@ -109,8 +110,12 @@ public:
 			std::lock_guard<std::mutex> lock(m_eventDescMapMutex);
 
 			// find if any subscription is found via the bloom filter.
-			auto bloomedEvents =
-				BloomEventDesc_Locked(headerMgr.GetBloomFilter());
+			std::vector<EventDescKIt> bloomedEvents;
+			{
+				StageTimer timer(MetricsStage::BloomCheck);
+				bloomedEvents =
+					BloomEventDesc_Locked(headerMgr.GetBloomFilter());
+			}
 
 			// nothing found in bloom filter;
 			// By the nature of bloom filter, there is no false negative.
@@ -122,9 +127,12 @@ public:
 
 
 			m_logger.Debug(
-				"Found " + std::to_string(bloomedEvents.size()) +
-				" positives in bloom filter at block #" +
-				std::to_string(headerMgr.GetNumber())
+				[&]()
+				{
+					return "Found " + std::to_string(bloomedEvents.size()) +
+						" positives in bloom filter at block #" +
+						std::to_string(headerMgr.GetNumber());
+				}
 			);
 
 
@@ -156,6 +164,7 @@ public:
 		// Now we've finished searching through the receipt managers
 		// and the subscription map is unlocked.
 
+		StageTimer timer(MetricsStage::EventDispatch);
 		ConductCallbackPlan(headerMgr, callbackPlans);
 	}
 
@@ -205,8 +214,11 @@ private: // helper functions
 			if (!logKRefs.empty())
 			{
 				logger.Debug(
-					"Found " + std::to_string(logKRefs.size()) +
-					" events in current receipt"
+					[&]()
+					{
+						return "Found " + std::to_string(logKRefs.size()) +
+							" events in current receipt";
+					}
 				);
 				plans.emplace_back(
 					std::make_pair(
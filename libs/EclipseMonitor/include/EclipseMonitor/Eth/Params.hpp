@@ -209,10 +209,87 @@ struct GoerliConfigDetails
 }; // struct GoerliConfigDetails
 
 
+/**
+ * @brief A network for synthetic chains, which stays on proof-of-work and
+ *        has every difficulty rule up to Gray Glacier active from block 0
+ *
+ */
+struct SyntheticPoWConfigDetails
+{
+	using BlkNumType = BlockNumber;
+
+	static const BlkNumType* ParisBlkNum()
+	{
+		return nullptr;
+	}
+
+	static const BlkNumType* GrayGlacierBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* ArrowGlacierBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* LondonBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* MuirGlacierBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* ConstantinopleBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* ByzantiumBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+
+	static const BlkNumType* HomesteadBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+}; // struct SyntheticPoWConfigDetails
+
+
+/**
+ * @brief A network for synthetic chains, which is on proof-of-stake from
+ *        block 0
+ *
+ */
+struct SyntheticPoSConfigDetails : public SyntheticPoWConfigDetails
+{
+	static const BlkNumType* ParisBlkNum()
+	{
+		static const BlkNumType blkNum(0UL);
+		return &blkNum;
+	}
+}; // struct SyntheticPoSConfigDetails
+
+
 using MainnetConfig = NetworkConfigImpl<MainnetConfigDetails>;
 
 using GoerliConfig = NetworkConfigImpl<GoerliConfigDetails>;
 
+using SyntheticPoWConfig = NetworkConfigImpl<SyntheticPoWConfigDetails>;
+
+using SyntheticPoSConfig = NetworkConfigImpl<SyntheticPoSConfigDetails>;
+
 
 } // namespace Eth
 } // namespace EclipseMonitor
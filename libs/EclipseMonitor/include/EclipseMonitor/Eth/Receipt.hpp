@@ -185,6 +185,20 @@ public: // static members:
 		return Receipt(ParseReceipt(rlpBytes));
 	}
 
+	/**
+	 * @brief Same as above, but the intermediate parse tree is allocated
+	 *        from the given arena
+	 *
+	 */
+	static Receipt FromBytes(
+		const Internal::Obj::BytesBaseObj& rlpBytes,
+		Internal::Obj::ObjectArena& arena
+	)
+	{
+		Internal::Obj::ObjectArenaScope arenaScope(arena);
+		return Receipt(ParseReceipt(rlpBytes));
+	}
+
 	using LogEntriesType = std::vector<ReceiptLogEntry>;
 	using LogEntriesKItType = typename LogEntriesType::const_iterator;
 	using LogEntriesKRefType = std::reference_wrapper<const ReceiptLogEntry>;
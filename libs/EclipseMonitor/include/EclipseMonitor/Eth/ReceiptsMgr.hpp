@@ -54,6 +54,9 @@ public:
 		size_t i = 0;
 		Internal::Obj::Bytes keyBigEndian;
 		keyBigEndian.reserve(8); // size_t usually is at most 8 bytes
+		// the parse tree of each receipt is dropped right after it's
+		// converted, so they can all share the same arena
+		Internal::Obj::ObjectArena receiptArena(16 * 1024);
 		for (const auto& receipt : receipts)
 		{
 			const auto& receiptBytes = receipt.AsBytes();
@@ -65,7 +68,10 @@ public:
 			trie.Put(keyRlp, receiptBytes);
 
 			// 2. receipt list
-			m_receipts.emplace_back(Receipt::FromBytes(receiptBytes));
+			m_receipts.emplace_back(
+				Receipt::FromBytes(receiptBytes, receiptArena)
+			);
+			receiptArena.Rewind();
 
 			++i;
 		}
@@ -146,16 +146,16 @@ protected: // helper functions:
 			}
 		);
 
-		using namespace Internal::Obj::Codec;
-		std::string sessionStr =
-			Hex::Encode<std::string>(baseSessID);
-		std::string nonceStr =
-			Hex::Encode<std::string>(syncState->GetNonce());
-
 		m_logger.Info(
-			std::string("Sync message generated:\n") +
-			"\tSession ID: " + sessionStr + "\n" +
-			"\tNonce:      " + nonceStr
+			[&]()
+			{
+				using namespace Internal::Obj::Codec;
+				return std::string("Sync message generated:\n") +
+					"\tSession ID: " + Hex::Encode<std::string>(baseSessID) +
+					"\n" +
+					"\tNonce:      " +
+					Hex::Encode<std::string>(syncState->GetNonce());
+			}
 		);
 
 		auto eventMgr = m_eventMgr.lock();
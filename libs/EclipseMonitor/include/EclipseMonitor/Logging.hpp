@@ -19,6 +19,10 @@ namespace Internal
 {
 
 
+/**
+ * @brief Accepts the same arguments as the real logger (strings, or callables
+ *        returning strings), and discards them without evaluating
+ */
 class DummyLogger
 {
 public:
@@ -28,16 +32,20 @@ public:
 
 	~DummyLogger() = default;
 
-	void Debug(const std::string&) const
+	template<typename _MsgT>
+	void Debug(_MsgT&&) const
 	{}
 
-	void Info(const std::string&) const
+	template<typename _MsgT>
+	void Info(_MsgT&&) const
 	{}
 
-	void Warn(const std::string&) const
+	template<typename _MsgT>
+	void Warn(_MsgT&&) const
 	{}
 
-	void Error(const std::string&) const
+	template<typename _MsgT>
+	void Error(_MsgT&&) const
 	{}
 }; // class DummyLogger
 
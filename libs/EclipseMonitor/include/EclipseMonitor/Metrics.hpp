@@ -0,0 +1,69 @@
+// Copyright (c) 2023 EclipseMonitor
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include "Config.hpp"
+
+
+namespace EclipseMonitor
+{
+
+
+/**
+ * @brief The stages timed inside the monitor
+ *
+ */
+enum class MetricsStage
+{
+	HeaderParse,
+	HeaderValidate,
+	BloomCheck,
+	EventDispatch,
+}; // enum class MetricsStage
+
+
+} // namespace EclipseMonitor
+
+
+#ifndef ECLIPSEMONITOR_METRICS_HEADER
+	// Metrics are disabled
+namespace EclipseMonitor
+{
+namespace Internal
+{
+
+
+/**
+ * @brief Accepts the same arguments as the real stage timer, and does nothing
+ */
+class DummyStageTimer
+{
+public:
+
+	DummyStageTimer(MetricsStage)
+	{}
+
+	~DummyStageTimer() = default;
+
+}; // class DummyStageTimer
+
+
+} // namespace Internal
+
+
+using StageTimer = Internal::DummyStageTimer;
+
+
+} // namespace EclipseMonitor
+
+#else // !ECLIPSEMONITOR_METRICS_HEADER
+	// Metrics are enabled
+	// The header must define `EclipseMonitor::StageTimer`, which is
+	// constructed with a `MetricsStage`, and records the time elapsed
+	// until it's destroyed
+#	include ECLIPSEMONITOR_METRICS_HEADER
+#endif // !ECLIPSEMONITOR_METRICS_HEADER
@@ -0,0 +1,61 @@
+// Copyright (c) 2023 EclipseMonitor
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+
+namespace EclipseMonitor
+{
+
+
+/**
+ * @brief Hops of a sampled block, and of the events matched in it, in the
+ *        order they're stamped; this order is also the layout of the trace
+ *        carried by the events in the heartbeat messages, so it's shared by
+ *        the client and its subscribers
+ *
+ */
+enum class TraceHop : size_t
+{
+	// stamped by the host
+	Fetch = 0,
+	Ingest,
+	// stamped by the enclave
+	Validate,
+	Match,
+	Emit,
+	// stamped by the subscriber
+	Recv,
+
+	NumOfHops,
+}; // enum class TraceHop
+
+
+inline size_t TraceHopToIdx(TraceHop hop)
+{
+	return static_cast<size_t>(hop);
+}
+
+
+inline std::vector<std::string> GetTraceHopNames()
+{
+	return std::vector<std::string>({
+		"fetch",
+		"ingest",
+		"validate",
+		"match",
+		"emit",
+		"recv",
+	});
+}
+
+
+} // namespace EclipseMonitor
@@ -155,6 +155,8 @@ macro(_decent_enclave_add_target_sgx_add_trusted)
 			DECENT_ENCLAVE_TRUSTED
 			DECENT_ENCLAVE_PLATFORM_SGX
 			DECENT_ENCLAVE_PLATFORM_SGX_TRUSTED
+			# CPUID is not available inside enclaves
+			SIMPLEOBJECTS_CODEC_HEX_NO_RUNTIME_DISPATCH
 			${_SGX_TARGET_TRUSTED_DEF}
 	)
 
@@ -0,0 +1,126 @@
+// Copyright (c) 2023 SimpleConcurrency
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <memory>
+#include <utility>
+
+#include "Task.hpp"
+#include "UpdateNotifier.hpp"
+
+
+#ifndef SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+namespace SimpleConcurrency
+#else
+namespace SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Threading
+{
+
+
+/**
+ * @brief The common interface of the classes that run `Task`s on
+ *        background threads.
+ *
+ */
+class Executor
+{
+public:
+	Executor() :
+		Executor(std::make_shared<UpdateNotifier>())
+	{}
+
+
+	/**
+	 * @brief Construct with a notifier that may be shared with other
+	 *        executors, so that the owner can wait on all of them at once.
+	 *
+	 */
+	Executor(std::shared_ptr<UpdateNotifier> notifier) :
+		m_notifier(std::move(notifier))
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~Executor() = default;
+	// LCOV_EXCL_STOP
+
+
+	/**
+	 * @brief Schedule a task to be run on a background thread.
+	 *
+	 */
+	virtual void AddTask(std::unique_ptr<Task> task) = 0;
+
+
+	/**
+	 * @brief Call the `Finishing` function of the tasks that are finished;
+	 *        should be called by the owner (main) thread.
+	 *
+	 */
+	virtual void Update() = 0;
+
+
+	/**
+	 * @brief Terminate all running tasks and stop all threads.
+	 *
+	 */
+	virtual void Terminate() = 0;
+
+
+	/**
+	 * @brief Block until there is something to update (or `WakeUp` is
+	 *        called), and then call `Update`.
+	 *
+	 */
+	void WaitAndUpdate()
+	{
+		m_notifier->Wait();
+		Update();
+	}
+
+
+	/**
+	 * @brief Wake up the owner thread blocked in `WaitAndUpdate`, e.g.,
+	 *        when the program is about to exit.
+	 *
+	 */
+	void WakeUp()
+	{
+		m_notifier->Notify();
+	}
+
+
+	const std::shared_ptr<UpdateNotifier>& GetUpdateNotifier() const
+	{
+		return m_notifier;
+	}
+
+
+protected:
+
+	/**
+	 * @brief Should be called by the child classes whenever `Update` has
+	 *        something to do.
+	 *
+	 */
+	void NotifyUpdate()
+	{
+		m_notifier->Notify();
+	}
+
+
+private:
+
+	std::shared_ptr<UpdateNotifier> m_notifier;
+
+
+}; // class Executor
+
+
+} // namespace Threading
+} // namespace SimpleConcurrency
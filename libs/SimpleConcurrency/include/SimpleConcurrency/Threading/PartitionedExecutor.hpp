@@ -0,0 +1,233 @@
+// Copyright (c) 2023 SimpleConcurrency
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+
+#include <atomic>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Executor.hpp"
+#include "WorkStealingPool.hpp"
+
+
+#ifndef SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+namespace SimpleConcurrency
+#else
+namespace SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Threading
+{
+
+
+/**
+ * @brief An executor that separates long-running services from short tasks:
+ *        - `AddServiceTask` gives each service (e.g., an IO service, or a
+ *          ticking task) a dedicated thread;
+ *        - `AddTask` runs short tasks on a work-stealing pool, which is never
+ *          occupied by the services;
+ *        - `GetTimerPool` gives a separate pool for the jobs of a timer
+ *          (e.g., `TimerWheel`), so periodic jobs, which may be long, don't
+ *          hold up the short tasks, and vice versa.
+ *
+ */
+class PartitionedExecutor :
+	public Executor
+{
+public:
+	PartitionedExecutor(size_t workerPoolSize, size_t timerPoolSize = 1) :
+		Executor(),
+		// share the notifier, so `WaitAndUpdate` also wakes up for the pools
+		m_workerPool(workerPoolSize, GetUpdateNotifier()),
+		m_timerPool(
+			std::make_shared<WorkStealingPool>(
+				timerPoolSize,
+				GetUpdateNotifier()
+			)
+		),
+		m_servicesMutex(),
+		m_services(),
+		m_finishedServicesSize(0),
+		m_terminated(false)
+	{}
+
+
+	// LCOV_EXCL_START
+	virtual ~PartitionedExecutor()
+	{
+		// terminate all threads
+		Terminate();
+	}
+	// LCOV_EXCL_STOP
+
+
+	virtual void Update() override
+	{
+		m_workerPool.Update();
+		m_timerPool->Update();
+
+		if (m_finishedServicesSize == 0)
+		{
+			return;
+		}
+
+		std::list<std::unique_ptr<ServiceEntry> > finished;
+		{
+			std::lock_guard<std::mutex> lock(m_servicesMutex);
+			for (auto it = m_services.begin(); it != m_services.end();)
+			{
+				auto curr = it++;
+				if ((*curr)->m_isFinished)
+				{
+					finished.splice(finished.end(), m_services, curr);
+					--m_finishedServicesSize;
+				}
+			}
+		}
+
+		for (auto& service : finished)
+		{
+			service->m_thread.join();
+			// call finishing function
+			service->m_task->Finishing();
+		}
+	}
+
+
+	virtual void AddTask(std::unique_ptr<Task> task) override
+	{
+		m_workerPool.AddTask(std::move(task));
+	}
+
+
+	/**
+	 * @brief Run a long-running task on a thread dedicated to it.
+	 *
+	 */
+	void AddServiceTask(std::unique_ptr<Task> task)
+	{
+		std::lock_guard<std::mutex> lock(m_servicesMutex);
+		if (m_terminated)
+		{
+			return;
+		}
+
+		std::unique_ptr<ServiceEntry> service(new ServiceEntry());
+		service->m_task = std::move(task);
+		ServiceEntry* servicePtr = service.get();
+
+		m_services.push_back(std::move(service));
+		servicePtr->m_thread = std::thread(
+			[this, servicePtr]()
+			{
+				ServiceRunner(*servicePtr);
+			}
+		);
+	}
+
+
+	virtual void Terminate() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_servicesMutex);
+			if (m_terminated)
+			{
+				return;
+			}
+			m_terminated = true;
+
+			// terminate all services
+			for (auto& service : m_services)
+			{
+				service->m_task->Terminate();
+			}
+		}
+
+		// no more services can be added, so it's safe to access the list
+		for (auto& service : m_services)
+		{
+			service->m_thread.join();
+		}
+		m_services.clear();
+
+		m_timerPool->Terminate();
+		m_workerPool.Terminate();
+	}
+
+
+	WorkStealingPool& GetWorkerPool()
+	{
+		return m_workerPool;
+	}
+
+
+	/**
+	 * @brief Get the pool for the jobs of a timer; it's shared, since timers
+	 *        (e.g., `TimerWheel`) keep a weak reference to their executor.
+	 *
+	 */
+	std::shared_ptr<WorkStealingPool> GetTimerPool()
+	{
+		return m_timerPool;
+	}
+
+
+private: // private types and functions:
+
+
+	struct ServiceEntry
+	{
+		ServiceEntry() :
+			m_task(),
+			m_thread(),
+			m_isFinished(false)
+		{}
+
+		std::unique_ptr<Task> m_task;
+		std::thread m_thread;
+		std::atomic_bool m_isFinished;
+	}; // struct ServiceEntry
+
+
+	void ServiceRunner(ServiceEntry& service)
+	{
+		try
+		{
+			service.m_task->Run();
+		}
+		catch(...)
+		{
+			service.m_task->OnException(std::current_exception());
+		}
+
+		// the counter goes first, so `Update` never sees the flag without it
+		++m_finishedServicesSize;
+		service.m_isFinished = true;
+		NotifyUpdate();
+	}
+
+
+private:
+
+	WorkStealingPool m_workerPool;
+	std::shared_ptr<WorkStealingPool> m_timerPool;
+
+	mutable std::mutex m_servicesMutex;
+	std::list<std::unique_ptr<ServiceEntry> > m_services;
+	std::atomic<size_t> m_finishedServicesSize;
+	bool m_terminated;
+
+}; // class PartitionedExecutor
+
+
+} // namespace Threading
+} // namespace SimpleConcurrency
@@ -16,6 +16,7 @@
 #include <thread>
 #include <vector>
 
+#include "Executor.hpp"
 #include "TaskRunner.hpp"
 
 
@@ -29,7 +30,8 @@ namespace Threading
 {
 
 
-class ThreadPool
+class ThreadPool :
+	public Executor
 {
 public:
 	ThreadPool(size_t poolSize) :
@@ -55,7 +57,7 @@ public:
 
 
 	// LCOV_EXCL_START
-	~ThreadPool()
+	virtual ~ThreadPool()
 	{
 		// terminate all threads
 		Terminate();
@@ -63,7 +65,7 @@ public:
 	// LCOV_EXCL_STOP
 
 
-	void Update()
+	virtual void Update() override
 	{
 		// check if there are any finished tasks
 		while (m_finishTasksQueueSize > 0)
@@ -85,7 +87,7 @@ public:
 	}
 
 
-	void AddTask(std::unique_ptr<Task> task)
+	virtual void AddTask(std::unique_ptr<Task> task) override
 	{
 		// add task to pending tasks
 		{
@@ -136,7 +138,7 @@ public:
 	}
 
 
-	void Terminate()
+	virtual void Terminate() override
 	{
 		m_terminated = true;
 
@@ -182,6 +184,7 @@ private: // private functions:
 		std::lock_guard<std::mutex> lock(m_finishTasksQueueMutex);
 		m_finishTasksQueue.push(std::move(task));
 		++m_finishTasksQueueSize;
+		NotifyUpdate();
 	}
 
 
@@ -86,6 +86,26 @@ public:
 	}
 
 
+	/**
+	 * @brief Tick once, instead of looping in `Run`; this is used when the
+	 *        task is driven by an external scheduler (e.g., `TimerWheel`).
+	 *
+	 * @return The time to wait before the next call; 0 if it should be
+	 *         called again without delay
+	 */
+	virtual TimeType TickOnce()
+	{
+		Tick();
+		return m_enableTickInterval ? m_tickInterval : TimeType(0);
+	}
+
+
+	bool IsTerminating() const
+	{
+		return m_isTerminating;
+	}
+
+
 protected:
 
 	virtual void Tick() = 0;
@@ -0,0 +1,492 @@
+// Copyright (c) 2023 SimpleConcurrency
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Executor.hpp"
+#include "LambdaTask.hpp"
+
+
+#ifndef SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+namespace SimpleConcurrency
+#else
+namespace SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Threading
+{
+
+
+/**
+ * @brief A hashed timing wheel that schedules many periodic jobs using a
+ *        single thread.
+ *        The wheel only keeps track of time; when a job is due, it is
+ *        posted to an executor, so a slow job doesn't delay the others.
+ *        A job is rescheduled only after it returns, so it never runs
+ *        concurrently with itself.
+ *        When no job is scheduled, the wheel thread sleeps until one is
+ *        added, instead of waking up on every tick.
+ *        A job scheduled through `ScheduleWakeable` can also be woken up
+ *        before it's due (e.g., when the event it waits for happens), with
+ *        the handle returned.
+ *        NOTE: the executor should not be the one for short tasks (see
+ *        `PartitionedExecutor::GetTimerPool`), since a periodic job may
+ *        take long.
+ *
+ */
+class TimerWheel
+{
+public: // static members:
+
+	/**
+	 * @brief Time in milliseconds
+	 *
+	 */
+	using TimeType = int64_t;
+
+	/**
+	 * @brief A job returns the delay until it should be called again;
+	 *        a negative value stops it.
+	 *
+	 */
+	using Callback = std::function<TimeType()>;
+
+	struct JobState;
+
+	/**
+	 * @brief Refers to a wakeable job, for as long as it's scheduled
+	 *
+	 */
+	using JobHandle = std::shared_ptr<JobState>;
+
+	static std::shared_ptr<TimerWheel> Create(
+		std::weak_ptr<Executor> executor,
+		TimeType tickInterval = 10,
+		size_t slotNum = 512
+	)
+	{
+		std::shared_ptr<TimerWheel> wheel(
+			new TimerWheel(std::move(executor), tickInterval, slotNum)
+		);
+		// the wheel thread and the dispatched jobs only hold weak
+		// references, so the last owner is never one of them, and the
+		// destructor never runs on the wheel thread
+		wheel->m_weakSelf = wheel;
+		TimerWheel* wheelPtr = wheel.get();
+		wheel->m_thread = std::thread(
+			[wheelPtr]()
+			{
+				wheelPtr->WheelLoop();
+			}
+		);
+		return wheel;
+	}
+
+public:
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel(TimerWheel&&) = delete;
+
+	// LCOV_EXCL_START
+	~TimerWheel()
+	{
+		Terminate();
+	}
+	// LCOV_EXCL_STOP
+
+	TimerWheel& operator=(const TimerWheel&) = delete;
+	TimerWheel& operator=(TimerWheel&&) = delete;
+
+
+	/**
+	 * @brief Call the given job after `delay` milliseconds; a job with no
+	 *        delay is posted to the executor right away.
+	 *
+	 */
+	void Schedule(TimeType delay, Callback callback)
+	{
+		ScheduleJob(delay, std::move(callback), nullptr);
+	}
+
+
+	/**
+	 * @brief Same as `Schedule`, but the job can be woken up with `Wake`
+	 *
+	 */
+	JobHandle ScheduleWakeable(TimeType delay, Callback callback)
+	{
+		JobHandle job = std::make_shared<JobState>();
+		ScheduleJob(delay, std::move(callback), job);
+		return job;
+	}
+
+
+	/**
+	 * @brief Call the given job now, instead of when it's due; if it's
+	 *        being called already, it's called again right after it
+	 *        returns, whatever delay it returns, so a wake-up is never
+	 *        missed. Waking up a stopped job does nothing.
+	 *
+	 */
+	void Wake(const JobHandle& job)
+	{
+		Callback callback;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_terminated || (job == nullptr))
+			{
+				return;
+			}
+			if (!job->m_isInWheel)
+			{
+				job->m_isWoken = true;
+				return;
+			}
+
+			callback = std::move(job->m_timer->m_callback);
+			m_slots[job->m_slot].erase(job->m_timer);
+			job->m_isInWheel = false;
+			--m_timerCount;
+		}
+		Dispatch(std::move(callback), job);
+	}
+
+
+	/**
+	 * @brief Drive a `TickingTask` with this wheel, instead of giving it a
+	 *        thread that sleeps between the ticks; the task is terminated
+	 *        when the wheel is.
+	 *        NOTE: the time values of the task are taken as milliseconds.
+	 *
+	 * @return The handle to wake up the task before its next tick is due
+	 */
+	template<typename _TickingTaskType>
+	JobHandle AddTickingTask(std::unique_ptr<_TickingTaskType> task)
+	{
+		std::shared_ptr<_TickingTaskType> taskPtr = std::move(task);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_terminated)
+			{
+				return nullptr;
+			}
+			m_tickingTasks.push_back(taskPtr);
+		}
+		return ScheduleWakeable(
+			0,
+			[taskPtr]() -> TimeType
+			{
+				if (taskPtr->IsTerminating())
+				{
+					return -1;
+				}
+
+				try
+				{
+					return static_cast<TimeType>(taskPtr->TickOnce());
+				}
+				catch(...)
+				{
+					taskPtr->OnException(std::current_exception());
+					return -1;
+				}
+			}
+		);
+	}
+
+
+	/**
+	 * @brief Stop the wheel, and terminate the ticking tasks it drives;
+	 *        jobs that are not yet due are dropped.
+	 *
+	 */
+	void Terminate()
+	{
+		std::vector<std::shared_ptr<Task> > tickingTasks;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_terminated)
+			{
+				return;
+			}
+			m_terminated = true;
+			tickingTasks.swap(m_tickingTasks);
+		}
+		m_cv.notify_all();
+
+		// a task may be in the middle of a tick on the executor
+		for (auto& task : tickingTasks)
+		{
+			task->Terminate();
+		}
+
+		if (m_thread.joinable())
+		{
+			if (m_thread.get_id() != std::this_thread::get_id())
+			{
+				m_thread.join();
+			}
+			else
+			{
+				// called from the wheel thread, which can't join itself;
+				// it leaves the loop as soon as this call returns
+				m_thread.detach();
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& slot : m_slots)
+		{
+			slot.clear();
+		}
+		m_timerCount = 0;
+	}
+
+
+private: // private types and functions:
+
+
+	struct Timer
+	{
+		size_t m_rounds;
+		Callback m_callback;
+		JobHandle m_job;
+	}; // struct Timer
+
+
+public:
+
+	/**
+	 * @brief Where a wakeable job is; guarded by the mutex of the wheel
+	 *
+	 */
+	struct JobState
+	{
+		JobState() :
+			m_isInWheel(false),
+			m_isWoken(false),
+			m_slot(0),
+			m_timer()
+		{}
+
+		bool m_isInWheel;
+		bool m_isWoken;
+		size_t m_slot;
+		std::list<Timer>::iterator m_timer;
+	}; // struct JobState
+
+
+private:
+
+
+	TimerWheel(
+		std::weak_ptr<Executor> executor,
+		TimeType tickInterval,
+		size_t slotNum
+	) :
+		m_executor(std::move(executor)),
+		m_tickInterval(tickInterval > 0 ? tickInterval : 1),
+		m_mutex(),
+		m_cv(),
+		m_slots(slotNum > 0 ? slotNum : 1),
+		m_cursor(0),
+		m_timerCount(0),
+		m_terminated(false),
+		m_tickingTasks(),
+		m_weakSelf(),
+		m_thread()
+	{}
+
+
+	void ScheduleJob(TimeType delay, Callback callback, JobHandle job)
+	{
+		if (delay <= 0)
+		{
+			Dispatch(std::move(callback), std::move(job));
+			return;
+		}
+
+		size_t ticks = static_cast<size_t>(
+			(delay + m_tickInterval - 1) / m_tickInterval
+		);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_terminated)
+			{
+				return;
+			}
+
+			size_t slot = (m_cursor + ticks) % m_slots.size();
+			// the number of times the slot is passed before the job is due
+			size_t rounds = (ticks - 1) / m_slots.size();
+			m_slots[slot].push_back(Timer({ rounds, std::move(callback), job }));
+			++m_timerCount;
+
+			if (job != nullptr)
+			{
+				job->m_isInWheel = true;
+				job->m_slot = slot;
+				job->m_timer = std::prev(m_slots[slot].end());
+			}
+		}
+		m_cv.notify_all();
+	}
+
+
+	void Dispatch(Callback callback, JobHandle job)
+	{
+		std::shared_ptr<Executor> executor = m_executor.lock();
+		if (executor == nullptr)
+		{
+			return;
+		}
+
+		std::weak_ptr<TimerWheel> weakSelf = m_weakSelf;
+		executor->AddTask(
+			MakeLambdaTask(
+				[weakSelf, callback, job](const std::atomic_bool&)
+				{
+					std::shared_ptr<TimerWheel> self = weakSelf.lock();
+					if ((self != nullptr) && (job != nullptr))
+					{
+						// wake-ups so far are served by this call
+						std::lock_guard<std::mutex> lock(self->m_mutex);
+						job->m_isWoken = false;
+					}
+					self.reset();
+
+					TimeType delay = callback();
+
+					self = weakSelf.lock();
+					if ((delay >= 0) && (self != nullptr))
+					{
+						if ((job != nullptr) && self->TakeWakeUp(*job))
+						{
+							delay = 0;
+						}
+						self->ScheduleJob(delay, callback, job);
+					}
+				}
+			)
+		);
+	}
+
+
+	bool TakeWakeUp(JobState& job)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const bool isWoken = job.m_isWoken;
+		job.m_isWoken = false;
+		return isWoken;
+	}
+
+
+	void WheelLoop()
+	{
+		const auto tickDuration = std::chrono::milliseconds(m_tickInterval);
+		auto nextTick = std::chrono::steady_clock::now() + tickDuration;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_terminated)
+		{
+			if (m_timerCount == 0)
+			{
+				// nothing to do; sleep until a job is scheduled
+				m_cv.wait(
+					lock,
+					[this]()
+					{
+						return (m_timerCount > 0) || m_terminated;
+					}
+				);
+				nextTick = std::chrono::steady_clock::now() + tickDuration;
+				continue;
+			}
+
+			if (
+				m_cv.wait_until(
+					lock,
+					nextTick,
+					[this]()
+					{
+						return m_terminated;
+					}
+				)
+			)
+			{
+				// terminated
+				break;
+			}
+			nextTick += tickDuration;
+
+			// advance the wheel, and collect the jobs that are due
+			m_cursor = (m_cursor + 1) % m_slots.size();
+			std::list<Timer>& slot = m_slots[m_cursor];
+			std::list<Timer> dueTimers;
+			for (auto it = slot.begin(); it != slot.end();)
+			{
+				auto curr = it++;
+				if (curr->m_rounds == 0)
+				{
+					if (curr->m_job != nullptr)
+					{
+						curr->m_job->m_isInWheel = false;
+					}
+					dueTimers.splice(dueTimers.end(), slot, curr);
+				}
+				else
+				{
+					--(curr->m_rounds);
+				}
+			}
+			m_timerCount -= dueTimers.size();
+
+			lock.unlock();
+			for (auto& timer : dueTimers)
+			{
+				Dispatch(std::move(timer.m_callback), std::move(timer.m_job));
+			}
+			lock.lock();
+		}
+	}
+
+
+private:
+
+	std::weak_ptr<Executor> m_executor;
+	TimeType m_tickInterval;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::vector<std::list<Timer> > m_slots;
+	size_t m_cursor;
+	size_t m_timerCount;
+	bool m_terminated;
+	std::vector<std::shared_ptr<Task> > m_tickingTasks;
+
+	std::weak_ptr<TimerWheel> m_weakSelf;
+	std::thread m_thread;
+
+}; // class TimerWheel
+
+
+} // namespace Threading
+} // namespace SimpleConcurrency
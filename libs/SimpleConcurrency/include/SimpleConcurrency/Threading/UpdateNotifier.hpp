@@ -0,0 +1,86 @@
+// Copyright (c) 2023 SimpleConcurrency
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <condition_variable>
+#include <mutex>
+
+
+#ifndef SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+namespace SimpleConcurrency
+#else
+namespace SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Threading
+{
+
+
+/**
+ * @brief Lets the owner thread of an executor sleep until there is
+ *        something to update (e.g., a task is finished), instead of
+ *        polling for it.
+ *        Notifications are counted, so a notification sent while the owner
+ *        is not waiting is not lost.
+ *
+ */
+class UpdateNotifier
+{
+public:
+	UpdateNotifier() :
+		m_mutex(),
+		m_cv(),
+		m_notifyCount(0)
+	{}
+
+	// LCOV_EXCL_START
+	~UpdateNotifier() = default;
+	// LCOV_EXCL_STOP
+
+
+	void Notify()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_notifyCount;
+		}
+		m_cv.notify_all();
+	}
+
+
+	/**
+	 * @brief Block until at least one notification is received since the
+	 *        last call to this function.
+	 *
+	 */
+	void Wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(
+			lock,
+			[this]()
+			{
+				return m_notifyCount > 0;
+			}
+		);
+		m_notifyCount = 0;
+	}
+
+
+private:
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	uint64_t m_notifyCount;
+
+}; // class UpdateNotifier
+
+
+} // namespace Threading
+} // namespace SimpleConcurrency
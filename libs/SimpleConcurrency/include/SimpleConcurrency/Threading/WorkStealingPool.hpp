@@ -0,0 +1,380 @@
+// Copyright (c) 2023 SimpleConcurrency
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Executor.hpp"
+
+
+#ifndef SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+namespace SimpleConcurrency
+#else
+namespace SIMPLECONCURRENCY_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Threading
+{
+
+
+/**
+ * @brief A fixed-size pool of worker threads, each of which has its own
+ *        deque of pending tasks.
+ *        A worker takes tasks from the front of its own deque, and when
+ *        that is empty, it steals from the front of the other workers'
+ *        deques, so the tasks given to the same worker are taken in the
+ *        order they were added, whichever worker runs them.
+ *        Tasks added from a worker thread go to that worker's deque;
+ *        tasks added from other threads are spread round-robin.
+ *        NOTE: this pool is meant for short tasks; tasks that run forever
+ *        occupy a worker for good, so they should be given dedicated
+ *        threads instead (see `PartitionedExecutor`).
+ *
+ */
+class WorkStealingPool :
+	public Executor
+{
+public:
+	WorkStealingPool(size_t poolSize) :
+		WorkStealingPool(poolSize, std::make_shared<UpdateNotifier>())
+	{}
+
+
+	WorkStealingPool(
+		size_t poolSize,
+		std::shared_ptr<UpdateNotifier> notifier
+	) :
+		Executor(std::move(notifier)),
+		m_terminated(false),
+		m_workers(),
+		m_threads(),
+		m_nextWorker(0),
+
+		m_idleMutex(),
+		m_idleCV(),
+		m_pendingTasksSize(0),
+
+		m_finishTasksQueueMutex(),
+		m_finishTasksQueue(),
+		m_finishTasksQueueSize(0)
+	{
+		if (poolSize == 0)
+		{
+			poolSize = 1;
+		}
+
+		m_workers.reserve(poolSize);
+		for (size_t i = 0; i < poolSize; ++i)
+		{
+			m_workers.emplace_back(new Worker());
+		}
+
+		m_threads.reserve(poolSize);
+		for (size_t i = 0; i < poolSize; ++i)
+		{
+			m_threads.emplace_back(
+				[this, i]()
+				{
+					WorkerLoop(i);
+				}
+			);
+		}
+	}
+
+
+	// LCOV_EXCL_START
+	virtual ~WorkStealingPool()
+	{
+		// terminate all threads
+		Terminate();
+	}
+	// LCOV_EXCL_STOP
+
+
+	virtual void Update() override
+	{
+		// check if there are any finished tasks
+		while (m_finishTasksQueueSize > 0)
+		{
+			std::unique_ptr<Task> task;
+
+			// Fetch a finished task
+			{
+				std::lock_guard<std::mutex> lock(m_finishTasksQueueMutex);
+
+				task = std::move(m_finishTasksQueue.front());
+				m_finishTasksQueue.pop();
+				--m_finishTasksQueueSize;
+			}
+
+			// call finishing function
+			task->Finishing();
+		}
+	}
+
+
+	virtual void AddTask(std::unique_ptr<Task> task) override
+	{
+		size_t workerIdx = GetCurrentWorkerIdx();
+		if (workerIdx >= m_workers.size())
+		{
+			// not called from one of our workers
+			workerIdx = (m_nextWorker++) % m_workers.size();
+		}
+
+		{
+			Worker& worker = *m_workers[workerIdx];
+			std::lock_guard<std::mutex> lock(worker.m_mutex);
+			worker.m_tasks.push_back(std::move(task));
+		}
+
+		{
+			// the counter is updated under the idle lock,
+			// so a worker that is about to sleep won't miss it
+			std::lock_guard<std::mutex> lock(m_idleMutex);
+			++m_pendingTasksSize;
+		}
+		m_idleCV.notify_one();
+	}
+
+
+	virtual void Terminate() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_idleMutex);
+			if (m_terminated)
+			{
+				return;
+			}
+			m_terminated = true;
+		}
+		m_idleCV.notify_all();
+
+		// terminate the tasks that are running
+		for (auto& worker : m_workers)
+		{
+			std::lock_guard<std::mutex> lock(worker->m_mutex);
+			if (worker->m_running != nullptr)
+			{
+				worker->m_running->Terminate();
+			}
+		}
+
+		// join all threads
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+		m_threads.clear();
+
+		// pending tasks are dropped
+		for (auto& worker : m_workers)
+		{
+			worker->m_tasks.clear();
+		}
+	}
+
+
+	size_t GetPoolSize() const
+	{
+		return m_workers.size();
+	}
+
+
+private: // private types and functions:
+
+
+	struct Worker
+	{
+		Worker() :
+			m_mutex(),
+			m_tasks(),
+			m_running(nullptr)
+		{}
+
+		std::mutex m_mutex;
+		std::deque<std::unique_ptr<Task> > m_tasks;
+		Task* m_running;
+	}; // struct Worker
+
+
+	static std::pair<const WorkStealingPool*, size_t>& GetThreadWorkerInfo()
+	{
+		static thread_local std::pair<const WorkStealingPool*, size_t>
+			info(nullptr, 0);
+		return info;
+	}
+
+
+	size_t GetCurrentWorkerIdx() const
+	{
+		const auto& info = GetThreadWorkerInfo();
+		return (info.first == this) ? info.second : m_workers.size();
+	}
+
+
+	void PushTaskToFinishQueue(std::unique_ptr<Task> task)
+	{
+		std::lock_guard<std::mutex> lock(m_finishTasksQueueMutex);
+		m_finishTasksQueue.push(std::move(task));
+		++m_finishTasksQueueSize;
+		NotifyUpdate();
+	}
+
+
+	/**
+	 * @brief Take a task from the front of the given worker's own deque,
+	 *        and mark it as running
+	 *
+	 * @return The task, or nullptr if there is no task or the pool is
+	 *         terminated
+	 */
+	std::unique_ptr<Task> TakeOwnTask(size_t workerIdx)
+	{
+		Worker& worker = *m_workers[workerIdx];
+		std::lock_guard<std::mutex> lock(worker.m_mutex);
+
+		if (m_terminated || worker.m_tasks.empty())
+		{
+			return nullptr;
+		}
+
+		std::unique_ptr<Task> task = std::move(worker.m_tasks.front());
+		worker.m_tasks.pop_front();
+		worker.m_running = task.get();
+		return task;
+	}
+
+
+	/**
+	 * @brief Steal a task from the front of another worker's deque,
+	 *        and mark it as running on the given worker
+	 *
+	 * @return The task, or nullptr if there is no task to steal or the
+	 *         pool is terminated
+	 */
+	std::unique_ptr<Task> StealTask(size_t workerIdx)
+	{
+		std::unique_ptr<Task> task;
+		for (size_t i = 1; i < m_workers.size() && task == nullptr; ++i)
+		{
+			Worker& victim = *m_workers[(workerIdx + i) % m_workers.size()];
+			std::lock_guard<std::mutex> lock(victim.m_mutex);
+			if (!victim.m_tasks.empty())
+			{
+				task = std::move(victim.m_tasks.front());
+				victim.m_tasks.pop_front();
+			}
+		}
+
+		if (task == nullptr)
+		{
+			return nullptr;
+		}
+
+		Worker& worker = *m_workers[workerIdx];
+		std::lock_guard<std::mutex> lock(worker.m_mutex);
+		if (m_terminated)
+		{
+			// `Terminate` may have already checked this worker,
+			// so don't start the task
+			return nullptr;
+		}
+		worker.m_running = task.get();
+		return task;
+	}
+
+
+	void WorkerLoop(size_t workerIdx)
+	{
+		GetThreadWorkerInfo() = std::make_pair(this, workerIdx);
+
+		Worker& worker = *m_workers[workerIdx];
+
+		while (true)
+		{
+			std::unique_ptr<Task> task = TakeOwnTask(workerIdx);
+			if (task == nullptr)
+			{
+				task = StealTask(workerIdx);
+			}
+
+			if (task == nullptr)
+			{
+				std::unique_lock<std::mutex> lock(m_idleMutex);
+				m_idleCV.wait(
+					lock,
+					[this]()
+					{
+						return (m_pendingTasksSize > 0) || m_terminated;
+					}
+				);
+				if (m_terminated)
+				{
+					return;
+				}
+				// some task is pending; go and find it
+				continue;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_idleMutex);
+				--m_pendingTasksSize;
+			}
+
+			try
+			{
+				task->Run();
+			}
+			catch(...)
+			{
+				task->OnException(std::current_exception());
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(worker.m_mutex);
+				worker.m_running = nullptr;
+			}
+
+			PushTaskToFinishQueue(std::move(task));
+		}
+	}
+
+
+private:
+
+	std::atomic_bool m_terminated;
+
+	std::vector<std::unique_ptr<Worker> > m_workers;
+	std::vector<std::thread> m_threads;
+	std::atomic<size_t> m_nextWorker;
+
+	mutable std::mutex m_idleMutex;
+	mutable std::condition_variable m_idleCV;
+	int64_t m_pendingTasksSize;
+
+	mutable std::mutex m_finishTasksQueueMutex;
+	std::queue<std::unique_ptr<Task> > m_finishTasksQueue;
+	std::atomic_uint64_t m_finishTasksQueueSize;
+
+}; // class WorkStealingPool
+
+
+} // namespace Threading
+} // namespace SimpleConcurrency
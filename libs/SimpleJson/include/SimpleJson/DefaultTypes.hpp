@@ -64,16 +64,21 @@ using DictParserT = DictParserImpl<
 	Internal::Obj::DictT<
 		typename DictKeyParser::RetType, typename _ValParser::RetType> >;
 
+/**
+ * @brief The strings and dict keys in trees built by `GenericObjectParser`
+ *        are mostly short, so they are kept inside the objects; the dicts are
+ *        mostly small, so they are backed by the flat hash map
+ */
 using GenericObjectParser = GenericObjectParserImpl<
 	IMContainerType,
 	Internal::Obj::Null,
 	Internal::Obj::Bool,
 	Internal::Obj::Int64,
 	Internal::Obj::Double,
-	Internal::Obj::String,
+	Internal::Obj::SmallString,
 	Internal::Obj::HashableObject,
 	Internal::Obj::ListT,
-	Internal::Obj::DictT,
+	Internal::Obj::FlatDictT,
 	Internal::Obj::Object>;
 
 template<
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 #include "Exceptions.hpp"
 #include "Utils.hpp"
@@ -122,6 +124,34 @@ public:
 	 */
 	virtual value_type GetChar() = 0;
 
+	/**
+	 * @brief Get the rest of the input, if it is stored in a contiguous
+	 *        buffer, so that the caller can scan it in bulk
+	 *
+	 * @return A pointer to the current charater and the number of
+	 *         charaters left; the pointer is nullptr if the input is not
+	 *         contiguous
+	 */
+	virtual std::pair<const value_type*, size_t> GetContiguousInput() const
+	{
+		return std::pair<const value_type*, size_t>(nullptr, 0);
+	}
+
+	/**
+	 * @brief Advance by the given number of charaters, which must not
+	 *        contain any line break (e.g., a run of charaters found via
+	 *        `GetContiguousInput`)
+	 *
+	 * @param count The number of charaters to skip
+	 */
+	virtual void SkipInLine(size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			this->GetCharAndAdv();
+		}
+	}
+
 	/**
 	 * @brief Expecting a delimiter.
 	 *        1) skip whitespaces until there is a non-whitespace char
@@ -448,6 +478,17 @@ public:
 		return res;
 	}
 
+	virtual std::pair<const value_type*, size_t>
+	GetContiguousInput() const override
+	{
+		return GetContiguousInputImpl(std::is_pointer<_ForwardItType>());
+	}
+
+	virtual void SkipInLine(size_t count) override
+	{
+		SkipInLineImpl(count, std::is_pointer<_ForwardItType>());
+	}
+
 	virtual value_type GetChar() override
 	{
 		// return the current charater (no matter if it's space or not)
@@ -478,6 +519,45 @@ private:
 		m_current = IsEnd() ? '\0' : *m_begin;
 	}
 
+	std::pair<const value_type*, size_t>
+	GetContiguousInputImpl(std::true_type /* isPointer */) const
+	{
+		return std::pair<const value_type*, size_t>(
+			m_begin, static_cast<size_t>(m_end - m_begin));
+	}
+
+	std::pair<const value_type*, size_t>
+	GetContiguousInputImpl(std::false_type /* isPointer */) const
+	{
+		return std::pair<const value_type*, size_t>(nullptr, 0);
+	}
+
+	void SkipInLineImpl(size_t count, std::true_type /* isPointer */)
+	{
+		if (static_cast<size_t>(m_end - m_begin) < count)
+		{
+			throw ParseError("Input string ends unexpectedly",
+				m_lineNum, m_colNum);
+		}
+
+		m_begin += count;
+		m_colNum += count;
+		m_current = IsEnd() ? '\0' : *m_begin;
+	}
+
+	void SkipInLineImpl(size_t count, std::false_type /* isPointer */)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (IsEnd())
+			{
+				throw ParseError("Input string ends unexpectedly",
+					m_lineNum, m_colNum);
+			}
+			Advance();
+		}
+	}
+
 }; // class ForwardIteratorStateMachine
 
 } // namespace SimpleJson
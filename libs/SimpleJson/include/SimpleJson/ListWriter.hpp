@@ -41,7 +41,7 @@ struct JsonWriterListImpl
 		++(stateNextLevel.m_nestLevel);
 		size_t len = obj.size();
 
-		for(auto it = obj.cbegin(); it != obj.cend(); ++it, --len)
+		for(const auto& item : obj.CSpan())
 		{
 			if (config.m_indent.size() > 0)
 			{
@@ -49,12 +49,13 @@ struct JsonWriterListImpl
 					config.m_indent, stateNextLevel.m_nestLevel);
 			}
 
-			_ObjWriter::Write(destIt, *it, config, stateNextLevel);
+			_ObjWriter::Write(destIt, item, config, stateNextLevel);
 
 			if (len != 1)
 			{
 				*destIt++ = ',';
 			}
+			--len;
 
 			if (config.m_indent.size() > 0)
 			{
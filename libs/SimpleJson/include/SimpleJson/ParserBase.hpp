@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "InputStateMachine.hpp"
 #include "Internal/SimpleObjects.hpp"
 
@@ -51,27 +53,61 @@ public:
 
 	virtual RetType Parse(const ContainerType& ctn) const
 	{
-		ISMType ism(
-			Internal::Obj::ToFrIt<true>(ctn.cbegin()),
-			Internal::Obj::ToFrIt<true>(ctn.cend()));
-
-		return Parse(ism);
+		return ParseContainer(ctn, false, IsContiguousCtn());
 	}
 
 	virtual RetType ParseTillEnd(const ContainerType& ctn) const
+	{
+		return ParseContainer(ctn, true, IsContiguousCtn());
+	}
+
+private:
+
+	using IsContiguousCtn = std::integral_constant<bool,
+		Internal::HasContiguousData<ContainerType>::value>;
+
+	/**
+	 * @brief Parse a container whose data is contiguous; the input is read
+	 *        via raw pointers, so parsers can scan it in bulk
+	 *        (see `InputStateMachineIf::GetContiguousInput`)
+	 */
+	RetType ParseContainer(
+		const ContainerType& ctn,
+		bool tillEnd,
+		std::true_type /* isContiguous */) const
+	{
+		const InputChType* begin = ctn.data();
+		ForwardIteratorStateMachine<const InputChType*> ism(
+			begin, begin + ctn.size());
+
+		return ParseISM(ism, tillEnd);
+	}
+
+	RetType ParseContainer(
+		const ContainerType& ctn,
+		bool tillEnd,
+		std::false_type /* isContiguous */) const
 	{
 		ISMType ism(
 			Internal::Obj::ToFrIt<true>(ctn.cbegin()),
 			Internal::Obj::ToFrIt<true>(ctn.cend()));
 
-		auto res = Parse(ism);
+		return ParseISM(ism, tillEnd);
+	}
 
-		ism.SkipWhiteSpace();
+	RetType ParseISM(InputStateMachineIf<InputChType>& ism, bool tillEnd) const
+	{
+		auto res = Parse(ism);
 
-		if (!ism.IsEnd())
+		if (tillEnd)
 		{
-			throw ParseError("Extra Data",
-				ism.GetLineCount(), ism.GetColCount());
+			ism.SkipWhiteSpace();
+
+			if (!ism.IsEnd())
+			{
+				throw ParseError("Extra Data",
+					ism.GetLineCount(), ism.GetColCount());
+			}
 		}
 
 		return res;
@@ -0,0 +1,424 @@
+// Copyright (c) 2023 SimpleJson
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "SaxHandler.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief The interface of a receiver of a string value picked out by
+ *        `SaxExtractor`
+ *
+ */
+class SaxStringSinkIf
+{
+public:
+
+	SaxStringSinkIf() = default;
+
+	// LCOV_EXCL_START
+	virtual ~SaxStringSinkIf() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnBegin() = 0;
+
+	/**
+	 * @brief A part of the string value; see `SaxHandlerIf::OnStringChunk`
+	 *
+	 */
+	virtual void OnChunk(const char* data, size_t size) = 0;
+
+	virtual void OnEnd() = 0;
+
+}; // class SaxStringSinkIf
+
+/**
+ * @brief The interface of a receiver of a list value picked out by
+ *        `SaxExtractor`; the items are picked out by their own bindings
+ *
+ */
+class SaxListSinkIf
+{
+public:
+
+	SaxListSinkIf() = default;
+
+	// LCOV_EXCL_START
+	virtual ~SaxListSinkIf() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnBegin() = 0;
+
+	virtual void OnEnd() = 0;
+
+}; // class SaxListSinkIf
+
+/**
+ * @brief A SAX handler that picks out the string and list values at the
+ *        given paths, and streams them to the bound sinks, while the rest of
+ *        the document is only checked for syntax and then dropped.
+ *        A path is a list of dict keys and list indices, for example,
+ *        `result`, `error.message`, or `result[*]`, where `[*]` matches any
+ *        item in the list; an empty path matches the root value.
+ *        A value goes to the first bound path that it matches only.
+ *        A `null` at a bound path is taken as a missing value, so the sink
+ *        isn't notified; any other value of the wrong type is an error.
+ *
+ */
+class SaxExtractor :
+	public SaxHandlerIf
+{
+public:
+
+	SaxExtractor() :
+		SaxHandlerIf(),
+		m_bindings(),
+		m_maxDepth(0),
+		m_frames(),
+		m_currSink(nullptr)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~SaxExtractor() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Stream the string values found at the given path to the sink;
+	 *        the sink must outlive the parsing
+	 *
+	 * @exception Exception If the path is malformed
+	 */
+	void Bind(const std::string& path, SaxStringSinkIf& sink)
+	{
+		AddBinding(path, &sink, nullptr);
+	}
+
+	/**
+	 * @brief Notify the sink when a list is found at the given path; the
+	 *        sink must outlive the parsing
+	 *
+	 * @exception Exception If the path is malformed
+	 */
+	void Bind(const std::string& path, SaxListSinkIf& sink)
+	{
+		AddBinding(path, nullptr, &sink);
+	}
+
+	virtual void OnNull() override
+	{
+		BeginValue();
+	}
+
+	virtual void OnBool(bool) override
+	{
+		BeginNonString();
+	}
+
+	virtual void OnNumber(const std::string&) override
+	{
+		BeginNonString();
+	}
+
+	virtual void OnStringBegin() override
+	{
+		const Binding* binding = BeginValue();
+		if (binding != nullptr)
+		{
+			if (binding->m_strSink == nullptr)
+			{
+				ThrowTypeError("list", *binding);
+			}
+			m_currSink = binding->m_strSink;
+			m_currSink->OnBegin();
+		}
+	}
+
+	virtual void OnStringChunk(const char* data, size_t size) override
+	{
+		if (m_currSink != nullptr)
+		{
+			m_currSink->OnChunk(data, size);
+		}
+	}
+
+	virtual void OnStringEnd() override
+	{
+		if (m_currSink != nullptr)
+		{
+			m_currSink->OnEnd();
+			m_currSink = nullptr;
+		}
+	}
+
+	virtual void OnListBegin() override
+	{
+		const Binding* binding = BeginValue();
+		SaxListSinkIf* listSink = nullptr;
+		if (binding != nullptr)
+		{
+			if (binding->m_listSink == nullptr)
+			{
+				ThrowTypeError("string", *binding);
+			}
+			listSink = binding->m_listSink;
+			listSink->OnBegin();
+		}
+		m_frames.push_back(Frame(true));
+		m_frames.back().m_listSink = listSink;
+	}
+
+	virtual void OnListEnd() override
+	{
+		SaxListSinkIf* listSink = m_frames.back().m_listSink;
+		m_frames.pop_back();
+		if (listSink != nullptr)
+		{
+			listSink->OnEnd();
+		}
+	}
+
+	virtual void OnDictBegin() override
+	{
+		BeginNonString();
+		m_frames.push_back(Frame(false));
+	}
+
+	virtual void OnKey(const std::string& key) override
+	{
+		m_frames.back().m_key = key;
+	}
+
+	virtual void OnDictEnd() override
+	{
+		m_frames.pop_back();
+	}
+
+private:
+
+	struct PathElem
+	{
+		enum class Kind
+		{
+			Key,
+			Index,
+			AnyIndex,
+		}; // enum class Kind
+
+		Kind m_kind;
+		std::string m_key;
+		size_t m_index;
+	}; // struct PathElem
+
+	struct Binding
+	{
+		std::string m_path;
+		std::vector<PathElem> m_elems;
+		SaxStringSinkIf* m_strSink;
+		SaxListSinkIf* m_listSink;
+	}; // struct Binding
+
+	struct Frame
+	{
+		Frame(bool isList) :
+			m_isList(isList),
+			m_key(),
+			m_index(0),
+			m_count(0),
+			m_listSink(nullptr)
+		{}
+
+		bool m_isList;
+		std::string m_key;
+		size_t m_index;
+		size_t m_count;
+		SaxListSinkIf* m_listSink;
+	}; // struct Frame
+
+	void AddBinding(
+		const std::string& path,
+		SaxStringSinkIf* strSink,
+		SaxListSinkIf* listSink
+	)
+	{
+		Binding binding;
+		binding.m_path = path;
+		binding.m_elems = ParsePath(path);
+		binding.m_strSink = strSink;
+		binding.m_listSink = listSink;
+
+		if (binding.m_elems.size() > m_maxDepth)
+		{
+			m_maxDepth = binding.m_elems.size();
+		}
+		m_bindings.push_back(std::move(binding));
+	}
+
+	[[noreturn]] static void ThrowTypeError(
+		const std::string& expType,
+		const Binding& binding
+	)
+	{
+		throw ParseError(
+			"Expecting a " + expType + " value at " + binding.m_path);
+	}
+
+	static std::vector<PathElem> ParsePath(const std::string& path)
+	{
+		std::vector<PathElem> res;
+		size_t i = 0;
+		while (i < path.size())
+		{
+			PathElem elem;
+			elem.m_index = 0;
+			if (path[i] == '[')
+			{
+				const size_t close = path.find(']', i);
+				if (close == std::string::npos || close == i + 1)
+				{
+					throw Exception("Invalid extraction path " + path);
+				}
+
+				const std::string idx = path.substr(i + 1, close - i - 1);
+				if (idx == "*")
+				{
+					elem.m_kind = PathElem::Kind::AnyIndex;
+				}
+				else
+				{
+					if (idx.find_first_not_of("0123456789") != std::string::npos)
+					{
+						throw Exception("Invalid extraction path " + path);
+					}
+					elem.m_kind = PathElem::Kind::Index;
+					elem.m_index = static_cast<size_t>(std::stoull(idx));
+				}
+				i = close + 1;
+			}
+			else
+			{
+				if (path[i] == '.')
+				{
+					if (res.empty())
+					{
+						throw Exception("Invalid extraction path " + path);
+					}
+					++i;
+				}
+
+				const size_t keyEnd = path.find_first_of(".[", i);
+				const size_t keyLen =
+					(keyEnd == std::string::npos ? path.size() : keyEnd) - i;
+				if (keyLen == 0)
+				{
+					throw Exception("Invalid extraction path " + path);
+				}
+				elem.m_kind = PathElem::Kind::Key;
+				elem.m_key = path.substr(i, keyLen);
+				i += keyLen;
+			}
+			res.push_back(std::move(elem));
+		}
+		return res;
+	}
+
+	bool IsMatch(const Binding& binding) const
+	{
+		if (binding.m_elems.size() != m_frames.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < m_frames.size(); ++i)
+		{
+			const PathElem& elem = binding.m_elems[i];
+			const Frame& frame = m_frames[i];
+			switch (elem.m_kind)
+			{
+			case PathElem::Kind::Key:
+				if (frame.m_isList || frame.m_key != elem.m_key)
+				{
+					return false;
+				}
+				break;
+			case PathElem::Kind::Index:
+				if (!frame.m_isList || frame.m_index != elem.m_index)
+				{
+					return false;
+				}
+				break;
+			case PathElem::Kind::AnyIndex:
+				if (!frame.m_isList)
+				{
+					return false;
+				}
+				break;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Advance the position for a new value
+	 *
+	 * @return The binding matching the value, or `nullptr` if there is none
+	 */
+	const Binding* BeginValue()
+	{
+		if (!m_frames.empty() && m_frames.back().m_isList)
+		{
+			Frame& frame = m_frames.back();
+			frame.m_index = frame.m_count++;
+		}
+
+		if (m_frames.size() > m_maxDepth)
+		{
+			return nullptr;
+		}
+
+		for (const auto& binding : m_bindings)
+		{
+			if (IsMatch(binding))
+			{
+				return &binding;
+			}
+		}
+		return nullptr;
+	}
+
+	void BeginNonString()
+	{
+		const Binding* binding = BeginValue();
+		if (binding != nullptr)
+		{
+			ThrowTypeError(
+				(binding->m_strSink != nullptr) ? "string" : "list",
+				*binding
+			);
+		}
+	}
+
+private:
+
+	std::vector<Binding> m_bindings;
+	size_t m_maxDepth;
+	std::vector<Frame> m_frames;
+	SaxStringSinkIf* m_currSink;
+
+}; // class SaxExtractor
+
+} // namespace SimpleJson
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 SimpleJson
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <string>
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief The interface of a handler receiving the events generated by
+ *        `SaxParser`, in the order they appear in the input
+ *
+ */
+class SaxHandlerIf
+{
+public:
+
+	SaxHandlerIf() = default;
+
+	// LCOV_EXCL_START
+	virtual ~SaxHandlerIf() = default;
+	// LCOV_EXCL_STOP
+
+	virtual void OnNull() = 0;
+
+	virtual void OnBool(bool val) = 0;
+
+	/**
+	 * @brief A number value
+	 *
+	 * @param num The number as it appears in the input (already validated)
+	 */
+	virtual void OnNumber(const std::string& num) = 0;
+
+	/**
+	 * @brief A string value begins; its content will be delivered via one or
+	 *        more calls to `OnStringChunk`, followed by `OnStringEnd`
+	 *
+	 */
+	virtual void OnStringBegin() = 0;
+
+	/**
+	 * @brief A part of the string value, with all escape sequences decoded
+	 *        and UTF-8 encoding validated.
+	 *        NOTE: the pointer may point into the input buffer, so it is only
+	 *        valid during this call
+	 *
+	 */
+	virtual void OnStringChunk(const char* data, size_t size) = 0;
+
+	virtual void OnStringEnd() = 0;
+
+	virtual void OnListBegin() = 0;
+
+	virtual void OnListEnd() = 0;
+
+	virtual void OnDictBegin() = 0;
+
+	/**
+	 * @brief The key of the next value in the current dictionary
+	 *
+	 */
+	virtual void OnKey(const std::string& key) = 0;
+
+	virtual void OnDictEnd() = 0;
+
+}; // class SaxHandlerIf
+
+} // namespace SimpleJson
@@ -0,0 +1,810 @@
+// Copyright (c) 2023 SimpleJson
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "SaxHandler.hpp"
+#include "Utils.hpp"
+#include "Internal/SimpleUtf.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief An event-driven (SAX) JSON parser that accepts its input in chunks
+ *        of any size, e.g., as they are received from the network, so the
+ *        whole input never needs to be held in memory.
+ *        Each value is reported to the given `SaxHandlerIf` as soon as it
+ *        is parsed; strings are reported in chunks as well.
+ *        The syntax accepted is the same as the one accepted by
+ *        `GenericObjectParser`.
+ *
+ */
+class SaxParser
+{
+public:
+
+	SaxParser(SaxHandlerIf& handler) :
+		m_handler(handler),
+		m_state(State::Value),
+		m_stack(),
+		m_strState(StrState::Normal),
+		m_isKey(false),
+		m_key(),
+		m_utf8Buf(),
+		m_utf8Need(0),
+		m_uVal(0),
+		m_uDigits(0),
+		m_uHigh(0),
+		m_numBuf(),
+		m_literal(nullptr),
+		m_literalIdx(0),
+		m_chunkBegin(nullptr),
+		m_consumed(0),
+		m_lineNum(0),
+		m_lineBegin(0)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~SaxParser() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Parse the next chunk of input
+	 *
+	 * @exception ParseError If the input is not valid JSON
+	 */
+	void Feed(const char* data, size_t size)
+	{
+		const char* it = data;
+		const char* end = data + size;
+		m_chunkBegin = data;
+
+		while (it != end)
+		{
+			switch (m_state)
+			{
+			case State::String:
+				it = ParseStringPart(it, end);
+				break;
+
+			case State::Number:
+				it = ParseNumberPart(it, end);
+				break;
+
+			case State::Literal:
+				it = ParseLiteralPart(it, end);
+				break;
+
+			default:
+				if (Internal::IsSpaceCh(*it))
+				{
+					if (*it == '\n')
+					{
+						NewLine(it);
+					}
+					++it;
+				}
+				else
+				{
+					ParseStructural(it);
+					++it;
+				}
+				break;
+			}
+		}
+
+		m_consumed += size;
+		m_chunkBegin = nullptr;
+	}
+
+	void Feed(const std::string& data)
+	{
+		Feed(data.data(), data.size());
+	}
+
+	/**
+	 * @brief Signal the end of input
+	 *
+	 * @exception ParseError If the input ends before a complete JSON value
+	 */
+	void Finish()
+	{
+		if (m_state == State::Number)
+		{
+			FinishNumber();
+		}
+
+		if (m_state != State::Done)
+		{
+			throw ParseError("Input string ends unexpectedly",
+				m_lineNum, m_consumed - m_lineBegin);
+		}
+	}
+
+	/**
+	 * @brief Has a complete JSON value been parsed
+	 *
+	 */
+	bool IsDone() const
+	{
+		return m_state == State::Done;
+	}
+
+private:
+
+	enum class State : uint8_t
+	{
+		Value,          // expecting a value
+		ValueOrListEnd, // right after '['
+		KeyOrDictEnd,   // right after '{'
+		Key,            // right after ',' in a dict
+		Colon,
+		CommaOrEnd,     // right after a value in a list or dict
+		String,
+		Number,
+		Literal,
+		Done,
+	}; // enum class State
+
+	enum class StrState : uint8_t
+	{
+		Normal,
+		Escape,
+		Unicode,
+		SurrogateBackslash,
+		SurrogateU,
+		Utf8,
+	}; // enum class StrState
+
+	size_t GetCol(const char* pos) const
+	{
+		return (m_consumed + static_cast<size_t>(pos - m_chunkBegin)) -
+			m_lineBegin;
+	}
+
+	[[noreturn]] void ThrowError(const std::string& issue, const char* pos) const
+	{
+		throw ParseError(issue, m_lineNum, GetCol(pos));
+	}
+
+	void NewLine(const char* pos)
+	{
+		++m_lineNum;
+		m_lineBegin = m_consumed + static_cast<size_t>(pos - m_chunkBegin) + 1;
+	}
+
+	void AfterValue()
+	{
+		m_state = m_stack.empty() ? State::Done : State::CommaOrEnd;
+	}
+
+	void ParseStructural(const char* it)
+	{
+		const char ch = *it;
+		switch (m_state)
+		{
+		case State::Value:
+			StartValue(it);
+			break;
+
+		case State::ValueOrListEnd:
+			if (ch == ']')
+			{
+				EndContainer();
+			}
+			else
+			{
+				StartValue(it);
+			}
+			break;
+
+		case State::KeyOrDictEnd:
+			if (ch == '}')
+			{
+				EndContainer();
+				break;
+			}
+			// fall through
+		case State::Key:
+			if (ch != '\"')
+			{
+				ThrowError("Unexpected character", it);
+			}
+			StartString(true);
+			break;
+
+		case State::Colon:
+			if (ch != ':')
+			{
+				ThrowError("Expecting ':' delimiter", it);
+			}
+			m_state = State::Value;
+			break;
+
+		case State::CommaOrEnd:
+			if (ch == ',')
+			{
+				m_state = (m_stack.back() == ']') ? State::Value : State::Key;
+			}
+			else if (ch == m_stack.back())
+			{
+				EndContainer();
+			}
+			else
+			{
+				ThrowError("Unexpected character", it);
+			}
+			break;
+
+		case State::Done:
+			ThrowError("Extra Data", it);
+
+		default:
+			// the other states are handled by the caller
+			break;
+		}
+	}
+
+	void StartValue(const char* it)
+	{
+		switch (*it)
+		{
+		case '\"':
+			StartString(false);
+			break;
+
+		case '[':
+			m_stack.push_back(']');
+			m_handler.OnListBegin();
+			m_state = State::ValueOrListEnd;
+			break;
+
+		case '{':
+			m_stack.push_back('}');
+			m_handler.OnDictBegin();
+			m_state = State::KeyOrDictEnd;
+			break;
+
+		case 't':
+			StartLiteral("true");
+			break;
+
+		case 'f':
+			StartLiteral("false");
+			break;
+
+		case 'n':
+			StartLiteral("null");
+			break;
+
+		case '-':
+		case '0':
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+		case '8':
+		case '9':
+			m_numBuf.assign(1, *it);
+			m_state = State::Number;
+			break;
+
+		default:
+			ThrowError("Unexpected character", it);
+		}
+	}
+
+	void EndContainer()
+	{
+		const char closing = m_stack.back();
+		m_stack.pop_back();
+		if (closing == ']')
+		{
+			m_handler.OnListEnd();
+		}
+		else
+		{
+			m_handler.OnDictEnd();
+		}
+		AfterValue();
+	}
+
+	//==========
+	// Literals
+	//==========
+
+	void StartLiteral(const char* literal)
+	{
+		m_literal = literal;
+		m_literalIdx = 1;
+		m_state = State::Literal;
+	}
+
+	const char* ParseLiteralPart(const char* it, const char* end)
+	{
+		for (; it != end && m_literal[m_literalIdx] != '\0'; ++it)
+		{
+			if (*it != m_literal[m_literalIdx])
+			{
+				ThrowError("Unexpected character", it);
+			}
+			++m_literalIdx;
+		}
+
+		if (m_literal[m_literalIdx] == '\0')
+		{
+			if (m_literal[0] == 'n')
+			{
+				m_handler.OnNull();
+			}
+			else
+			{
+				m_handler.OnBool(m_literal[0] == 't');
+			}
+			AfterValue();
+		}
+		return it;
+	}
+
+	//==========
+	// Numbers
+	//==========
+
+	static bool IsNumberCh(char ch)
+	{
+		return (ch >= '0' && ch <= '9') ||
+			(ch == '-') || (ch == '+') || (ch == '.') ||
+			(ch == 'e') || (ch == 'E');
+	}
+
+	static bool IsDigitCh(char ch)
+	{
+		return (ch >= '0' && ch <= '9');
+	}
+
+	/**
+	 * @brief Check the number against the grammar in RFC 7159 section 6
+	 *
+	 */
+	static bool IsValidNumber(const std::string& num)
+	{
+		size_t i = 0;
+		const size_t size = num.size();
+
+		if (i < size && num[i] == '-')
+		{
+			++i;
+		}
+
+		// int part
+		if (i < size && num[i] == '0')
+		{
+			++i;
+		}
+		else if (i < size && IsDigitCh(num[i]))
+		{
+			while (i < size && IsDigitCh(num[i]))
+			{
+				++i;
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		// frac part
+		if (i < size && num[i] == '.')
+		{
+			++i;
+			if (!(i < size && IsDigitCh(num[i])))
+			{
+				return false;
+			}
+			while (i < size && IsDigitCh(num[i]))
+			{
+				++i;
+			}
+		}
+
+		// exp part
+		if (i < size && (num[i] == 'e' || num[i] == 'E'))
+		{
+			++i;
+			if (i < size && (num[i] == '+' || num[i] == '-'))
+			{
+				++i;
+			}
+			if (!(i < size && IsDigitCh(num[i])))
+			{
+				return false;
+			}
+			while (i < size && IsDigitCh(num[i]))
+			{
+				++i;
+			}
+		}
+
+		return i == size;
+	}
+
+	void FinishNumber()
+	{
+		if (!IsValidNumber(m_numBuf))
+		{
+			throw ParseError("Invalid number " + m_numBuf,
+				m_lineNum, m_consumed - m_lineBegin);
+		}
+		m_handler.OnNumber(m_numBuf);
+		AfterValue();
+	}
+
+	const char* ParseNumberPart(const char* it, const char* end)
+	{
+		const char* begin = it;
+		while (it != end && IsNumberCh(*it))
+		{
+			++it;
+		}
+		m_numBuf.append(begin, it);
+
+		if (it != end)
+		{
+			// the number ends before this char
+			if (!IsValidNumber(m_numBuf))
+			{
+				ThrowError("Invalid number " + m_numBuf, it);
+			}
+			m_handler.OnNumber(m_numBuf);
+			AfterValue();
+		}
+		return it;
+	}
+
+	//==========
+	// Strings
+	//==========
+
+	void StartString(bool isKey)
+	{
+		m_isKey = isKey;
+		m_strState = StrState::Normal;
+		m_state = State::String;
+		if (isKey)
+		{
+			m_key.clear();
+		}
+		else
+		{
+			m_handler.OnStringBegin();
+		}
+	}
+
+	void EndString()
+	{
+		if (m_isKey)
+		{
+			m_handler.OnKey(m_key);
+			m_state = State::Colon;
+		}
+		else
+		{
+			m_handler.OnStringEnd();
+			AfterValue();
+		}
+	}
+
+	void EmitStr(const char* data, size_t size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		if (m_isKey)
+		{
+			m_key.append(data, size);
+		}
+		else
+		{
+			m_handler.OnStringChunk(data, size);
+		}
+	}
+
+	template<typename _It>
+	void ValidateUtf8(_It begin, _It end, const char* pos) const
+	{
+		try
+		{
+			Internal::Utf::Utf8ToCodePtOnce(begin, end);
+		}
+		catch(const Internal::Utf::UtfConversionException& e)
+		{
+			ThrowError(std::string("Invalid Unicode - ") + e.what(), pos);
+		}
+	}
+
+	size_t GetUtf8Size(char leading, const char* pos) const
+	{
+		try
+		{
+			size_t contCount = 0;
+			std::tie(contCount, std::ignore) =
+				Internal::Utf::Internal::Utf8ReadLeading(leading);
+			return contCount + 1;
+		}
+		catch(const Internal::Utf::UtfConversionException& e)
+		{
+			ThrowError(std::string("Invalid Unicode - ") + e.what(), pos);
+		}
+	}
+
+	void EmitCodeUnits(const char16_t* begin, const char16_t* end,
+		const char* pos)
+	{
+		std::string utf8;
+		try
+		{
+			Internal::Utf::Utf16ToUtf8(begin, end, std::back_inserter(utf8));
+		}
+		catch(const Internal::Utf::UtfConversionException& e)
+		{
+			ThrowError(std::string("Invalid Unicode - ") + e.what(), pos);
+		}
+		EmitStr(utf8.data(), utf8.size());
+	}
+
+	const char* ParseStringPart(const char* it, const char* end)
+	{
+		while (it != end && m_state == State::String)
+		{
+			switch (m_strState)
+			{
+			case StrState::Normal:
+				it = ParseStringRun(it, end);
+				break;
+
+			case StrState::Escape:
+				ParseEscape(it);
+				++it;
+				break;
+
+			case StrState::Unicode:
+				ParseUnicodeDigit(it);
+				++it;
+				break;
+
+			case StrState::SurrogateBackslash:
+				if (*it != '\\')
+				{
+					ThrowError("Unexpected character", it);
+				}
+				m_strState = StrState::SurrogateU;
+				++it;
+				break;
+
+			case StrState::SurrogateU:
+				if (*it != 'u')
+				{
+					ThrowError("Unexpected character", it);
+				}
+				m_uVal = 0;
+				m_uDigits = 0;
+				m_strState = StrState::Unicode;
+				++it;
+				break;
+
+			case StrState::Utf8:
+				// complete the UTF-8 char cut off by the previous chunk
+				while (it != end && m_utf8Buf.size() < m_utf8Need)
+				{
+					m_utf8Buf.push_back(*it++);
+				}
+				if (m_utf8Buf.size() == m_utf8Need)
+				{
+					ValidateUtf8(m_utf8Buf.cbegin(), m_utf8Buf.cend(), it);
+					EmitStr(m_utf8Buf.data(), m_utf8Buf.size());
+					m_strState = StrState::Normal;
+				}
+				break;
+			}
+		}
+		return it;
+	}
+
+	/**
+	 * @brief Emit the run of plain characters that begins at `it`, as a
+	 *        single chunk that points into the input buffer
+	 *
+	 */
+	const char* ParseStringRun(const char* it, const char* end)
+	{
+		const char* runBegin = it;
+		while (true)
+		{
+			it = Internal::FindJsonStrSpecialCh(it, end);
+			if (it == end)
+			{
+				EmitStr(runBegin, static_cast<size_t>(it - runBegin));
+				return it;
+			}
+
+			const char ch = *it;
+			if (ch == '\"')
+			{
+				EmitStr(runBegin, static_cast<size_t>(it - runBegin));
+				EndString();
+				return it + 1;
+			}
+			else if (ch == '\\')
+			{
+				EmitStr(runBegin, static_cast<size_t>(it - runBegin));
+				m_strState = StrState::Escape;
+				return it + 1;
+			}
+			else if (static_cast<uint8_t>(ch) < 0x80)
+			{
+				// a control char; it's kept as is, like `StringParserImpl`
+				if (ch == '\n')
+				{
+					NewLine(it);
+				}
+				++it;
+			}
+			else
+			{
+				const size_t utf8Size = GetUtf8Size(ch, it);
+				if (static_cast<size_t>(end - it) < utf8Size)
+				{
+					// the char is cut off by the end of this chunk
+					EmitStr(runBegin, static_cast<size_t>(it - runBegin));
+					m_utf8Buf.assign(it, end);
+					m_utf8Need = utf8Size;
+					m_strState = StrState::Utf8;
+					return end;
+				}
+				ValidateUtf8(it, it + utf8Size, it);
+				it += utf8Size;
+			}
+		}
+	}
+
+	void ParseEscape(const char* it)
+	{
+		char ch = '\0';
+		switch (*it)
+		{
+		case '\"':
+			ch = '\"';
+			break;
+		case '\\':
+			ch = '\\';
+			break;
+		case '/':
+			ch = '/';
+			break;
+		case 'b':
+			ch = '\b';
+			break;
+		case 'f':
+			ch = '\f';
+			break;
+		case 'n':
+			ch = '\n';
+			break;
+		case 'r':
+			ch = '\r';
+			break;
+		case 't':
+			ch = '\t';
+			break;
+		case 'u':
+			m_uVal = 0;
+			m_uDigits = 0;
+			m_uHigh = 0;
+			m_strState = StrState::Unicode;
+			return;
+		default:
+			ThrowError("Unexpected character", it);
+		}
+
+		EmitStr(&ch, 1);
+		m_strState = StrState::Normal;
+	}
+
+	void ParseUnicodeDigit(const char* it)
+	{
+		const char ch = *it;
+		uint8_t val = 0;
+		if (ch >= '0' && ch <= '9')
+		{
+			val = static_cast<uint8_t>(ch - '0');
+		}
+		else if (ch >= 'A' && ch <= 'F')
+		{
+			val = static_cast<uint8_t>((ch - 'A') + 0xa);
+		}
+		else if (ch >= 'a' && ch <= 'f')
+		{
+			val = static_cast<uint8_t>((ch - 'a') + 0xa);
+		}
+		else
+		{
+			ThrowError("Invalid \\uXXXX escape", it);
+		}
+
+		m_uVal = static_cast<char16_t>((m_uVal << 4) | val);
+		if (++m_uDigits < 4)
+		{
+			return;
+		}
+
+		m_strState = StrState::Normal;
+		if (m_uHigh != 0)
+		{
+			// the second half of a surrogate pair
+			const char16_t pair[2] = { m_uHigh, m_uVal };
+			m_uHigh = 0;
+			EmitCodeUnits(std::begin(pair), std::end(pair), it);
+		}
+		else if (Internal::Utf::Internal::IsUtf16SurrogateFirst(m_uVal))
+		{
+			m_uHigh = m_uVal;
+			m_strState = StrState::SurrogateBackslash;
+		}
+		else
+		{
+			EmitCodeUnits(&m_uVal, &m_uVal + 1, it);
+		}
+	}
+
+private:
+
+	SaxHandlerIf& m_handler;
+
+	State m_state;
+	// the closing chars of the containers being parsed
+	std::vector<char> m_stack;
+
+	StrState m_strState;
+	bool m_isKey;
+	std::string m_key;
+	std::string m_utf8Buf;
+	size_t m_utf8Need;
+	char16_t m_uVal;
+	size_t m_uDigits;
+	char16_t m_uHigh;
+
+	std::string m_numBuf;
+
+	const char* m_literal;
+	size_t m_literalIdx;
+
+	// for error positions
+	const char* m_chunkBegin;
+	size_t m_consumed;
+	size_t m_lineNum;
+	size_t m_lineBegin;
+
+}; // class SaxParser
+
+} // namespace SimpleJson
@@ -8,6 +8,8 @@
 
 
 #include "DefaultTypes.hpp"
+#include "SaxExtractor.hpp"
+#include "SaxParser.hpp"
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
 namespace SimpleJson
@@ -22,6 +24,21 @@ inline static Internal::Obj::Object LoadStr(const IMContainerType& str)
 	return parser.ParseTillEnd(str);
 }
 
+/**
+ * @brief Parse the JSON string, allocating all nodes of the returned tree
+ *        from the given arena, which must outlive the returned object
+ *
+ */
+inline static Internal::Obj::Object LoadStr(
+	const IMContainerType& str,
+	Internal::Obj::ObjectArena& arena
+)
+{
+	Internal::Obj::ObjectArenaScope arenaScope(arena);
+	GenericObjectParser parser;
+	return parser.ParseTillEnd(str);
+}
+
 template<typename _ObjType>
 struct FindObjWriter;
 
@@ -86,6 +103,12 @@ struct FindObjWriter<Internal::Obj::Dict>
 	using type = JsonWriterDictT<JsonWriterKey, JsonWriterObject>;
 }; // struct FindObjWriter
 
+template<>
+struct FindObjWriter<Internal::Obj::FlatDict>
+{
+	using type = JsonWriterDictT<JsonWriterKey, JsonWriterObject>;
+}; // struct FindObjWriter
+
 template<
 	typename _ObjType,
 	typename _WriterType = typename FindObjWriter<_ObjType>::type>
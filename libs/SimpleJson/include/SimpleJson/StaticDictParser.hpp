@@ -139,7 +139,8 @@ public: // static members:
 			m_targetKeyPtr(keyPtr),
 			m_ismPtr(ismPtr),
 			m_clPtr(clPtr),
-			m_parsed(0)
+			m_parsed(0),
+			m_parsedIdx(0)
 		{}
 
 		~ParseValueCallBack() = default;
@@ -150,12 +151,14 @@ public: // static members:
 			std::pair<_KeyType, _ValType>& core,
 			const std::pair<_KeyType, _ValParserType>& parser)
 		{
-			if (core.first.key == (*m_targetKeyPtr))
+			// keys are unique, so stop comparing once a match is found
+			if ((m_parsed == 0) && (core.first.key == (*m_targetKeyPtr)))
 			{
 				// A match is found
 				core.second = parser.second.Parse(*m_ismPtr);
 				++m_parsed;
 				++((*m_clPtr)[i]);
+				m_parsedIdx = i;
 			}
 		}
 
@@ -163,6 +166,7 @@ public: // static members:
 		InputStateMachineIf<InputChType>* m_ismPtr;
 		_ParsedValChecklist* m_clPtr;
 		size_t m_parsed;
+		size_t m_parsedIdx;
 
 	}; // struct ParseValueCallBack
 
@@ -180,6 +184,7 @@ public:
 	{
 		TupleCore resTp;
 		_ParsedValChecklist checklist = { 0 };
+		size_t nextIdx = 0;
 
 		auto ch = ism.SkipSpaceAndGetCharAndAdv();
 
@@ -195,7 +200,7 @@ public:
 			}
 			else
 			{
-				ParseKeyValPair(ism, resTp, checklist);
+				ParseKeyValPair(ism, resTp, checklist, nextIdx);
 			}
 
 			// Check if there is following items
@@ -204,7 +209,7 @@ public:
 			{
 				ism.GetCharAndAdv(); // consume ','
 
-				ParseKeyValPair(ism, resTp, checklist);
+				ParseKeyValPair(ism, resTp, checklist, nextIdx);
 
 				ch = ism.SkipSpaceAndGetChar();
 			}
@@ -222,17 +227,38 @@ public:
 			ism.GetLineCount(), ism.GetColCount());
 	}
 
+	/**
+	 * @brief Parse a key-value pair, and store the value in the matching
+	 *        item of the tuple
+	 *
+	 * @param nextIdx The index of the item that is expected to come next;
+	 *                since the writers emit the items in the order of the
+	 *                tuple, this item is checked first, before searching
+	 *                through the entire tuple
+	 */
 	void ParseKeyValPair(
 		InputStateMachineIf<InputChType>& ism,
 		TupleCore& resTp,
-		_ParsedValChecklist& checklist) const
+		_ParsedValChecklist& checklist,
+		size_t& nextIdx) const
 	{
 		auto k = m_keyParser.Parse(ism);
 		ism.ExpDelimiter(':');
 
 		ParseValueCallBack cb(&k, &ism, &checklist);
 
-		Internal::Obj::Internal::TupleOperation::BinOp(resTp, m_parserTp, cb);
+		Internal::Obj::Internal::TupleOperation::BinOpAt(
+			nextIdx, resTp, m_parserTp, cb);
+		if (cb.m_parsed == 0)
+		{
+			Internal::Obj::Internal::TupleOperation::BinOp(
+				resTp, m_parserTp, cb);
+		}
+
+		if (cb.m_parsed != 0)
+		{
+			nextIdx = cb.m_parsedIdx + 1;
+		}
 
 		if (cb.m_parsed == 0)
 		{
@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
 #include "ParserBase.hpp"
 #include "Internal/SimpleUtf.hpp"
 
@@ -72,6 +76,8 @@ protected:
 		{
 			while(true)
 			{
+				AppendPlainRun(ism, res);
+
 				ch = ism.GetCharAndAdv();
 				// Case 1 - ending quote
 				if (ch == '\"') // Ending
@@ -126,6 +132,104 @@ protected:
 
 private:
 
+	/**
+	 * @brief Fast path for contiguous input: copy the run of characters
+	 *        that need no special handling (i.e., up to the next quote,
+	 *        backslash, control character, or invalid UTF-8 sequence) into
+	 *        `res` in one go, and skip over it.
+	 *        Anything that stops the run is left for the per-character
+	 *        path, so errors are reported at the same positions.
+	 */
+	void AppendPlainRun(
+		InputStateMachineIf<InputChType>& ism, ObjType& res) const
+	{
+		AppendPlainRunImpl(ism, res, IsByteInput());
+	}
+
+	using IsByteInput =
+		std::integral_constant<bool, (sizeof(InputChType) == 1)>;
+
+	void AppendPlainRunImpl(
+		InputStateMachineIf<InputChType>&,
+		ObjType&,
+		std::false_type /* isByteInput */) const
+	{}
+
+	void AppendPlainRunImpl(
+		InputStateMachineIf<InputChType>& ism,
+		ObjType& res,
+		std::true_type /* isByteInput */) const
+	{
+		const InputChType* begin = nullptr;
+		size_t size = 0;
+		std::tie(begin, size) = ism.GetContiguousInput();
+		if (begin == nullptr)
+		{
+			return;
+		}
+
+		const InputChType* end = begin + size;
+		const InputChType* it = begin;
+		while (true)
+		{
+			it = Internal::FindJsonStrSpecialCh(it, end);
+			if ((it == end) || AsciiTraitType::IsAsciiFast(*it))
+			{
+				// the end of input, or a quote, backslash, or control char
+				break;
+			}
+
+			// a non-ASCII char; it's kept in the run only if it's valid UTF-8
+			// (a valid encoding is the shortest one, so it's copied as is)
+			const InputChType* next = SkipValidUtf8(it, end);
+			if (next == it)
+			{
+				break;
+			}
+			it = next;
+		}
+
+		const size_t runLen = static_cast<size_t>(it - begin);
+		if (runLen == 0)
+		{
+			return;
+		}
+
+		const size_t oriSize = res.size();
+		res.resize(oriSize + runLen);
+		std::copy(begin, it, &res[oriSize]);
+
+		ism.SkipInLine(runLen);
+	}
+
+	/**
+	 * @brief Validate one UTF-8 encoded character via SimpleUtf
+	 *
+	 * @return Pointer to the byte after the character, or `begin` if it is
+	 *         not valid, or is cut off by the end of input
+	 */
+	static const InputChType* SkipValidUtf8(
+		const InputChType* begin, const InputChType* end)
+	{
+		try
+		{
+			size_t contCount = 0;
+			std::tie(contCount, std::ignore) =
+				Internal::Utf::Internal::Utf8ReadLeading(*begin);
+			if (static_cast<size_t>(end - begin) <= contCount)
+			{
+				return begin;
+			}
+
+			return Internal::Utf::Utf8ToCodePtOnce(
+				begin, begin + contCount + 1).second;
+		}
+		catch(const Internal::Utf::UtfConversionException&)
+		{
+			return begin;
+		}
+	}
+
 	char16_t ParseUXXXX(InputStateMachineIf<InputChType>& ism) const
 	{
 		char16_t res = 0;
@@ -48,8 +48,9 @@ struct JsonWriterStringImpl
 		const WriterStates&)
 	{
 		*dest++ = '\"';
-		auto it = obj.begin();
-		while(it != obj.end())
+		const _CharType* it = obj.data();
+		const _CharType* const end = it + obj.size();
+		while(it != end)
 		{
 			auto ch = (*it);
 			if(AsciiTraitType::IsAsciiFast(ch))
@@ -5,7 +5,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
 namespace SimpleJson
@@ -59,5 +65,78 @@ inline void RepeatOutput(_OutIt out, const _Container& ctn, size_t repTime)
 	RepeatOutput(out, ctn.begin(), ctn.end(), repTime);
 }
 
+/**
+ * @brief Check if a container stores its values in a contiguous buffer that
+ *        can be accessed via `data()`
+ *
+ * @tparam _CtnType The type of the container
+ */
+template<typename _CtnType>
+struct HasContiguousData
+{
+	template<typename _T>
+	static std::is_same<
+		decltype(std::declval<const _T&>().data()),
+		const typename _T::value_type*>
+	Test(int);
+
+	template<typename _T>
+	static std::false_type Test(...);
+
+	static constexpr bool value = decltype(Test<_CtnType>(0))::value;
+}; // struct HasContiguousData
+
+/**
+ * @brief Find the first character in the given buffer that can't be copied
+ *        verbatim into a JSON string value, i.e., the ending quote, a
+ *        backslash, a control character (including line breaks), or a
+ *        non-ASCII byte.
+ *        The buffer is scanned 8 bytes at a time.
+ *
+ * @return Pointer to the character found, or `end` if there is none
+ */
+template<typename _CharType>
+inline const _CharType* FindJsonStrSpecialCh(
+	const _CharType* begin, const _CharType* end)
+{
+	static_assert(sizeof(_CharType) == 1,
+		"This function only works with byte-sized characters");
+
+	static constexpr uint64_t sk_ones  = 0x0101010101010101ULL;
+	static constexpr uint64_t sk_highs = 0x8080808080808080ULL;
+
+	while (static_cast<size_t>(end - begin) >= sizeof(uint64_t))
+	{
+		uint64_t word = 0;
+		std::memcpy(&word, begin, sizeof(word));
+
+		const uint64_t quote = word ^ (sk_ones * '\"');
+		const uint64_t bslash = word ^ (sk_ones * '\\');
+		// a byte is flagged if it's zero (i.e., a match), less than 0x20,
+		// or has the high bit set; a flag may also be set on a byte after
+		// a real match, so the exact position is found below
+		const uint64_t mask =
+			((quote - sk_ones) & ~quote) |
+			((bslash - sk_ones) & ~bslash) |
+			(word - (sk_ones * 0x20)) |
+			word;
+		if ((mask & sk_highs) != 0)
+		{
+			break;
+		}
+		begin += sizeof(uint64_t);
+	}
+
+	for (; begin != end; ++begin)
+	{
+		const uint8_t ch = static_cast<uint8_t>(*begin);
+		if ((ch == '\"') || (ch == '\\') || (ch < 0x20) || (ch >= 0x80))
+		{
+			return begin;
+		}
+	}
+	return end;
+}
+
 } // namespace Internal
 } // namespace SimpleJson
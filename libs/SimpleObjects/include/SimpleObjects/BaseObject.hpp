@@ -12,6 +12,7 @@
 #include "Compare.hpp"
 #include "Exception.hpp"
 #include "Iterator.hpp"
+#include "ObjectArena.hpp"
 
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
@@ -91,6 +92,29 @@ public:
 	virtual ~BaseObject() = default;
 	// LCOV_EXCL_STOP
 
+	/**
+	 * @brief Objects are allocated from the arena of the current
+	 *        `ObjectArenaScope`, if there is one
+	 *
+	 */
+	static void* operator new(size_t size)
+	{
+		return Internal::ObjectAllocate(size);
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		Internal::ObjectFree(ptr);
+	}
+
+	static void* operator new(size_t, void* ptr) noexcept
+	{
+		return ptr;
+	}
+
+	static void operator delete(void*, void*) noexcept
+	{}
+
 	virtual ObjCategory GetCategory() const = 0;
 
 	virtual const char* GetCategoryName() const = 0;
@@ -205,7 +205,7 @@ public:
 		}
 		catch(const std::bad_cast&)
 		{
-			throw TypeError("Bytes", this->GetCategoryName());
+			SetFromOtherContainer(other);
 		}
 	}
 
@@ -218,7 +218,7 @@ public:
 		}
 		catch(const std::bad_cast&)
 		{
-			throw TypeError("Bytes", this->GetCategoryName());
+			SetFromOtherContainer(other);
 		}
 	}
 
@@ -301,6 +301,11 @@ public:
 		m_data.insert(m_data.end(), begin, end);
 	}
 
+	virtual void Append(const Base& other) override
+	{
+		AppendContiguous(other.data(), other.size());
+	}
+
 	// ========== iterators ==========
 
 	using Base::begin;
@@ -412,6 +417,41 @@ private:
 		*outit++ = '\"';
 	}
 
+	/**
+	 * @brief Copy the data of a Bytes object with a different container type
+	 *
+	 */
+	void SetFromOtherContainer(const BaseBaseBase& other)
+	{
+		if (other.GetCategory() != sk_cat())
+		{
+			throw TypeError("Bytes", other.GetCategoryName());
+		}
+		const auto& otherObj = other.AsBytes();
+		m_data = ContainerType(
+			otherObj.data(), otherObj.data() + otherObj.size());
+	}
+
+	/**
+	 * @brief Append a contiguous range, which may be part of this object
+	 *
+	 */
+	void AppendContiguous(const_pointer begin, size_t size)
+	{
+		if (begin == m_data.data())
+		{
+			m_data.reserve(m_data.size() + size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				m_data.push_back(m_data[i]);
+			}
+		}
+		else
+		{
+			m_data.insert(m_data.end(), begin, begin + size);
+		}
+	}
+
 	std::unique_ptr<Self> CopyImpl() const
 	{
 		return Internal::make_unique<Self>(*this);
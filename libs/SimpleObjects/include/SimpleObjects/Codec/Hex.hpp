@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <algorithm>
 #include <iterator>
 #include <stdexcept>
 #include <string>
@@ -16,6 +17,7 @@
 
 #include "HexEncodeImpl.hpp"
 #include "HexDecodeImpl.hpp"
+#include "HexBulkImpl.hpp"
 
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
@@ -66,8 +68,16 @@ struct Hex
 	{
 		static constexpr size_t sk_inValTypeSize =
 			sizeof(typename _InContainer::value_type);
+		using _CanBulk = std::integral_constant<bool,
+			_KeepLeadingZero &&
+			HexBulkIsContiguous<_OutContainer>::value &&
+			HexBulkIsContiguous<_InContainer>::value>;
 
 		_OutContainer dest;
+		if (TryBulkEncodeCtn(dest, src, prefix, _CanBulk()))
+		{
+			return dest;
+		}
 		dest.reserve(src.size() * 2 + prefix.size());
 
 		BytesToHexImpl<Alphabet, sk_inValTypeSize>::
@@ -113,8 +123,15 @@ struct Hex
 	)
 	{
 		static constexpr size_t sk_inValTypeSize = sizeof(_InValueType);
+		using _CanBulk = std::integral_constant<bool,
+			_KeepLeadingZero &&
+			HexBulkIsContiguous<_OutContainer>::value>;
 
 		_OutContainer dest;
+		if (TryBulkEncode(dest, std::begin(src), std::end(src), prefix, _CanBulk()))
+		{
+			return dest;
+		}
 		dest.reserve(_InSize * 2 + prefix.size());
 
 		BytesToHexImpl<Alphabet, sk_inValTypeSize>::
@@ -371,8 +388,16 @@ struct Hex
 			HexDecodeCanPadInPlace<_InItType>();
 
 		HexDecodeCheckPadImpl<_PadOpt>::ThrowIfOdd(src.size());
+		using _CanBulk = std::integral_constant<bool,
+			_KeepLeadingZero &&
+			HexBulkIsContiguous<_OutContainer>::value &&
+			HexBulkIsContiguous<_InContainer>::value>;
 
 		_OutContainer dest;
+		if (TryBulkDecodeCtn(dest, src, _CanBulk()))
+		{
+			return dest;
+		}
 		dest.reserve((src.size() + 1) / 2);
 
 		size_t decodedSize = 0;
@@ -484,8 +509,17 @@ struct Hex
 		static constexpr size_t sk_outputValSize = sizeof(_OutputValType);
 		static constexpr bool sk_canPadInPlace =
 			HexDecodeCanPadInPlace<_InIt>();
+		using _CanBulk = std::integral_constant<bool,
+			_KeepLeadingZero &&
+			std::is_pointer<_InIt>::value &&
+			(sizeof(typename std::iterator_traits<_InIt>::value_type) == 1) &&
+			HexBulkIsContiguous<_OutContainer>::value>;
 
 		_OutContainer dest;
+		if (TryBulkDecode(dest, begin, end, _CanBulk()))
+		{
+			return dest;
+		}
 
 		size_t decodedSize = 0;
 		HexToBytesImpl<HexValueLut, sk_outputValSize>::
@@ -580,6 +614,222 @@ struct Hex
 	//==========
 
 
+	//==========
+	// Bulk functions over contiguous buffers
+	//==========
+
+
+	/**
+	 * @brief Decode the hex digits in [begin, end) straight into the given
+	 *        preallocated buffer, using the fastest implementation that the
+	 *        CPU supports
+	 *
+	 * @param dest     The buffer to hold the decoded bytes
+	 * @param destSize The size of the buffer, which must be exactly half of
+	 *                 the number of hex digits
+	 *
+	 * @exception std::invalid_argument If the sizes don't match, or any of
+	 *                                  the given characters is not a hex
+	 *                                  digit
+	 */
+	template<
+		typename _OutValType,
+		typename _InValType,
+		typename std::enable_if<
+			(sizeof(_OutValType) == 1) && (sizeof(_InValType) == 1),
+			int
+		>::type = 0
+	>
+	static void DecodeInto(
+		_OutValType* dest,
+		size_t destSize,
+		const _InValType* begin,
+		const _InValType* end
+	)
+	{
+		const size_t inSize = static_cast<size_t>(end - begin);
+		HexDecodeCheckPadImpl<HexPad::Disabled>::ThrowIfOdd(inSize);
+		if (destSize != inSize / 2)
+		{
+			throw std::invalid_argument(
+				"The size of the output buffer doesn't match the input"
+			);
+		}
+
+		HexBulk::Decode(
+			reinterpret_cast<uint8_t*>(dest),
+			reinterpret_cast<const uint8_t*>(begin),
+			destSize
+		);
+	}
+
+
+	/**
+	 * @brief Encode the bytes in [begin, end) straight into the given
+	 *        preallocated buffer, using the fastest implementation that the
+	 *        CPU supports; all leading zeros are kept, and no prefix is added
+	 *
+	 * @param dest     The buffer to hold the hex digits
+	 * @param destSize The size of the buffer, which must be exactly twice
+	 *                 the number of input bytes
+	 *
+	 * @exception std::invalid_argument If the sizes don't match
+	 */
+	template<
+		typename _OutValType,
+		typename _InValType,
+		typename std::enable_if<
+			(sizeof(_OutValType) == 1) && (sizeof(_InValType) == 1),
+			int
+		>::type = 0
+	>
+	static void EncodeInto(
+		_OutValType* dest,
+		size_t destSize,
+		const _InValType* begin,
+		const _InValType* end
+	)
+	{
+		static constexpr auto sk_alphabet = Alphabet::Alphabet();
+
+		const size_t inSize = static_cast<size_t>(end - begin);
+		if (destSize != inSize * 2)
+		{
+			throw std::invalid_argument(
+				"The size of the output buffer doesn't match the input"
+			);
+		}
+
+		HexBulk::Encode(
+			reinterpret_cast<uint8_t*>(dest),
+			reinterpret_cast<const uint8_t*>(begin),
+			inSize,
+			reinterpret_cast<const uint8_t*>(sk_alphabet.data())
+		);
+	}
+
+
+	//==========
+	// Helper functions
+	//==========
+
+
+	template<typename _OutContainer, typename _InValType>
+	static bool TryBulkDecode(
+		_OutContainer& dest,
+		const _InValType* begin,
+		const _InValType* end,
+		std::true_type /* canBulk */
+	)
+	{
+		const size_t inSize = static_cast<size_t>(end - begin);
+		if (inSize % 2 != 0)
+		{
+			// padding is handled by the regular decoder
+			return false;
+		}
+
+		dest.resize(inSize / 2);
+		if (inSize > 0)
+		{
+			DecodeInto(&dest[0], inSize / 2, begin, end);
+		}
+		return true;
+	}
+
+	template<typename _OutContainer, typename _InIt>
+	static bool TryBulkDecode(
+		_OutContainer&,
+		_InIt,
+		_InIt,
+		std::false_type /* canBulk */
+	)
+	{
+		return false;
+	}
+
+
+	template<typename _OutContainer, typename _InContainer>
+	static bool TryBulkDecodeCtn(
+		_OutContainer& dest,
+		const _InContainer& src,
+		std::true_type canBulk
+	)
+	{
+		return TryBulkDecode(
+			dest, src.data(), src.data() + src.size(), canBulk);
+	}
+
+	template<typename _OutContainer, typename _InContainer>
+	static bool TryBulkDecodeCtn(
+		_OutContainer&,
+		const _InContainer&,
+		std::false_type /* canBulk */
+	)
+	{
+		return false;
+	}
+
+
+	template<typename _OutContainer, typename _InValType>
+	static bool TryBulkEncode(
+		_OutContainer& dest,
+		const _InValType* begin,
+		const _InValType* end,
+		const PrefixType& prefix,
+		std::true_type /* canBulk */
+	)
+	{
+		const size_t inSize = static_cast<size_t>(end - begin);
+		if (inSize == 0)
+		{
+			// the prefix is only added before the first byte
+			return true;
+		}
+
+		dest.resize(prefix.size() + (inSize * 2));
+		std::copy(prefix.begin(), prefix.end(), &dest[0]);
+		EncodeInto(&dest[prefix.size()], inSize * 2, begin, end);
+		return true;
+	}
+
+	template<typename _OutContainer, typename _InIt>
+	static bool TryBulkEncode(
+		_OutContainer&,
+		_InIt,
+		_InIt,
+		const PrefixType&,
+		std::false_type /* canBulk */
+	)
+	{
+		return false;
+	}
+
+
+	template<typename _OutContainer, typename _InContainer>
+	static bool TryBulkEncodeCtn(
+		_OutContainer& dest,
+		const _InContainer& src,
+		const PrefixType& prefix,
+		std::true_type canBulk
+	)
+	{
+		return TryBulkEncode(
+			dest, src.data(), src.data() + src.size(), prefix, canBulk);
+	}
+
+	template<typename _OutContainer, typename _InContainer>
+	static bool TryBulkEncodeCtn(
+		_OutContainer&,
+		const _InContainer&,
+		const PrefixType&,
+		std::false_type /* canBulk */
+	)
+	{
+		return false;
+	}
+
+
 }; // struct Hex
 
 
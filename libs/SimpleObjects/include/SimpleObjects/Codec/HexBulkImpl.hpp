@@ -0,0 +1,573 @@
+// Copyright (c) 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../Endianness.hpp"
+
+
+/**
+ * The bulk codec picks the widest implementation available:
+ * - AVX2, if the code is compiled with AVX2 enabled, or, on x86 with GCC or
+ *   Clang, if the CPU supports it at runtime (the check can be turned off by
+ *   defining SIMPLEOBJECTS_CODEC_HEX_NO_RUNTIME_DISPATCH, e.g., for code that
+ *   runs in an environment where CPUID is not available, like SGX enclaves);
+ * - SSE2, if the code is compiled with SSE2 enabled (always on x86-64);
+ * - otherwise, or if SIMPLEOBJECTS_CODEC_HEX_NO_SIMD is defined, or the
+ *   intrinsics headers are not available (e.g., `-nostdinc` builds), a
+ *   portable SWAR (SIMD within a register) implementation.
+ */
+#if defined(__SSE2__) && !defined(SIMPLEOBJECTS_CODEC_HEX_NO_SIMD)
+#	if defined(__has_include)
+#		if __has_include(<immintrin.h>)
+#			define SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+#		endif
+#	else
+#		define SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+#	endif // defined(__has_include)
+#endif // defined(__SSE2__) && !defined(SIMPLEOBJECTS_CODEC_HEX_NO_SIMD)
+
+#if defined(__AVX2__) && defined(SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2)
+#	define SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+	(defined(__x86_64__) || defined(__i386__)) && \
+	defined(SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2) && \
+	!defined(SIMPLEOBJECTS_CODEC_HEX_NO_RUNTIME_DISPATCH)
+#	define SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+#	define SIMPLEOBJECTS_CODEC_HEX_AVX2_DISPATCH
+#endif
+
+#ifdef SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+#	include <immintrin.h>
+#endif // SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+
+#ifdef SIMPLEOBJECTS_CODEC_HEX_AVX2_DISPATCH
+#	define SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC __attribute__((target("avx2")))
+#else
+#	define SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+#endif // SIMPLEOBJECTS_CODEC_HEX_AVX2_DISPATCH
+
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Codec
+{
+
+namespace Internal
+{
+
+
+/**
+ * @brief Check if the given container stores 1-byte values in a contiguous
+ *        buffer, so it can be processed by the bulk codec
+ *
+ */
+template<typename _CtnType>
+struct HexBulkIsContiguous
+{
+	template<typename _T>
+	static std::integral_constant<bool,
+		std::is_same<
+			decltype(std::declval<const _T&>().data()),
+			const typename _T::value_type*
+		>::value &&
+		(sizeof(typename _T::value_type) == 1)
+	>
+	Test(int);
+
+	template<typename _T>
+	static std::false_type Test(...);
+
+	static constexpr bool value = decltype(Test<_CtnType>(0))::value;
+}; // struct HexBulkIsContiguous
+
+
+struct HexBulkSwar
+{
+	static constexpr uint64_t sk_ones  = 0x0101010101010101ULL;
+	static constexpr uint64_t sk_highs = 0x8080808080808080ULL;
+	static constexpr uint64_t sk_lows  = 0x0F0F0F0F0F0F0F0FULL;
+
+	/**
+	 * @brief Flags (via the high bit of each byte) the bytes that are
+	 *        greater than or equal to `lo`; all bytes must be ASCII
+	 *
+	 */
+	static uint64_t GreaterEq(uint64_t x, uint8_t lo)
+	{
+		return (x + (sk_ones * (0x80U - lo))) & sk_highs;
+	}
+
+	/**
+	 * @brief Flags (via the high bit of each byte) the bytes that are
+	 *        greater than `hi`; all bytes must be ASCII
+	 *
+	 */
+	static uint64_t Greater(uint64_t x, uint8_t hi)
+	{
+		return (x + (sk_ones * (0x7FU - hi))) & sk_highs;
+	}
+
+	/**
+	 * @brief Decode 8 hex digits into 4 bytes
+	 *
+	 * @return true if all digits are valid, otherwise false
+	 */
+	static bool Decode8(uint8_t* dest, const uint8_t* src)
+	{
+		uint64_t x = 0;
+		std::memcpy(&x, src, sizeof(x));
+
+		const uint64_t lower = x | (sk_ones * 0x20U);
+		const uint64_t isDigit = GreaterEq(x, '0') & ~Greater(x, '9');
+		const uint64_t isAlpha = GreaterEq(lower, 'a') & ~Greater(lower, 'f');
+		if (((x & sk_highs) != 0) || ((isDigit | isAlpha) != sk_highs))
+		{
+			return false;
+		}
+
+		// '0'-'9' => 0-9; 'a'-'f' and 'A'-'F' => 1-6, plus 9
+		const uint64_t nibbles = (x & sk_lows) + ((isAlpha >> 7) * 9);
+
+		// the low byte of each 16-bit lane gets (even << 4) | odd
+		const uint64_t packed = (nibbles << 4) | (nibbles >> 8);
+		dest[0] = static_cast<uint8_t>(packed);
+		dest[1] = static_cast<uint8_t>(packed >> 16);
+		dest[2] = static_cast<uint8_t>(packed >> 32);
+		dest[3] = static_cast<uint8_t>(packed >> 48);
+		return true;
+	}
+
+	/**
+	 * @brief Encode 4 bytes into 8 hex digits
+	 *
+	 * @param alphaOffset The distance from `'9' + 1` to the first letter
+	 *                    of the alphabet
+	 */
+	static void Encode4(uint8_t* dest, const uint8_t* src, uint8_t alphaOffset)
+	{
+		const uint64_t x =
+			(static_cast<uint64_t>(src[0])) |
+			(static_cast<uint64_t>(src[1]) << 16) |
+			(static_cast<uint64_t>(src[2]) << 32) |
+			(static_cast<uint64_t>(src[3]) << 48);
+
+		const uint64_t laneLows = 0x000F000F000F000FULL;
+		const uint64_t nibbles =
+			((x >> 4) & laneLows) | ((x & laneLows) << 8);
+		// a byte is flagged if its nibble is 10 or more
+		const uint64_t isAlpha = ((nibbles + (sk_ones * 0x76U)) & sk_highs) >> 7;
+
+		const uint64_t chars =
+			nibbles + (sk_ones * '0') + (isAlpha * alphaOffset);
+		std::memcpy(dest, &chars, sizeof(chars));
+	}
+
+	static size_t Decode(uint8_t* dest, const uint8_t* src, size_t destSize)
+	{
+		size_t i = 0;
+		for (; i + 4 <= destSize; i += 4)
+		{
+			if (!Decode8(dest + i, src + (i * 2)))
+			{
+				break;
+			}
+		}
+		return i;
+	}
+
+	static size_t Encode(
+		uint8_t* dest,
+		const uint8_t* src,
+		size_t srcSize,
+		uint8_t alphaOffset
+	)
+	{
+		size_t i = 0;
+		for (; i + 4 <= srcSize; i += 4)
+		{
+			Encode4(dest + (i * 2), src + i, alphaOffset);
+		}
+		return i;
+	}
+}; // struct HexBulkSwar
+
+
+#ifdef SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+struct HexBulkSse2
+{
+	/**
+	 * @brief Convert 16 hex digits to nibbles, and flag the invalid ones
+	 *
+	 */
+	static __m128i ToNibbles(__m128i x, __m128i& invalid)
+	{
+		const __m128i digit = _mm_sub_epi8(x, _mm_set1_epi8('0'));
+		const __m128i alpha = _mm_sub_epi8(
+			_mm_or_si128(x, _mm_set1_epi8(0x20)),
+			_mm_set1_epi8('a')
+		);
+		// unsigned (a <= b) is (min(a, b) == a)
+		const __m128i isDigit = _mm_cmpeq_epi8(
+			_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+		const __m128i isAlpha = _mm_cmpeq_epi8(
+			_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+		invalid = _mm_or_si128(
+			invalid,
+			_mm_andnot_si128(
+				_mm_or_si128(isDigit, isAlpha),
+				_mm_set1_epi8(-1)
+			)
+		);
+
+		return _mm_or_si128(
+			_mm_and_si128(isDigit, digit),
+			_mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10)))
+		);
+	}
+
+	static __m128i PackNibbles(__m128i nibbles)
+	{
+		// the low byte of each 16-bit lane gets (even << 4) | odd
+		return _mm_and_si128(
+			_mm_or_si128(
+				_mm_slli_epi16(nibbles, 4),
+				_mm_srli_epi16(nibbles, 8)
+			),
+			_mm_set1_epi16(0x00FF)
+		);
+	}
+
+	static __m128i ToHexChars(__m128i nibbles, uint8_t alphaOffset)
+	{
+		const __m128i isAlpha =
+			_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+		return _mm_add_epi8(
+			_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+			_mm_and_si128(isAlpha, _mm_set1_epi8(static_cast<char>(alphaOffset)))
+		);
+	}
+
+	static size_t Decode(uint8_t* dest, const uint8_t* src, size_t destSize)
+	{
+		size_t i = 0;
+		for (; i + 16 <= destSize; i += 16)
+		{
+			const uint8_t* in = src + (i * 2);
+			__m128i invalid = _mm_setzero_si128();
+			const __m128i lo = ToNibbles(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)),
+				invalid
+			);
+			const __m128i hi = ToNibbles(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16)),
+				invalid
+			);
+			if (_mm_movemask_epi8(invalid) != 0)
+			{
+				break;
+			}
+
+			_mm_storeu_si128(
+				reinterpret_cast<__m128i*>(dest + i),
+				_mm_packus_epi16(PackNibbles(lo), PackNibbles(hi))
+			);
+		}
+		return i;
+	}
+
+	static size_t Encode(
+		uint8_t* dest,
+		const uint8_t* src,
+		size_t srcSize,
+		uint8_t alphaOffset
+	)
+	{
+		const __m128i lowMask = _mm_set1_epi8(0x0F);
+
+		size_t i = 0;
+		for (; i + 16 <= srcSize; i += 16)
+		{
+			const __m128i x =
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i hi = ToHexChars(
+				_mm_and_si128(_mm_srli_epi16(x, 4), lowMask), alphaOffset);
+			const __m128i lo = ToHexChars(
+				_mm_and_si128(x, lowMask), alphaOffset);
+
+			uint8_t* out = dest + (i * 2);
+			_mm_storeu_si128(
+				reinterpret_cast<__m128i*>(out),
+				_mm_unpacklo_epi8(hi, lo)
+			);
+			_mm_storeu_si128(
+				reinterpret_cast<__m128i*>(out + 16),
+				_mm_unpackhi_epi8(hi, lo)
+			);
+		}
+		return i;
+	}
+}; // struct HexBulkSse2
+#endif // SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2
+
+
+#ifdef SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+struct HexBulkAvx2
+{
+	SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+	static __m256i ToNibbles(__m256i x, __m256i& invalid)
+	{
+		const __m256i digit = _mm256_sub_epi8(x, _mm256_set1_epi8('0'));
+		const __m256i alpha = _mm256_sub_epi8(
+			_mm256_or_si256(x, _mm256_set1_epi8(0x20)),
+			_mm256_set1_epi8('a')
+		);
+		const __m256i isDigit = _mm256_cmpeq_epi8(
+			_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+		const __m256i isAlpha = _mm256_cmpeq_epi8(
+			_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+		invalid = _mm256_or_si256(
+			invalid,
+			_mm256_andnot_si256(
+				_mm256_or_si256(isDigit, isAlpha),
+				_mm256_set1_epi8(-1)
+			)
+		);
+
+		return _mm256_or_si256(
+			_mm256_and_si256(isDigit, digit),
+			_mm256_and_si256(
+				isAlpha,
+				_mm256_add_epi8(alpha, _mm256_set1_epi8(10))
+			)
+		);
+	}
+
+	SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+	static __m256i PackNibbles(__m256i nibbles)
+	{
+		return _mm256_and_si256(
+			_mm256_or_si256(
+				_mm256_slli_epi16(nibbles, 4),
+				_mm256_srli_epi16(nibbles, 8)
+			),
+			_mm256_set1_epi16(0x00FF)
+		);
+	}
+
+	SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+	static __m256i ToHexChars(__m256i nibbles, uint8_t alphaOffset)
+	{
+		const __m256i isAlpha =
+			_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+		return _mm256_add_epi8(
+			_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')),
+			_mm256_and_si256(
+				isAlpha,
+				_mm256_set1_epi8(static_cast<char>(alphaOffset))
+			)
+		);
+	}
+
+	SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+	static size_t Decode(uint8_t* dest, const uint8_t* src, size_t destSize)
+	{
+		size_t i = 0;
+		for (; i + 32 <= destSize; i += 32)
+		{
+			const uint8_t* in = src + (i * 2);
+			__m256i invalid = _mm256_setzero_si256();
+			const __m256i lo = ToNibbles(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)),
+				invalid
+			);
+			const __m256i hi = ToNibbles(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32)),
+				invalid
+			);
+			if (_mm256_movemask_epi8(invalid) != 0)
+			{
+				break;
+			}
+
+			// packing works within 128-bit lanes; put the quarters in order
+			const __m256i packed =
+				_mm256_packus_epi16(PackNibbles(lo), PackNibbles(hi));
+			_mm256_storeu_si256(
+				reinterpret_cast<__m256i*>(dest + i),
+				_mm256_permute4x64_epi64(packed, 0xD8)
+			);
+		}
+		return i;
+	}
+
+	SIMPLEOBJECTS_CODEC_HEX_AVX2_FUNC
+	static size_t Encode(
+		uint8_t* dest,
+		const uint8_t* src,
+		size_t srcSize,
+		uint8_t alphaOffset
+	)
+	{
+		const __m256i lowMask = _mm256_set1_epi8(0x0F);
+
+		size_t i = 0;
+		for (; i + 32 <= srcSize; i += 32)
+		{
+			const __m256i x =
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			const __m256i hi = ToHexChars(
+				_mm256_and_si256(_mm256_srli_epi16(x, 4), lowMask),
+				alphaOffset
+			);
+			const __m256i lo = ToHexChars(
+				_mm256_and_si256(x, lowMask), alphaOffset);
+
+			// unpacking works within 128-bit lanes as well
+			const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+			const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+
+			uint8_t* out = dest + (i * 2);
+			_mm256_storeu_si256(
+				reinterpret_cast<__m256i*>(out),
+				_mm256_permute2x128_si256(first, second, 0x20)
+			);
+			_mm256_storeu_si256(
+				reinterpret_cast<__m256i*>(out + 32),
+				_mm256_permute2x128_si256(first, second, 0x31)
+			);
+		}
+		return i;
+	}
+}; // struct HexBulkAvx2
+#endif // SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+
+
+/**
+ * @brief Bulk hex encoder and decoder over contiguous buffers.
+ *        The vectorized implementations process the bulk of the input;
+ *        the tail (and, when decoding, any block that contains an invalid
+ *        digit) is processed one byte at a time, which also reports the
+ *        error.
+ *
+ */
+struct HexBulk
+{
+	using DecodeFunc = size_t(*)(uint8_t*, const uint8_t*, size_t);
+	using EncodeFunc = size_t(*)(uint8_t*, const uint8_t*, size_t, uint8_t);
+
+	static bool HasAvx2()
+	{
+#if defined(SIMPLEOBJECTS_CODEC_HEX_AVX2_DISPATCH)
+		// we may be called by a static initializer that runs before the
+		// CPU info is initialized
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#elif defined(SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static std::pair<DecodeFunc, EncodeFunc> SelectFuncs()
+	{
+#ifdef SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+		if (HasAvx2())
+		{
+			return std::make_pair(&HexBulkAvx2::Decode, &HexBulkAvx2::Encode);
+		}
+#endif // SIMPLEOBJECTS_CODEC_HEX_HAS_AVX2
+
+#if defined(SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2)
+		return std::make_pair(&HexBulkSse2::Decode, &HexBulkSse2::Encode);
+#else
+		return std::make_pair(
+			Endian::native == Endian::little ? &HexBulkSwar::Decode : nullptr,
+			Endian::native == Endian::little ? &HexBulkSwar::Encode : nullptr
+		);
+#endif // defined(SIMPLEOBJECTS_CODEC_HEX_HAS_SSE2)
+	}
+
+	static const std::pair<DecodeFunc, EncodeFunc>& GetFuncs()
+	{
+		static const std::pair<DecodeFunc, EncodeFunc> sk_funcs = SelectFuncs();
+		return sk_funcs;
+	}
+
+	static uint8_t DecodeNibble(uint8_t ch)
+	{
+		return (ch >= '0' && ch <= '9') ? static_cast<uint8_t>(ch - '0') :
+			(ch >= 'A' && ch <= 'F') ? static_cast<uint8_t>(ch - 'A' + 10) :
+			(ch >= 'a' && ch <= 'f') ? static_cast<uint8_t>(ch - 'a' + 10) :
+			throw std::invalid_argument("Invalid hex character");
+	}
+
+	/**
+	 * @brief Decode `destSize * 2` hex digits from `src` into `dest`
+	 *
+	 * @exception std::invalid_argument If there is any invalid hex digit
+	 */
+	static void Decode(uint8_t* dest, const uint8_t* src, size_t destSize)
+	{
+		DecodeFunc func = GetFuncs().first;
+		size_t i = (func != nullptr) ? func(dest, src, destSize) : 0;
+
+		for (; i < destSize; ++i)
+		{
+			dest[i] = static_cast<uint8_t>(
+				(DecodeNibble(src[i * 2]) << 4) |
+				DecodeNibble(src[(i * 2) + 1])
+			);
+		}
+	}
+
+	/**
+	 * @brief Encode `srcSize` bytes from `src` into `srcSize * 2` hex
+	 *        digits in `dest`
+	 *
+	 * @param alphabet The 16 characters of the hex alphabet
+	 */
+	static void Encode(
+		uint8_t* dest,
+		const uint8_t* src,
+		size_t srcSize,
+		const uint8_t* alphabet
+	)
+	{
+		EncodeFunc func = GetFuncs().second;
+		const uint8_t alphaOffset =
+			static_cast<uint8_t>(alphabet[10] - ('9' + 1));
+		size_t i = (func != nullptr) ? func(dest, src, srcSize, alphaOffset) : 0;
+
+		for (; i < srcSize; ++i)
+		{
+			dest[i * 2] = alphabet[(src[i] >> 4) & 0x0F];
+			dest[(i * 2) + 1] = alphabet[src[i] & 0x0F];
+		}
+	}
+}; // struct HexBulk
+
+
+} // namespace Internal
+
+
+} // namespace Codec
+} // namespace SimpleObjects
@@ -15,7 +15,10 @@
 #include "String.hpp"
 #include "List.hpp"
 #include "Dict.hpp"
+#include "FlatHashMap.hpp"
 #include "Bytes.hpp"
+#include "SmallString.hpp"
+#include "SmallVector.hpp"
 
 #include "Object.hpp"
 #include "HashableObject.hpp"
@@ -39,6 +42,9 @@ using ToStringType = std::string;
 template<typename _KeyType, typename _ValType>
 using MapType = std::unordered_map<_KeyType, _ValType>;
 
+template<typename _KeyType, typename _ValType>
+using FlatMapType = FlatHashMap<_KeyType, _ValType>;
+
 template<typename _ValType>
 using VecType = std::vector<_ValType>;
 
@@ -76,6 +82,15 @@ using Double = RealNumT<double  >;
 
 using String = StringImpl<std::string, ToStringType>;
 
+/**
+ * @brief Short strings (e.g., dict keys, hex-encoded numbers and addresses)
+ *        are kept inside the object without a separate heap allocation
+ *
+ */
+static constexpr size_t sk_smallStrInlineCap = 48;
+using SmallString =
+	StringImpl<SmallBasicString<char, sk_smallStrInlineCap>, ToStringType>;
+
 // ========== Convenient types of Object ==========
 
 using Object = ObjectImpl<ToStringType>;
@@ -98,11 +113,31 @@ using DictT = DictImpl<_KeyType, _Valtype, MapType, ToStringType>;
 
 using Dict = DictT<HashableObject, Object>;
 
+/**
+ * @brief Dict backed by `FlatHashMap`, which is faster to build and query
+ *        for small dicts, but inserting or removing an item invalidates
+ *        references to the other items
+ *
+ */
+template<typename _KeyType, typename _Valtype>
+using FlatDictT = DictImpl<_KeyType, _Valtype, FlatMapType, ToStringType>;
+
+using FlatDict = FlatDictT<HashableObject, Object>;
+
 // ========== Convenient types of Bytes ==========
 
 using BytesBaseObj = BytesBaseObject<uint8_t, ToStringType>;
 using Bytes = BytesImpl<std::vector<uint8_t>, ToStringType>;
 
+/**
+ * @brief Short byte strings (e.g., hashes, addresses and integers) are kept
+ *        inside the object without a separate heap allocation
+ *
+ */
+static constexpr size_t sk_smallBytesInlineCap = 48;
+using SmallBytes =
+	BytesImpl<SmallVector<uint8_t, sk_smallBytesInlineCap>, ToStringType>;
+
 // ========== Convenient types of base classes ==========
 
 using BaseObj = BaseObject<ToStringType>;
@@ -7,6 +7,8 @@
 
 #include "DictBaseObject.hpp"
 
+#include <functional>
+#include <map>
 #include <memory>
 
 #include "Internal/DictKey.hpp"
@@ -21,6 +23,21 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+namespace Internal
+{
+
+template<typename _ContainerType>
+struct IsKeyOrderedContainer : public std::false_type
+{}; // struct IsKeyOrderedContainer
+
+template<typename _KeyType, typename _ValType, typename _Alloc>
+struct IsKeyOrderedContainer<
+	std::map<_KeyType, _ValType, std::less<_KeyType>, _Alloc> > :
+	public std::true_type
+{}; // struct IsKeyOrderedContainer
+
+} // namespace Internal
+
 template<
 	typename _KeyType,
 	typename _ValType,
@@ -399,6 +416,11 @@ public:
 		return m_data.size();
 	}
 
+	virtual bool IsOrderedByKey() const override
+	{
+		return Internal::IsKeyOrderedContainer<ContainerType>::value;
+	}
+
 	// ========== removing values ==========
 
 	virtual void clear() override
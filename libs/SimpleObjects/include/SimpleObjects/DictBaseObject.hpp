@@ -131,6 +131,16 @@ public:
 
 	virtual void clear() = 0;
 
+	/**
+	 * @brief Does iterating this dict visit the keys in ascending order
+	 *        (i.e., by `operator<` of the keys)? Serializers that need a
+	 *        canonical order can skip sorting when this is true.
+	 */
+	virtual bool IsOrderedByKey() const
+	{
+		return false;
+	}
+
 	// ========== Functions that involves value_type in prototype ==========
 
 	mapped_type& operator[](const key_type& key)
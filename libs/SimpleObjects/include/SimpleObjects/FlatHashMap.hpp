@@ -0,0 +1,511 @@
+// Copyright 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A hash map that keeps all entries in one contiguous array, and caches
+ *        the hash value of each key, so a key is hashed only once.
+ *        Maps with no more than `_LinearScanMax` entries are searched by a
+ *        linear scan over the cached hash values; larger maps build an
+ *        open-addressing (linear probing) index over the entries.
+ *        It can be used in place of `std::unordered_map` as the container of
+ *        `DictImpl`, but NOTE:
+ *        - inserting or removing an entry invalidates all iterators,
+ *          pointers and references to the entries;
+ *        - removing an entry moves the last entry into its place;
+ *        - the keys must not be modified via the iterators.
+ *
+ * @tparam _KeyType       Type of the keys
+ * @tparam _ValType       Type of the mapped values
+ * @tparam _LinearScanMax Maximum number of entries searched by linear scan
+ * @tparam _Hasher        Type of the hash function object
+ * @tparam _KeyEqual      Type of the key equality function object
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	size_t _LinearScanMax = 8,
+	typename _Hasher = std::hash<_KeyType>,
+	typename _KeyEqual = std::equal_to<_KeyType> >
+class FlatHashMap
+{
+public: // static members:
+
+	using Self = FlatHashMap<
+		_KeyType, _ValType, _LinearScanMax, _Hasher, _KeyEqual>;
+
+	typedef _KeyType                                 key_type;
+	typedef _ValType                                 mapped_type;
+	typedef std::pair<key_type, mapped_type>         value_type;
+	typedef size_t                                   size_type;
+	typedef std::ptrdiff_t                           difference_type;
+	typedef _Hasher                                  hasher;
+	typedef _KeyEqual                                key_equal;
+	typedef value_type&                              reference;
+	typedef const value_type&                        const_reference;
+
+	using EntryCtnType = std::vector<value_type>;
+
+	typedef typename EntryCtnType::iterator          iterator;
+	typedef typename EntryCtnType::const_iterator    const_iterator;
+
+	static constexpr size_type sk_linearScanMax = _LinearScanMax;
+
+public:
+
+	FlatHashMap() :
+		m_entries(),
+		m_hashes(),
+		m_slots()
+	{}
+
+	FlatHashMap(const Self& other) = default;
+
+	FlatHashMap(Self&& other) noexcept :
+		m_entries(std::move(other.m_entries)),
+		m_hashes(std::move(other.m_hashes)),
+		m_slots(std::move(other.m_slots))
+	{}
+
+	// LCOV_EXCL_START
+	~FlatHashMap() = default;
+	// LCOV_EXCL_STOP
+
+	Self& operator=(const Self& rhs) = default;
+
+	Self& operator=(Self&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			m_entries = std::move(rhs.m_entries);
+			m_hashes = std::move(rhs.m_hashes);
+			m_slots = std::move(rhs.m_slots);
+		}
+		return *this;
+	}
+
+	// ========== iterators ==========
+
+	iterator begin() noexcept
+	{
+		return m_entries.begin();
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return m_entries.begin();
+	}
+
+	const_iterator cbegin() const noexcept
+	{
+		return m_entries.cbegin();
+	}
+
+	iterator end() noexcept
+	{
+		return m_entries.end();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return m_entries.end();
+	}
+
+	const_iterator cend() const noexcept
+	{
+		return m_entries.cend();
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const noexcept
+	{
+		return m_entries.empty();
+	}
+
+	size_type size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	void reserve(size_type count)
+	{
+		m_entries.reserve(count);
+		m_hashes.reserve(count);
+		if (count > _LinearScanMax)
+		{
+			const size_type slotCount = CalcSlotCount(count);
+			if (slotCount > m_slots.size())
+			{
+				Rehash(slotCount);
+			}
+		}
+	}
+
+	// ========== lookup ==========
+
+	iterator find(const key_type& key)
+	{
+		const size_type idx = FindIndex(key, hasher()(key));
+		return idx == sk_npos ? end() : (begin() + idx);
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		const size_type idx = FindIndex(key, hasher()(key));
+		return idx == sk_npos ? cend() : (cbegin() + idx);
+	}
+
+	size_type count(const key_type& key) const
+	{
+		return FindIndex(key, hasher()(key)) == sk_npos ? 0 : 1;
+	}
+
+	mapped_type& at(const key_type& key)
+	{
+		const size_type idx = FindIndex(key, hasher()(key));
+		if (idx == sk_npos)
+		{
+			throw std::out_of_range("FlatHashMap::at - key not found");
+		}
+		return m_entries[idx].second;
+	}
+
+	const mapped_type& at(const key_type& key) const
+	{
+		const size_type idx = FindIndex(key, hasher()(key));
+		if (idx == sk_npos)
+		{
+			throw std::out_of_range("FlatHashMap::at - key not found");
+		}
+		return m_entries[idx].second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		const size_t hashVal = hasher()(key);
+		const size_type idx = FindIndex(key, hashVal);
+		if (idx != sk_npos)
+		{
+			return m_entries[idx].second;
+		}
+		return Append(value_type(key, mapped_type()), hashVal)->second;
+	}
+
+	mapped_type& operator[](key_type&& key)
+	{
+		const size_t hashVal = hasher()(key);
+		const size_type idx = FindIndex(key, hashVal);
+		if (idx != sk_npos)
+		{
+			return m_entries[idx].second;
+		}
+		return Append(
+			value_type(std::forward<key_type>(key), mapped_type()),
+			hashVal)->second;
+	}
+
+	// ========== modifiers ==========
+
+	std::pair<iterator, bool> insert(const value_type& entry)
+	{
+		return InsertEntry(value_type(entry));
+	}
+
+	std::pair<iterator, bool> insert(value_type&& entry)
+	{
+		return InsertEntry(std::forward<value_type>(entry));
+	}
+
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(_Args&&... args)
+	{
+		return InsertEntry(value_type(std::forward<_Args>(args)...));
+	}
+
+	size_type erase(const key_type& key)
+	{
+		const size_type idx = FindIndex(key, hasher()(key));
+		if (idx == sk_npos)
+		{
+			return 0;
+		}
+		RemoveAt(idx);
+		return 1;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		const size_type idx = static_cast<size_type>(pos - cbegin());
+		RemoveAt(idx);
+		return begin() + idx;
+	}
+
+	void clear() noexcept
+	{
+		m_entries.clear();
+		m_hashes.clear();
+		m_slots.clear();
+	}
+
+	void swap(Self& other) noexcept
+	{
+		m_entries.swap(other.m_entries);
+		m_hashes.swap(other.m_hashes);
+		m_slots.swap(other.m_slots);
+	}
+
+	// ========== comparisons ==========
+
+	bool operator==(const Self& rhs) const
+	{
+		if (size() != rhs.size())
+		{
+			return false;
+		}
+		for (size_type i = 0; i < m_entries.size(); ++i)
+		{
+			const size_type rhsIdx =
+				rhs.FindIndex(m_entries[i].first, m_hashes[i]);
+			if (rhsIdx == sk_npos ||
+				!(m_entries[i].second == rhs.m_entries[rhsIdx].second))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private:
+
+	static constexpr size_type sk_npos = static_cast<size_type>(-1);
+
+	static constexpr size_type sk_initCapacity = 8;
+
+	/**
+	 * @brief Spread the bits of the given hash value, since the index uses the
+	 *        lower bits only
+	 *
+	 */
+	static size_t MixHash(size_t hashVal)
+	{
+		uint64_t h = static_cast<uint64_t>(hashVal);
+		h ^= (h >> 33);
+		h *= 0xFF51AFD7ED558CCDULL;
+		h ^= (h >> 33);
+		return static_cast<size_t>(h);
+	}
+
+	/**
+	 * @brief The index is kept at most half full
+	 *
+	 */
+	static size_type CalcSlotCount(size_type entryCount)
+	{
+		size_type slotCount = 16;
+		while (slotCount < (entryCount * 2))
+		{
+			slotCount *= 2;
+		}
+		return slotCount;
+	}
+
+	size_type FindIndex(const key_type& key, size_t hashVal) const
+	{
+		if (m_slots.empty())
+		{
+			for (size_type i = 0; i < m_hashes.size(); ++i)
+			{
+				if (m_hashes[i] == hashVal &&
+					key_equal()(m_entries[i].first, key))
+				{
+					return i;
+				}
+			}
+			return sk_npos;
+		}
+
+		const size_type mask = m_slots.size() - 1;
+		for (size_type pos = MixHash(hashVal) & mask; ; pos = (pos + 1) & mask)
+		{
+			const size_type slot = m_slots[pos];
+			if (slot == 0)
+			{
+				return sk_npos;
+			}
+			const size_type idx = slot - 1;
+			if (m_hashes[idx] == hashVal &&
+				key_equal()(m_entries[idx].first, key))
+			{
+				return idx;
+			}
+		}
+	}
+
+	/**
+	 * @brief Find the index position that refers to the given entry
+	 *
+	 */
+	size_type FindSlotPos(size_type idx) const
+	{
+		const size_type mask = m_slots.size() - 1;
+		size_type pos = MixHash(m_hashes[idx]) & mask;
+		while (m_slots[pos] != idx + 1)
+		{
+			pos = (pos + 1) & mask;
+		}
+		return pos;
+	}
+
+	void PlaceInSlots(size_type idx)
+	{
+		const size_type mask = m_slots.size() - 1;
+		size_type pos = MixHash(m_hashes[idx]) & mask;
+		while (m_slots[pos] != 0)
+		{
+			pos = (pos + 1) & mask;
+		}
+		m_slots[pos] = idx + 1;
+	}
+
+	/**
+	 * @brief Rebuild the index from the cached hash values, without hashing
+	 *        any key again
+	 *
+	 */
+	void Rehash(size_type slotCount)
+	{
+		m_slots.assign(slotCount, 0);
+		for (size_type i = 0; i < m_hashes.size(); ++i)
+		{
+			PlaceInSlots(i);
+		}
+	}
+
+	iterator Append(value_type&& entry, size_t hashVal)
+	{
+		if (m_entries.capacity() == 0)
+		{
+			// skip the smallest steps of growth, since most maps have a few
+			// entries
+			m_entries.reserve(sk_initCapacity);
+			m_hashes.reserve(sk_initCapacity);
+		}
+		m_entries.push_back(std::forward<value_type>(entry));
+		m_hashes.push_back(hashVal);
+
+		const size_type idx = m_entries.size() - 1;
+		if (m_slots.empty())
+		{
+			if (m_entries.size() > _LinearScanMax)
+			{
+				Rehash(CalcSlotCount(m_entries.size()));
+			}
+		}
+		else if ((m_entries.size() * 2) > m_slots.size())
+		{
+			Rehash(CalcSlotCount(m_entries.size()));
+		}
+		else
+		{
+			// once built, the index is kept even if the map shrinks
+			PlaceInSlots(idx);
+		}
+		return begin() + idx;
+	}
+
+	std::pair<iterator, bool> InsertEntry(value_type&& entry)
+	{
+		const size_t hashVal = hasher()(entry.first);
+		const size_type idx = FindIndex(entry.first, hashVal);
+		if (idx != sk_npos)
+		{
+			return std::make_pair(begin() + idx, false);
+		}
+		return std::make_pair(
+			Append(std::forward<value_type>(entry), hashVal), true);
+	}
+
+	/**
+	 * @brief Remove the entry from the index (with backward shift, so no
+	 *        tombstone is needed), and fill its place with the last entry
+	 *
+	 */
+	void RemoveAt(size_type idx)
+	{
+		const size_type lastIdx = m_entries.size() - 1;
+
+		if (!m_slots.empty())
+		{
+			const size_type mask = m_slots.size() - 1;
+			size_type hole = FindSlotPos(idx);
+			for (size_type pos = (hole + 1) & mask; ; pos = (pos + 1) & mask)
+			{
+				const size_type slot = m_slots[pos];
+				if (slot == 0)
+				{
+					break;
+				}
+				const size_type home = MixHash(m_hashes[slot - 1]) & mask;
+				// the entry stays if its home is cyclically in (hole, pos]
+				const bool stays = (hole <= pos) ?
+					(hole < home && home <= pos) :
+					(hole < home || home <= pos);
+				if (!stays)
+				{
+					m_slots[hole] = slot;
+					hole = pos;
+				}
+			}
+			m_slots[hole] = 0;
+
+			if (idx != lastIdx)
+			{
+				m_slots[FindSlotPos(lastIdx)] = idx + 1;
+			}
+		}
+
+		if (idx != lastIdx)
+		{
+			m_entries[idx] = std::move(m_entries[lastIdx]);
+			m_hashes[idx] = m_hashes[lastIdx];
+		}
+		m_entries.pop_back();
+		m_hashes.pop_back();
+	}
+
+	EntryCtnType m_entries;
+	std::vector<size_t> m_hashes;
+	/**
+	 * @brief Index over the entries, where 0 is an empty slot and any other
+	 *        value is the position of the entry plus one; it's empty while
+	 *        the map is small enough to be searched by linear scan
+	 */
+	std::vector<size_type> m_slots;
+
+}; // class FlatHashMap
+
+} // namespace SimpleObjects
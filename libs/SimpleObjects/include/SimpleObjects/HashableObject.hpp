@@ -51,7 +51,7 @@ public:
 		HashableObjectImpl(*other.m_ptr)
 	{}
 
-	HashableObjectImpl(Self&& other) :
+	HashableObjectImpl(Self&& other) noexcept :
 		m_ptr(std::forward<BasePtr>(other.m_ptr))
 	{}
 
@@ -75,7 +75,7 @@ public:
 		return *this;
 	}
 
-	Self& operator=(Self&& rhs)
+	Self& operator=(Self&& rhs) noexcept
 	{
 		m_ptr = std::forward<BasePtr>(rhs.m_ptr);
 		return *this;
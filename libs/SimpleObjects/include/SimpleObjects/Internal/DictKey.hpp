@@ -54,7 +54,7 @@ public: // static members
 
 public:
 
-	DictKeyImpl(DictKeyImpl&& other) :
+	DictKeyImpl(DictKeyImpl&& other) noexcept :
 		m_val(std::forward<std::unique_ptr<_ValType> >(other.m_val)),
 		m_valPtr(
 			m_val.get() != nullptr ?
@@ -101,7 +101,7 @@ public:
 		return *this;
 	}
 
-	Self& operator=(Self&& rhs)
+	Self& operator=(Self&& rhs) noexcept
 	{
 		if (this != &rhs)
 		{
@@ -23,6 +23,8 @@
 // In addition to boost::container_hash, another potential option is
 // https://github.com/llvm/llvm-project/blob/llvmorg-14.0.1/libcxx/include/__functional/hash.h
 
+#pragma once
+
 #include <cstddef>
 #include <cstdint>
 
@@ -53,6 +53,7 @@ public: // Static member:
 	typedef const BaseBase&                              base_const_reference;
 	typedef RdIterator<base_value_type, false>           base_iterator;
 	typedef RdIterator<base_value_type, true>            base_const_iterator;
+	typedef typename Base::const_span                    const_span;
 
 	static constexpr ObjCategory sk_cat()
 	{
@@ -152,8 +153,9 @@ public:
 			return false;
 		}
 
+		const_span rhsSpan = rhs.CSpan();
 		return std::equal(m_data.cbegin(), m_data.cend(),
-			rhs.cbegin(),
+			rhsSpan.cbegin(),
 			[](const BaseBase& a, const BaseBase& b) -> bool
 			{ return a == b; }
 		);
@@ -161,9 +163,10 @@ public:
 
 	virtual ObjectOrder ListBaseCompare(const Base& rhs) const override
 	{
+		const_span rhsSpan = rhs.CSpan();
 		return Internal::ObjectRangeCompareThreeWay(
-			cbegin(), cend(),
-			rhs.cbegin(), rhs.cend());
+			m_data.cbegin(), m_data.cend(),
+			rhsSpan.cbegin(), rhsSpan.cend());
 	}
 
 	using Base::operator==;
@@ -514,6 +517,11 @@ protected:
 
 	// ========== adding/removing values ==========
 
+	virtual const_span ListBaseCSpan() const override
+	{
+		return CSpanImpl(Internal::IsContiguousContainer<ContainerType>());
+	}
+
 	virtual void ListBasePushBack(base_value_type&& val) override
 	{
 		try
@@ -542,6 +550,16 @@ protected:
 
 private:
 
+	const_span CSpanImpl(std::true_type) const
+	{
+		return const_span::FromArray(m_data.data(), m_data.size());
+	}
+
+	const_span CSpanImpl(std::false_type) const
+	{
+		return Base::ListBaseCSpan();
+	}
+
 	std::unique_ptr<Self> CopyImpl() const
 	{
 		return Internal::make_unique<Self>(*this);
@@ -8,6 +8,7 @@
 #include "BaseObject.hpp"
 
 #include "Iterator.hpp"
+#include "ObjectSpan.hpp"
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
@@ -34,6 +35,7 @@ public: // Static Objects
 	typedef const value_type*                   const_pointer;
 	typedef RdIterator<value_type, false>       iterator;
 	typedef RdIterator<value_type, true>        const_iterator;
+	typedef ObjectSpan<value_type>              const_span;
 
 	static constexpr Self* sk_null = nullptr;
 
@@ -208,15 +210,30 @@ public:
 
 	void Append(const Self& other)
 	{
-		Append(other.cbegin(), other.cend());
+		const size_t otherSize = other.size();
+		if (&other == this)
+		{
+			// the span could be invalidated by push_back
+			for (size_t i = 0; i < otherSize; ++i)
+			{
+				push_back(ListBaseAt(i));
+			}
+			return;
+		}
+
+		const const_span otherSpan = other.CSpan();
+		for (size_t i = 0; i < otherSize; ++i)
+		{
+			push_back(otherSpan[i]);
+		}
 	}
 
 	// ========== item searching ==========
 
 	bool Contains(const_reference val) const
 	{
-		auto e = cend();
-		return std::find(cbegin(), e, val) != e;
+		const const_span span = CSpan();
+		return std::find(span.cbegin(), span.cend(), val) != span.cend();
 	}
 
 	// ========== iterators ==========
@@ -251,6 +268,16 @@ public:
 		return cend();
 	}
 
+	/**
+	 * @brief Get a span over the items, which is much cheaper to iterate
+	 *        than the type-erased iterators above
+	 *
+	 */
+	const_span CSpan() const
+	{
+		return ListBaseCSpan();
+	}
+
 	// ========== Copy and Move ==========
 
 	virtual std::unique_ptr<Self> Copy(const Self* /*unused*/) const = 0;
@@ -285,6 +312,23 @@ protected:
 
 	virtual void ListBasePushBack(const_reference val) = 0;
 
+	/**
+	 * @brief By default, the span accesses the items via `ListBaseAt`;
+	 *        lists backed by contiguous containers should override this
+	 *
+	 */
+	virtual const_span ListBaseCSpan() const
+	{
+		return const_span::FromGetter(this, size(), &GetItemViaAt);
+	}
+
+private:
+
+	static const_reference GetItemViaAt(const void* list, size_t idx)
+	{
+		return static_cast<const Self*>(list)->ListBaseAt(idx);
+	}
+
 }; // class ListBaseObject
 
 } // namespace SimpleObjects
@@ -47,7 +47,9 @@ public:
 		ObjectImpl(*other.m_ptr)
 	{}
 
-	ObjectImpl(Self&& other) :
+	// noexcept, so containers of objects move them instead of making deep
+	// copies when they grow
+	ObjectImpl(Self&& other) noexcept :
 		m_ptr(std::forward<BasePtr>(other.m_ptr))
 	{}
 
@@ -71,7 +73,7 @@ public:
 		return *this;
 	}
 
-	Self& operator=(Self&& rhs)
+	Self& operator=(Self&& rhs) noexcept
 	{
 		m_ptr = std::forward<BasePtr>(rhs.m_ptr);
 		return *this;
@@ -0,0 +1,259 @@
+// Copyright 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <new>
+#include <vector>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A monotonic arena for the objects in a tree (e.g., the one produced
+ *        by a parser).
+ *        Allocations are carved out of large blocks, freeing an object is a
+ *        no-op, and all blocks are released in one shot when the arena is
+ *        released or destroyed.
+ *        NOTE: all objects allocated from an arena must be destroyed before
+ *        the arena is released; the arena is not thread-safe.
+ *
+ */
+class ObjectArena
+{
+public: // static members:
+
+	static constexpr size_t sk_alignment = alignof(std::max_align_t);
+
+	static constexpr size_t sk_defaultBlockSize = 64 * 1024;
+
+public:
+
+	ObjectArena(size_t blockSize = sk_defaultBlockSize) :
+		m_blockSize(AlignUp(blockSize < 1 ? 1 : blockSize)),
+		m_blocks(),
+		m_currBlock(nullptr),
+		m_curr(nullptr),
+		m_end(nullptr),
+		m_allocatedSize(0)
+	{}
+
+	ObjectArena(const ObjectArena&) = delete;
+
+	ObjectArena(ObjectArena&&) = delete;
+
+	// LCOV_EXCL_START
+	~ObjectArena()
+	{
+		Release();
+	}
+	// LCOV_EXCL_STOP
+
+	ObjectArena& operator=(const ObjectArena&) = delete;
+
+	ObjectArena& operator=(ObjectArena&&) = delete;
+
+	void* Allocate(size_t size)
+	{
+		size = AlignUp(size);
+		m_allocatedSize += size;
+
+		if (size > (m_blockSize / 4))
+		{
+			// a large allocation gets its own block, so the space left in
+			// the current block is not wasted
+			return NewBlock(size);
+		}
+
+		if (static_cast<size_t>(m_end - m_curr) < size)
+		{
+			m_currBlock = NewBlock(m_blockSize);
+			m_curr = m_currBlock;
+			m_end = m_curr + m_blockSize;
+		}
+
+		void* res = m_curr;
+		m_curr += size;
+		return res;
+	}
+
+	/**
+	 * @brief Free all blocks at once
+	 *
+	 */
+	void Release() noexcept
+	{
+		for (void* block : m_blocks)
+		{
+			::operator delete(block);
+		}
+		m_blocks.clear();
+		m_currBlock = nullptr;
+		m_curr = nullptr;
+		m_end = nullptr;
+		m_allocatedSize = 0;
+	}
+
+	/**
+	 * @brief Free all blocks but the current one, and start over from the
+	 *        beginning of it, so an arena reused in a loop doesn't keep
+	 *        growing, nor goes back to the heap on every round
+	 *
+	 */
+	void Rewind() noexcept
+	{
+		for (void* block : m_blocks)
+		{
+			if (block != m_currBlock)
+			{
+				::operator delete(block);
+			}
+		}
+		m_blocks.clear();
+		if (m_currBlock != nullptr)
+		{
+			// reserved in `NewBlock`, so it doesn't throw
+			m_blocks.push_back(m_currBlock);
+		}
+		m_curr = m_currBlock;
+		m_allocatedSize = 0;
+	}
+
+	/**
+	 * @brief Get the total number of bytes handed out since the last release
+	 *
+	 */
+	size_t GetAllocatedSize() const
+	{
+		return m_allocatedSize;
+	}
+
+private:
+
+	static size_t AlignUp(size_t size)
+	{
+		return (size + (sk_alignment - 1)) & ~(sk_alignment - 1);
+	}
+
+	uint8_t* NewBlock(size_t size)
+	{
+		m_blocks.reserve(m_blocks.size() + 1);
+		uint8_t* block = static_cast<uint8_t*>(::operator new(size));
+		m_blocks.push_back(block);
+		return block;
+	}
+
+	size_t m_blockSize;
+	std::vector<void*> m_blocks;
+	uint8_t* m_currBlock;
+	uint8_t* m_curr;
+	uint8_t* m_end;
+	size_t m_allocatedSize;
+
+}; // class ObjectArena
+
+/**
+ * @brief While an instance is alive, the objects created on this thread are
+ *        allocated from the given arena; scopes can be nested
+ *
+ */
+class ObjectArenaScope
+{
+public: // static members:
+
+	/**
+	 * @brief Get the arena of the innermost scope on this thread, or
+	 *        `nullptr` if there is none
+	 *
+	 */
+	static ObjectArena* GetCurrent()
+	{
+		return GetCurrentRef();
+	}
+
+public:
+
+	ObjectArenaScope(ObjectArena& arena) :
+		m_prev(GetCurrentRef())
+	{
+		GetCurrentRef() = &arena;
+	}
+
+	ObjectArenaScope(const ObjectArenaScope&) = delete;
+
+	ObjectArenaScope(ObjectArenaScope&&) = delete;
+
+	// LCOV_EXCL_START
+	~ObjectArenaScope()
+	{
+		GetCurrentRef() = m_prev;
+	}
+	// LCOV_EXCL_STOP
+
+	ObjectArenaScope& operator=(const ObjectArenaScope&) = delete;
+
+	ObjectArenaScope& operator=(ObjectArenaScope&&) = delete;
+
+private:
+
+	static ObjectArena*& GetCurrentRef()
+	{
+		static thread_local ObjectArena* s_current = nullptr;
+		return s_current;
+	}
+
+	ObjectArena* m_prev;
+
+}; // class ObjectArenaScope
+
+namespace Internal
+{
+
+/**
+ * @brief Every object allocation is prefixed with the arena it comes from
+ *        (or `nullptr` for the heap), so it can be freed correctly even
+ *        after the scope has ended
+ *
+ */
+static constexpr size_t sk_objAllocHeaderSize = ObjectArena::sk_alignment;
+
+inline void* ObjectAllocate(size_t size)
+{
+	ObjectArena* arena = ObjectArenaScope::GetCurrent();
+	const size_t fullSize = size + sk_objAllocHeaderSize;
+
+	void* raw = (arena != nullptr) ?
+		arena->Allocate(fullSize) :
+		::operator new(fullSize);
+
+	*static_cast<ObjectArena**>(raw) = arena;
+	return static_cast<uint8_t*>(raw) + sk_objAllocHeaderSize;
+}
+
+inline void ObjectFree(void* ptr) noexcept
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	void* raw = static_cast<uint8_t*>(ptr) - sk_objAllocHeaderSize;
+	if (*static_cast<ObjectArena**>(raw) == nullptr)
+	{
+		::operator delete(raw);
+	}
+	// otherwise, the memory is freed when the arena is released
+}
+
+} // namespace Internal
+
+} // namespace SimpleObjects
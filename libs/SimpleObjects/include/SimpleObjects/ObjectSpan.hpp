@@ -0,0 +1,207 @@
+// Copyright 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+namespace Internal
+{
+
+template<typename _ContainerType>
+struct IsContiguousContainer : public std::false_type
+{}; // struct IsContiguousContainer
+
+template<typename _ValType, typename _Alloc>
+struct IsContiguousContainer<std::vector<_ValType, _Alloc> > :
+	public std::integral_constant<bool, !std::is_same<_ValType, bool>::value>
+{}; // struct IsContiguousContainer
+
+} // namespace Internal
+
+/**
+ * @brief A read-only view of the items of a container, accessed as their base
+ *        type.
+ *        Unlike the type-erased iterators, it doesn't allocate, and accessing
+ *        an item costs one plain (non-virtual) function call, which is a
+ *        static cast over a contiguous array of the concrete item type.
+ *        Containers that are not contiguous can still be viewed via a
+ *        function that accesses the items by index.
+ *        NOTE: the span must not be used after the container is modified or
+ *        destroyed.
+ *
+ * @tparam _BaseType The base type of the items
+ */
+template<typename _BaseType>
+class ObjectSpan
+{
+public: // static members:
+
+	using Self = ObjectSpan<_BaseType>;
+
+	typedef _BaseType         value_type;
+	typedef const _BaseType&  const_reference;
+	typedef size_t            size_type;
+
+	typedef const_reference (*GetterType)(const void*, size_t);
+
+	/**
+	 * @brief Build a span over a contiguous array of the concrete item type
+	 *
+	 */
+	template<typename _ItemType>
+	static Self FromArray(const _ItemType* data, size_t size)
+	{
+		static_assert(std::is_base_of<_BaseType, _ItemType>::value,
+			"The item type must be derived from the base type");
+		return Self(data, size, &GetArrayItem<_ItemType>);
+	}
+
+	/**
+	 * @brief Build a span that accesses the items of a non-contiguous
+	 *        container by index, via the given function
+	 *
+	 */
+	static Self FromGetter(const void* ctn, size_t size, GetterType getter)
+	{
+		return Self(ctn, size, getter);
+	}
+
+	class const_iterator
+	{
+	public:
+
+		typedef std::forward_iterator_tag  iterator_category;
+		typedef _BaseType                  value_type;
+		typedef std::ptrdiff_t             difference_type;
+		typedef const _BaseType*           pointer;
+		typedef const _BaseType&           reference;
+
+		const_iterator(const void* data, GetterType getter, size_t idx) :
+			m_data(data),
+			m_getter(getter),
+			m_idx(idx)
+		{}
+
+		reference operator*() const
+		{
+			return m_getter(m_data, m_idx);
+		}
+
+		pointer operator->() const
+		{
+			return &(m_getter(m_data, m_idx));
+		}
+
+		const_iterator& operator++()
+		{
+			++m_idx;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator tmp = *this;
+			++m_idx;
+			return tmp;
+		}
+
+		bool operator==(const const_iterator& rhs) const
+		{
+			return m_idx == rhs.m_idx;
+		}
+
+		bool operator!=(const const_iterator& rhs) const
+		{
+			return m_idx != rhs.m_idx;
+		}
+
+	private:
+
+		const void* m_data;
+		GetterType m_getter;
+		size_t m_idx;
+
+	}; // class const_iterator
+
+	typedef const_iterator iterator;
+
+public:
+
+	ObjectSpan(const Self& other) = default;
+
+	// LCOV_EXCL_START
+	~ObjectSpan() = default;
+	// LCOV_EXCL_STOP
+
+	Self& operator=(const Self& other) = default;
+
+	const_reference operator[](size_t idx) const
+	{
+		return m_getter(m_data, idx);
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(m_data, m_getter, 0);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(m_data, m_getter, m_size);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+private:
+
+	template<typename _ItemType>
+	static const_reference GetArrayItem(const void* data, size_t idx)
+	{
+		return static_cast<const _ItemType*>(data)[idx];
+	}
+
+	ObjectSpan(const void* data, size_t size, GetterType getter) :
+		m_data(data),
+		m_size(size),
+		m_getter(getter)
+	{}
+
+	const void* m_data;
+	size_t m_size;
+	GetterType m_getter;
+
+}; // class ObjectSpan
+
+} // namespace SimpleObjects
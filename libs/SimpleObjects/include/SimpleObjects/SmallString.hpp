@@ -0,0 +1,402 @@
+// Copyright 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "SmallVector.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A null-terminated string that keeps up to `_InlineCap` characters
+ *        inside the object itself; it can be used in place of
+ *        `std::basic_string` as the container of `StringImpl`
+ *
+ * @tparam _CharType  Type of the characters
+ * @tparam _InlineCap Number of characters (excluding the null terminator)
+ *                    that can be stored without a heap allocation
+ */
+template<typename _CharType, size_t _InlineCap>
+class SmallBasicString
+{
+public: // static members:
+
+	using Self = SmallBasicString<_CharType, _InlineCap>;
+	using BufType = SmallVector<_CharType, _InlineCap + 1>;
+
+	typedef std::char_traits<_CharType>                    traits_type;
+	typedef typename BufType::allocator_type               allocator_type;
+	typedef typename BufType::value_type                   value_type;
+	typedef typename BufType::size_type                    size_type;
+	typedef typename BufType::difference_type              difference_type;
+	typedef typename BufType::reference                    reference;
+	typedef typename BufType::const_reference              const_reference;
+	typedef typename BufType::pointer                      pointer;
+	typedef typename BufType::const_pointer                const_pointer;
+	typedef typename BufType::iterator                     iterator;
+	typedef typename BufType::const_iterator               const_iterator;
+	typedef typename BufType::reverse_iterator             reverse_iterator;
+	typedef typename BufType::const_reverse_iterator       const_reverse_iterator;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+public:
+
+	SmallBasicString() :
+		m_buf(1, value_type())
+	{}
+
+	SmallBasicString(const_pointer str) :
+		SmallBasicString(str, traits_type::length(str))
+	{}
+
+	SmallBasicString(const_pointer str, size_type count) :
+		m_buf()
+	{
+		m_buf.reserve(count + 1);
+		m_buf.assign(str, str + count);
+		m_buf.push_back(value_type());
+	}
+
+	template<
+		typename _ItType,
+		typename std::enable_if<
+			!std::is_integral<_ItType>::value,
+			int
+		>::type = 0
+	>
+	SmallBasicString(_ItType begin, _ItType end) :
+		m_buf(begin, end)
+	{
+		m_buf.push_back(value_type());
+	}
+
+	SmallBasicString(std::initializer_list<value_type> l) :
+		SmallBasicString(l.begin(), l.end())
+	{}
+
+	template<typename _Traits, typename _Alloc>
+	SmallBasicString(const std::basic_string<_CharType, _Traits, _Alloc>& str) :
+		SmallBasicString(str.data(), str.size())
+	{}
+
+	SmallBasicString(const Self& other) :
+		m_buf(other.m_buf)
+	{}
+
+	SmallBasicString(Self&& other) noexcept :
+		m_buf(std::move(other.m_buf))
+	{
+		other.ResetEmpty();
+	}
+
+	// LCOV_EXCL_START
+	~SmallBasicString() = default;
+	// LCOV_EXCL_STOP
+
+	Self& operator=(const Self& rhs)
+	{
+		m_buf = rhs.m_buf;
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			m_buf = std::move(rhs.m_buf);
+			rhs.ResetEmpty();
+		}
+		return *this;
+	}
+
+	Self& operator=(const_pointer str)
+	{
+		assign(str, traits_type::length(str));
+		return *this;
+	}
+
+	void assign(const_pointer str, size_type count)
+	{
+		m_buf.clear();
+		m_buf.reserve(count + 1);
+		m_buf.insert(m_buf.end(), str, str + count);
+		m_buf.push_back(value_type());
+	}
+
+	// ========== element access ==========
+
+	reference at(size_type idx)
+	{
+		CheckIndex(idx);
+		return m_buf[idx];
+	}
+
+	const_reference at(size_type idx) const
+	{
+		CheckIndex(idx);
+		return m_buf[idx];
+	}
+
+	reference operator[](size_type idx)
+	{
+		return m_buf[idx];
+	}
+
+	const_reference operator[](size_type idx) const
+	{
+		return m_buf[idx];
+	}
+
+	pointer data() noexcept
+	{
+		return m_buf.data();
+	}
+
+	const_pointer data() const noexcept
+	{
+		return m_buf.data();
+	}
+
+	const_pointer c_str() const noexcept
+	{
+		return m_buf.data();
+	}
+
+	// ========== iterators ==========
+
+	iterator begin() noexcept
+	{
+		return m_buf.begin();
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return m_buf.begin();
+	}
+
+	const_iterator cbegin() const noexcept
+	{
+		return m_buf.cbegin();
+	}
+
+	iterator end() noexcept
+	{
+		return m_buf.end() - 1;
+	}
+
+	const_iterator end() const noexcept
+	{
+		return m_buf.end() - 1;
+	}
+
+	const_iterator cend() const noexcept
+	{
+		return m_buf.cend() - 1;
+	}
+
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	const_reverse_iterator crbegin() const noexcept
+	{
+		return const_reverse_iterator(cend());
+	}
+
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	const_reverse_iterator crend() const noexcept
+	{
+		return const_reverse_iterator(cbegin());
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	size_type size() const noexcept
+	{
+		return m_buf.size() - 1;
+	}
+
+	size_type length() const noexcept
+	{
+		return size();
+	}
+
+	size_type capacity() const noexcept
+	{
+		return m_buf.capacity() - 1;
+	}
+
+	void reserve(size_type cap)
+	{
+		m_buf.reserve(cap + 1);
+	}
+
+	// ========== modifiers ==========
+
+	void clear() noexcept
+	{
+		ResetEmpty();
+	}
+
+	void push_back(value_type ch)
+	{
+		m_buf.back() = ch;
+		m_buf.push_back(value_type());
+	}
+
+	void pop_back()
+	{
+		m_buf.pop_back();
+		m_buf.back() = value_type();
+	}
+
+	void resize(size_type count)
+	{
+		resize(count, value_type());
+	}
+
+	void resize(size_type count, value_type ch)
+	{
+		m_buf.back() = ch;
+		m_buf.resize(count + 1, ch);
+		m_buf.back() = value_type();
+	}
+
+	Self& append(const_pointer str, size_type count)
+	{
+		m_buf.pop_back();
+		m_buf.insert(m_buf.end(), str, str + count);
+		m_buf.push_back(value_type());
+		return *this;
+	}
+
+	Self& operator+=(value_type ch)
+	{
+		push_back(ch);
+		return *this;
+	}
+
+	Self& operator+=(const_pointer str)
+	{
+		return append(str, traits_type::length(str));
+	}
+
+	Self& operator+=(const Self& other)
+	{
+		return append(other.data(), other.size());
+	}
+
+	void swap(Self& other) noexcept
+	{
+		m_buf.swap(other.m_buf);
+	}
+
+	// ========== comparisons ==========
+
+	int compare(const Self& other) const
+	{
+		const size_type lhsSize = size();
+		const size_type rhsSize = other.size();
+		const int cmpRes = traits_type::compare(
+			data(), other.data(), std::min(lhsSize, rhsSize));
+		if (cmpRes != 0)
+		{
+			return cmpRes;
+		}
+		return lhsSize < rhsSize ? -1 : (lhsSize > rhsSize ? 1 : 0);
+	}
+
+	bool operator==(const Self& rhs) const
+	{
+		return (size() == rhs.size()) &&
+			(traits_type::compare(data(), rhs.data(), size()) == 0);
+	}
+
+#ifdef __cpp_lib_three_way_comparison
+	std::strong_ordering operator<=>(const Self& rhs) const
+	{
+		return compare(rhs) <=> 0;
+	}
+#else
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	bool operator<(const Self& rhs) const
+	{
+		return compare(rhs) < 0;
+	}
+
+	bool operator>(const Self& rhs) const
+	{
+		return compare(rhs) > 0;
+	}
+
+	bool operator<=(const Self& rhs) const
+	{
+		return compare(rhs) <= 0;
+	}
+
+	bool operator>=(const Self& rhs) const
+	{
+		return compare(rhs) >= 0;
+	}
+#endif
+
+private:
+
+	void CheckIndex(size_type idx) const
+	{
+		if (idx >= size())
+		{
+			throw std::out_of_range("SmallBasicString index out of range");
+		}
+	}
+
+	void ResetEmpty() noexcept
+	{
+		// the buffer always has room for the terminator
+		m_buf.clear();
+		m_buf.push_back(value_type());
+	}
+
+	BufType m_buf;
+
+}; // class SmallBasicString
+
+} // namespace SimpleObjects
@@ -0,0 +1,655 @@
+// Copyright 2023 SimpleObjects
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef __cpp_lib_three_way_comparison
+#include <compare>
+#endif
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A vector of trivially copyable values that keeps up to
+ *        `_InlineCap` values inside the object itself, and only goes to the
+ *        heap when it grows beyond that; it can be used in place of
+ *        `std::vector` as the container of `BytesImpl`
+ *
+ * @tparam _ValType  Type of the values
+ * @tparam _InlineCap Number of values that can be stored without a heap
+ *                    allocation
+ */
+template<typename _ValType, size_t _InlineCap>
+class SmallVector
+{
+public: // static members:
+
+	static_assert(std::is_trivially_copyable<_ValType>::value,
+		"SmallVector only supports trivially copyable types");
+	static_assert(_InlineCap > 0,
+		"The inline capacity of SmallVector must be larger than zero");
+
+	using Self = SmallVector<_ValType, _InlineCap>;
+
+	typedef std::allocator<_ValType>               allocator_type;
+	typedef _ValType                               value_type;
+	typedef size_t                                 size_type;
+	typedef std::ptrdiff_t                         difference_type;
+	typedef value_type&                            reference;
+	typedef const value_type&                      const_reference;
+	typedef value_type*                            pointer;
+	typedef const value_type*                      const_pointer;
+	typedef pointer                                iterator;
+	typedef const_pointer                          const_iterator;
+	typedef std::reverse_iterator<iterator>        reverse_iterator;
+	typedef std::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+	static constexpr size_type sk_inlineCap = _InlineCap;
+
+public:
+
+	SmallVector() noexcept :
+		m_ptr(m_inline),
+		m_size(0),
+		m_cap(_InlineCap)
+	{}
+
+	explicit SmallVector(size_type count) :
+		SmallVector()
+	{
+		resize(count);
+	}
+
+	SmallVector(size_type count, const value_type& val) :
+		SmallVector()
+	{
+		resize(count, val);
+	}
+
+	template<
+		typename _ItType,
+		typename std::enable_if<
+			!std::is_integral<_ItType>::value,
+			int
+		>::type = 0
+	>
+	SmallVector(_ItType begin, _ItType end) :
+		SmallVector()
+	{
+		assign(begin, end);
+	}
+
+	SmallVector(std::initializer_list<value_type> l) :
+		SmallVector()
+	{
+		assign(l.begin(), l.end());
+	}
+
+	SmallVector(const Self& other) :
+		SmallVector()
+	{
+		assign(other.begin(), other.end());
+	}
+
+	SmallVector(Self&& other) noexcept :
+		SmallVector()
+	{
+		TakeFrom(other);
+	}
+
+	// LCOV_EXCL_START
+	~SmallVector()
+	{
+		FreeHeap();
+	}
+	// LCOV_EXCL_STOP
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			assign(rhs.begin(), rhs.end());
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			FreeHeap();
+			m_ptr = m_inline;
+			m_size = 0;
+			m_cap = _InlineCap;
+			TakeFrom(rhs);
+		}
+		return *this;
+	}
+
+	Self& operator=(std::initializer_list<value_type> l)
+	{
+		assign(l.begin(), l.end());
+		return *this;
+	}
+
+	template<typename _ItType>
+	void assign(_ItType begin, _ItType end)
+	{
+		AssignImpl(begin, end,
+			typename std::iterator_traits<_ItType>::iterator_category());
+	}
+
+	// ========== element access ==========
+
+	reference at(size_type idx)
+	{
+		CheckIndex(idx);
+		return m_ptr[idx];
+	}
+
+	const_reference at(size_type idx) const
+	{
+		CheckIndex(idx);
+		return m_ptr[idx];
+	}
+
+	reference operator[](size_type idx)
+	{
+		return m_ptr[idx];
+	}
+
+	const_reference operator[](size_type idx) const
+	{
+		return m_ptr[idx];
+	}
+
+	reference front()
+	{
+		return m_ptr[0];
+	}
+
+	const_reference front() const
+	{
+		return m_ptr[0];
+	}
+
+	reference back()
+	{
+		return m_ptr[m_size - 1];
+	}
+
+	const_reference back() const
+	{
+		return m_ptr[m_size - 1];
+	}
+
+	pointer data() noexcept
+	{
+		return m_ptr;
+	}
+
+	const_pointer data() const noexcept
+	{
+		return m_ptr;
+	}
+
+	// ========== iterators ==========
+
+	iterator begin() noexcept
+	{
+		return m_ptr;
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return m_ptr;
+	}
+
+	const_iterator cbegin() const noexcept
+	{
+		return m_ptr;
+	}
+
+	iterator end() noexcept
+	{
+		return m_ptr + m_size;
+	}
+
+	const_iterator end() const noexcept
+	{
+		return m_ptr + m_size;
+	}
+
+	const_iterator cend() const noexcept
+	{
+		return m_ptr + m_size;
+	}
+
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	const_reverse_iterator crbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	const_reverse_iterator crend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	size_type max_size() const noexcept
+	{
+		return allocator_type().max_size();
+	}
+
+	size_type capacity() const noexcept
+	{
+		return m_cap;
+	}
+
+	/**
+	 * @brief Whether the values are stored inside the object, rather than
+	 *        on the heap
+	 *
+	 */
+	bool IsInline() const noexcept
+	{
+		return m_ptr == m_inline;
+	}
+
+	void reserve(size_type cap)
+	{
+		if (cap > m_cap)
+		{
+			Reallocate(cap);
+		}
+	}
+
+	void shrink_to_fit()
+	{
+		if (!IsInline() && m_size <= _InlineCap)
+		{
+			pointer heapPtr = m_ptr;
+			size_type heapCap = m_cap;
+			CopyValues(m_inline, heapPtr, m_size);
+			m_ptr = m_inline;
+			m_cap = _InlineCap;
+			allocator_type().deallocate(heapPtr, heapCap);
+		}
+	}
+
+	// ========== modifiers ==========
+
+	void clear() noexcept
+	{
+		m_size = 0;
+	}
+
+	void push_back(const value_type& val)
+	{
+		if (m_size == m_cap)
+		{
+			// `val` may refer to a value in this vector
+			const value_type tmp = val;
+			Grow(m_size + 1);
+			m_ptr[m_size++] = tmp;
+		}
+		else
+		{
+			m_ptr[m_size++] = val;
+		}
+	}
+
+	void pop_back()
+	{
+		--m_size;
+	}
+
+	void resize(size_type count)
+	{
+		resize(count, value_type());
+	}
+
+	void resize(size_type count, const value_type& val)
+	{
+		if (count > m_size)
+		{
+			const value_type tmp = val;
+			Grow(count);
+			std::fill(m_ptr + m_size, m_ptr + count, tmp);
+		}
+		m_size = count;
+	}
+
+	iterator insert(const_iterator pos, const value_type& val)
+	{
+		const value_type tmp = val;
+		iterator dest = MakeGap(pos, 1);
+		*dest = tmp;
+		return dest;
+	}
+
+	template<
+		typename _ItType,
+		typename std::enable_if<
+			!std::is_integral<_ItType>::value,
+			int
+		>::type = 0
+	>
+	iterator insert(const_iterator pos, _ItType begin, _ItType end)
+	{
+		return InsertImpl(pos, begin, end,
+			typename std::iterator_traits<_ItType>::iterator_category());
+	}
+
+	iterator insert(const_iterator pos, std::initializer_list<value_type> l)
+	{
+		return insert(pos, l.begin(), l.end());
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(const_iterator begin, const_iterator end)
+	{
+		iterator dest = m_ptr + (begin - m_ptr);
+		const size_type tailSize = static_cast<size_type>(cend() - end);
+		if (begin != end)
+		{
+			MoveValues(dest, end, tailSize);
+			m_size -= static_cast<size_type>(end - begin);
+		}
+		return dest;
+	}
+
+	void swap(Self& other) noexcept
+	{
+		Self tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	// ========== comparisons ==========
+
+	bool operator==(const Self& rhs) const
+	{
+		return (m_size == rhs.m_size) &&
+			std::equal(begin(), end(), rhs.begin());
+	}
+
+#ifdef __cpp_lib_three_way_comparison
+	auto operator<=>(const Self& rhs) const
+	{
+		return std::lexicographical_compare_three_way(
+			begin(), end(), rhs.begin(), rhs.end());
+	}
+#else
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	bool operator<(const Self& rhs) const
+	{
+		return std::lexicographical_compare(
+			begin(), end(), rhs.begin(), rhs.end());
+	}
+
+	bool operator>(const Self& rhs) const
+	{
+		return rhs < *this;
+	}
+
+	bool operator<=(const Self& rhs) const
+	{
+		return !(rhs < *this);
+	}
+
+	bool operator>=(const Self& rhs) const
+	{
+		return !(*this < rhs);
+	}
+#endif
+
+private:
+
+	static void CopyValues(pointer dest, const_pointer src, size_type count)
+	{
+		if (count > 0)
+		{
+			std::memcpy(dest, src, count * sizeof(value_type));
+		}
+	}
+
+	static void MoveValues(pointer dest, const_pointer src, size_type count)
+	{
+		if (count > 0)
+		{
+			std::memmove(dest, src, count * sizeof(value_type));
+		}
+	}
+
+	void CheckIndex(size_type idx) const
+	{
+		if (idx >= m_size)
+		{
+			throw std::out_of_range("SmallVector index out of range");
+		}
+	}
+
+	void FreeHeap() noexcept
+	{
+		if (!IsInline())
+		{
+			allocator_type().deallocate(m_ptr, m_cap);
+		}
+	}
+
+	void Reallocate(size_type cap)
+	{
+		pointer newPtr = allocator_type().allocate(cap);
+		CopyValues(newPtr, m_ptr, m_size);
+		FreeHeap();
+		m_ptr = newPtr;
+		m_cap = cap;
+	}
+
+	/**
+	 * @brief Make room for at least `minCap` values, growing geometrically
+	 *
+	 */
+	void Grow(size_type minCap)
+	{
+		if (minCap > m_cap)
+		{
+			Reallocate(std::max(minCap, m_cap * 2));
+		}
+	}
+
+	void TakeFrom(Self& other) noexcept
+	{
+		if (other.IsInline())
+		{
+			CopyValues(m_inline, other.m_inline, other.m_size);
+			m_size = other.m_size;
+		}
+		else
+		{
+			m_ptr = other.m_ptr;
+			m_size = other.m_size;
+			m_cap = other.m_cap;
+			other.m_ptr = other.m_inline;
+			other.m_cap = _InlineCap;
+		}
+		other.m_size = 0;
+	}
+
+	/**
+	 * @brief Shift the values after `pos` to make a gap of `count` values
+	 *
+	 * @return The beginning of the gap
+	 */
+	iterator MakeGap(const_iterator pos, size_type count)
+	{
+		const size_type idx = static_cast<size_type>(pos - m_ptr);
+		Grow(m_size + count);
+		MoveValues(m_ptr + idx + count, m_ptr + idx, m_size - idx);
+		m_size += count;
+		return m_ptr + idx;
+	}
+
+	template<typename _ItType>
+	void AssignImpl(_ItType begin, _ItType end, std::input_iterator_tag)
+	{
+		clear();
+		for (; begin != end; ++begin)
+		{
+			push_back(*begin);
+		}
+	}
+
+	template<typename _ItType>
+	void AssignImpl(_ItType begin, _ItType end, std::forward_iterator_tag)
+	{
+		const size_type count =
+			static_cast<size_type>(std::distance(begin, end));
+		clear();
+		Grow(count);
+		std::copy(begin, end, m_ptr);
+		m_size = count;
+	}
+
+	template<typename _ItType>
+	iterator InsertImpl(
+		const_iterator pos, _ItType begin, _ItType end, std::input_iterator_tag)
+	{
+		const size_type idx = static_cast<size_type>(pos - m_ptr);
+		for (size_type i = idx; begin != end; ++begin, ++i)
+		{
+			insert(m_ptr + i, *begin);
+		}
+		return m_ptr + idx;
+	}
+
+	template<typename _ItType>
+	iterator InsertImpl(
+		const_iterator pos, _ItType begin, _ItType end,
+		std::forward_iterator_tag)
+	{
+		const size_type count =
+			static_cast<size_type>(std::distance(begin, end));
+		// the source range may be in this vector, so copy it out first if
+		// this vector needs to grow
+		if (m_size + count > m_cap)
+		{
+			Self tmp;
+			tmp.reserve(std::max(m_size + count, m_cap * 2));
+			const size_type idx = static_cast<size_type>(pos - m_ptr);
+			tmp.assign(cbegin(), pos);
+			tmp.m_size += count;
+			std::copy(begin, end, tmp.m_ptr + idx);
+			CopyValues(tmp.m_ptr + idx + count, m_ptr + idx, m_size - idx);
+			tmp.m_size += (m_size - idx);
+			*this = std::move(tmp);
+			return m_ptr + idx;
+		}
+
+		if (IsInThis(begin))
+		{
+			// the gap shifts the values the source range refers to
+			const Self tmp(begin, end);
+			iterator dest = MakeGap(pos, count);
+			std::copy(tmp.cbegin(), tmp.cend(), dest);
+			return dest;
+		}
+
+		iterator dest = MakeGap(pos, count);
+		std::copy(begin, end, dest);
+		return dest;
+	}
+
+	template<
+		typename _ItType,
+		typename std::enable_if<
+			std::is_convertible<_ItType, const_pointer>::value,
+			int
+		>::type = 0
+	>
+	bool IsInThis(_ItType it) const
+	{
+		const_pointer ptr = it;
+		return !std::less<const_pointer>()(ptr, m_ptr) &&
+			std::less<const_pointer>()(ptr, m_ptr + m_size);
+	}
+
+	template<
+		typename _ItType,
+		typename std::enable_if<
+			!std::is_convertible<_ItType, const_pointer>::value,
+			int
+		>::type = 0
+	>
+	bool IsInThis(_ItType) const
+	{
+		// other iterator types can't refer to this vector
+		return false;
+	}
+
+	pointer m_ptr;
+	size_type m_size;
+	size_type m_cap;
+	value_type m_inline[_InlineCap];
+
+}; // class SmallVector
+
+} // namespace SimpleObjects
@@ -9,6 +9,8 @@
 
 #include <algorithm>
 
+#include "Internal/hash.hpp"
+
 #include "Compare.hpp"
 #include "ToString.hpp"
 #include "Utils.hpp"
@@ -255,12 +257,16 @@ public:
 		m_data.pop_back();
 	}
 
-	using Base::Append;
 	virtual void Append(const_iterator begin, const_iterator end) override
 	{
 		std::copy(begin, end, std::back_inserter(m_data));
 	}
 
+	virtual void Append(const Base& other) override
+	{
+		AppendContiguous(other.data(), other.size());
+	}
+
 	// ========== item searching ==========
 
 	using Base::StartsWith;
@@ -343,7 +349,10 @@ public:
 
 	virtual std::size_t Hash() const override
 	{
-		return std::hash<ContainerType>()(m_data);
+		// hash over the characters, rather than the container, so strings
+		// with different container types that compare equal also have the
+		// same hash value
+		return Internal::hash_range(m_data.cbegin(), m_data.cend());
 	}
 
 	// ========== Overrides BaseObject ==========
@@ -364,7 +373,7 @@ public:
 		}
 		catch(const std::bad_cast&)
 		{
-			throw TypeError("String", this->GetCategoryName());
+			SetFromOtherContainer(other);
 		}
 	}
 
@@ -377,7 +386,7 @@ public:
 		}
 		catch(const std::bad_cast&)
 		{
-			throw TypeError("String", this->GetCategoryName());
+			SetFromOtherContainer(other);
 		}
 	}
 
@@ -430,6 +439,41 @@ public:
 
 private:
 
+	/**
+	 * @brief Copy the data of a String object with a different container type
+	 *
+	 */
+	void SetFromOtherContainer(const BaseBaseBase& other)
+	{
+		if (other.GetCategory() != sk_cat())
+		{
+			throw TypeError("String", other.GetCategoryName());
+		}
+		const auto& otherObj = other.AsString();
+		m_data = ContainerType(
+			otherObj.data(), otherObj.data() + otherObj.size());
+	}
+
+	/**
+	 * @brief Append a contiguous range, which may be part of this object
+	 *
+	 */
+	void AppendContiguous(const_pointer begin, size_t size)
+	{
+		if (begin == m_data.data())
+		{
+			m_data.reserve(m_data.size() + size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				m_data.push_back(m_data[i]);
+			}
+		}
+		else
+		{
+			m_data.append(begin, size);
+		}
+	}
+
 	std::unique_ptr<Self> CopyImpl() const
 	{
 		return Internal::make_unique<Self>(*this);
@@ -270,6 +270,27 @@ struct TupleOperationImpl
 			std::get<_I>(std::forward<_Tp1>(tp1)),
 			std::get<_I>(std::forward<_Tp2>(tp2)));
 	}
+
+	template<typename _Tp1, typename _Tp2, typename _CallbackType>
+	static void BinOpAt(
+		size_t idx, _Tp1&& tp1, _Tp2&& tp2, _CallbackType&& callback)
+	{
+		if (idx == _I)
+		{
+			callback(
+				_I,
+				std::get<_I>(std::forward<_Tp1>(tp1)),
+				std::get<_I>(std::forward<_Tp2>(tp2)));
+		}
+		else
+		{
+			TupleOperationImpl<_I - 1>::BinOpAt(
+				idx,
+				std::forward<_Tp1>(tp1),
+				std::forward<_Tp2>(tp2),
+				std::forward<_CallbackType>(callback));
+		}
+	}
 }; // struct TupleOperationImpl
 
 template<>
@@ -291,6 +312,19 @@ struct TupleOperationImpl<0>
 			std::get<0>(std::forward<_Tp1>(tp1)),
 			std::get<0>(std::forward<_Tp2>(tp2)));
 	}
+
+	template<typename _Tp1, typename _Tp2, typename _CallbackType>
+	static void BinOpAt(
+		size_t idx, _Tp1&& tp1, _Tp2&& tp2, _CallbackType&& callback)
+	{
+		if (idx == 0)
+		{
+			callback(
+				0,
+				std::get<0>(std::forward<_Tp1>(tp1)),
+				std::get<0>(std::forward<_Tp2>(tp2)));
+		}
+	}
 }; // struct TupleOperationImpl
 
 struct TupleOperation
@@ -327,6 +361,32 @@ struct TupleOperation
 			std::forward<_Tp2>(tp2),
 			std::forward<_CallbackType>(callback));
 	}
+
+	/**
+	 * @brief Perform the binary operation only on the `idx`-th items of the
+	 *        two tuples; nothing is done if `idx` is out of range
+	 *
+	 */
+	template<typename _Tp1, typename _Tp2, typename _CallbackType>
+	static void BinOpAt(
+		size_t idx, _Tp1&& tp1, _Tp2&& tp2, _CallbackType&& callback)
+	{ // ^ perfect forwarding
+		using _Tp1Raw = typename std::remove_cv<
+			typename std::remove_reference<_Tp1>::type>::type;
+		using _Tp2Raw = typename std::remove_cv<
+			typename std::remove_reference<_Tp2>::type>::type;
+		static constexpr size_t tp1Size = std::tuple_size<_Tp1Raw>::value;
+		static constexpr size_t tp2Size = std::tuple_size<_Tp2Raw>::value;
+		static_assert(tp1Size == tp2Size && tp1Size > 0,
+			"Two tuples must have the same size, "
+			"and they must have at least 1 item");
+
+		TupleOperationImpl<tp1Size - 1>::BinOpAt(
+			idx,
+			std::forward<_Tp1>(tp1),
+			std::forward<_Tp2>(tp2),
+			std::forward<_CallbackType>(callback));
+	}
 }; // struct TupleOperation
 
 template<template<typename> class _Transform, typename _T>
@@ -73,6 +73,22 @@ inline typename GenericParserT<_ContainerType>::RetType Parse(
 }
 
 
+/**
+ * @brief Parse the RLP bytes, allocating all nodes of the returned tree from
+ *        the given arena, which must outlive the returned object
+ *
+ */
+template<typename _ContainerType>
+inline typename GenericParserT<_ContainerType>::RetType Parse(
+	const _ContainerType& container,
+	Internal::SimRlp::Internal::Obj::ObjectArena& arena
+)
+{
+	Internal::SimRlp::Internal::Obj::ObjectArenaScope arenaScope(arena);
+	return GenericParserT<_ContainerType>().Parse(container);
+}
+
+
 // ====================
 // Writers
 // ====================
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -92,31 +93,54 @@ struct CatArrayWriterImpl
 
 	using GenericWriter = _GenericWriter;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InArrayObjType& val)
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InArrayObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
+	{
+		size_t sizeIdx = sizeCache.Reserve();
+
+		// 1.specs
+		size_t payloadSize = 1;
+
+		// 2.items
+		for (const auto& item : val.CSpan())
+		{
+			payloadSize += GenericWriter::CalcSize(item, sizeCache);
+		}
+
+		sizeCache.Set(sizeIdx, payloadSize);
+		return Internal::CalcRlpListSize(payloadSize);
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _InArrayObjType& val
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(sizeCache.Next(), destIt);
 
 		// 1.specs
-		auto catId = SerializeCatId(CatId::Array);
-		outBytes.push_back(catId);
+		*(destIt++) = SerializeCatId(CatId::Array);
 
 		// 2.items
-		auto itEnd = val.end();
-		for (auto it = val.begin(); it != itEnd; ++it)
+		for (const auto& item : val.CSpan())
 		{
-			ccntr(outBytes, GenericWriter::Write(*it));
+			destIt = GenericWriter::WriteTo(destIt, sizeCache, item);
 		}
 
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return destIt;
 	}
 
 }; // struct CatArrayWriterImpl
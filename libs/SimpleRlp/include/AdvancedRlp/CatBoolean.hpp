@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -92,29 +93,41 @@ struct CatBooleanWriterImpl
 {
 	using Self = CatBooleanWriterImpl<_InObjType, _OutCtnType>;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InObjType& val)
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InObjType&,
+		Internal::SimRlp::WriterSizeCache&
+	)
+	{
+		return Internal::CalcRlpListSize(1);
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache&,
+		const _InObjType& val
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(1, destIt);
 
 		// 1.specs
-		auto catId = val.IsTrue() ?
+		*(destIt++) = val.IsTrue() ?
 			SerializeCatId(CatId::True) :
 			SerializeCatId(CatId::False);
-		outBytes.push_back(catId);
 
 		// 2.raw data
 		// N/A
 
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return destIt;
 	}
 
 }; // struct CatBooleanWriterImpl
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -89,27 +90,44 @@ struct CatBytesWriterImpl
 
 	using RlpBytesWriter  = _RlpBytesWriter;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InObjType& inBytes)
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(inBytes, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, inBytes);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InObjType& inBytes,
+		Internal::SimRlp::WriterSizeCache&
+	)
+	{
+		return Internal::CalcRlpListSize(CalcPayloadSize(inBytes));
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache&,
+		const _InObjType& inBytes
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(CalcPayloadSize(inBytes), destIt);
 
 		// 1.specs
-		outBytes.push_back(SerializeCatId(CatId::Bytes));
+		*(destIt++) = SerializeCatId(CatId::Bytes);
 
 		// 2.raw data
-		auto rawData = RlpBytesWriter::Write(inBytes);
-		ccntr(outBytes, rawData);
-
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return RlpBytesWriter::WriteTo(destIt, inBytes);
+	}
+
+private:
+
+	inline static size_t CalcPayloadSize(const _InObjType& inBytes)
+	{
+		return 1 + RlpBytesWriter::CalcSize(inBytes);
 	}
 
 }; // struct CatBytesWriterImpl
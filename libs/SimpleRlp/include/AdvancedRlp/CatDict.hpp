@@ -6,8 +6,10 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -142,7 +144,7 @@ struct TransformCatDictImpl
 using TransformCatDict = TransformCatDictImpl<
 	true,
 	Internal::SimRlp::ListObjType,
-	Internal::SimRlp::Internal::Obj::Dict>;
+	Internal::SimRlp::Internal::Obj::FlatDict>;
 
 
 // ====================
@@ -163,46 +165,150 @@ struct CatDictWriterImpl
 
 	using GenericWriter = _GenericWriter;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InDictObjType& val)
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	/**
+	 * @brief Calculate the size of the given dict.
+	 *        Items are written in the order of their keys; if the dict isn't
+	 *        already ordered by key, the items are sorted here, and the
+	 *        sorted order is recorded in the size cache, so that `WriteTo`
+	 *        doesn't need to sort them again.
+	 *
+	 */
+	inline static size_t CalcSize(
+		const _InDictObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
+	{
+		size_t sizeIdx = sizeCache.Reserve();
 
 		// 1.specs
-		auto catId = SerializeCatId(CatId::Dict);
-		outBytes.push_back(catId);
+		size_t payloadSize = 1;
 
 		// 2.items
 		auto itEnd = val.end();
-		using DictItType = decltype(itEnd);
-		// put iterators into a vector
-		std::vector<DictItType> itVec;
-		for (auto it = val.begin(); it != itEnd; ++it)
+		if (val.IsOrderedByKey())
 		{
-			itVec.push_back(it);
+			for (auto it = val.begin(); it != itEnd; ++it)
+			{
+				payloadSize += GenericWriter::CalcSize(
+					*std::get<0>(*it), sizeCache
+				);
+				payloadSize += GenericWriter::CalcSize(
+					*std::get<1>(*it), sizeCache
+				);
+			}
 		}
-		// sort by key
-		std::sort(itVec.begin(), itVec.end(),
-			[](const DictItType& a, const DictItType& b)
+		else
+		{
+			std::vector<ItemRef> items = CollectItems(val);
+			// sort by key
+			std::sort(items.begin(), items.end(),
+				[](const ItemRef& a, const ItemRef& b)
+				{
+					return *(a.m_key) < *(b.m_key);
+				});
+
+			// record the sorted order
+			for (const auto& item : items)
+			{
+				sizeCache.Set(sizeCache.Reserve(), item.m_idx);
+			}
+
+			for (const auto& item : items)
 			{
-				return *std::get<0>(*a) < *std::get<0>(*b);
-			});
-		// generate bytes for items
-		for (auto it = itVec.begin(); it != itVec.end(); ++it)
+				payloadSize += GenericWriter::CalcSize(*(item.m_key), sizeCache);
+				payloadSize += GenericWriter::CalcSize(*(item.m_val), sizeCache);
+			}
+		}
+
+		sizeCache.Set(sizeIdx, payloadSize);
+		return Internal::CalcRlpListSize(payloadSize);
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _InDictObjType& val
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(sizeCache.Next(), destIt);
+
+		// 1.specs
+		*(destIt++) = SerializeCatId(CatId::Dict);
+
+		// 2.items
+		auto itEnd = val.end();
+		if (val.IsOrderedByKey())
+		{
+			for (auto it = val.begin(); it != itEnd; ++it)
+			{
+				destIt = GenericWriter::WriteTo(
+					destIt, sizeCache, *std::get<0>(*it)
+				);
+				destIt = GenericWriter::WriteTo(
+					destIt, sizeCache, *std::get<1>(*it)
+				);
+			}
+		}
+		else
+		{
+			std::vector<ItemRef> items = CollectItems(val);
+
+			// take the sorted order recorded by `CalcSize`
+			std::vector<size_t> order(items.size());
+			for (auto& idx : order)
+			{
+				idx = sizeCache.Next();
+			}
+
+			for (const auto& idx : order)
+			{
+				const ItemRef& item = items[idx];
+				destIt = GenericWriter::WriteTo(destIt, sizeCache, *(item.m_key));
+				destIt = GenericWriter::WriteTo(destIt, sizeCache, *(item.m_val));
+			}
+		}
+
+		return destIt;
+	}
+
+private:
+
+	using KeyType = typename _InDictObjType::key_type;
+	using ValType = typename _InDictObjType::mapped_type;
+
+	struct ItemRef
+	{
+		const KeyType* m_key;
+		const ValType* m_val;
+		size_t m_idx;
+	}; // struct ItemRef
+
+	inline static std::vector<ItemRef> CollectItems(const _InDictObjType& val)
+	{
+		std::vector<ItemRef> items;
+		items.reserve(val.size());
+
+		auto itEnd = val.end();
+		for (auto it = val.begin(); it != itEnd; ++it)
 		{
-			ccntr(outBytes, GenericWriter::Write(*std::get<0>(**it)));
-			ccntr(outBytes, GenericWriter::Write(*std::get<1>(**it)));
+			items.push_back(ItemRef({
+				&(*std::get<0>(*it)),
+				&(*std::get<1>(*it)),
+				items.size()
+			}));
 		}
 
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return items;
 	}
 
 }; // struct CatDictWriterImpl
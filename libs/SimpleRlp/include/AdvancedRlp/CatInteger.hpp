@@ -461,6 +461,50 @@ struct BuildIntRawData<uint64_t> :
 	public BuildUIntRawDataImpl<uint64_t>
 {}; // struct BuildIntRawData<uint64_t>
 
+
+/**
+ * @brief A fixed-size buffer for the raw data of an integer, so that
+ *        writing an integer doesn't need any heap allocation
+ */
+class IntRawData
+{
+public:
+
+	IntRawData() :
+		m_data(),
+		m_size(0)
+	{}
+
+	void resize(size_t size)
+	{
+		if (size > sizeof(m_data))
+		{
+			throw SerializeError("The integer is too large");
+		}
+		m_size = size;
+	}
+
+	uint8_t* data()
+	{
+		return m_data;
+	}
+
+	const uint8_t* data() const
+	{
+		return m_data;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+
+	uint8_t m_data[sizeof(uint64_t)];
+	size_t m_size;
+}; // class IntRawData
+
 } // namespace Internal
 
 
@@ -471,19 +515,69 @@ struct CatIntegerWriterImpl
 {
 	using Self = CatIntegerWriterImpl<_InObjType, _OutCtnType>;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InObjType& val)
 	{
-		Concatenator ccntr;
-		_OutCtnType specs;
-		_OutCtnType rawData;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InObjType& val,
+		Internal::SimRlp::WriterSizeCache&
+	)
+	{
+		uint8_t specs[sk_specsSize];
+		Internal::IntRawData rawData;
+		BuildSpecsAndRawData(specs, rawData, val);
+
+		return Internal::CalcRlpListSize(CalcPayloadSize(specs, rawData));
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache&,
+		const _InObjType& val
+	)
+	{
+		uint8_t specs[sk_specsSize];
+		Internal::IntRawData rawData;
+		BuildSpecsAndRawData(specs, rawData, val);
+
+		destIt = Internal::WriteRlpListHeader(
+			CalcPayloadSize(specs, rawData),
+			destIt
+		);
+		destIt = Internal::WriteRlpBytes(specs, sk_specsSize, destIt);
+		return Internal::WriteRlpBytes(rawData.data(), rawData.size(), destIt);
+	}
+
+private:
 
+	static constexpr size_t sk_specsSize = 3;
+
+	inline static size_t CalcPayloadSize(
+		const uint8_t (&specs)[sk_specsSize],
+		const Internal::IntRawData& rawData
+	)
+	{
+		return Internal::CalcRlpBytesSize(specs, sk_specsSize) +
+			Internal::CalcRlpBytesSize(rawData.data(), rawData.size());
+	}
+
+	inline static void BuildSpecsAndRawData(
+		uint8_t (&specs)[sk_specsSize],
+		Internal::IntRawData& rawData,
+		const _InObjType& val
+	)
+	{
 		// 1.specs
-		specs.push_back(SerializeCatId(CatId::Integer));
-		specs.push_back(0x00U);
-		specs.push_back(0x00U);
+		specs[0] = SerializeCatId(CatId::Integer);
+		specs[1] = 0x00U;
+		specs[2] = 0x00U;
 		uint8_t& widthByte = specs[1];
 		uint8_t& signByte = specs[2];
 
@@ -539,25 +633,6 @@ struct CatIntegerWriterImpl
 		default:
 			throw SerializeTypeError(val.GetNumTypeName(), "CatIntegerWriter");
 		}
-
-		// 3.build RLP list
-		specs = Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::Bytes>(
-				specs,
-				ccntr
-			);
-		rawData = Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::Bytes>(
-				rawData,
-				ccntr
-			);
-		ccntr(specs, rawData);
-
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				specs,
-				ccntr
-			);
 	}
 
 }; // struct CatIntegerWriterImpl
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -80,26 +81,35 @@ struct CatNullWriterImpl
 {
 	using Self = CatNullWriterImpl<_OutCtnType>;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write()
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(sizeCache));
+		WriteTo(&outBytes[0], sizeCache);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(Internal::SimRlp::WriterSizeCache&)
+	{
+		return Internal::CalcRlpListSize(1);
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache&
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(1, destIt);
 
 		// 1.specs
-		outBytes.push_back(SerializeCatId(CatId::Null));
+		*(destIt++) = SerializeCatId(CatId::Null);
 
 		// 2.raw data
 		// N/A
 
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return destIt;
 	}
 
 }; // struct CatNullWriterImpl
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -152,31 +153,56 @@ struct CatStaticDictWriterImpl
 
 	using GenericWriter = _GenericWriter;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InStaticDictObjType& val)
 	{
-		Concatenator ccntr;
-		_OutCtnType outBytes;
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InStaticDictObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
+	{
+		size_t sizeIdx = sizeCache.Reserve();
+
+		// 1.specs
+		size_t payloadSize = 1;
+
+		// 2.items
+		const size_t numItems = val.size();
+		for (size_t i = 0; i < numItems; ++i)
+		{
+			payloadSize += GenericWriter::CalcSize(val[i], sizeCache);
+		}
+
+		sizeCache.Set(sizeIdx, payloadSize);
+		return Internal::CalcRlpListSize(payloadSize);
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _InStaticDictObjType& val
+	)
+	{
+		destIt = Internal::WriteRlpListHeader(sizeCache.Next(), destIt);
 
 		// 1.specs
-		auto catId = SerializeCatId(CatId::StaticDict);
-		outBytes.push_back(catId);
+		*(destIt++) = SerializeCatId(CatId::StaticDict);
 
 		// 2.items
-		auto itEnd = val.end();
-		for (auto it = val.begin(); it != val.end(); ++it)
+		const size_t numItems = val.size();
+		for (size_t i = 0; i < numItems; ++i)
 		{
-			ccntr(outBytes, GenericWriter::Write(it->second.get()));
+			destIt = GenericWriter::WriteTo(destIt, sizeCache, val[i]);
 		}
 
-		// 3.build RLP list
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				outBytes,
-				ccntr
-			);
+		return destIt;
 	}
 
 }; // struct CatStaticDictWriterImpl
@@ -8,6 +8,7 @@
 #include "Internal/SimpleUtf.hpp"
 
 #include "ParserUtils.hpp"
+#include "WriterUtils.hpp"
 
 #ifndef ADVANCEDRLP_CUSTOMIZED_NAMESPACE
 namespace AdvancedRlp
@@ -140,42 +141,40 @@ struct CatStringWriterImpl
 {
 	using Self = CatStringWriterImpl<_InObjType, _OutCtnType>;
 
-	using Concatenator = Internal::SimRlp::OutContainerConcat<_OutCtnType>;
-
 
 	inline static _OutCtnType Write(const _InObjType& val)
+	{
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _InObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
 	{
 		using _CharType = typename _InObjType::value_type;
 		size_t chWidth = sizeof(_CharType);
 
-		Concatenator ccntr;
-		_OutCtnType specs;
-		_OutCtnType rawData;
-
-		// 1.specs
-		specs.push_back(SerializeCatId(CatId::String));
-		specs.push_back(0x00U);
-		auto& chWidthByte = specs[1];
-
-		// 2.raw data
+		size_t rawSize = 0;
 		switch (chWidth)
 		{
 		case 1:
 		{
 			// 1-byte - assume to be UTF-8
-			chWidthByte = 0x00U;
-
-			auto begin = val.cbegin();
-			auto end = val.cend();
-			auto dest = std::back_inserter(rawData);
+			// (raw pointers are much cheaper to step through than the
+			// type-erased iterators)
+			const _CharType* begin = val.data();
+			const _CharType* end = begin + val.size();
 
 			using InputIt = decltype(begin);
-			using OutputIt = decltype(dest);
 
-			Internal::Utf::UtfConvert(
+			rawSize = Internal::Utf::UtfConvertGetSize(
 				Internal::Utf::Utf8ToCodePtOnce<InputIt>,
-				Internal::Utf::CodePtToUtf8Once<OutputIt>,
-				begin, end, dest);
+				Internal::Utf::CodePtToUtf8OnceGetSize,
+				begin, end);
 			break;
 		}
 
@@ -187,24 +186,81 @@ struct CatStringWriterImpl
 		// LCOV_EXCL_STOP
 		}
 
-		// 3.build RLP list
-		specs = Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::Bytes>(
-				specs,
-				ccntr
-			);
-		rawData = Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::Bytes>(
-				rawData,
-				ccntr
-			);
-		ccntr(specs, rawData);
-
-		return Internal::SimRlp::
-			SerializeBytes<Internal::SimRlp::RlpEncTypeCat::List>(
-				specs,
-				ccntr
-			);
+		// the converted size is needed again by `WriteTo`
+		sizeCache.Set(sizeCache.Reserve(), rawSize);
+
+		return Internal::CalcRlpListSize(CalcPayloadSize(rawSize));
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _InObjType& val
+	)
+	{
+		const size_t rawSize = sizeCache.Next();
+
+		destIt = Internal::WriteRlpListHeader(
+			CalcPayloadSize(rawSize),
+			destIt
+		);
+
+		// 1.specs
+		const uint8_t specs[sk_specsSize] = {
+			SerializeCatId(CatId::String),
+			0x00U, // 1-byte chars (UTF-8)
+		};
+		destIt = Internal::WriteRlpBytes(specs, sk_specsSize, destIt);
+
+		// 2.raw data
+		// a single UTF-8 code unit is always <= 0x7F, so it has no header
+		if (rawSize != 1)
+		{
+			destIt = Internal::SimRlp::SerializeLeadingBytes<
+				Internal::SimRlp::RlpEncTypeCat::Bytes,
+				uint8_t
+			>(rawSize, destIt);
+		}
+
+		const auto* begin = val.data();
+		const auto* end = begin + val.size();
+		if (rawSize == val.size())
+		{
+			// re-encoding never makes a code point longer, so if the size
+			// is unchanged, every code point is already in its canonical
+			// form, and the input can be copied as it is
+			return std::copy(begin, end, destIt);
+		}
+
+		while (begin != end)
+		{
+			auto codePtRes = Internal::Utf::Utf8ToCodePtOnce(begin, end);
+			Internal::Utf::CodePtToUtf8Once(codePtRes.first, destIt);
+			// `CodePtToUtf8Once` takes the iterator by value
+			size_t chSize =
+				Internal::Utf::CodePtToUtf8OnceGetSize(codePtRes.first);
+			for (size_t i = 0; i < chSize; ++i)
+			{
+				++destIt;
+			}
+			begin = codePtRes.second;
+		}
+
+		return destIt;
+	}
+
+private:
+
+	static constexpr size_t sk_specsSize = 2;
+
+	inline static size_t CalcPayloadSize(size_t rawSize)
+	{
+		// specs are 2 bytes, so they always take 3 bytes once encoded
+		size_t rawEncSize = (rawSize == 1) ?
+			1 :
+			Internal::CalcRlpBytesHeaderSize(rawSize) + rawSize;
+		return (1 + sk_specsSize) + rawEncSize;
 	}
 
 }; // struct CatStringWriterImpl
@@ -36,11 +36,50 @@ struct GenericRealNumWriterImpl
 
 
 	inline static _OutCtnType Write(const _RealNumObjType& val)
+	{
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _RealNumObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
+	{
+		switch (val.GetNumType())
+		{
+		case Internal::SimRlp::Internal::Obj::RealNumType::Bool:
+			return BooleanWriter::CalcSize(val, sizeCache);
+
+		case Internal::SimRlp::Internal::Obj::RealNumType::Int8:
+		case Internal::SimRlp::Internal::Obj::RealNumType::Int16:
+		case Internal::SimRlp::Internal::Obj::RealNumType::Int32:
+		case Internal::SimRlp::Internal::Obj::RealNumType::Int64:
+		case Internal::SimRlp::Internal::Obj::RealNumType::UInt8:
+		case Internal::SimRlp::Internal::Obj::RealNumType::UInt16:
+		case Internal::SimRlp::Internal::Obj::RealNumType::UInt32:
+		case Internal::SimRlp::Internal::Obj::RealNumType::UInt64:
+			return IntegerWriter::CalcSize(val, sizeCache);
+
+		default:
+			throw SerializeTypeError(
+				val.GetNumTypeName(), "GenericRealNumWriter");
+		}
+	}
+
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _RealNumObjType& val
+	)
 	{
 		switch (val.GetNumType())
 		{
 		case Internal::SimRlp::Internal::Obj::RealNumType::Bool:
-			return BooleanWriter::Write(val);
+			return BooleanWriter::WriteTo(destIt, sizeCache, val);
 
 		case Internal::SimRlp::Internal::Obj::RealNumType::Int8:
 		case Internal::SimRlp::Internal::Obj::RealNumType::Int16:
@@ -50,7 +89,7 @@ struct GenericRealNumWriterImpl
 		case Internal::SimRlp::Internal::Obj::RealNumType::UInt16:
 		case Internal::SimRlp::Internal::Obj::RealNumType::UInt32:
 		case Internal::SimRlp::Internal::Obj::RealNumType::UInt64:
-			return IntegerWriter::Write(val);
+			return IntegerWriter::WriteTo(destIt, sizeCache, val);
 
 		default:
 			throw SerializeTypeError(
@@ -94,34 +133,96 @@ struct GenericWriterImpl
 	using StaticDictWriter  = _StaticDictWriter<Self>;
 
 
+	/**
+	 * @brief Write the given object into a buffer of the exact size.
+	 *        It's done in two phases: `CalcSize` computes the size of every
+	 *        nested item once, and `WriteTo` writes all of them straight into
+	 *        the output, so no intermediate buffer is needed.
+	 *
+	 */
 	inline static _OutCtnType Write(const _ObjType& val)
+	{
+		Internal::SimRlp::WriterSizeCache sizeCache;
+		_OutCtnType outBytes(CalcSize(val, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, val);
+		return outBytes;
+	}
+
+	inline static size_t CalcSize(
+		const _ObjType& val,
+		Internal::SimRlp::WriterSizeCache& sizeCache
+	)
+	{
+		using namespace Internal::SimRlp::Internal;
+
+		switch (val.GetCategory())
+		{
+		case Obj::ObjCategory::Bytes:
+			return BytesWriter::CalcSize(val.AsBytes(), sizeCache);
+
+		case Obj::ObjCategory::Null:
+			return NullWriter::CalcSize(sizeCache);
+
+		case Obj::ObjCategory::Bool:
+		case Obj::ObjCategory::Integer:
+		case Obj::ObjCategory::Real:
+			return RealNumWriter::CalcSize(val.AsRealNum(), sizeCache);
+
+		case Obj::ObjCategory::String:
+			return StringWriter::CalcSize(val.AsString(), sizeCache);
+
+		case Obj::ObjCategory::List:
+			return ArrayWriter::CalcSize(val.AsList(), sizeCache);
+
+		case Obj::ObjCategory::Dict:
+			return DictWriter::CalcSize(val.AsDict(), sizeCache);
+
+		case Obj::ObjCategory::StaticDict:
+			return StaticDictWriter::CalcSize(val.AsStaticDict(), sizeCache);
+
+		default:
+			throw SerializeTypeError(val.GetCategoryName(), "GenericWriter");
+		}
+	}
+
+	/**
+	 * @brief Write the given object to the output iterator;
+	 *        `CalcSize(val, sizeCache)` must be called before this
+	 *
+	 */
+	template<typename _DestIt>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		Internal::SimRlp::WriterSizeCache& sizeCache,
+		const _ObjType& val
+	)
 	{
 		using namespace Internal::SimRlp::Internal;
 
 		switch (val.GetCategory())
 		{
 		case Obj::ObjCategory::Bytes:
-			return BytesWriter::Write(val.AsBytes());
+			return BytesWriter::WriteTo(destIt, sizeCache, val.AsBytes());
 
 		case Obj::ObjCategory::Null:
-			return NullWriter::Write();
+			return NullWriter::WriteTo(destIt, sizeCache);
 
 		case Obj::ObjCategory::Bool:
 		case Obj::ObjCategory::Integer:
 		case Obj::ObjCategory::Real:
-			return RealNumWriter::Write(val.AsRealNum());
+			return RealNumWriter::WriteTo(destIt, sizeCache, val.AsRealNum());
 
 		case Obj::ObjCategory::String:
-			return StringWriter::Write(val.AsString());
+			return StringWriter::WriteTo(destIt, sizeCache, val.AsString());
 
 		case Obj::ObjCategory::List:
-			return ArrayWriter::Write(val.AsList());
+			return ArrayWriter::WriteTo(destIt, sizeCache, val.AsList());
 
 		case Obj::ObjCategory::Dict:
-			return DictWriter::Write(val.AsDict());
+			return DictWriter::WriteTo(destIt, sizeCache, val.AsDict());
 
 		case Obj::ObjCategory::StaticDict:
-			return StaticDictWriter::Write(val.AsStaticDict());
+			return StaticDictWriter::WriteTo(destIt, sizeCache, val.AsStaticDict());
 
 		default:
 			throw SerializeTypeError(val.GetCategoryName(), "GenericWriter");
@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 
+#include <algorithm>
+
 #include "Internal/SimpleRlp.hpp"
 
 #include "Exceptions.hpp"
@@ -46,6 +50,66 @@ struct PrimitiveToRaw<
 	}
 }; // struct PrimitiveToRaw
 
+
+/**
+ * @brief The size of a RLP list whose payload has the given size
+ */
+inline size_t CalcRlpListSize(size_t payloadSize)
+{
+	return SimRlp::SerializedSize<SimRlp::RlpEncTypeCat::List>::
+		Calc<uint8_t>(payloadSize);
+}
+
+
+template<typename _DestIt>
+inline _DestIt WriteRlpListHeader(size_t payloadSize, _DestIt destIt)
+{
+	return SimRlp::SerializeLeadingBytes<SimRlp::RlpEncTypeCat::List, uint8_t>(
+		payloadSize, destIt
+	);
+}
+
+
+/**
+ * @brief The size of the leading bytes of RLP bytes with the given size,
+ *        not counting the single-byte special case
+ */
+inline size_t CalcRlpBytesHeaderSize(size_t size)
+{
+	return SimRlp::Internal::EncodeRlpBytesImpl<
+		SimRlp::RlpEncTypeCat::Bytes,
+		false
+	>::CalcLeadingBytesSize(size);
+}
+
+
+/**
+ * @brief The size of the given raw bytes, once encoded as RLP bytes
+ */
+inline size_t CalcRlpBytesSize(const uint8_t* data, size_t size)
+{
+	return SimRlp::SerializedSize<SimRlp::RlpEncTypeCat::Bytes>::
+		Calc(size, data);
+}
+
+
+/**
+ * @brief Write the given raw bytes as RLP bytes
+ */
+template<typename _DestIt>
+inline _DestIt WriteRlpBytes(const uint8_t* data, size_t size, _DestIt destIt)
+{
+	// Special case - if the input is just 1 byte
+	if ((size != 1) || (data[0] > 0x7FU))
+	{
+		destIt = SimRlp::SerializeLeadingBytes<
+			SimRlp::RlpEncTypeCat::Bytes,
+			uint8_t
+		>(size, destIt);
+	}
+	return std::copy(data, data + size, destIt);
+}
+
 } // namespace Internal
 
 } // namespace AdvancedRlp
@@ -30,6 +30,11 @@ using OutputContainerType = std::vector<uint8_t>;
 using RetObjType   = Internal::Obj::Object;
 using BytesObjType = Internal::Obj::Bytes;
 using ListObjType  = Internal::Obj::List;
+/**
+ * @brief Type of the bytes in trees built by `GeneralParser`, which are
+ *        mostly short (e.g., hashes, addresses and integers)
+ */
+using GeneralBytesObjType = Internal::Obj::SmallBytes;
 
 
 //====================
@@ -58,13 +63,21 @@ using ListParserT =
 		_InnerBytesParser,
 		_InnerListParser>;
 
-using ListParser = ListParserT<BytesParser, SelfParserPlaceholder>;
+using GeneralBytesParser =
+	BytesParserImpl<
+		InputContainerType,
+		ByteValType,
+		GeneralBytesObjType,
+		TransformByteToBytes<ByteValType, GeneralBytesObjType>,
+		TransformPassthrough<GeneralBytesObjType> >;
+
+using ListParser = ListParserT<GeneralBytesParser, SelfParserPlaceholder>;
 
 using GeneralParser =
 	GeneralParserImpl<
 		InputContainerType,
 		ByteValType,
-		BytesParser,
+		GeneralBytesParser,
 		ListParser,
 		RetObjType>;
 
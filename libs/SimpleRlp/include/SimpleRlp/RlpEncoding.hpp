@@ -149,6 +149,28 @@ struct EncodeRlpBytesImpl<RlpEncTypeCat::Bytes, false>
 		}
 	}
 
+	template<typename _DestIt>
+	static _DestIt WriteLeadingBytes(size_t byteSize, _DestIt destIt)
+	{
+		if (byteSize <= 55)
+		{
+			// RlpEncodeType::BytesShort
+			*(destIt++) = static_cast<uint8_t>(0x80U + byteSize);
+			return destIt;
+		}
+		else
+		{
+			// RlpEncodeType::BytesLong
+			auto lenValSize =
+				EncodeSizeValue<Endian::native, sk_isValSigned>::
+					EncodedWidth(byteSize);
+			*(destIt++) = static_cast<uint8_t>(0xB7U + lenValSize);
+			return EncodeSizeValue<Endian::native, sk_isValSigned>::Encode(
+				byteSize, destIt
+			);
+		}
+	}
+
 	static size_t CalcLeadingBytesSize(size_t byteSize)
 	{
 		if (byteSize <= 55)
@@ -232,6 +254,28 @@ struct EncodeRlpBytesImpl<RlpEncTypeCat::List, false>
 		}
 	}
 
+	template<typename _DestIt>
+	static _DestIt WriteLeadingBytes(size_t byteSize, _DestIt destIt)
+	{
+		if (byteSize <= 55)
+		{
+			// RlpEncodeType::ListShort
+			*(destIt++) = static_cast<uint8_t>(0xC0U + byteSize);
+			return destIt;
+		}
+		else
+		{
+			// RlpEncodeType::ListLong
+			auto lenValSize =
+				EncodeSizeValue<Endian::native, sk_isValSigned>::
+					EncodedWidth(byteSize);
+			*(destIt++) = static_cast<uint8_t>(0xF7U + lenValSize);
+			return EncodeSizeValue<Endian::native, sk_isValSigned>::Encode(
+				byteSize, destIt
+			);
+		}
+	}
+
 	static size_t CalcLeadingBytesSize(size_t byteSize)
 	{
 		if (byteSize <= 55)
@@ -321,6 +365,33 @@ inline _CtnType SerializeBytes(const _CtnType& inBytes, _OutConcatOp concatOp)
 // 	}
 // }
 
+/**
+ * @brief Helper function to write the leading bytes (i.e., the RLP header)
+ *        of a serial of bytes or a concatenated list of bytes, directly to
+ *        the given output iterator; the payload is expected to be written
+ *        right after it.
+ *        NOTE: for `RlpEncTypeCat::Bytes`, the caller is responsible for the
+ *        special case of a single byte in the range [0x00, 0x7F], which has
+ *        no leading bytes.
+ *
+ * @tparam _RlpCat  The category of the payload
+ * @tparam _ValType The type of each individual byte in the destination
+ * @tparam _DestIt  The type of the output iterator
+ *
+ * @param byteSize  The size of the payload, in bytes
+ * @param destIt    The output iterator
+ *
+ * @return The output iterator after the leading bytes
+ */
+template<RlpEncTypeCat _RlpCat, typename _ValType, typename _DestIt>
+inline _DestIt SerializeLeadingBytes(size_t byteSize, _DestIt destIt)
+{
+	return Internal::EncodeRlpBytesImpl<
+		_RlpCat,
+		std::numeric_limits<_ValType>::is_signed
+	>::WriteLeadingBytes(byteSize, destIt);
+}
+
 template<RlpEncTypeCat _RlpCat>
 struct SerializedSize;
 
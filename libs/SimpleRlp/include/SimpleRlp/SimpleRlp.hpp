@@ -19,11 +19,61 @@ inline RetObjType ParseRlp(const InputContainerType& inBytes)
 	return GeneralParser().Parse(inBytes);
 }
 
+/**
+ * @brief Parse the RLP bytes, allocating all nodes of the returned tree from
+ *        the given arena, which must outlive the returned object
+ *
+ */
+inline RetObjType ParseRlp(
+	const InputContainerType& inBytes,
+	Internal::Obj::ObjectArena& arena
+)
+{
+	Internal::Obj::ObjectArenaScope arenaScope(arena);
+	return GeneralParser().Parse(inBytes);
+}
+
 inline OutputContainerType WriteRlp(const Internal::Obj::BaseObj& obj)
 {
 	return WriterGeneric::Write(obj);
 }
 
+/**
+ * @brief Write the RLP encoding of the given object to the given output
+ *        iterator (e.g., a pointer into a buffer of at least
+ *        `CalcRlpSize(obj)` bytes), without any intermediate buffer
+ *
+ * @return The output iterator after the last byte written
+ */
+template<typename _DestIt>
+inline _DestIt WriteRlp(const Internal::Obj::BaseObj& obj, _DestIt destIt)
+{
+	WriterSizeCache sizeCache;
+	WriterGeneric::CalcSize(obj, sizeCache);
+	return WriterGeneric::WriteTo(destIt, sizeCache, obj);
+}
+
+/**
+ * @brief Write the RLP encoding of the given object to the given buffer
+ *
+ * @return The number of bytes written
+ */
+inline size_t WriteRlp(
+	const Internal::Obj::BaseObj& obj,
+	uint8_t* buf,
+	size_t bufSize
+)
+{
+	WriterSizeCache sizeCache;
+	size_t size = WriterGeneric::CalcSize(obj, sizeCache);
+	if (size > bufSize)
+	{
+		throw SerializeError("The given buffer is too small for the RLP");
+	}
+	WriterGeneric::WriteTo(buf, sizeCache, obj);
+	return size;
+}
+
 inline size_t CalcRlpSize(const Internal::Obj::BaseObj& obj)
 {
 	return WriterGeneric::CalcSize(obj);
@@ -83,10 +83,30 @@ protected:
 	{
 		TupleCore resTp;
 
-		size_t numOfParsers = std::tuple_size<ParserTuple>::value;
-		size_t numOfParsed = 0;
+		// The items are positional, so they are parsed in the order of the
+		// parser tuple in a single pass, without looking up the parser for
+		// each item
+		ParseValueCallBack cb(ism, size);
+		Internal::Obj::Internal::TupleOperation::BinOp(resTp, m_parserTp, cb);
+
+		if ((cb.m_parsed < sk_numOfParsers) && !_AllowMissingItem)
+		{
+			// missing items
+			throw ParseError("The static dict parser is expecting more items"
+				" to parse", ism.GetBytesCount());
+		}
+
 		while (size > 0)
 		{
+			// extra items
+			if (!_AllowExtraItem)
+			{
+				// extra item is not allowed, throw err
+				throw ParseError("The static dict parser encounters more "
+					"items than expected", ism.GetBytesCount());
+			}
+
+			// allowing extra item, consume it
 			InputByteType nextByte = ism.GetByteAndAdv();
 			--size;
 
@@ -95,39 +115,7 @@ protected:
 			std::tie(nextType, nextVal) =
 				DecodeRlpLeadingByte(nextByte, ism.GetBytesCount());
 
-			if (numOfParsed >= numOfParsers)
-			{
-				// extra items
-				if (_AllowExtraItem)
-				{
-					// allowing extra item, consume it
-					FallbackValParse().Parse(ism, nextType, nextVal, size);
-				}
-				else
-				{
-					// extra item is not allowed, throw err
-					throw ParseError("The static dict parser encounters more "
-						"items than expected", ism.GetBytesCount());
-				}
-			}
-			else
-			{
-				// item index within range
-				ParseValueCallBack cb(
-					numOfParsed, ism, nextType, nextVal, size);
-
-				Internal::Obj::Internal::TupleOperation::
-					BinOp(resTp, m_parserTp, cb);
-			}
-
-			++numOfParsed;
-		}
-
-		if ((numOfParsed < numOfParsers) && !_AllowMissingItem)
-		{
-			// missing items
-			throw ParseError("The static dict parser is expecting more items"
-				" to parse", ism.GetBytesCount());
+			FallbackValParse().Parse(ism, nextType, nextVal, size);
 		}
 
 		return RetType(std::move(resTp));
@@ -135,19 +123,16 @@ protected:
 
 private: // static members:
 
+	static constexpr size_t sk_numOfParsers =
+		std::tuple_size<ParserTuple>::value;
+
 	struct ParseValueCallBack
 	{
 
 		ParseValueCallBack(
-			size_t idx,
 			InputStateMachineIf<InputByteType>& ism,
-			RlpEncodeType rlpType,
-			InputByteType rlpVal,
 			size_t& byteLeft):
-			m_idx(idx),
 			m_ismPtr(&ism),
-			m_rlpType(rlpType),
-			m_rlpVal(rlpVal),
 			m_byteLeftPtr(&byteLeft),
 			m_parsed(0)
 		{}
@@ -156,23 +141,30 @@ private: // static members:
 
 		template<typename _KeyType, typename _ValType, typename _ValParserType>
 		void operator()(
-			size_t i,
+			size_t,
 			std::pair<_KeyType, _ValType>& core,
 			const std::pair<_KeyType, _ValParserType>& parser)
 		{
-			if (i == m_idx)
+			if ((*m_byteLeftPtr) == 0)
 			{
-				// A match is found
-				core.second = parser.second.Parse(
-					*m_ismPtr, m_rlpType, m_rlpVal, *m_byteLeftPtr);
-				++m_parsed;
+				// no more items in the input; the rest are missing
+				return;
 			}
+
+			InputByteType nextByte = m_ismPtr->GetByteAndAdv();
+			--(*m_byteLeftPtr);
+
+			RlpEncodeType nextType;
+			InputByteType nextVal;
+			std::tie(nextType, nextVal) =
+				DecodeRlpLeadingByte(nextByte, m_ismPtr->GetBytesCount());
+
+			core.second = parser.second.Parse(
+				*m_ismPtr, nextType, nextVal, *m_byteLeftPtr);
+			++m_parsed;
 		}
 
-		size_t m_idx;
 		InputStateMachineIf<InputByteType>* m_ismPtr;
-		RlpEncodeType m_rlpType;
-		InputByteType m_rlpVal;
 		size_t* m_byteLeftPtr;
 		size_t m_parsed;
 
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include <algorithm>
+#include <vector>
+
 #include <SimpleObjects/BasicDefs.hpp>
 
 #include "RlpEncoding.hpp"
@@ -25,6 +30,51 @@ struct OutContainerConcat
 	}
 }; // struct OutContainerConcat
 
+
+/**
+ * @brief The payload sizes of the lists in an object tree, in the order they
+ *        are visited.
+ *        Writing is done in two phases: `CalcSize` fills this cache, and
+ *        `WriteTo` takes the sizes from it to generate each list header,
+ *        so every size is computed only once, and every item is written
+ *        straight to the final output.
+ */
+class WriterSizeCache
+{
+public:
+
+	WriterSizeCache() :
+		m_sizes(),
+		m_readPos(0)
+	{}
+
+	/**
+	 * @brief Reserve a slot for a list whose size is not known yet
+	 *
+	 * @return the index of the slot
+	 */
+	size_t Reserve()
+	{
+		m_sizes.push_back(0);
+		return m_sizes.size() - 1;
+	}
+
+	void Set(size_t idx, size_t size)
+	{
+		m_sizes[idx] = size;
+	}
+
+	size_t Next()
+	{
+		return m_sizes[m_readPos++];
+	}
+
+private:
+
+	std::vector<size_t> m_sizes;
+	size_t m_readPos;
+}; // class WriterSizeCache
+
 template<typename _OutCtnType>
 struct WriterBytesImpl
 {
@@ -32,30 +82,59 @@ struct WriterBytesImpl
 
 	template<typename _BytesObjType>
 	inline static _OutCtnType Write(const _BytesObjType& inBytes)
+	{
+		_OutCtnType outBytes(CalcSize(inBytes));
+		WriteTo(&outBytes[0], inBytes);
+		return outBytes;
+	}
+
+	template<typename _BytesObjType>
+	inline static size_t CalcSize(const _BytesObjType& inBytes)
+	{
+		return SerializedSize<RlpEncTypeCat::Bytes>::Calc(
+			inBytes.size(), inBytes.data()
+		);
+	}
+
+	template<typename _BytesObjType>
+	inline static size_t CalcSize(
+		const _BytesObjType& inBytes,
+		WriterSizeCache&
+	)
+	{
+		return CalcSize(inBytes);
+	}
+
+	template<typename _DestIt, typename _BytesObjType>
+	inline static _DestIt WriteTo(_DestIt destIt, const _BytesObjType& inBytes)
 	{
 		using _OutCtnValType = typename _OutCtnType::value_type;
-		_OutCtnType outBytes;
 
 		const size_t inSize = inBytes.size();
 
 		auto begin = inBytes.data();
 		auto end = begin + inSize;
 
-		outBytes.reserve(inSize);
-		for (auto it = begin; it != end; ++it)
+		// Special case - if the input is just 1 byte
+		if ((inSize != 1) || (*begin > 0x7FU))
 		{
-			outBytes.push_back(static_cast<_OutCtnValType>(*it));
+			destIt = SerializeLeadingBytes<
+				RlpEncTypeCat::Bytes,
+				_OutCtnValType
+			>(inSize, destIt);
 		}
 
-		return SerializeBytes<RlpEncTypeCat::Bytes>(outBytes, Concatenator());
+		return std::copy(begin, end, destIt);
 	}
 
-	template<typename _BytesObjType>
-	inline static size_t CalcSize(const _BytesObjType& inBytes)
+	template<typename _DestIt, typename _BytesObjType>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		WriterSizeCache&,
+		const _BytesObjType& inBytes
+	)
 	{
-		return SerializedSize<RlpEncTypeCat::Bytes>::Calc(
-			inBytes.size(), inBytes.data()
-		);
+		return WriteTo(destIt, inBytes);
 	}
 
 }; // struct WriterBytesImpl
@@ -71,15 +150,12 @@ struct WriterListImpl
 	template<typename _ListObjType>
 	inline static _OutCtnType Write(const _ListObjType& inList)
 	{
-		_OutCtnType outBytes;
+		WriterSizeCache sizeCache;
+		// RLP is never empty, so the buffer has at least one byte
+		_OutCtnType outBytes(CalcSize(inList, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, inList);
 
-		for (const auto& item : inList)
-		{
-			auto subBytes = GenericWriter::Write(item);
-			Concatenator()(outBytes, subBytes);
-		}
-
-		return SerializeBytes<RlpEncTypeCat::List>(outBytes, Concatenator());
+		return outBytes;
 	}
 
 	template<typename _ListObjType>
@@ -88,13 +164,59 @@ struct WriterListImpl
 		using _OutValType = typename _OutCtnType::value_type;
 
 		size_t innerSize = 0;
-		for (const auto& item : inList)
+		for (const auto& item : inList.CSpan())
 		{
 			innerSize += GenericWriter::CalcSize(item);
 		}
 		return SerializedSize<RlpEncTypeCat::List>::Calc<_OutValType>(innerSize);
 	}
 
+	template<typename _ListObjType>
+	inline static size_t CalcSize(
+		const _ListObjType& inList,
+		WriterSizeCache& sizeCache
+	)
+	{
+		using _OutValType = typename _OutCtnType::value_type;
+
+		size_t sizeIdx = sizeCache.Reserve();
+
+		size_t innerSize = 0;
+		for (const auto& item : inList.CSpan())
+		{
+			innerSize += GenericWriter::CalcSize(item, sizeCache);
+		}
+
+		sizeCache.Set(sizeIdx, innerSize);
+		return SerializedSize<RlpEncTypeCat::List>::Calc<_OutValType>(innerSize);
+	}
+
+	/**
+	 * @brief Write the given list to the output iterator;
+	 *        `CalcSize(inList, sizeCache)` must be called before this
+	 *
+	 */
+	template<typename _DestIt, typename _ListObjType>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		WriterSizeCache& sizeCache,
+		const _ListObjType& inList
+	)
+	{
+		using _OutValType = typename _OutCtnType::value_type;
+
+		destIt = SerializeLeadingBytes<RlpEncTypeCat::List, _OutValType>(
+			sizeCache.Next(), destIt
+		);
+
+		for (const auto& item : inList.CSpan())
+		{
+			destIt = GenericWriter::WriteTo(destIt, sizeCache, item);
+		}
+
+		return destIt;
+	}
+
 }; // struct WriterListImpl
 
 template<typename _OutCtnType, typename _GenericWriter>
@@ -111,45 +233,99 @@ struct WriterStaticDictImpl
 		size_t skipLast = 0
 	)
 	{
-		_OutCtnType outBytes;
+		WriterSizeCache sizeCache;
+		// RLP is never empty, so the buffer has at least one byte
+		_OutCtnType outBytes(CalcSize(inDict, sizeCache, skipLast));
+		WriteTo(&outBytes[0], sizeCache, inDict, skipLast);
 
-		size_t itemLeft = inDict.size();
-		for (const auto& item : inDict)
+		return outBytes;
+	}
+
+	template<typename _StaticDictObjType>
+	inline static size_t CalcSize(
+		const _StaticDictObjType& inDict,
+		size_t skipLast = 0
+	)
+	{
+		using _OutValType = typename _OutCtnType::value_type;
+
+		size_t innerSize = 0;
+		const size_t numItems = NumItemsToWrite(inDict, skipLast);
+		for (size_t i = 0; i < numItems; ++i)
 		{
-			if (itemLeft <= skipLast)
-			{
-				break;
-			}
-			auto subBytes = GenericWriter::Write(item.second.get());
-			Concatenator()(outBytes, subBytes);
-			--itemLeft;
+			innerSize += GenericWriter::CalcSize(inDict[i]);
 		}
-
-		return SerializeBytes<RlpEncTypeCat::List>(outBytes, Concatenator());
+		return SerializedSize<RlpEncTypeCat::List>::Calc<_OutValType>(innerSize);
 	}
 
 	template<typename _StaticDictObjType>
 	inline static size_t CalcSize(
 		const _StaticDictObjType& inDict,
+		WriterSizeCache& sizeCache,
 		size_t skipLast = 0
 	)
 	{
 		using _OutValType = typename _OutCtnType::value_type;
 
+		size_t sizeIdx = sizeCache.Reserve();
+
 		size_t innerSize = 0;
-		size_t itemLeft = inDict.size();
-		for (const auto& item : inDict)
+		const size_t numItems = NumItemsToWrite(inDict, skipLast);
+		for (size_t i = 0; i < numItems; ++i)
 		{
-			if (itemLeft <= skipLast)
-			{
-				break;
-			}
-			innerSize += GenericWriter::CalcSize(item.second.get());
-			--itemLeft;
+			innerSize += GenericWriter::CalcSize(inDict[i], sizeCache);
 		}
+
+		sizeCache.Set(sizeIdx, innerSize);
 		return SerializedSize<RlpEncTypeCat::List>::Calc<_OutValType>(innerSize);
 	}
 
+	/**
+	 * @brief Write the given static dict to the output iterator;
+	 *        `CalcSize(inDict, sizeCache, skipLast)` must be called before
+	 *        this
+	 *
+	 */
+	template<typename _DestIt, typename _StaticDictObjType>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		WriterSizeCache& sizeCache,
+		const _StaticDictObjType& inDict,
+		size_t skipLast = 0
+	)
+	{
+		using _OutValType = typename _OutCtnType::value_type;
+
+		destIt = SerializeLeadingBytes<RlpEncTypeCat::List, _OutValType>(
+			sizeCache.Next(), destIt
+		);
+
+		const size_t numItems = NumItemsToWrite(inDict, skipLast);
+		for (size_t i = 0; i < numItems; ++i)
+		{
+			destIt = GenericWriter::WriteTo(destIt, sizeCache, inDict[i]);
+		}
+
+		return destIt;
+	}
+
+private:
+
+	/**
+	 * @brief The items are accessed by their index in the static dict,
+	 *        which is cheaper than going through its type-erased iterators
+	 *
+	 */
+	template<typename _StaticDictObjType>
+	inline static size_t NumItemsToWrite(
+		const _StaticDictObjType& inDict,
+		size_t skipLast
+	)
+	{
+		const size_t size = inDict.size();
+		return size > skipLast ? size - skipLast : 0;
+	}
+
 }; // struct WriterStaticDictImpl
 
 template<
@@ -171,17 +347,28 @@ struct WriterGenericImpl
 
 	template<typename _GenericObjType>
 	inline static _OutCtnType Write(const _GenericObjType& obj)
+	{
+		WriterSizeCache sizeCache;
+		// RLP is never empty, so the buffer has at least one byte
+		_OutCtnType outBytes(CalcSize(obj, sizeCache));
+		WriteTo(&outBytes[0], sizeCache, obj);
+
+		return outBytes;
+	}
+
+	template<typename _GenericObjType>
+	inline static size_t CalcSize(const _GenericObjType& obj)
 	{
 		switch (obj.GetCategory())
 		{
 		case Internal::Obj::ObjCategory::Bytes:
-			return BytesWriter::Write(obj.AsBytes());
+			return BytesWriter::CalcSize(obj.AsBytes());
 
 		case Internal::Obj::ObjCategory::List:
-			return ListWriter::Write(obj.AsList());
+			return ListWriter::CalcSize(obj.AsList());
 
 		case Internal::Obj::ObjCategory::StaticDict:
-			return StaticDictWriter::Write(obj.AsStaticDict());
+			return StaticDictWriter::CalcSize(obj.AsStaticDict());
 
 		default:
 			throw SerializeTypeError(obj.GetCategoryName());
@@ -189,18 +376,51 @@ struct WriterGenericImpl
 	}
 
 	template<typename _GenericObjType>
-	inline static size_t CalcSize(const _GenericObjType& obj)
+	inline static size_t CalcSize(
+		const _GenericObjType& obj,
+		WriterSizeCache& sizeCache
+	)
 	{
 		switch (obj.GetCategory())
 		{
 		case Internal::Obj::ObjCategory::Bytes:
-			return BytesWriter::CalcSize(obj.AsBytes());
+			return BytesWriter::CalcSize(obj.AsBytes(), sizeCache);
 
 		case Internal::Obj::ObjCategory::List:
-			return ListWriter::CalcSize(obj.AsList());
+			return ListWriter::CalcSize(obj.AsList(), sizeCache);
 
 		case Internal::Obj::ObjCategory::StaticDict:
-			return StaticDictWriter::CalcSize(obj.AsStaticDict());
+			return StaticDictWriter::CalcSize(obj.AsStaticDict(), sizeCache);
+
+		default:
+			throw SerializeTypeError(obj.GetCategoryName());
+		}
+	}
+
+	/**
+	 * @brief Write the given object to the output iterator;
+	 *        `CalcSize(obj, sizeCache)` must be called before this
+	 *
+	 */
+	template<typename _DestIt, typename _GenericObjType>
+	inline static _DestIt WriteTo(
+		_DestIt destIt,
+		WriterSizeCache& sizeCache,
+		const _GenericObjType& obj
+	)
+	{
+		switch (obj.GetCategory())
+		{
+		case Internal::Obj::ObjCategory::Bytes:
+			return BytesWriter::WriteTo(destIt, sizeCache, obj.AsBytes());
+
+		case Internal::Obj::ObjCategory::List:
+			return ListWriter::WriteTo(destIt, sizeCache, obj.AsList());
+
+		case Internal::Obj::ObjCategory::StaticDict:
+			return StaticDictWriter::WriteTo(
+				destIt, sizeCache, obj.AsStaticDict()
+			);
 
 		default:
 			throw SerializeTypeError(obj.GetCategoryName());
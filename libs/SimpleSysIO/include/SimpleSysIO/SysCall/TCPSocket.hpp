@@ -190,6 +190,19 @@ public:
 	}
 
 
+	/**
+	 * @brief Shut down both directions of the connection, so that calls
+	 *        blocked on this socket (e.g., in another thread) return;
+	 *        errors (e.g., the socket is not connected) are ignored
+	 *
+	 */
+	void Shutdown() noexcept
+	{
+		boost::system::error_code ec;
+		m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+	}
+
+
 protected:
 
 
@@ -33,6 +33,7 @@
 #include <iterator>
 #include <limits>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 #include "Exceptions.hpp"